@@ -0,0 +1,135 @@
+#include "async_scheduler.h"
+
+#include <string>
+#include <thread>
+
+#include "../common/logger.h"
+#include "execution_context.h"
+#include "graph.h"
+
+using oneday::core::Logger;
+
+namespace oneday {
+namespace core {
+namespace blueprint {
+
+AsyncScheduler::AsyncScheduler(Engine& engine) : m_engine(engine) {}
+
+AsyncScheduler::TaskId AsyncScheduler::start(const BlueprintGraph& graph,
+                                             ExecutionContext* context,
+                                             CompletionCallback onComplete) {
+    // 第二次 beginRun 会重置节点值，挂起中的执行恢复后将在被覆盖的状态上继续
+    if (isGraphActive(graph)) {
+        ExecutionResult result;
+        result.message = "Graph already has an active execution";
+        result.errorDetails = "Graph " + graph.getId() + " is suspended in task " +
+                              std::to_string(m_activeGraphs.at(&graph));
+        result.totalNodes = static_cast<int>(graph.getNodeCount());
+        Logger::error("Async blueprint start rejected: {}", result.errorDetails);
+        if (onComplete) {
+            onComplete(kInvalidTaskId, result);
+        }
+        return kInvalidTaskId;
+    }
+
+    auto task = std::make_unique<Task>();
+    if (!context) {
+        task->ownedContext = std::make_unique<ExecutionContext>();
+        context = task->ownedContext.get();
+    }
+    task->onComplete = std::move(onComplete);
+
+    const TaskId id = m_nextId++;
+    const bool suspended = m_engine.startRun(graph, *context, task->run);
+    schedule(id, std::move(task), suspended);
+    return id;
+}
+
+size_t AsyncScheduler::update(Clock::time_point now) {
+    // 先取出本次到期的全部条目，保证每个执行在一次 update 中至多恢复一次
+    std::vector<TaskId> due;
+    while (!m_timers.empty() && m_timers.top().time <= now) {
+        due.push_back(m_timers.top().id);
+        m_timers.pop();
+    }
+
+    size_t resumed = 0;
+    for (TaskId id : due) {
+        auto it = m_tasks.find(id);
+        if (it == m_tasks.end()) {
+            continue;  // 已取消
+        }
+        std::unique_ptr<Task> task = std::move(it->second);
+        m_tasks.erase(it);
+
+        const bool suspended = m_engine.resumeRun(task->run);
+        schedule(id, std::move(task), suspended);
+        ++resumed;
+    }
+    return resumed;
+}
+
+void AsyncScheduler::runUntilIdle() {
+    while (auto wakeTime = getNextWakeTime()) {
+        std::this_thread::sleep_until(*wakeTime);
+        update();
+    }
+}
+
+bool AsyncScheduler::cancel(TaskId id) {
+    auto it = m_tasks.find(id);
+    if (it == m_tasks.end()) {
+        return false;
+    }
+    std::unique_ptr<Task> task = std::move(it->second);
+    m_tasks.erase(it);
+    m_activeGraphs.erase(task->run.graph);
+
+    // 定时器条目留在队列中，出队时因找不到任务而被忽略
+    ExecutionRun& run = task->run;
+    run.finished = true;
+    run.result.success = false;
+    run.result.message = "Execution cancelled";
+    run.context->setState(ExecutionState::Cancelled);
+    if (task->onComplete) {
+        task->onComplete(id, run.result);
+    }
+    return true;
+}
+
+std::optional<AsyncScheduler::Clock::time_point> AsyncScheduler::getNextWakeTime() {
+    dropStaleTimers();
+    if (m_timers.empty()) {
+        return std::nullopt;
+    }
+    return m_timers.top().time;
+}
+
+void AsyncScheduler::schedule(TaskId id, std::unique_ptr<Task> task, bool suspended) {
+    if (suspended) {
+        m_timers.push(TimerEntry{task->run.resumeTime, m_sequence++, id});
+        m_activeGraphs[task->run.graph] = id;
+        m_tasks.emplace(id, std::move(task));
+        return;
+    }
+
+    // 先释放图表再回调，回调中可以重新开始同一个图表
+    m_activeGraphs.erase(task->run.graph);
+
+    if (!task->run.result.success) {
+        Logger::warning("Async blueprint task {} ended: {}", id, task->run.result.message);
+    }
+    if (task->onComplete) {
+        task->onComplete(id, task->run.result);
+    }
+}
+
+void AsyncScheduler::dropStaleTimers() {
+    while (!m_timers.empty() && m_tasks.find(m_timers.top().id) == m_tasks.end()) {
+        m_timers.pop();
+    }
+}
+
+}  // namespace blueprint
+}  // namespace core
+}  // namespace oneday
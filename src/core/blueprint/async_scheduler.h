@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "engine.h"
+
+namespace oneday {
+namespace core {
+namespace blueprint {
+
+/**
+ * @brief 蓝图异步调度器
+ *
+ * 在单个线程上协作式地复用多个图表执行：执行流节点（如延迟节点）挂起时，
+ * 执行状态连同恢复时间放入按时间排序的优先队列，update() 只恢复已到期的执行。
+ * 大部分时间在等待延迟的脚本因此不再各自占用一个阻塞的线程。
+ *
+ * 调度器不是线程安全的，start/update/cancel 需在同一线程调用。
+ * 节点值存放在图表节点中，每个图表同一时间只能有一个活动的执行：图表已有挂起中的执行时，
+ * 再次 start() 会被拒绝（需要并发运行的实例应各自使用独立的图表对象）。
+ */
+class AsyncScheduler {
+  public:
+    using Clock = ExecutionRun::Clock;
+    using TaskId = uint64_t;
+    using CompletionCallback = std::function<void(TaskId, const ExecutionResult&)>;
+
+    static constexpr TaskId kInvalidTaskId = 0;  ///< start() 被拒绝时返回的任务ID
+
+    /**
+     * @brief 构造函数
+     * @param engine 执行引擎（生命周期需长于调度器）
+     */
+    explicit AsyncScheduler(Engine& engine);
+
+    /**
+     * @brief 开始执行图表，立即运行到结束或第一次挂起
+     * @param graph 要执行的图表（执行结束前不能销毁）
+     * @param context 执行上下文，为空时由调度器为该执行创建独立的上下文
+     * @param onComplete 执行结束（成功、失败或取消）时的回调
+     * @return 任务ID（执行未挂起就已结束时同样有效，回调已在返回前调用）；
+     *         图表已有挂起中的执行时返回 kInvalidTaskId，回调以失败结果在返回前调用
+     */
+    TaskId start(const BlueprintGraph& graph,
+                 ExecutionContext* context = nullptr,
+                 CompletionCallback onComplete = nullptr);
+
+    /**
+     * @brief 恢复所有到期的执行
+     * @param now 当前时间
+     * @return 本次恢复的执行数量
+     */
+    size_t update(Clock::time_point now);
+
+    /**
+     * @brief 使用当前时间恢复所有到期的执行
+     */
+    size_t update() {
+        return update(Clock::now());
+    }
+
+    /**
+     * @brief 阻塞运行，直到所有执行结束（空闲时睡眠到下一个恢复时间）
+     */
+    void runUntilIdle();
+
+    /**
+     * @brief 取消挂起中的执行
+     * @return 任务存在并被取消返回 true
+     */
+    bool cancel(TaskId id);
+
+    /**
+     * @brief 获取挂起中的执行数量
+     */
+    size_t getActiveCount() const {
+        return m_tasks.size();
+    }
+
+    /**
+     * @brief 图表是否有挂起中的执行
+     */
+    bool isGraphActive(const BlueprintGraph& graph) const {
+        return m_activeGraphs.find(&graph) != m_activeGraphs.end();
+    }
+
+    /**
+     * @brief 获取最早的恢复时间（没有挂起的执行时为空）
+     */
+    std::optional<Clock::time_point> getNextWakeTime();
+
+  private:
+    /**
+     * @brief 挂起中的执行
+     */
+    struct Task {
+        ExecutionRun run;                                ///< 执行状态
+        std::unique_ptr<ExecutionContext> ownedContext;  ///< 调度器创建的上下文
+        CompletionCallback onComplete;                   ///< 完成回调
+    };
+
+    /**
+     * @brief 定时器条目（按恢复时间排序，同一时间按入队顺序）
+     */
+    struct TimerEntry {
+        Clock::time_point time;  ///< 恢复时间
+        uint64_t sequence;       ///< 入队序号
+        TaskId id;               ///< 任务ID
+
+        bool operator>(const TimerEntry& other) const {
+            return time != other.time ? time > other.time : sequence > other.sequence;
+        }
+    };
+
+    Engine& m_engine;                                                  ///< 执行引擎
+    std::unordered_map<TaskId, std::unique_ptr<Task>> m_tasks;         ///< 挂起中的执行
+    std::unordered_map<const BlueprintGraph*, TaskId> m_activeGraphs;  ///< 有挂起执行的图表
+    std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<TimerEntry>>
+        m_timers;                                                      ///< 恢复时间队列
+    TaskId m_nextId = 1;                                               ///< 下一个任务ID
+    uint64_t m_sequence = 0;                                           ///< 定时器入队序号
+
+    /**
+     * @brief 执行挂起时登记定时器，结束时调用回调并移除任务
+     */
+    void schedule(TaskId id, std::unique_ptr<Task> task, bool suspended);
+
+    /**
+     * @brief 丢弃已取消任务遗留在队首的定时器
+     */
+    void dropStaleTimers();
+};
+
+}  // namespace blueprint
+}  // namespace core
+}  // namespace oneday
@@ -1,5 +1,7 @@
 #include "data_types.h"
 
+#include <charconv>
+#include <cstdlib>
 #include <iomanip>
 #include <sstream>
 
@@ -13,79 +15,19 @@ namespace blueprint {
 
 // BlueprintValue 实现
 
-BlueprintValue::BlueprintValue() : m_value(std::monostate{}), m_type(DataType::None) {}
-
-template <typename T>
-BlueprintValue::BlueprintValue(const T& value) : m_value(value) {
-    updateType();
-}
-
-BlueprintValue::BlueprintValue(const BlueprintValue& other)
-    : m_value(other.m_value), m_type(other.m_type) {}
-
-BlueprintValue::BlueprintValue(BlueprintValue&& other) noexcept
-    : m_value(std::move(other.m_value)), m_type(other.m_type) {
-    other.m_type = DataType::None;
-}
-
-BlueprintValue& BlueprintValue::operator=(const BlueprintValue& other) {
-    if (this != &other) {
-        m_value = other.m_value;
-        m_type = other.m_type;
-    }
-    return *this;
-}
-
-BlueprintValue& BlueprintValue::operator=(BlueprintValue&& other) noexcept {
-    if (this != &other) {
-        m_value = std::move(other.m_value);
-        m_type = other.m_type;
-        other.m_type = DataType::None;
-    }
-    return *this;
-}
-
-DataType BlueprintValue::getType() const {
-    return m_type;
+BlueprintValue::BlueprintValue(std::string&& value) : m_type(DataType::String) {
+    new (&m_storage.shared)
+        std::shared_ptr<const void>(std::make_shared<const std::string>(std::move(value)));
 }
 
-template <typename T>
-bool BlueprintValue::is() const {
-    return std::holds_alternative<T>(m_value);
+BlueprintValue::BlueprintValue(BlueprintArray&& value) : m_type(DataType::Array) {
+    new (&m_storage.shared)
+        std::shared_ptr<const void>(std::make_shared<const BlueprintArray>(std::move(value)));
 }
 
-template <typename T>
-T BlueprintValue::get() const {
-    try {
-        return std::get<T>(m_value);
-    } catch (const std::bad_variant_access& e) {
-        Logger::error("BlueprintValue::get() - Type mismatch: " + std::string(e.what()));
-        return T{};
-    }
-}
-
-template <typename T>
-bool BlueprintValue::tryGet(T& outValue) const {
-    if (std::holds_alternative<T>(m_value)) {
-        outValue = std::get<T>(m_value);
-        return true;
-    }
-    return false;
-}
-
-template <typename T>
-void BlueprintValue::set(const T& value) {
-    m_value = value;
-    updateType();
-}
-
-bool BlueprintValue::isEmpty() const {
-    return m_type == DataType::None;
-}
-
-void BlueprintValue::clear() {
-    m_value = std::monostate{};
-    m_type = DataType::None;
+void BlueprintValue::reportTypeMismatch(DataType requested) const {
+    Logger::error("BlueprintValue::get() - Type mismatch: requested {}, holds {}",
+                  DataTypeUtils::getTypeName(requested), DataTypeUtils::getTypeName(m_type));
 }
 
 std::string BlueprintValue::toString() const {
@@ -102,7 +44,7 @@ std::string BlueprintValue::toString() const {
             oss << std::fixed << std::setprecision(3) << get<float>();
             return oss.str();
         case DataType::String:
-            return get<std::string>();
+            return *getIf<std::string>();
         case DataType::Vector2: {
             auto v = get<Vector2>();
             oss << "(" << v.x << ", " << v.y << ")";
@@ -121,8 +63,7 @@ std::string BlueprintValue::toString() const {
         case DataType::Object:
             return "Object";
         case DataType::Array: {
-            auto arr = get<BlueprintArray>();
-            oss << "Array[" << arr.size() << "]";
+            oss << "Array[" << getIf<BlueprintArray>()->size() << "]";
             return oss.str();
         }
         case DataType::Execution:
@@ -137,41 +78,41 @@ bool BlueprintValue::operator==(const BlueprintValue& other) const {
         return false;
     }
 
-    return m_value == other.m_value;
+    switch (m_type) {
+        case DataType::None:
+            return true;
+        case DataType::Boolean:
+            return load<bool>() == other.load<bool>();
+        case DataType::Integer:
+            return load<int>() == other.load<int>();
+        case DataType::Float:
+            return load<float>() == other.load<float>();
+        case DataType::Vector2:
+            return load<Vector2>() == other.load<Vector2>();
+        case DataType::Vector3:
+            return load<Vector3>() == other.load<Vector3>();
+        case DataType::Color:
+            return load<Color>() == other.load<Color>();
+        case DataType::Execution:
+            return load<ExecutionToken>() == other.load<ExecutionToken>();
+        case DataType::Object:
+            return m_storage.shared == other.m_storage.shared ||
+                   *getIf<ObjectReference>() == *other.getIf<ObjectReference>();
+        case DataType::String:
+            return m_storage.shared == other.m_storage.shared ||
+                   *getIf<std::string>() == *other.getIf<std::string>();
+        case DataType::Array:
+            return m_storage.shared == other.m_storage.shared ||
+                   *getIf<BlueprintArray>() == *other.getIf<BlueprintArray>();
+        default:
+            return false;
+    }
 }
 
 bool BlueprintValue::operator!=(const BlueprintValue& other) const {
     return !(*this == other);
 }
 
-void BlueprintValue::updateType() {
-    if (std::holds_alternative<std::monostate>(m_value)) {
-        m_type = DataType::None;
-    } else if (std::holds_alternative<bool>(m_value)) {
-        m_type = DataType::Boolean;
-    } else if (std::holds_alternative<int>(m_value)) {
-        m_type = DataType::Integer;
-    } else if (std::holds_alternative<float>(m_value)) {
-        m_type = DataType::Float;
-    } else if (std::holds_alternative<std::string>(m_value)) {
-        m_type = DataType::String;
-    } else if (std::holds_alternative<Vector2>(m_value)) {
-        m_type = DataType::Vector2;
-    } else if (std::holds_alternative<Vector3>(m_value)) {
-        m_type = DataType::Vector3;
-    } else if (std::holds_alternative<Color>(m_value)) {
-        m_type = DataType::Color;
-    } else if (std::holds_alternative<ObjectReference>(m_value)) {
-        m_type = DataType::Object;
-    } else if (std::holds_alternative<BlueprintArray>(m_value)) {
-        m_type = DataType::Array;
-    } else if (std::holds_alternative<ExecutionToken>(m_value)) {
-        m_type = DataType::Execution;
-    } else {
-        m_type = DataType::None;
-    }
-}
-
 // DataTypeUtils 实现
 
 const std::map<DataType, std::string> DataTypeUtils::s_typeNames = {
@@ -276,171 +217,177 @@ Color DataTypeUtils::getTypeColor(DataType type) {
     return it != s_typeColors.end() ? it->second : Color(0.5f, 0.5f, 0.5f);
 }
 
-// 显式模板实例化
-template BlueprintValue::BlueprintValue(const bool&);
-template BlueprintValue::BlueprintValue(const int&);
-template BlueprintValue::BlueprintValue(const float&);
-template BlueprintValue::BlueprintValue(const std::string&);
-template BlueprintValue::BlueprintValue(const Vector2&);
-template BlueprintValue::BlueprintValue(const Vector3&);
-template BlueprintValue::BlueprintValue(const Color&);
-template BlueprintValue::BlueprintValue(const ExecutionToken&);
-
-template bool BlueprintValue::is<bool>() const;
-template bool BlueprintValue::is<int>() const;
-template bool BlueprintValue::is<float>() const;
-template bool BlueprintValue::is<std::string>() const;
-
-template bool BlueprintValue::get<bool>() const;
-template int BlueprintValue::get<int>() const;
-template float BlueprintValue::get<float>() const;
-template std::string BlueprintValue::get<std::string>() const;
-
-template void BlueprintValue::set<bool>(const bool&);
-template void BlueprintValue::set<int>(const int&);
-template void BlueprintValue::set<float>(const float&);
-template void BlueprintValue::set<std::string>(const std::string&);
-
 // TypeConversionManager 实现
 
-TypeConversionManager& TypeConversionManager::instance() {
-    static TypeConversionManager instance;
-    static bool initialized = false;
-    if (!initialized) {
-        instance.initializeDefaultConverters();
-        initialized = true;
-    }
-    return instance;
-}
+namespace {
 
-void TypeConversionManager::registerConverter(std::unique_ptr<TypeConverter> converter) {
-    if (converter) {
-        auto key = std::make_pair(converter->getFromType(), converter->getToType());
-        m_converters[key] = std::move(converter);
-        Logger::info("Registered type converter: " + DataTypeUtils::getTypeName(key.first) +
-                     " -> " + DataTypeUtils::getTypeName(key.second));
+bool intToFloat(const BlueprintValue& from, BlueprintValue& to) {
+    const int* value = from.getIf<int>();
+    if (!value) {
+        return false;
     }
+    to = BlueprintValue(static_cast<float>(*value));
+    return true;
 }
 
-bool TypeConversionManager::convert(const BlueprintValue& from,
-                                    DataType toType,
-                                    BlueprintValue& result) {
-    if (from.getType() == toType) {
-        result = from;
-        return true;
+bool floatToInt(const BlueprintValue& from, BlueprintValue& to) {
+    const float* value = from.getIf<float>();
+    if (!value) {
+        return false;
     }
+    to = BlueprintValue(static_cast<int>(*value));
+    return true;
+}
 
-    auto key = std::make_pair(from.getType(), toType);
-    auto it = m_converters.find(key);
-
-    if (it != m_converters.end()) {
-        return it->second->convert(from, result);
+bool vector2ToVector3(const BlueprintValue& from, BlueprintValue& to) {
+    const Vector2* value = from.getIf<Vector2>();
+    if (!value) {
+        return false;
     }
-
-    return false;
+    to = BlueprintValue(Vector3(value->x, value->y, 0.0f));
+    return true;
 }
 
-bool TypeConversionManager::canConvert(DataType from, DataType to) const {
-    if (from == to) {
-        return true;
+bool vector3ToVector2(const BlueprintValue& from, BlueprintValue& to) {
+    const Vector3* value = from.getIf<Vector3>();
+    if (!value) {
+        return false;
     }
-
-    auto key = std::make_pair(from, to);
-    return m_converters.find(key) != m_converters.end();
+    to = BlueprintValue(Vector2(value->x, value->y));
+    return true;
 }
 
-// 基础类型转换器实现
-class IntToFloatConverter : public TypeConverter {
-  public:
-    bool convert(const BlueprintValue& from, BlueprintValue& to) override {
-        if (from.is<int>()) {
-            to.set(static_cast<float>(from.get<int>()));
-            return true;
-        }
+bool boolToString(const BlueprintValue& from, BlueprintValue& to) {
+    const bool* value = from.getIf<bool>();
+    if (!value) {
         return false;
     }
+    to = BlueprintValue(std::string(*value ? "true" : "false"));
+    return true;
+}
 
-    DataType getFromType() const override {
-        return DataType::Integer;
-    }
-    DataType getToType() const override {
-        return DataType::Float;
+bool intToString(const BlueprintValue& from, BlueprintValue& to) {
+    const int* value = from.getIf<int>();
+    if (!value) {
+        return false;
     }
-};
+    to = BlueprintValue(std::to_string(*value));
+    return true;
+}
 
-class FloatToIntConverter : public TypeConverter {
-  public:
-    bool convert(const BlueprintValue& from, BlueprintValue& to) override {
-        if (from.is<float>()) {
-            to.set(static_cast<int>(from.get<float>()));
-            return true;
-        }
+bool floatToString(const BlueprintValue& from, BlueprintValue& to) {
+    const float* value = from.getIf<float>();
+    if (!value) {
         return false;
     }
+    to = BlueprintValue(std::to_string(*value));
+    return true;
+}
 
-    DataType getFromType() const override {
-        return DataType::Float;
-    }
-    DataType getToType() const override {
-        return DataType::Integer;
+bool stringToBool(const BlueprintValue& from, BlueprintValue& to) {
+    const std::string* value = from.getIf<std::string>();
+    if (!value) {
+        return false;
     }
-};
-
-class BoolToStringConverter : public TypeConverter {
-  public:
-    bool convert(const BlueprintValue& from, BlueprintValue& to) override {
-        if (from.is<bool>()) {
-            to.set(from.get<bool>() ? std::string("true") : std::string("false"));
-            return true;
-        }
+    if (*value == "true" || *value == "1") {
+        to = BlueprintValue(true);
+    } else if (*value == "false" || *value == "0") {
+        to = BlueprintValue(false);
+    } else {
         return false;
     }
+    return true;
+}
 
-    DataType getFromType() const override {
-        return DataType::Boolean;
-    }
-    DataType getToType() const override {
-        return DataType::String;
+bool stringToInt(const BlueprintValue& from, BlueprintValue& to) {
+    const std::string* value = from.getIf<std::string>();
+    if (!value) {
+        return false;
     }
-};
-
-class NumberToStringConverter : public TypeConverter {
-  private:
-    DataType m_fromType;
-
-  public:
-    explicit NumberToStringConverter(DataType fromType) : m_fromType(fromType) {}
-
-    bool convert(const BlueprintValue& from, BlueprintValue& to) override {
-        if (m_fromType == DataType::Integer && from.is<int>()) {
-            to.set(std::to_string(from.get<int>()));
-            return true;
-        } else if (m_fromType == DataType::Float && from.is<float>()) {
-            to.set(std::to_string(from.get<float>()));
-            return true;
-        }
+    int result = 0;
+    auto [end, error] = std::from_chars(value->data(), value->data() + value->size(), result);
+    if (error != std::errc() || end != value->data() + value->size()) {
         return false;
     }
+    to = BlueprintValue(result);
+    return true;
+}
 
-    DataType getFromType() const override {
-        return m_fromType;
+bool stringToFloat(const BlueprintValue& from, BlueprintValue& to) {
+    const std::string* value = from.getIf<std::string>();
+    if (!value || value->empty()) {
+        return false;
     }
-    DataType getToType() const override {
-        return DataType::String;
+    char* end = nullptr;
+    const float result = std::strtof(value->c_str(), &end);
+    if (end != value->c_str() + value->size()) {
+        return false;
     }
-};
+    to = BlueprintValue(result);
+    return true;
+}
+
+constexpr size_t index(DataType type) {
+    return static_cast<size_t>(type);
+}
+
+constexpr ConversionTable makeBuiltinConverters() {
+    ConversionTable table{};
 
-void TypeConversionManager::initializeDefaultConverters() {
     // 数值类型转换
-    registerConverter(std::make_unique<IntToFloatConverter>());
-    registerConverter(std::make_unique<FloatToIntConverter>());
+    table[index(DataType::Integer)][index(DataType::Float)] = &intToFloat;
+    table[index(DataType::Float)][index(DataType::Integer)] = &floatToInt;
+
+    // 向量类型转换
+    table[index(DataType::Vector2)][index(DataType::Vector3)] = &vector2ToVector3;
+    table[index(DataType::Vector3)][index(DataType::Vector2)] = &vector3ToVector2;
 
     // 转换为字符串
-    registerConverter(std::make_unique<BoolToStringConverter>());
-    registerConverter(std::make_unique<NumberToStringConverter>(DataType::Integer));
-    registerConverter(std::make_unique<NumberToStringConverter>(DataType::Float));
+    table[index(DataType::Boolean)][index(DataType::String)] = &boolToString;
+    table[index(DataType::Integer)][index(DataType::String)] = &intToString;
+    table[index(DataType::Float)][index(DataType::String)] = &floatToString;
+
+    // 从字符串解析
+    table[index(DataType::String)][index(DataType::Boolean)] = &stringToBool;
+    table[index(DataType::String)][index(DataType::Integer)] = &stringToInt;
+    table[index(DataType::String)][index(DataType::Float)] = &stringToFloat;
+
+    return table;
+}
+
+constexpr ConversionTable kBuiltinConverters = makeBuiltinConverters();
+
+}  // namespace
+
+TypeConversionManager::TypeConversionManager() : m_converters(kBuiltinConverters) {}
+
+TypeConversionManager& TypeConversionManager::instance() {
+    static TypeConversionManager instance;
+    return instance;
+}
+
+void TypeConversionManager::registerConverter(DataType from,
+                                              DataType to,
+                                              ConversionFunction converter) {
+    m_converters[index(from)][index(to)] = converter;
+    Logger::info("Registered type converter: {} -> {}",
+                 DataTypeUtils::getTypeName(from), DataTypeUtils::getTypeName(to));
+}
 
-    Logger::info("Default type converters initialized");
+bool TypeConversionManager::convert(const BlueprintValue& from,
+                                    DataType toType,
+                                    BlueprintValue& result) const {
+    if (from.getType() == toType) {
+        result = from;
+        return true;
+    }
+
+    ConversionFunction converter = getConverter(from.getType(), toType);
+    return converter && converter(from, result);
+}
+
+bool TypeConversionManager::canConvert(DataType from, DataType to) const {
+    return from == to || getConverter(from, to) != nullptr;
 }
 
 }  // namespace blueprint
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <string>
-#include <variant>
 #include <vector>
 #include <map>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <typeinfo>
 #include <functional>
 
+#include <spdlog/fmt/fmt.h>
+
 namespace oneday {
 namespace core {
 namespace blueprint {
@@ -100,101 +106,238 @@ class BlueprintValue;
 using BlueprintArray = std::vector<BlueprintValue>;
 
 /**
- * @brief 对象引用类型
+ * @brief 对象引用类型：共享的对象指针及其动态类型
+ *
+ * 从 std::shared_ptr<T> 构造时记下 T 的类型，as<T>() 只在类型一致时返回对象，
+ * 节点可以据此拒绝类型不符的输入。从 std::shared_ptr<void> 构造的引用没有类型信息，
+ * 只能按 void 取出。
  */
-using ObjectReference = std::shared_ptr<void>;
+class ObjectReference {
+public:
+    ObjectReference() = default;
+
+    template<typename T>
+    ObjectReference(std::shared_ptr<T> object)
+        : m_object(std::const_pointer_cast<std::remove_const_t<T>>(std::move(object))),
+          m_type(&typeid(std::remove_const_t<T>)) {}
+
+    /**
+     * @brief 按类型取出对象（引用为空或类型不一致时返回空指针）
+     */
+    template<typename T>
+    std::shared_ptr<T> as() const {
+        if (!m_object || *m_type != typeid(std::remove_const_t<T>)) {
+            return nullptr;
+        }
+        return std::static_pointer_cast<T>(m_object);
+    }
+
+    /**
+     * @brief 对象的类型（空引用为 void）
+     */
+    const std::type_info& type() const { return m_object ? *m_type : typeid(void); }
+
+    explicit operator bool() const { return m_object != nullptr; }
+
+    /**
+     * @brief 引用同一个对象时相等
+     */
+    bool operator==(const ObjectReference& other) const { return m_object == other.m_object; }
+
+private:
+    std::shared_ptr<void> m_object;               ///< 被引用的对象
+    const std::type_info* m_type = &typeid(void); ///< 构造时的对象类型
+};
+
+/**
+ * @brief C++ 类型到蓝图数据类型的编译期映射
+ *
+ * inlineStorage 为 true 的类型可平凡复制，直接存放在 BlueprintValue 内部；
+ * 其余类型（字符串、数组、对象）存放在共享的不可变堆对象中。
+ */
+template <typename T>
+struct BlueprintValueTraits {
+    static constexpr bool supported = false;
+};
+
+#define ONEDAY_BLUEPRINT_VALUE_TRAITS(CppType, Type, Inline)  \
+    template <>                                                \
+    struct BlueprintValueTraits<CppType> {                     \
+        static constexpr bool supported = true;                \
+        static constexpr DataType type = DataType::Type;       \
+        static constexpr bool inlineStorage = Inline;          \
+    };
+
+ONEDAY_BLUEPRINT_VALUE_TRAITS(bool, Boolean, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(int, Integer, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(float, Float, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(Vector2, Vector2, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(Vector3, Vector3, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(Color, Color, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(ExecutionToken, Execution, true)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(std::string, String, false)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(ObjectReference, Object, false)
+ONEDAY_BLUEPRINT_VALUE_TRAITS(BlueprintArray, Array, false)
+
+#undef ONEDAY_BLUEPRINT_VALUE_TRAITS
 
 /**
- * @brief 蓝图值的变体类型
+ * @brief 可存入 BlueprintValue 的 C++ 类型
  */
-using ValueVariant = std::variant<
-    std::monostate,     // None
-    bool,               // Boolean
-    int,                // Integer
-    float,              // Float
-    std::string,        // String
-    Vector2,            // Vector2
-    Vector3,            // Vector3
-    Color,              // Color
-    ObjectReference,    // Object
-    BlueprintArray,     // Array
-    ExecutionToken      // Execution
->;
+template <typename T>
+concept BlueprintValueType = BlueprintValueTraits<T>::supported;
 
 /**
  * @brief 蓝图系统的通用值类型
+ *
+ * 布尔、整数、浮点、向量、颜色和执行流标记以平凡可复制的形式内联存储，拷贝只是一次
+ * 定长内存复制；字符串、数组和对象存放在共享的不可变堆对象中，拷贝只增加引用计数。
+ * is/get 等模板在编译期确定目标类型，运行时只比较一次类型标记。
  */
 class BlueprintValue {
 public:
     /**
      * @brief 默认构造函数
      */
-    BlueprintValue();
+    BlueprintValue() noexcept : m_type(DataType::None) {}
     
     /**
      * @brief 从具体类型构造
      */
-    template<typename T>
-    BlueprintValue(const T& value);
+    template<BlueprintValueType T>
+    BlueprintValue(const T& value) : m_type(DataType::None) {
+        construct(value);
+    }
+    
+    /**
+     * @brief 从字符串右值构造（避免复制字符串内容）
+     */
+    BlueprintValue(std::string&& value);
+    
+    /**
+     * @brief 从数组右值构造（避免复制数组元素）
+     */
+    BlueprintValue(BlueprintArray&& value);
     
     /**
      * @brief 拷贝构造函数
      */
-    BlueprintValue(const BlueprintValue& other);
+    BlueprintValue(const BlueprintValue& other) noexcept : m_type(other.m_type) {
+        copyStorage(other);
+    }
     
     /**
      * @brief 移动构造函数
      */
-    BlueprintValue(BlueprintValue&& other) noexcept;
+    BlueprintValue(BlueprintValue&& other) noexcept : m_type(other.m_type) {
+        moveStorage(other);
+    }
+    
+    /**
+     * @brief 析构函数
+     */
+    ~BlueprintValue() {
+        destroy();
+    }
     
     /**
      * @brief 赋值操作符
      */
-    BlueprintValue& operator=(const BlueprintValue& other);
+    BlueprintValue& operator=(const BlueprintValue& other) noexcept {
+        if (!usesSharedStorage(m_type) && !usesSharedStorage(other.m_type)) {
+            std::memcpy(m_storage.bytes, other.m_storage.bytes, kInlineSize);
+            m_type = other.m_type;
+        } else if (this != &other) {
+            // 先复制再释放：other 可能由本值持有的数组间接引用
+            BlueprintValue copy(other);
+            destroy();
+            m_type = copy.m_type;
+            moveStorage(copy);
+        }
+        return *this;
+    }
     
     /**
      * @brief 移动赋值操作符
      */
-    BlueprintValue& operator=(BlueprintValue&& other) noexcept;
+    BlueprintValue& operator=(BlueprintValue&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            m_type = other.m_type;
+            moveStorage(other);
+        }
+        return *this;
+    }
     
     /**
      * @brief 获取数据类型
      */
-    DataType getType() const;
+    DataType getType() const { return m_type; }
     
     /**
      * @brief 检查是否为指定类型
      */
-    template<typename T>
-    bool is() const;
+    template<BlueprintValueType T>
+    bool is() const {
+        return m_type == BlueprintValueTraits<T>::type;
+    }
     
     /**
-     * @brief 获取指定类型的值
+     * @brief 获取指定类型的值（类型不匹配时记录错误并返回默认值）
      */
-    template<typename T>
-    T get() const;
+    template<BlueprintValueType T>
+    T get() const {
+        if (!is<T>()) {
+            reportTypeMismatch(BlueprintValueTraits<T>::type);
+            return T{};
+        }
+        return load<T>();
+    }
+    
+    /**
+     * @brief 获取指定类型值的指针，不复制（类型不匹配时返回空指针）
+     */
+    template<BlueprintValueType T>
+    const T* getIf() const {
+        if (!is<T>()) {
+            return nullptr;
+        }
+        if constexpr (BlueprintValueTraits<T>::inlineStorage) {
+            return std::launder(reinterpret_cast<const T*>(m_storage.bytes));
+        } else {
+            return static_cast<const T*>(m_storage.shared.get());
+        }
+    }
     
     /**
      * @brief 尝试获取指定类型的值
      */
-    template<typename T>
-    bool tryGet(T& outValue) const;
+    template<BlueprintValueType T>
+    bool tryGet(T& outValue) const {
+        if (!is<T>()) {
+            return false;
+        }
+        outValue = load<T>();
+        return true;
+    }
     
     /**
      * @brief 设置值
      */
-    template<typename T>
-    void set(const T& value);
+    template<BlueprintValueType T>
+    void set(const T& value) {
+        *this = BlueprintValue(value);
+    }
     
     /**
      * @brief 检查是否为空
      */
-    bool isEmpty() const;
+    bool isEmpty() const { return m_type == DataType::None; }
     
     /**
      * @brief 清空值
      */
-    void clear();
+    void clear() { destroy(); }
     
     /**
      * @brief 转换为字符串表示
@@ -208,10 +351,72 @@ public:
     bool operator!=(const BlueprintValue& other) const;
 
 private:
-    ValueVariant m_value;
+    static constexpr size_t kInlineSize = sizeof(Color);  ///< 最大的内联类型
+    
+    /**
+     * @brief 值存储：内联字节或共享堆对象，由 m_type 决定哪个成员有效
+     */
+    union Storage {
+        alignas(8) unsigned char bytes[kInlineSize];  ///< 内联值
+        std::shared_ptr<const void> shared;           ///< 字符串/数组/对象
+        
+        Storage() noexcept {}
+        ~Storage() {}
+    };
+    
+    Storage m_storage;
     DataType m_type;
     
-    void updateType();
+    static bool usesSharedStorage(DataType type) {
+        return type == DataType::String || type == DataType::Array || type == DataType::Object;
+    }
+    
+    template<typename T>
+    void construct(const T& value) {
+        if constexpr (BlueprintValueTraits<T>::inlineStorage) {
+            static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= kInlineSize);
+            new (m_storage.bytes) T(value);
+        } else {
+            new (&m_storage.shared) std::shared_ptr<const void>(std::make_shared<const T>(value));
+        }
+        m_type = BlueprintValueTraits<T>::type;
+    }
+    
+    template<typename T>
+    T load() const {
+        if constexpr (BlueprintValueTraits<T>::inlineStorage) {
+            return *std::launder(reinterpret_cast<const T*>(m_storage.bytes));
+        } else {
+            return *static_cast<const T*>(m_storage.shared.get());
+        }
+    }
+    
+    void copyStorage(const BlueprintValue& other) noexcept {
+        if (usesSharedStorage(m_type)) {
+            new (&m_storage.shared) std::shared_ptr<const void>(other.m_storage.shared);
+        } else {
+            std::memcpy(m_storage.bytes, other.m_storage.bytes, kInlineSize);
+        }
+    }
+    
+    void moveStorage(BlueprintValue& other) noexcept {
+        if (usesSharedStorage(m_type)) {
+            new (&m_storage.shared) std::shared_ptr<const void>(std::move(other.m_storage.shared));
+            other.m_storage.shared.~shared_ptr();
+        } else {
+            std::memcpy(m_storage.bytes, other.m_storage.bytes, kInlineSize);
+        }
+        other.m_type = DataType::None;
+    }
+    
+    void destroy() noexcept {
+        if (usesSharedStorage(m_type)) {
+            m_storage.shared.~shared_ptr();
+        }
+        m_type = DataType::None;
+    }
+    
+    void reportTypeMismatch(DataType requested) const;
 };
 
 /**
@@ -260,30 +465,26 @@ private:
 };
 
 /**
- * @brief 类型转换器接口
+ * @brief 数据类型数量（DataType 枚举值连续，可直接作为数组下标）
  */
-class TypeConverter {
-public:
-    virtual ~TypeConverter() = default;
-    
-    /**
-     * @brief 执行类型转换
-     */
-    virtual bool convert(const BlueprintValue& from, BlueprintValue& to) = 0;
-    
-    /**
-     * @brief 获取源类型
-     */
-    virtual DataType getFromType() const = 0;
-    
-    /**
-     * @brief 获取目标类型
-     */
-    virtual DataType getToType() const = 0;
-};
+constexpr size_t kDataTypeCount = static_cast<size_t>(DataType::Execution) + 1;
+
+/**
+ * @brief 类型转换函数：把 from 转换后写入 to，from 的实际类型不符时返回 false
+ */
+using ConversionFunction = bool (*)(const BlueprintValue& from, BlueprintValue& to);
+
+/**
+ * @brief 以 [源类型][目标类型] 为下标的转换函数表，空指针表示不支持该转换
+ */
+using ConversionTable =
+    std::array<std::array<ConversionFunction, kDataTypeCount>, kDataTypeCount>;
 
 /**
  * @brief 类型转换管理器
+ *
+ * 内置转换在编译期生成稠密的二维函数指针表，查找只是两次数组下标。
+ * 执行计划在编译图表时为端口类型不同的连接预先绑定转换函数，执行期间不再查找。
  */
 class TypeConversionManager {
 public:
@@ -293,14 +494,23 @@ public:
     static TypeConversionManager& instance();
     
     /**
-     * @brief 注册类型转换器
+     * @brief 注册或替换类型转换函数
+     *
+     * 需在编译图表之前完成，已编译的执行计划保留编译时绑定的函数。
+     */
+    void registerConverter(DataType from, DataType to, ConversionFunction converter);
+    
+    /**
+     * @brief 获取类型转换函数（不支持时返回空指针）
      */
-    void registerConverter(std::unique_ptr<TypeConverter> converter);
+    ConversionFunction getConverter(DataType from, DataType to) const {
+        return m_converters[static_cast<size_t>(from)][static_cast<size_t>(to)];
+    }
     
     /**
      * @brief 执行类型转换
      */
-    bool convert(const BlueprintValue& from, DataType toType, BlueprintValue& result);
+    bool convert(const BlueprintValue& from, DataType toType, BlueprintValue& result) const;
     
     /**
      * @brief 检查是否支持转换
@@ -308,13 +518,22 @@ public:
     bool canConvert(DataType from, DataType to) const;
 
 private:
-    TypeConversionManager() = default;
+    TypeConversionManager();
     
-    std::map<std::pair<DataType, DataType>, std::unique_ptr<TypeConverter>> m_converters;
-    
-    void initializeDefaultConverters();
+    ConversionTable m_converters;   ///< 当前转换表（内置表加注册的转换）
 };
 
 } // namespace blueprint
 } // namespace core
 } // namespace oneday
+
+/**
+ * @brief 允许 BlueprintValue 直接作为日志格式化参数，仅在日志实际输出时才调用 toString()
+ */
+template <>
+struct fmt::formatter<oneday::core::blueprint::BlueprintValue> : fmt::formatter<std::string> {
+    template <typename FormatContext>
+    auto format(const oneday::core::blueprint::BlueprintValue& value, FormatContext& ctx) const {
+        return fmt::formatter<std::string>::format(value.toString(), ctx);
+    }
+};
@@ -1,17 +1,311 @@
 #include "engine.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
 #include "../common/logger.h"
+#include "../common/thread_pool.h"
+#include "execution_context.h"
+#include "execution_plan.h"
+#include "graph.h"
 
+using oneday::common::ThreadPool;
 using oneday::core::Logger;
 
 namespace oneday {
 namespace core {
 namespace blueprint {
 
+namespace {
+
+// 执行栈条目的最高位标记"循环体结束后重新进入循环节点"
+constexpr uint32_t kLoopReentryFlag = 0x80000000u;
+
+// 缓存的执行计划数量上限，超过后整体清空（图表被销毁后遗留的条目不会再命中）
+constexpr size_t kMaxCachedPlans = 64;
+
+// 默认并行阈值：波前节点数低于该值时线程池调度开销大于收益
+constexpr size_t kDefaultParallelThreshold = 32;
+
+}  // namespace
+
 class Engine::Impl {
   public:
     bool isExecuting = false;
     bool isPaused = false;
+    int maxExecutionSteps = 1000000;
+
+    bool parallelEnabled = true;
+    size_t parallelThreshold = kDefaultParallelThreshold;
+
+    std::unordered_map<const BlueprintGraph*, std::shared_ptr<const ExecutionPlan>> planCache;
+    std::vector<uint32_t> execStack;                ///< 同步执行的执行流栈（跨次执行复用，避免重复分配）
+    std::vector<NodeExecutionResult> waveResults;  ///< 并行波前的节点结果
+
+    /**
+     * @brief 把上游输出复制到节点的数据输入（按需使用预绑定的类型转换）
+     */
+    static void pullInputs(const ExecutionPlan& plan, const PlanNode& planNode) {
+        BaseNode* node = planNode.node;
+        for (uint32_t b = planNode.inputs.begin; b < planNode.inputs.begin + planNode.inputs.count;
+             ++b) {
+            const PlanInputBinding& binding = plan.inputBindings[b];
+            const BlueprintValue& value = plan.nodes[binding.sourceNode].node->getOutputValue(
+                static_cast<int>(binding.sourcePort));
+            if (binding.convert) {
+                BlueprintValue converted;
+                if (binding.convert(value, converted)) {
+                    node->setInputValue(static_cast<int>(binding.targetPort), converted);
+                    continue;
+                }
+            }
+            node->setInputValue(static_cast<int>(binding.targetPort), value);
+        }
+    }
+
+    /**
+     * @brief 记录节点执行结果
+     */
+    static bool finishNode(const PlanNode& planNode,
+                           const NodeExecutionResult& nodeResult,
+                           ExecutionContext& context,
+                           ExecutionResult& result) {
+        context.updateNodeStats(nodeResult.success, nodeResult.executionTime);
+        ++result.nodesExecuted;
+
+        if (!nodeResult.success) {
+            result.errorDetails = nodeResult.errorMessage;
+            context.setError("Node " + planNode.node->getId() +
+                             " failed: " + nodeResult.errorMessage);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 拉取数据输入并执行单个节点
+     */
+    bool runNode(const ExecutionPlan& plan,
+                 const PlanNode& planNode,
+                 ExecutionContext& context,
+                 ExecutionResult& result) {
+        pullInputs(plan, planNode);
+        context.onNodeExecuting(planNode.node->getId(), planNode.node);
+        return finishNode(planNode, planNode.node->execute(context), context, result);
+    }
+
+    /**
+     * @brief 按波前依次执行纯数据节点
+     * @param order 节点下标数组（dependencies 或 dataflowOrder）
+     * @param waves 波前区间（指向 plan.wavefronts）
+     */
+    bool runWavefronts(const ExecutionPlan& plan,
+                       const std::vector<uint32_t>& order,
+                       const PlanRange& waves,
+                       ExecutionContext& context,
+                       ExecutionResult& result) {
+        for (uint32_t w = waves.begin; w < waves.begin + waves.count; ++w) {
+            const PlanRange& wave = plan.wavefronts[w];
+            // 波前开头声明可并行的节点分发到线程池，其余节点在调用线程串行执行
+            uint32_t serialBegin = wave.begin;
+            const uint32_t parallelCount = plan.parallelCounts[w];
+            if (parallelEnabled && parallelCount >= parallelThreshold) {
+                if (!runWavefrontParallel(plan, order, PlanRange{wave.begin, parallelCount},
+                                          context, result)) {
+                    return false;
+                }
+                serialBegin += parallelCount;
+            }
+            for (uint32_t k = serialBegin; k < wave.begin + wave.count; ++k) {
+                if (!runNode(plan, plan.nodes[order[k]], context, result)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 在线程池上并行执行一个波前
+     *
+     * 执行前回调和统计在调用线程串行处理，工作线程只负责拉取输入和执行节点。
+     */
+    bool runWavefrontParallel(const ExecutionPlan& plan,
+                              const std::vector<uint32_t>& order,
+                              const PlanRange& wave,
+                              ExecutionContext& context,
+                              ExecutionResult& result) {
+        for (uint32_t k = wave.begin; k < wave.begin + wave.count; ++k) {
+            const BaseNode* node = plan.nodes[order[k]].node;
+            context.onNodeExecuting(node->getId(), node);
+        }
+
+        ThreadPool& pool = ThreadPool::instance();
+        waveResults.resize(wave.count);
+        const size_t grainSize = std::max<size_t>(1, wave.count / (pool.getThreadCount() * 4 + 1));
+        pool.parallelFor(
+            wave.count,
+            [&](size_t k) {
+                const PlanNode& planNode = plan.nodes[order[wave.begin + k]];
+                pullInputs(plan, planNode);
+                waveResults[k] = planNode.node->execute(context);
+            },
+            grainSize);
+
+        for (uint32_t k = 0; k < wave.count; ++k) {
+            if (!finishNode(plan.nodes[order[wave.begin + k]], waveResults[k], context, result)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 复位节点并准备执行流栈
+     */
+    static void beginRun(const ExecutionPlan& plan, ExecutionRun& run) {
+        run.result = ExecutionResult();
+        run.result.totalNodes = static_cast<int>(plan.nodes.size());
+        run.steps = 0;
+        run.finished = false;
+        run.startTime = ExecutionRun::Clock::now();
+
+        for (const PlanNode& planNode : plan.nodes) {
+            planNode.node->reset();
+        }
+        run.context->startExecution();
+
+        run.execStack.clear();
+        for (auto it = plan.entryNodes.rbegin(); it != plan.entryNodes.rend(); ++it) {
+            run.execStack.push_back(*it);
+        }
+    }
+
+    /**
+     * @brief 推进执行，直到结束或某个执行流节点请求挂起
+     * @return true 表示已挂起（run.resumeTime 为恢复时间）
+     */
+    bool advanceRun(const ExecutionPlan& plan, ExecutionRun& run) {
+        ExecutionContext& context = *run.context;
+        ExecutionResult& result = run.result;
+        auto& stack = run.execStack;
+
+        isExecuting = true;
+        if (context.isWaiting()) {
+            context.setState(ExecutionState::Running);
+        }
+
+        bool ok = true;
+        if (plan.isDataflowOnly()) {
+            ok = runWavefronts(plan, plan.dataflowOrder, plan.dataflowWaves, context, result);
+        }
+
+        while (ok && !stack.empty()) {
+            if (isPaused || context.isPauseRequested()) {
+                result.message = "Execution paused";
+                context.setState(ExecutionState::Paused);
+                ok = false;
+                break;
+            }
+            if (context.isStopRequested()) {
+                result.message = "Execution cancelled";
+                context.setState(ExecutionState::Cancelled);
+                ok = false;
+                break;
+            }
+            if (++run.steps > maxExecutionSteps) {
+                result.errorDetails =
+                    "Exceeded " + std::to_string(maxExecutionSteps) + " execution steps";
+                context.setError(result.errorDetails);
+                ok = false;
+                break;
+            }
+
+            uint32_t entry = stack.back();
+            stack.pop_back();
+            const uint32_t index = entry & ~kLoopReentryFlag;
+            const PlanNode& planNode = plan.nodes[index];
+
+            // 首次进入循环节点时复位计数（嵌套循环每轮外层迭代都会重新进入）
+            if (planNode.loopBodyPort >= 0 && !(entry & kLoopReentryFlag)) {
+                planNode.node->reset();
+            }
+
+            if (!runWavefronts(plan, plan.dependencies, planNode.dependencyWaves, context, result)) {
+                ok = false;
+                break;
+            }
+
+            if (planNode.execInputPort >= 0) {
+                planNode.node->setInputValue(planNode.execInputPort,
+                                             BlueprintValue(ExecutionToken(true)));
+            }
+            pullInputs(plan, planNode);
+            context.onNodeExecuting(planNode.node->getId(), planNode.node);
+            const NodeExecutionResult nodeResult = planNode.node->execute(context);
+            if (!finishNode(planNode, nodeResult, context, result)) {
+                ok = false;
+                break;
+            }
+
+            // 后继逆序入栈，保证按端口声明顺序深度优先执行
+            for (uint32_t o = planNode.execOutputs.count; o-- > 0;) {
+                const PlanExecOutput& output = plan.execOutputs[planNode.execOutputs.begin + o];
+                if (!isFired(planNode, output.outputPort)) {
+                    continue;
+                }
+                if (static_cast<int>(output.outputPort) == planNode.loopBodyPort) {
+                    stack.push_back(index | kLoopReentryFlag);
+                }
+                for (uint32_t s = output.successors.count; s-- > 0;) {
+                    stack.push_back(plan.successors[output.successors.begin + s]);
+                }
+            }
+
+            // 节点请求挂起且之后还有执行流：保留执行栈，交还给调用者等待
+            if (nodeResult.suspendTime > 0.0 && !stack.empty()) {
+                run.resumeTime = ExecutionRun::Clock::now() +
+                                 std::chrono::duration_cast<ExecutionRun::Clock::duration>(
+                                     std::chrono::duration<double>(nodeResult.suspendTime));
+                context.setState(ExecutionState::Waiting);
+                isExecuting = false;
+                return true;
+            }
+        }
+
+        finishRun(run, ok);
+        return false;
+    }
+
+    /**
+     * @brief 结束执行并填写结果
+     */
+    void finishRun(ExecutionRun& run, bool ok) {
+        ExecutionResult& result = run.result;
+        if (ok) {
+            run.context->endExecution();
+            result.success = true;
+            result.message = "Graph executed successfully";
+        } else if (result.message.empty()) {
+            result.message = "Graph execution failed";
+        }
+
+        run.finished = true;
+        isExecuting = false;
+        result.executionTime = std::chrono::duration<double, std::milli>(
+                                   ExecutionRun::Clock::now() - run.startTime)
+                                   .count();
+    }
+
+    /**
+     * @brief 检查执行流输出端口是否被触发
+     */
+    static bool isFired(const PlanNode& planNode, uint32_t outputPort) {
+        const BlueprintValue& value = planNode.node->getOutputValue(static_cast<int>(outputPort));
+        return value.is<ExecutionToken>() && value.get<ExecutionToken>().valid;
+    }
 };
 
 Engine::Engine() : pImpl(std::make_unique<Impl>()) {
@@ -21,18 +315,113 @@ Engine::Engine() : pImpl(std::make_unique<Impl>()) {
 Engine::~Engine() = default;
 
 ExecutionResult Engine::executeGraph(const BlueprintGraph& graph) {
-    Logger::info("Executing blueprint graph");
-    // 基础实现占位符
-    ExecutionResult result;
-    result.success = true;
-    result.message = "Graph executed successfully";
-    return result;
+    ExecutionContext context;
+    return executeGraph(graph, context);
+}
+
+ExecutionResult Engine::executeGraph(const BlueprintGraph& graph, ExecutionContext& context) {
+    std::string error;
+    std::shared_ptr<const ExecutionPlan> plan = compileGraph(graph, error);
+    if (!plan) {
+        ExecutionResult result;
+        result.message = "Graph compilation failed";
+        result.errorDetails = error;
+        context.setError(error);
+        result.totalNodes = static_cast<int>(graph.getNodeCount());
+        return result;
+    }
+    return executePlan(*plan, context);
+}
+
+std::shared_ptr<const ExecutionPlan> Engine::compileGraph(const BlueprintGraph& graph) {
+    std::string error;
+    return compileGraph(graph, error);
+}
+
+std::shared_ptr<const ExecutionPlan> Engine::compileGraph(const BlueprintGraph& graph,
+                                                          std::string& errorMessage) {
+    auto it = pImpl->planCache.find(&graph);
+    if (it != pImpl->planCache.end() && it->second->isUpToDate(graph)) {
+        return it->second;
+    }
+
+    std::shared_ptr<const ExecutionPlan> plan = ExecutionPlan::compile(graph, errorMessage);
+    if (!plan) {
+        Logger::error("Failed to compile graph {}: {}", graph.getId(), errorMessage);
+        return nullptr;
+    }
+
+    if (pImpl->planCache.size() >= kMaxCachedPlans) {
+        pImpl->planCache.clear();
+    }
+    pImpl->planCache[&graph] = plan;
+    Logger::info("Compiled blueprint graph {} ({} nodes)", graph.getId(), plan->nodes.size());
+    return plan;
+}
+
+ExecutionResult Engine::executePlan(const ExecutionPlan& plan, ExecutionContext& context) {
+    ExecutionRun run;
+    run.context = &context;
+    run.execStack.swap(pImpl->execStack);
+    pImpl->beginRun(plan, run);
+
+    // 同步执行：挂起时在调用线程等待到期
+    while (pImpl->advanceRun(plan, run)) {
+        std::this_thread::sleep_until(run.resumeTime);
+    }
+
+    run.execStack.swap(pImpl->execStack);
+    return run.result;
+}
+
+bool Engine::startRun(const BlueprintGraph& graph, ExecutionContext& context, ExecutionRun& run) {
+    run = ExecutionRun();
+    run.graph = &graph;
+    run.context = &context;
+    run.plan = compileGraph(graph, run.result.errorDetails);
+    if (!run.plan) {
+        run.result.message = "Graph compilation failed";
+        context.setError(run.result.errorDetails);
+        run.result.totalNodes = static_cast<int>(graph.getNodeCount());
+        run.finished = true;
+        return false;
+    }
+
+    pImpl->beginRun(*run.plan, run);
+    return pImpl->advanceRun(*run.plan, run);
+}
+
+bool Engine::resumeRun(ExecutionRun& run) {
+    if (run.finished || !run.plan) {
+        return false;
+    }
+
+    // 挂起期间图表被编辑过：计划中的节点指针可能已失效
+    if (run.graph && !run.plan->isUpToDate(*run.graph)) {
+        run.result.errorDetails =
+            "Graph " + run.graph->getId() + " was modified while execution was suspended";
+        run.context->setError(run.result.errorDetails);
+        pImpl->finishRun(run, false);
+        return false;
+    }
+    return pImpl->advanceRun(*run.plan, run);
 }
 
 bool Engine::validateGraph(const BlueprintGraph& graph) {
-    Logger::info("Validating blueprint graph");
-    // 基础验证占位符
-    return true;
+    GraphValidationResult validation = graph.validate();
+    for (const auto& error : validation.errors) {
+        Logger::warning("Graph {} validation error: {}", graph.getId(), error);
+    }
+    return validation.isValid;
+}
+
+void Engine::setMaxExecutionSteps(int maxSteps) {
+    pImpl->maxExecutionSteps = std::max(1, maxSteps);
+}
+
+void Engine::setParallelExecution(bool enabled, size_t minWavefrontSize) {
+    pImpl->parallelEnabled = enabled;
+    pImpl->parallelThreshold = std::max<size_t>(2, minWavefrontSize);
 }
 
 void Engine::pauseExecution() {
@@ -47,4 +436,4 @@ void Engine::resumeExecution() {
 
 }  // namespace blueprint
 }  // namespace core
-}  // namespace oneday
\ No newline at end of file
+}  // namespace oneday
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,6 +12,8 @@ namespace core {
 namespace blueprint {
 
 class BlueprintGraph;
+class ExecutionContext;
+class ExecutionPlan;
 
 /**
  * @brief 执行结果结构
@@ -22,9 +27,37 @@ struct ExecutionResult {
     int totalNodes = 0;          ///< 总节点数
 };
 
+/**
+ * @brief 可挂起的执行状态
+ *
+ * 执行流节点请求挂起（如延迟节点）时，执行栈和累计结果保留在这里，
+ * 到达 resumeTime 后由 Engine::resumeRun 继续。节点值存放在图表节点中，
+ * 因此同一个图表同一时间只能有一个活动的执行（AsyncScheduler 拒绝重复开始）。
+ */
+struct ExecutionRun {
+    using Clock = std::chrono::steady_clock;
+
+    std::shared_ptr<const ExecutionPlan> plan;  ///< 执行计划
+    const BlueprintGraph* graph = nullptr;      ///< 源图表（非空时恢复前检查计划是否过期）
+    ExecutionContext* context = nullptr;        ///< 执行上下文
+    std::vector<uint32_t> execStack;            ///< 执行流栈
+    ExecutionResult result;                     ///< 累计执行结果
+    int steps = 0;                              ///< 已执行步数
+    bool finished = false;                      ///< 是否已结束（result 有效）
+    Clock::time_point startTime;                ///< 开始时间
+    Clock::time_point resumeTime;               ///< 挂起时的恢复时间
+};
+
 /**
  * @brief 蓝图脚本执行引擎
  * 负责解析、编译和执行蓝图图表
+ *
+ * 图表首次执行时被编译为 ExecutionPlan 并缓存，之后只要图表结构未变化
+ * （BlueprintGraph::getRevision() 不变）就直接复用该计划。
+ * 足够宽的纯数据节点波前在常驻线程池上并行执行。
+ *
+ * 执行流可以挂起（见 ExecutionRun）：executeGraph 在调用线程等待到期后继续，
+ * startRun/resumeRun 则把等待交给调用者，AsyncScheduler 借此在一个线程上复用大量执行。
  */
 class Engine {
   public:
@@ -38,6 +71,45 @@ class Engine {
      */
     ExecutionResult executeGraph(const BlueprintGraph& graph);
 
+    /**
+     * @brief 使用指定执行上下文执行蓝图图表（变量在多次执行之间保留）
+     * @param graph 要执行的蓝图图表
+     * @param context 执行上下文
+     * @return 执行结果
+     */
+    ExecutionResult executeGraph(const BlueprintGraph& graph, ExecutionContext& context);
+
+    /**
+     * @brief 编译图表为执行计划
+     * @param graph 要编译的图表
+     * @return 执行计划，编译失败返回空指针
+     */
+    std::shared_ptr<const ExecutionPlan> compileGraph(const BlueprintGraph& graph);
+
+    /**
+     * @brief 执行已编译的计划
+     * @param plan 执行计划
+     * @param context 执行上下文
+     * @return 执行结果
+     */
+    ExecutionResult executePlan(const ExecutionPlan& plan, ExecutionContext& context);
+
+    /**
+     * @brief 开始一次可挂起的执行，运行到结束或第一次挂起
+     * @param graph 要执行的蓝图图表
+     * @param context 执行上下文（需在执行结束前保持有效）
+     * @param run 执行状态
+     * @return true 表示执行已挂起，需在 run.resumeTime 之后调用 resumeRun
+     */
+    bool startRun(const BlueprintGraph& graph, ExecutionContext& context, ExecutionRun& run);
+
+    /**
+     * @brief 继续挂起的执行，运行到结束或下一次挂起
+     * @param run 执行状态
+     * @return true 表示执行再次挂起
+     */
+    bool resumeRun(ExecutionRun& run);
+
     /**
      * @brief 验证图表有效性
      * @param graph 要验证的图表
@@ -45,6 +117,21 @@ class Engine {
      */
     bool validateGraph(const BlueprintGraph& graph);
 
+    /**
+     * @brief 设置单次执行允许的最大节点执行步数（防止执行流死循环）
+     * @param maxSteps 最大步数
+     */
+    void setMaxExecutionSteps(int maxSteps);
+
+    /**
+     * @brief 设置纯数据节点的并行执行
+     * @param enabled 是否启用
+     * @param minWavefrontSize 波前节点数达到该阈值才分发到线程池，较小的波前在调用线程串行执行
+     *
+     * 只有声明可并行（BaseNode::isParallelSafe）的纯数据节点会分发到线程池，其余节点总在调用线程执行。
+     */
+    void setParallelExecution(bool enabled, size_t minWavefrontSize = 32);
+
     /**
      * @brief 暂停执行
      */
@@ -56,10 +143,16 @@ class Engine {
     void resumeExecution();
 
   private:
+    /**
+     * @brief 编译图表为执行计划，失败时通过 errorMessage 返回原因
+     */
+    std::shared_ptr<const ExecutionPlan> compileGraph(const BlueprintGraph& graph,
+                                                      std::string& errorMessage);
+
     class Impl;
     std::unique_ptr<Impl> pImpl;
 };
 
 }  // namespace blueprint
 }  // namespace core
-}  // namespace oneday
\ No newline at end of file
+}  // namespace oneday
@@ -16,9 +16,9 @@ ExecutionContext::ExecutionContext(BlueprintGraph* graph)
     , m_stopRequested(false) {
     
     // 创建全局作用域
-    m_variableScopes.push_back(std::map<std::string, BlueprintValue>());
+    m_scopeStarts.push_back(0);
     
-    Logger::debug("ExecutionContext created");
+    ONEDAY_LOG_DEBUG("ExecutionContext created");
 }
 
 void ExecutionContext::setGraph(BlueprintGraph* graph) {
@@ -29,8 +29,8 @@ void ExecutionContext::setState(ExecutionState state) {
     ExecutionState oldState = m_state;
     m_state = state;
     
-    Logger::debug("ExecutionContext state changed from " + std::to_string(static_cast<int>(oldState)) + 
-                 " to " + std::to_string(static_cast<int>(state)));
+    ONEDAY_LOG_DEBUG("ExecutionContext state changed from {} to {}",
+                     static_cast<int>(oldState), static_cast<int>(state));
     
     // 触发状态变化回调
     if (m_stateChangeCallback) {
@@ -38,6 +38,42 @@ void ExecutionContext::setState(ExecutionState state) {
     }
 }
 
+// VariableNameTable 实现
+
+VariableNameTable& VariableNameTable::instance() {
+    static VariableNameTable table;
+    return table;
+}
+
+VariableId VariableNameTable::intern(const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_ids.find(name);
+        if (it != m_ids.end()) {
+            return it->second;
+        }
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto [it, inserted] = m_ids.emplace(name, static_cast<VariableId>(m_names.size()));
+    if (inserted) {
+        m_names.push_back(name);
+    }
+    return it->second;
+}
+
+VariableId VariableNameTable::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(name);
+    return it != m_ids.end() ? it->second : kInvalidVariableId;
+}
+
+const std::string& VariableNameTable::getName(VariableId id) const {
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return id < m_names.size() ? m_names[id] : empty;
+}
+
 // 变量管理实现
 
 void ExecutionContext::setVariable(const std::string& name, const BlueprintValue& value) {
@@ -46,8 +82,26 @@ void ExecutionContext::setVariable(const std::string& name, const BlueprintValue
         return;
     }
     
-    getCurrentScope()[name] = value;
-    Logger::debug("Set variable: " + name + " = " + value.toString());
+    setVariable(VariableNameTable::instance().intern(name), value);
+}
+
+void ExecutionContext::setVariable(VariableId id, const BlueprintValue& value) {
+    if (id == kInvalidVariableId) {
+        Logger::warning("Attempted to set variable with invalid id");
+        return;
+    }
+    if (id >= m_bindings.size()) {
+        m_bindings.resize(static_cast<size_t>(id) + 1, -1);
+    }
+    
+    // 当前作用域内已有绑定则原地覆盖，否则压入新条目遮蔽外层绑定
+    const int32_t binding = m_bindings[id];
+    if (binding >= static_cast<int32_t>(m_scopeStarts.back())) {
+        m_variables[binding].value = value;
+        return;
+    }
+    m_bindings[id] = static_cast<int32_t>(m_variables.size());
+    m_variables.push_back(VariableEntry{id, binding, value});
 }
 
 BlueprintValue ExecutionContext::getVariable(const std::string& name) const {
@@ -56,16 +110,18 @@ BlueprintValue ExecutionContext::getVariable(const std::string& name) const {
         return BlueprintValue();
     }
     
-    // 从当前作用域向上查找变量
-    for (auto it = m_variableScopes.rbegin(); it != m_variableScopes.rend(); ++it) {
-        auto varIt = it->find(name);
-        if (varIt != it->end()) {
-            return varIt->second;
-        }
+    const BlueprintValue* value = findVariable(VariableNameTable::instance().find(name));
+    if (!value) {
+        ONEDAY_LOG_DEBUG("Variable not found: {}", name);
+        return BlueprintValue();
     }
-    
-    Logger::debug("Variable not found: " + name);
-    return BlueprintValue();
+    return *value;
+}
+
+const BlueprintValue& ExecutionContext::getVariable(VariableId id) const {
+    static const BlueprintValue empty;
+    const BlueprintValue* value = findVariable(id);
+    return value ? *value : empty;
 }
 
 bool ExecutionContext::hasVariable(const std::string& name) const {
@@ -73,14 +129,7 @@ bool ExecutionContext::hasVariable(const std::string& name) const {
         return false;
     }
     
-    // 从当前作用域向上查找变量
-    for (auto it = m_variableScopes.rbegin(); it != m_variableScopes.rend(); ++it) {
-        if (it->find(name) != it->end()) {
-            return true;
-        }
-    }
-    
-    return false;
+    return hasVariable(VariableNameTable::instance().find(name));
 }
 
 bool ExecutionContext::deleteVariable(const std::string& name) {
@@ -88,28 +137,36 @@ bool ExecutionContext::deleteVariable(const std::string& name) {
         return false;
     }
     
-    // 从当前作用域向上查找并删除变量
-    for (auto it = m_variableScopes.rbegin(); it != m_variableScopes.rend(); ++it) {
-        auto varIt = it->find(name);
-        if (varIt != it->end()) {
-            it->erase(varIt);
-            Logger::debug("Deleted variable: " + name);
-            return true;
-        }
+    return deleteVariable(VariableNameTable::instance().find(name));
+}
+
+bool ExecutionContext::deleteVariable(VariableId id) {
+    if (!hasVariable(id)) {
+        return false;
     }
     
-    return false;
+    // 条目留在栈中作为空位（弹出作用域时跳过），恢复被遮蔽的外层绑定
+    VariableEntry& entry = m_variables[m_bindings[id]];
+    m_bindings[id] = entry.shadowed;
+    entry.id = kInvalidVariableId;
+    entry.value.clear();
+    while (!m_variables.empty() && m_variables.back().id == kInvalidVariableId &&
+           m_variables.size() > m_scopeStarts.back()) {
+        m_variables.pop_back();
+    }
+    return true;
 }
 
 std::vector<std::string> ExecutionContext::getAllVariableNames() const {
     std::vector<std::string> names;
+    std::vector<bool> seen(m_bindings.size(), false);
     
     // 收集所有作用域中的变量名（避免重复）
-    for (const auto& scope : m_variableScopes) {
-        for (const auto& pair : scope) {
-            if (std::find(names.begin(), names.end(), pair.first) == names.end()) {
-                names.push_back(pair.first);
-            }
+    const VariableNameTable& table = VariableNameTable::instance();
+    for (const auto& entry : m_variables) {
+        if (entry.id != kInvalidVariableId && !seen[entry.id]) {
+            seen[entry.id] = true;
+            names.push_back(table.getName(entry.id));
         }
     }
     
@@ -117,51 +174,58 @@ std::vector<std::string> ExecutionContext::getAllVariableNames() const {
 }
 
 void ExecutionContext::clearVariables() {
-    for (auto& scope : m_variableScopes) {
-        scope.clear();
-    }
-    Logger::debug("Cleared all variables");
+    m_variables.clear();
+    std::fill(m_bindings.begin(), m_bindings.end(), -1);
+    std::fill(m_scopeStarts.begin(), m_scopeStarts.end(), 0u);
 }
 
 // 作用域管理实现
 
 void ExecutionContext::pushScope() {
-    m_variableScopes.push_back(std::map<std::string, BlueprintValue>());
-    Logger::debug("Pushed new variable scope, depth: " + std::to_string(m_variableScopes.size()));
+    m_scopeStarts.push_back(static_cast<uint32_t>(m_variables.size()));
 }
 
 void ExecutionContext::popScope() {
-    if (m_variableScopes.size() > 1) {  // 保留全局作用域
-        m_variableScopes.pop_back();
-        Logger::debug("Popped variable scope, depth: " + std::to_string(m_variableScopes.size()));
-    } else {
+    if (m_scopeStarts.size() <= 1) {  // 保留全局作用域
         Logger::warning("Cannot pop global variable scope");
+        return;
+    }
+    
+    // 逆序恢复被遮蔽的绑定，然后截断变量栈
+    const uint32_t start = m_scopeStarts.back();
+    m_scopeStarts.pop_back();
+    for (size_t i = m_variables.size(); i-- > start;) {
+        const VariableEntry& entry = m_variables[i];
+        if (entry.id != kInvalidVariableId) {
+            m_bindings[entry.id] = entry.shadowed;
+        }
     }
+    m_variables.erase(m_variables.begin() + start, m_variables.end());
 }
 
 // 执行控制实现
 
 void ExecutionContext::requestPause() {
     m_pauseRequested = true;
-    Logger::debug("Pause requested");
+    ONEDAY_LOG_DEBUG("Pause requested");
 }
 
 void ExecutionContext::requestStop() {
     m_stopRequested = true;
-    Logger::debug("Stop requested");
+    ONEDAY_LOG_DEBUG("Stop requested");
 }
 
 void ExecutionContext::resetRequests() {
     m_pauseRequested = false;
     m_stopRequested = false;
-    Logger::debug("Reset execution requests");
+    ONEDAY_LOG_DEBUG("Reset execution requests");
 }
 
 // 统计信息实现
 
 void ExecutionContext::resetStats() {
     m_stats = ExecutionStats();
-    Logger::debug("Reset execution statistics");
+    ONEDAY_LOG_DEBUG("Reset execution statistics");
 }
 
 void ExecutionContext::updateNodeStats(bool success, double executionTime) {
@@ -175,7 +239,7 @@ void ExecutionContext::updateNodeStats(bool success, double executionTime) {
 void ExecutionContext::startExecution() {
     m_stats.startTime = std::chrono::steady_clock::now();
     setState(ExecutionState::Running);
-    Logger::debug("Started execution timing");
+    ONEDAY_LOG_DEBUG("Started execution timing");
 }
 
 void ExecutionContext::endExecution() {
@@ -186,9 +250,8 @@ void ExecutionContext::endExecution() {
         setState(ExecutionState::Completed);
     }
     
-    Logger::info("Execution completed in " + std::to_string(duration.count()) + "ms, " +
-                std::to_string(m_stats.executedNodes) + " nodes executed, " +
-                std::to_string(m_stats.errorNodes) + " errors");
+    Logger::info("Execution completed in {}ms, {} nodes executed, {} errors",
+                 duration.count(), m_stats.executedNodes, m_stats.errorNodes);
 }
 
 // 错误处理实现
@@ -196,12 +259,12 @@ void ExecutionContext::endExecution() {
 void ExecutionContext::setError(const std::string& error) {
     m_errorMessage = error;
     setState(ExecutionState::Error);
-    Logger::error("Execution error: " + error);
+    Logger::error("Execution error: {}", error);
 }
 
 void ExecutionContext::clearError() {
     m_errorMessage.clear();
-    Logger::debug("Cleared execution error");
+    ONEDAY_LOG_DEBUG("Cleared execution error");
 }
 
 // 调试支持实现
@@ -212,14 +275,14 @@ void ExecutionContext::setBreakpoint(const std::string& nodeId, bool enabled) {
     }
     
     m_breakpoints[nodeId] = enabled;
-    Logger::debug("Set breakpoint on node " + nodeId + ": " + (enabled ? "enabled" : "disabled"));
+    ONEDAY_LOG_DEBUG("Set breakpoint on node {}: {}", nodeId, (enabled ? "enabled" : "disabled"));
 }
 
 void ExecutionContext::removeBreakpoint(const std::string& nodeId) {
     auto it = m_breakpoints.find(nodeId);
     if (it != m_breakpoints.end()) {
         m_breakpoints.erase(it);
-        Logger::debug("Removed breakpoint from node " + nodeId);
+        ONEDAY_LOG_DEBUG("Removed breakpoint from node {}", nodeId);
     }
 }
 
@@ -230,7 +293,7 @@ bool ExecutionContext::hasBreakpoint(const std::string& nodeId) const {
 
 void ExecutionContext::clearBreakpoints() {
     m_breakpoints.clear();
-    Logger::debug("Cleared all breakpoints");
+    ONEDAY_LOG_DEBUG("Cleared all breakpoints");
 }
 
 std::vector<std::string> ExecutionContext::getBreakpoints() const {
@@ -259,25 +322,6 @@ void ExecutionContext::setStateChangeCallback(StateChangeCallback callback) {
     m_stateChangeCallback = callback;
 }
 
-// 私有方法实现
-
-std::map<std::string, BlueprintValue>& ExecutionContext::getCurrentScope() {
-    if (m_variableScopes.empty()) {
-        // 这不应该发生，但为了安全起见
-        m_variableScopes.push_back(std::map<std::string, BlueprintValue>());
-    }
-    return m_variableScopes.back();
-}
-
-const std::map<std::string, BlueprintValue>& ExecutionContext::getCurrentScope() const {
-    if (m_variableScopes.empty()) {
-        // 返回静态空映射
-        static const std::map<std::string, BlueprintValue> emptyScope;
-        return emptyScope;
-    }
-    return m_variableScopes.back();
-}
-
 } // namespace blueprint
 } // namespace core
 } // namespace oneday
@@ -4,9 +4,13 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace oneday {
 namespace core {
@@ -25,7 +29,8 @@ enum class ExecutionState {
     Paused,         ///< 已暂停
     Completed,      ///< 执行完成
     Error,          ///< 执行错误
-    Cancelled       ///< 已取消
+    Cancelled,      ///< 已取消
+    Waiting         ///< 挂起等待恢复（异步执行）
 };
 
 /**
@@ -40,8 +45,57 @@ struct ExecutionStats {
     std::chrono::steady_clock::time_point endTime;   ///< 结束时间
 };
 
+/**
+ * @brief 变量ID（驻留后的变量名下标）
+ */
+using VariableId = uint32_t;
+
+/**
+ * @brief 无效变量ID
+ */
+constexpr VariableId kInvalidVariableId = UINT32_MAX;
+
+/**
+ * @brief 变量名驻留表
+ *
+ * 进程内唯一：同一个变量名在所有图表和执行上下文中对应同一个ID，
+ * 变量节点在设置变量名时即可解析出ID，执行时按ID直接访问上下文中的变量槽位。
+ */
+class VariableNameTable {
+public:
+    /**
+     * @brief 获取单例实例
+     */
+    static VariableNameTable& instance();
+    
+    /**
+     * @brief 驻留变量名，返回其ID（已存在时返回原ID）
+     */
+    VariableId intern(const std::string& name);
+    
+    /**
+     * @brief 查找变量名的ID（从未驻留时返回 kInvalidVariableId）
+     */
+    VariableId find(const std::string& name) const;
+    
+    /**
+     * @brief 获取ID对应的变量名（引用在程序生命周期内有效）
+     */
+    const std::string& getName(VariableId id) const;
+
+private:
+    VariableNameTable() = default;
+    
+    mutable std::shared_mutex m_mutex;                  ///< 读写锁
+    std::unordered_map<std::string, VariableId> m_ids;  ///< 变量名 -> ID
+    std::deque<std::string> m_names;                    ///< ID -> 变量名（deque 扩容不移动元素）
+};
+
 /**
  * @brief 执行上下文 - 管理蓝图执行过程中的状态和数据
+ *
+ * 变量存放在扁平的变量栈中，每个作用域是栈上的一段；每个变量ID记录最内层绑定的位置，
+ * 按ID读写是一次数组下标访问，压入/弹出作用域只移动栈顶。
  */
 class ExecutionContext {
 public:
@@ -85,6 +139,11 @@ public:
      */
     bool isPaused() const { return m_state == ExecutionState::Paused; }
     
+    /**
+     * @brief 检查是否挂起等待恢复
+     */
+    bool isWaiting() const { return m_state == ExecutionState::Waiting; }
+    
     /**
      * @brief 检查是否已完成
      */
@@ -98,25 +157,55 @@ public:
     // 变量管理
     
     /**
-     * @brief 设置变量值
+     * @brief 设置变量值（写入当前作用域，遮蔽外层同名变量）
      */
     void setVariable(const std::string& name, const BlueprintValue& value);
     
+    /**
+     * @brief 按ID设置变量值
+     */
+    void setVariable(VariableId id, const BlueprintValue& value);
+    
     /**
      * @brief 获取变量值
      */
     BlueprintValue getVariable(const std::string& name) const;
     
+    /**
+     * @brief 按ID获取变量值（不存在时返回空值）
+     */
+    const BlueprintValue& getVariable(VariableId id) const;
+    
+    /**
+     * @brief 按ID查找变量（不存在时返回空指针）
+     */
+    const BlueprintValue* findVariable(VariableId id) const {
+        if (id >= m_bindings.size() || m_bindings[id] < 0) {
+            return nullptr;
+        }
+        return &m_variables[m_bindings[id]].value;
+    }
+    
     /**
      * @brief 检查变量是否存在
      */
     bool hasVariable(const std::string& name) const;
     
     /**
-     * @brief 删除变量
+     * @brief 按ID检查变量是否存在
+     */
+    bool hasVariable(VariableId id) const { return findVariable(id) != nullptr; }
+    
+    /**
+     * @brief 删除变量（删除最内层的绑定）
      */
     bool deleteVariable(const std::string& name);
     
+    /**
+     * @brief 按ID删除变量
+     */
+    bool deleteVariable(VariableId id);
+    
     /**
      * @brief 获取所有变量名
      */
@@ -142,7 +231,7 @@ public:
     /**
      * @brief 获取当前作用域深度
      */
-    int getScopeDepth() const { return static_cast<int>(m_variableScopes.size()); }
+    int getScopeDepth() const { return static_cast<int>(m_scopeStarts.size()); }
     
     // 执行控制
     
@@ -279,7 +368,18 @@ private:
     ExecutionState m_state;                                     ///< 执行状态
     
     // 变量管理
-    std::vector<std::map<std::string, BlueprintValue>> m_variableScopes; ///< 变量作用域栈
+    /**
+     * @brief 变量栈条目
+     */
+    struct VariableEntry {
+        VariableId id;          ///< 变量ID（已删除的条目为 kInvalidVariableId）
+        int32_t shadowed;       ///< 被本条目遮蔽的外层条目下标（无则为-1）
+        BlueprintValue value;   ///< 变量值
+    };
+    
+    std::vector<VariableEntry> m_variables;                     ///< 扁平变量栈
+    std::vector<uint32_t> m_scopeStarts;                        ///< 各作用域在变量栈中的起始下标
+    std::vector<int32_t> m_bindings;                            ///< 变量ID -> 最内层条目下标（无则为-1）
     
     // 执行控制
     bool m_pauseRequested;                                      ///< 暂停请求标志
@@ -297,16 +397,6 @@ private:
     // 事件回调
     NodeExecutionCallback m_nodeExecutionCallback;             ///< 节点执行回调
     StateChangeCallback m_stateChangeCallback;                 ///< 状态变化回调
-    
-    /**
-     * @brief 获取当前变量作用域
-     */
-    std::map<std::string, BlueprintValue>& getCurrentScope();
-    
-    /**
-     * @brief 获取当前变量作用域（只读）
-     */
-    const std::map<std::string, BlueprintValue>& getCurrentScope() const;
 };
 
 } // namespace blueprint
@@ -0,0 +1,254 @@
+#include "execution_plan.h"
+
+#include <algorithm>
+
+#include "../common/logger.h"
+#include "graph.h"
+
+using oneday::core::Logger;
+
+namespace oneday {
+namespace core {
+namespace blueprint {
+
+namespace {
+
+bool hasExecutionPort(const std::vector<NodePort>& ports) {
+    return std::any_of(ports.begin(), ports.end(), [](const NodePort& port) {
+        return port.dataType == DataType::Execution;
+    });
+}
+
+}  // namespace
+
+std::shared_ptr<ExecutionPlan> ExecutionPlan::compile(const BlueprintGraph& graph,
+                                                      std::string& errorMessage) {
+    auto plan = std::make_shared<ExecutionPlan>();
+    plan->m_graph = &graph;
+    plan->m_revision = graph.getRevision();
+
+    const auto& graphNodes = graph.getNodes();
+    const uint32_t nodeCount = static_cast<uint32_t>(graphNodes.size());
+
+    // 计划节点下标与图表节点下标一致
+    plan->nodes.resize(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        BaseNode* node = graphNodes[i].get();
+        PlanNode& planNode = plan->nodes[i];
+        planNode.node = node;
+        planNode.isPure = !hasExecutionPort(node->getInputPorts()) &&
+                          !hasExecutionPort(node->getOutputPorts());
+        planNode.isParallelSafe = planNode.isPure && node->isParallelSafe();
+        if (node->getType() == NodeType::Loop) {
+            planNode.loopBodyPort = node->findOutputSlot("loop_body");
+        }
+
+        const auto& inputPorts = node->getInputPorts();
+        for (size_t p = 0; p < inputPorts.size(); ++p) {
+            if (inputPorts[p].dataType == DataType::Execution) {
+                planNode.execInputPort = static_cast<int>(p);
+                break;
+            }
+        }
+        if (node->getType() == NodeType::Start) {
+            plan->entryNodes.push_back(i);
+        }
+    }
+
+    // 按节点分桶的连接：数据输入与执行流后继
+    std::vector<std::vector<PlanInputBinding>> bindingsByNode(nodeCount);
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> execEdgesByNode(nodeCount);
+    for (const auto& connection : graph.getConnections()) {
+        const int sourceIndex = graph.findNodeIndex(connection.sourceNodeId);
+        const int targetIndex = graph.findNodeIndex(connection.targetNodeId);
+        if (sourceIndex < 0 || targetIndex < 0) {
+            errorMessage = "Connection " + connection.id + " references a missing node";
+            return nullptr;
+        }
+
+        const BaseNode* source = plan->nodes[sourceIndex].node;
+        const BaseNode* target = plan->nodes[targetIndex].node;
+        int sourcePort = source->findOutputSlot(connection.sourcePortId);
+        int targetPort = target->findInputSlot(connection.targetPortId);
+        if (sourcePort < 0 || targetPort < 0) {
+            errorMessage = "Connection " + connection.id + " references a missing port";
+            return nullptr;
+        }
+
+        if (source->getOutputPorts()[sourcePort].dataType == DataType::Execution) {
+            execEdgesByNode[sourceIndex].emplace_back(static_cast<uint32_t>(sourcePort),
+                                                      static_cast<uint32_t>(targetIndex));
+        } else {
+            PlanInputBinding binding;
+            binding.sourceNode = static_cast<uint32_t>(sourceIndex);
+            binding.sourcePort = static_cast<uint32_t>(sourcePort);
+            binding.targetPort = static_cast<uint32_t>(targetPort);
+
+            // 声明类型不同的连接在编译期绑定转换函数（None 端口的值类型只能在运行时确定）
+            const DataType sourceType = source->getOutputPorts()[sourcePort].dataType;
+            const DataType targetType = target->getInputPorts()[targetPort].dataType;
+            if (sourceType != targetType && sourceType != DataType::None &&
+                targetType != DataType::None) {
+                binding.convert =
+                    TypeConversionManager::instance().getConverter(sourceType, targetType);
+            }
+            bindingsByNode[targetIndex].push_back(binding);
+        }
+    }
+
+    // 展开为扁平数组
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        PlanNode& planNode = plan->nodes[i];
+
+        planNode.inputs.begin = static_cast<uint32_t>(plan->inputBindings.size());
+        planNode.inputs.count = static_cast<uint32_t>(bindingsByNode[i].size());
+        plan->inputBindings.insert(
+            plan->inputBindings.end(), bindingsByNode[i].begin(), bindingsByNode[i].end());
+
+        // 执行流输出按端口声明顺序排列，保证 Sequence 等节点的触发顺序稳定
+        auto& edges = execEdgesByNode[i];
+        std::stable_sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        planNode.execOutputs.begin = static_cast<uint32_t>(plan->execOutputs.size());
+        for (size_t e = 0; e < edges.size();) {
+            PlanExecOutput output;
+            output.outputPort = edges[e].first;
+            output.successors.begin = static_cast<uint32_t>(plan->successors.size());
+            for (; e < edges.size() && edges[e].first == output.outputPort; ++e) {
+                plan->successors.push_back(edges[e].second);
+            }
+            output.successors.count =
+                static_cast<uint32_t>(plan->successors.size()) - output.successors.begin;
+            plan->execOutputs.push_back(output);
+        }
+        planNode.execOutputs.count =
+            static_cast<uint32_t>(plan->execOutputs.size()) - planNode.execOutputs.begin;
+    }
+
+    // 纯数据依赖：沿数据绑定向上游收集纯节点（后序遍历即拓扑序），同时检测数据环。
+    // 层级 = 上游纯节点的最大层级 + 1，同层级的纯节点之间没有数据依赖
+    std::vector<uint8_t> mark(nodeCount, 0);  // 0=未访问 1=访问中 2=已完成
+    std::vector<uint32_t> level(nodeCount, 0);
+    std::vector<uint32_t> order;
+    bool hasCycle = false;
+    // 迭代式DFS，长链纯节点不会耗尽调用栈
+    std::vector<std::pair<uint32_t, uint32_t>> stack;  // (节点下标, 下一条待访问的数据绑定)
+    auto visit = [&](uint32_t root) {
+        mark[root] = 1;
+        stack.emplace_back(root, plan->nodes[root].inputs.begin);
+        while (!stack.empty()) {
+            auto& [index, next] = stack.back();
+            const PlanRange& inputs = plan->nodes[index].inputs;
+            if (next == inputs.begin + inputs.count) {
+                // 出栈时上游纯节点都已完成（仍在访问中的属于数据环，不计入层级）
+                uint32_t nodeLevel = 0;
+                for (uint32_t b = inputs.begin; b < next; ++b) {
+                    uint32_t source = plan->inputBindings[b].sourceNode;
+                    if (plan->nodes[source].isPure && mark[source] == 2) {
+                        nodeLevel = std::max(nodeLevel, level[source] + 1);
+                    }
+                }
+                level[index] = nodeLevel;
+                mark[index] = 2;
+                order.push_back(index);
+                stack.pop_back();
+                continue;
+            }
+
+            uint32_t source = plan->inputBindings[next++].sourceNode;
+            if (!plan->nodes[source].isPure) {
+                continue;
+            }
+            if (mark[source] == 1) {
+                hasCycle = true;
+            } else if (mark[source] == 0) {
+                mark[source] = 1;
+                stack.emplace_back(source, plan->nodes[source].inputs.begin);
+            }
+        }
+    };
+
+    // 按层级稳定排序（仍是拓扑序）并划分波前，同一波前内可并行的节点在前；
+    // list 将被放在目标数组的 base 处
+    auto buildWavefronts = [&](std::vector<uint32_t>& list, uint32_t base) {
+        std::stable_sort(list.begin(), list.end(), [&](uint32_t a, uint32_t b) {
+            if (level[a] != level[b]) {
+                return level[a] < level[b];
+            }
+            return plan->nodes[a].isParallelSafe && !plan->nodes[b].isParallelSafe;
+        });
+        PlanRange waves;
+        waves.begin = static_cast<uint32_t>(plan->wavefronts.size());
+        for (size_t k = 0; k < list.size();) {
+            PlanRange wave;
+            wave.begin = base + static_cast<uint32_t>(k);
+            const uint32_t waveLevel = level[list[k]];
+            uint32_t parallelCount = 0;
+            for (; k < list.size() && level[list[k]] == waveLevel; ++k) {
+                parallelCount += plan->nodes[list[k]].isParallelSafe ? 1 : 0;
+            }
+            wave.count = base + static_cast<uint32_t>(k) - wave.begin;
+            plan->wavefronts.push_back(wave);
+            plan->parallelCounts.push_back(parallelCount);
+        }
+        waves.count = static_cast<uint32_t>(plan->wavefronts.size()) - waves.begin;
+        return waves;
+    };
+
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        if (plan->nodes[i].isPure) {
+            continue;
+        }
+        order.clear();
+        visit(i);
+        for (uint32_t visited : order) {
+            mark[visited] = 0;  // 只复位本次访问过的节点，避免每个节点都清空整表
+        }
+        order.pop_back();  // 去掉节点自身
+
+        PlanNode& planNode = plan->nodes[i];
+        planNode.dependencies.begin = static_cast<uint32_t>(plan->dependencies.size());
+        planNode.dependencies.count = static_cast<uint32_t>(order.size());
+        planNode.dependencyWaves = buildWavefronts(order, planNode.dependencies.begin);
+        plan->dependencies.insert(plan->dependencies.end(), order.begin(), order.end());
+    }
+
+    if (plan->entryNodes.empty()) {
+        // 没有开始节点：按拓扑序执行全部纯数据节点
+        std::fill(mark.begin(), mark.end(), 0);
+        order.clear();
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            if (plan->nodes[i].isPure && mark[i] == 0) {
+                visit(i);
+            }
+        }
+        plan->dataflowWaves = buildWavefronts(order, 0);
+        plan->dataflowOrder = order;
+
+        size_t skipped = std::count_if(plan->nodes.begin(),
+                                       plan->nodes.end(),
+                                       [](const PlanNode& node) { return !node.isPure; });
+        if (skipped > 0) {
+            Logger::warning("Graph has no start node, {} execution nodes will not run", skipped);
+        }
+    }
+
+    if (hasCycle) {
+        errorMessage = "Data connections form a cycle";
+        return nullptr;
+    }
+
+    ONEDAY_LOG_DEBUG(
+        "Compiled execution plan: {} nodes, {} data bindings, {} execution edges, {} wavefronts",
+        nodeCount, plan->inputBindings.size(), plan->successors.size(), plan->wavefronts.size());
+    return plan;
+}
+
+bool ExecutionPlan::isUpToDate(const BlueprintGraph& graph) const {
+    return m_graph == &graph && m_revision == graph.getRevision();
+}
+
+}  // namespace blueprint
+}  // namespace core
+}  // namespace oneday
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "data_types.h"
+
+namespace oneday {
+namespace core {
+namespace blueprint {
+
+// 前向声明
+class BaseNode;
+class BlueprintGraph;
+
+/**
+ * @brief 扁平索引区间（指向执行计划中某个共享数组的一段）
+ */
+struct PlanRange {
+    uint32_t begin = 0;  ///< 起始下标
+    uint32_t count = 0;  ///< 元素个数
+};
+
+/**
+ * @brief 数据输入绑定 - 执行前把上游输出端口的值复制到本节点的输入端口
+ */
+struct PlanInputBinding {
+    uint32_t sourceNode = 0;               ///< 源节点在计划中的索引
+    uint32_t sourcePort = 0;               ///< 源节点输出端口槽位
+    uint32_t targetPort = 0;               ///< 本节点输入端口槽位
+    ConversionFunction convert = nullptr;  ///< 端口类型不同时编译期绑定的转换函数
+};
+
+/**
+ * @brief 执行流输出 - 某个执行流输出端口及其后继节点
+ */
+struct PlanExecOutput {
+    uint32_t outputPort = 0;  ///< 执行流输出端口槽位
+    PlanRange successors;     ///< 后继节点区间（指向 ExecutionPlan::successors）
+};
+
+/**
+ * @brief 计划中的单个节点
+ */
+struct PlanNode {
+    BaseNode* node = nullptr;     ///< 图表中的节点
+    bool isPure = false;          ///< 纯数据节点（无执行流端口，按需求值）
+    bool isParallelSafe = false;  ///< 纯数据节点且声明可并行执行（BaseNode::isParallelSafe）
+    int execInputPort = -1;       ///< 执行流输入端口槽位（无则为-1）
+    int loopBodyPort = -1;        ///< 循环体输出端口槽位（非循环节点为-1）
+    PlanRange inputs;             ///< 数据输入绑定（指向 ExecutionPlan::inputBindings）
+    PlanRange dependencies;       ///< 执行前需要求值的纯数据节点（指向 ExecutionPlan::dependencies）
+    PlanRange dependencyWaves;    ///< dependencies 的波前划分（指向 ExecutionPlan::wavefronts）
+    PlanRange execOutputs;        ///< 执行流输出（指向 ExecutionPlan::execOutputs）
+};
+
+/**
+ * @brief 预编译的执行计划
+ *
+ * 由 BlueprintGraph 一次性编译得到：节点被映射为稠密索引，连接被解析为端口槽位绑定，
+ * 执行流连接被展开为后继表，端口类型不同的数据连接预先绑定类型转换函数。运行时只做数组遍历，不再扫描连接列表或按字符串查找节点。
+ *
+ * 纯数据节点按依赖深度分层：同一层（波前）内的节点互不依赖。每个波前内声明可并行的节点排在前面，
+ * 只有这部分可以分发到线程池，其余节点在调用线程串行执行。
+ */
+class ExecutionPlan {
+  public:
+    /**
+     * @brief 编译图表
+     * @param graph 源图表
+     * @param errorMessage 编译失败时的错误信息
+     * @return 执行计划，失败时返回空指针
+     */
+    static std::shared_ptr<ExecutionPlan> compile(const BlueprintGraph& graph,
+                                                  std::string& errorMessage);
+
+    /**
+     * @brief 检查计划是否仍与图表结构一致
+     */
+    bool isUpToDate(const BlueprintGraph& graph) const;
+
+    /**
+     * @brief 是否为纯数据流模式（图表没有开始节点，按拓扑序执行全部数据节点）
+     */
+    bool isDataflowOnly() const {
+        return entryNodes.empty();
+    }
+
+    std::vector<PlanNode> nodes;                  ///< 节点表
+    std::vector<PlanInputBinding> inputBindings;  ///< 所有数据输入绑定
+    std::vector<uint32_t> dependencies;           ///< 所有纯数据依赖
+    std::vector<PlanExecOutput> execOutputs;      ///< 所有执行流输出
+    std::vector<uint32_t> successors;             ///< 所有执行流后继
+    std::vector<uint32_t> entryNodes;             ///< 入口节点（开始节点）
+    std::vector<uint32_t> dataflowOrder;          ///< 纯数据流模式下的执行顺序（按波前排列）
+    std::vector<PlanRange> wavefronts;            ///< 所有波前（指向 dependencies 或 dataflowOrder）
+    std::vector<uint32_t> parallelCounts;         ///< 每个波前开头可并行执行的节点数（与 wavefronts 对应）
+    PlanRange dataflowWaves;                      ///< dataflowOrder 的波前划分
+
+  private:
+    const BlueprintGraph* m_graph = nullptr;  ///< 源图表
+    uint64_t m_revision = 0;                  ///< 编译时的图表版本号
+};
+
+}  // namespace blueprint
+}  // namespace core
+}  // namespace oneday
@@ -1,22 +1,501 @@
 #include "graph.h"
 
+#include <algorithm>
+#include <atomic>
 #include <ctime>
 #include <nlohmann/json.hpp>
+#include <random>
+#include <sstream>
 
 #include "../common/logger.h"
 
+using oneday::core::Logger;
+
 namespace oneday {
 namespace core {
 namespace blueprint {
 
-// BlueprintGraph implementation
-// Note: Most methods are already implemented inline in the header file
-// This file only contains methods that need complex implementation
+// BlueprintGraph 实现
+
+BlueprintGraph::BlueprintGraph(const std::string& id) : m_id(id.empty() ? generateGraphId() : id) {
+    touchRevision();
+    ONEDAY_LOG_DEBUG("Created blueprint graph: {}", m_id);
+}
+
+// 节点管理
+
+bool BlueprintGraph::addNode(std::unique_ptr<BaseNode> node) {
+    if (!node) {
+        Logger::warning("Attempted to add null node to graph {}", m_id);
+        return false;
+    }
+
+    if (m_nodeIndex.count(node->getId())) {
+        Logger::warning("Node {} already exists in graph {}", node->getId(), m_id);
+        return false;
+    }
+
+    BaseNode* rawNode = node.get();
+    m_nodeIndex.emplace(rawNode->getId(), static_cast<uint32_t>(m_nodes.size()));
+    m_nodes.push_back(std::move(node));
+    m_adjacency.emplace_back();
+    touchRevision();
+
+    if (m_nodeAddedCallback) {
+        m_nodeAddedCallback(rawNode);
+    }
+    return true;
+}
+
+bool BlueprintGraph::removeNode(const std::string& nodeId) {
+    auto it = m_nodeIndex.find(nodeId);
+    if (it == m_nodeIndex.end()) {
+        return false;
+    }
+
+    removeNodeConnections(nodeId);
+
+    // 与末尾节点交换后删除，邻接表随节点一起移动
+    const uint32_t index = it->second;
+    const uint32_t last = static_cast<uint32_t>(m_nodes.size()) - 1;
+    m_nodeIndex.erase(it);
+    if (index != last) {
+        m_nodes[index] = std::move(m_nodes[last]);
+        m_adjacency[index] = std::move(m_adjacency[last]);
+        m_nodeIndex[m_nodes[index]->getId()] = index;
+    }
+    m_nodes.pop_back();
+    m_adjacency.pop_back();
+    touchRevision();
+
+    if (m_nodeRemovedCallback) {
+        m_nodeRemovedCallback(nodeId);
+    }
+    return true;
+}
+
+BaseNode* BlueprintGraph::findNode(const std::string& nodeId) const {
+    auto it = m_nodeIndex.find(nodeId);
+    return it != m_nodeIndex.end() ? m_nodes[it->second].get() : nullptr;
+}
+
+int BlueprintGraph::findNodeIndex(const std::string& nodeId) const {
+    auto it = m_nodeIndex.find(nodeId);
+    return it != m_nodeIndex.end() ? static_cast<int>(it->second) : -1;
+}
+
+std::vector<BaseNode*> BlueprintGraph::findNodesByType(NodeType type) const {
+    std::vector<BaseNode*> result;
+    for (const auto& node : m_nodes) {
+        if (node->getType() == type) {
+            result.push_back(node.get());
+        }
+    }
+    return result;
+}
+
+void BlueprintGraph::clearNodes() {
+    clearConnections();
+    m_nodes.clear();
+    m_nodeIndex.clear();
+    m_adjacency.clear();
+    touchRevision();
+}
+
+// 连接管理
+
+bool BlueprintGraph::addConnection(const NodeConnection& connection) {
+    if (!isValidConnection(connection)) {
+        Logger::warning("Invalid connection {}.{} -> {}.{}",
+                        connection.sourceNodeId, connection.sourcePortId, connection.targetNodeId,
+                        connection.targetPortId);
+        return false;
+    }
+
+    NodeConnection stored = connection;
+    if (stored.id.empty()) {
+        stored.id = NodeUtils::generateConnectionId();
+    } else if (m_connectionIndex.count(stored.id)) {
+        Logger::warning("Connection {} already exists in graph {}", stored.id, m_id);
+        return false;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_connections.size());
+    m_connectionIndex.emplace(stored.id, index);
+    m_adjacency[m_nodeIndex.at(stored.sourceNodeId)].outputs.push_back(index);
+    m_adjacency[m_nodeIndex.at(stored.targetNodeId)].inputs.push_back(index);
+    m_connections.push_back(std::move(stored));
+    touchRevision();
+
+    if (m_connectionAddedCallback) {
+        m_connectionAddedCallback(m_connections.back());
+    }
+    return true;
+}
+
+bool BlueprintGraph::removeConnection(const std::string& connectionId) {
+    auto it = m_connectionIndex.find(connectionId);
+    if (it == m_connectionIndex.end()) {
+        return false;
+    }
+
+    const uint32_t index = it->second;
+    const uint32_t last = static_cast<uint32_t>(m_connections.size()) - 1;
+    const NodeConnection& removed = m_connections[index];
+    eraseAdjacency(m_adjacency[m_nodeIndex.at(removed.sourceNodeId)].outputs, index);
+    eraseAdjacency(m_adjacency[m_nodeIndex.at(removed.targetNodeId)].inputs, index);
+    m_connectionIndex.erase(it);
+
+    // 与末尾连接交换后删除，并修正被移动连接在邻接表中的下标
+    if (index != last) {
+        const NodeConnection& moved = m_connections[last];
+        replaceAdjacency(m_adjacency[m_nodeIndex.at(moved.sourceNodeId)].outputs, last, index);
+        replaceAdjacency(m_adjacency[m_nodeIndex.at(moved.targetNodeId)].inputs, last, index);
+        m_connectionIndex[moved.id] = index;
+        m_connections[index] = std::move(m_connections[last]);
+    }
+    m_connections.pop_back();
+    touchRevision();
+
+    if (m_connectionRemovedCallback) {
+        m_connectionRemovedCallback(connectionId);
+    }
+    return true;
+}
+
+void BlueprintGraph::removeNodeConnections(const std::string& nodeId) {
+    auto it = m_nodeIndex.find(nodeId);
+    if (it == m_nodeIndex.end()) {
+        return;
+    }
+
+    // 先收集ID，删除过程中下标会变化
+    const NodeAdjacency& adjacency = m_adjacency[it->second];
+    std::vector<std::string> toRemove;
+    toRemove.reserve(adjacency.inputs.size() + adjacency.outputs.size());
+    for (uint32_t index : adjacency.inputs) {
+        toRemove.push_back(m_connections[index].id);
+    }
+    for (uint32_t index : adjacency.outputs) {
+        toRemove.push_back(m_connections[index].id);
+    }
+    for (const auto& connectionId : toRemove) {
+        removeConnection(connectionId);
+    }
+}
+
+const NodeConnection* BlueprintGraph::findConnection(const std::string& connectionId) const {
+    auto it = m_connectionIndex.find(connectionId);
+    return it != m_connectionIndex.end() ? &m_connections[it->second] : nullptr;
+}
+
+std::vector<NodeConnection> BlueprintGraph::getInputConnections(const std::string& nodeId) const {
+    ConnectionView view = getInputConnectionsView(nodeId);
+    return std::vector<NodeConnection>(view.begin(), view.end());
+}
+
+std::vector<NodeConnection> BlueprintGraph::getOutputConnections(const std::string& nodeId) const {
+    ConnectionView view = getOutputConnectionsView(nodeId);
+    return std::vector<NodeConnection>(view.begin(), view.end());
+}
+
+ConnectionView BlueprintGraph::getInputConnectionsView(const std::string& nodeId) const {
+    int index = findNodeIndex(nodeId);
+    return index >= 0 ? getInputConnectionsView(static_cast<size_t>(index)) : ConnectionView();
+}
+
+ConnectionView BlueprintGraph::getOutputConnectionsView(const std::string& nodeId) const {
+    int index = findNodeIndex(nodeId);
+    return index >= 0 ? getOutputConnectionsView(static_cast<size_t>(index)) : ConnectionView();
+}
+
+bool BlueprintGraph::isValidConnection(const NodeConnection& connection) const {
+    if (connection.sourceNodeId == connection.targetNodeId) {
+        return false;
+    }
+
+    const BaseNode* sourceNode = findNode(connection.sourceNodeId);
+    const BaseNode* targetNode = findNode(connection.targetNodeId);
+    if (!sourceNode || !targetNode) {
+        return false;
+    }
+
+    const NodePort* sourcePort = sourceNode->findOutputPort(connection.sourcePortId);
+    const NodePort* targetPort = targetNode->findInputPort(connection.targetPortId);
+    if (!sourcePort || !targetPort) {
+        return false;
+    }
+
+    // 任意类型端口（None）可以接收任何数据
+    if (targetPort->dataType != DataType::None && sourcePort->dataType != DataType::None &&
+        !NodeUtils::isValidConnection(*sourcePort, *targetPort)) {
+        return false;
+    }
+
+    // 数据输入端口只能有一个来源，执行流输入可以有多个
+    if (targetPort->dataType != DataType::Execution) {
+        for (const auto& existing : getInputConnectionsView(connection.targetNodeId)) {
+            if (existing.targetPortId == connection.targetPortId) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void BlueprintGraph::clearConnections() {
+    m_connections.clear();
+    m_connectionIndex.clear();
+    for (auto& adjacency : m_adjacency) {
+        adjacency.inputs.clear();
+        adjacency.outputs.clear();
+    }
+    touchRevision();
+}
+
+// 图表变量管理
+
+void BlueprintGraph::setVariable(const std::string& name, const BlueprintValue& value) {
+    m_variables[name] = value;
+}
+
+BlueprintValue BlueprintGraph::getVariable(const std::string& name) const {
+    auto it = m_variables.find(name);
+    return it != m_variables.end() ? it->second : BlueprintValue();
+}
+
+bool BlueprintGraph::hasVariable(const std::string& name) const {
+    return m_variables.find(name) != m_variables.end();
+}
+
+bool BlueprintGraph::deleteVariable(const std::string& name) {
+    return m_variables.erase(name) > 0;
+}
+
+void BlueprintGraph::clearVariables() {
+    m_variables.clear();
+}
+
+// 图表验证
+
+GraphValidationResult BlueprintGraph::validate() const {
+    GraphValidationResult result;
+
+    for (const auto& connection : m_connections) {
+        if (!findNode(connection.sourceNodeId) || !findNode(connection.targetNodeId)) {
+            result.errors.push_back("Connection " + connection.id + " references a missing node");
+        }
+    }
+
+    if (hasCyclicDependency()) {
+        result.errors.push_back("Graph contains a cyclic dependency");
+    }
+
+    if (!m_nodes.empty() && findStartNodes().empty()) {
+        result.warnings.push_back("Graph has no start node; nodes run in dataflow order");
+    }
+
+    result.isValid = result.errors.empty();
+    return result;
+}
+
+bool BlueprintGraph::hasCyclicDependency() const {
+    // 迭代式DFS三色标记：0=未访问 1=在栈上 2=已完成
+    std::vector<uint8_t> color(m_nodes.size(), 0);
+    std::vector<std::pair<uint32_t, size_t>> stack;  // (节点下标, 下一条待访问的输出连接)
+
+    for (uint32_t root = 0; root < m_nodes.size(); ++root) {
+        if (color[root] != 0) {
+            continue;
+        }
+        color[root] = 1;
+        stack.emplace_back(root, 0);
+
+        while (!stack.empty()) {
+            auto& [node, next] = stack.back();
+            const auto& outputs = m_adjacency[node].outputs;
+            if (next == outputs.size()) {
+                color[node] = 2;
+                stack.pop_back();
+                continue;
+            }
+
+            const uint32_t target = m_nodeIndex.at(m_connections[outputs[next++]].targetNodeId);
+            if (color[target] == 1) {
+                return true;
+            }
+            if (color[target] == 0) {
+                color[target] = 1;
+                stack.emplace_back(target, 0);
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<BaseNode*> BlueprintGraph::getTopologicalOrder() const {
+    // Kahn算法，基于邻接表 O(V+E)
+    std::vector<uint32_t> inDegree(m_nodes.size());
+    std::vector<uint32_t> ready;
+    for (uint32_t i = 0; i < m_nodes.size(); ++i) {
+        inDegree[i] = static_cast<uint32_t>(m_adjacency[i].inputs.size());
+        if (inDegree[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    std::vector<BaseNode*> order;
+    order.reserve(m_nodes.size());
+    for (size_t head = 0; head < ready.size(); ++head) {
+        const uint32_t node = ready[head];
+        order.push_back(m_nodes[node].get());
+
+        for (uint32_t connection : m_adjacency[node].outputs) {
+            const uint32_t target = m_nodeIndex.at(m_connections[connection].targetNodeId);
+            if (--inDegree[target] == 0) {
+                ready.push_back(target);
+            }
+        }
+    }
+
+    if (order.size() != m_nodes.size()) {
+        Logger::warning("Graph {} contains a cycle, topological order is incomplete", m_id);
+    }
+    return order;
+}
+
+std::vector<BaseNode*> BlueprintGraph::findStartNodes() const {
+    return findNodesByType(NodeType::Start);
+}
+
+std::vector<BaseNode*> BlueprintGraph::findEndNodes() const {
+    return findNodesByType(NodeType::End);
+}
+
+// 序列化
+
+std::string BlueprintGraph::exportToJson() const {
+    nlohmann::json json;
+    json["id"] = m_id;
+    json["name"] = m_name;
+    json["metadata"] = {{"version", m_metadata.version},
+                        {"author", m_metadata.author},
+                        {"description", m_metadata.description}};
+
+    nlohmann::json nodes = nlohmann::json::array();
+    for (const auto& node : m_nodes) {
+        nlohmann::json entry;
+        entry["id"] = node->getId();
+        entry["type"] = NodeUtils::getNodeTypeName(node->getType());
+        entry["name"] = node->getName();
+        entry["description"] = node->getDescription();
+
+        // 已设置的输入常量按字符串形式写出
+        nlohmann::json inputs = nlohmann::json::object();
+        const auto& inputPorts = node->getInputPorts();
+        for (size_t i = 0; i < inputPorts.size(); ++i) {
+            const BlueprintValue& value = node->getInputValue(static_cast<int>(i));
+            if (!value.isEmpty()) {
+                inputs[inputPorts[i].id] = value.toString();
+            }
+        }
+        entry["inputs"] = std::move(inputs);
+        nodes.push_back(std::move(entry));
+    }
+    json["nodes"] = std::move(nodes);
+
+    nlohmann::json connections = nlohmann::json::array();
+    for (const auto& connection : m_connections) {
+        connections.push_back({{"id", connection.id},
+                               {"sourceNode", connection.sourceNodeId},
+                               {"sourcePort", connection.sourcePortId},
+                               {"targetNode", connection.targetNodeId},
+                               {"targetPort", connection.targetPortId}});
+    }
+    json["connections"] = std::move(connections);
+    return json.dump(2);
+}
+
+bool BlueprintGraph::importFromJson(const std::string& json) {
+    nlohmann::json root = nlohmann::json::parse(json, nullptr, false);
+    if (root.is_discarded() || !root.is_object()) {
+        Logger::error("Failed to parse blueprint graph JSON");
+        return false;
+    }
+
+    // 没有按类型创建节点的工厂，节点和连接无法从 JSON 重建；拒绝导入而不是静默丢弃
+    for (const char* key : {"nodes", "connections"}) {
+        const auto list = root.find(key);
+        if (list != root.end() && (!list->is_array() || !list->empty())) {
+            Logger::error("Importing blueprint graph {} from JSON is not supported", key);
+            return false;
+        }
+    }
+
+    clear();
+    m_id = root.value("id", std::string());
+    if (m_id.empty()) {
+        m_id = generateGraphId();
+    }
+    m_name = root.value("name", std::string());
+    m_metadata = GraphMetadata();
+    const auto metadata = root.find("metadata");
+    if (metadata != root.end() && metadata->is_object()) {
+        m_metadata.version = metadata->value("version", m_metadata.version);
+        m_metadata.author = metadata->value("author", std::string());
+        m_metadata.description = metadata->value("description", std::string());
+    }
+    touchRevision();
+
+    ONEDAY_LOG_DEBUG("Imported blueprint graph {} from JSON", m_id);
+    return true;
+}
+
+// 图表操作
+
+void BlueprintGraph::clear() {
+    clearNodes();
+    clearVariables();
+}
+
+void BlueprintGraph::resetNodeStates() {
+    for (const auto& node : m_nodes) {
+        node->reset();
+    }
+}
+
+// 私有方法
+
+void BlueprintGraph::touchRevision() {
+    static std::atomic<uint64_t> s_nextRevision{1};
+    m_revision = s_nextRevision.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string BlueprintGraph::generateGraphId() {
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+    static std::uniform_int_distribution<> dis(0, 15);
+
+    std::ostringstream oss;
+    oss << "graph_";
+    for (int i = 0; i < 8; ++i) {
+        oss << std::hex << dis(gen);
+    }
+    return oss.str();
+}
+
+void BlueprintGraph::eraseAdjacency(std::vector<uint32_t>& list, uint32_t connectionIndex) {
+    auto it = std::find(list.begin(), list.end(), connectionIndex);
+    if (it != list.end()) {
+        list.erase(it);
+    }
+}
 
-// BlueprintGraph implementation
-// All methods are implemented inline in the header file
-// This file is kept for future complex implementations
+void BlueprintGraph::replaceAdjacency(std::vector<uint32_t>& list, uint32_t from, uint32_t to) {
+    std::replace(list.begin(), list.end(), from, to);
+}
 
 }  // namespace blueprint
 }  // namespace core
-}  // namespace oneday
\ No newline at end of file
+}  // namespace oneday
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "data_types.h"
@@ -37,8 +41,87 @@ struct GraphValidationResult {
     std::vector<std::string> warnings;  ///< 警告列表
 };
 
+/**
+ * @brief 连接视图 - 按下标引用图表内的连接，不复制连接数据
+ * 图表增删节点或连接后失效
+ */
+class ConnectionView {
+  public:
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = NodeConnection;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const NodeConnection*;
+        using reference = const NodeConnection&;
+
+        Iterator() = default;
+        Iterator(const std::vector<NodeConnection>* connections, const uint32_t* index)
+            : m_connections(connections), m_index(index) {}
+
+        reference operator*() const {
+            return (*m_connections)[*m_index];
+        }
+        pointer operator->() const {
+            return &(*m_connections)[*m_index];
+        }
+        Iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++m_index;
+            return previous;
+        }
+        bool operator==(const Iterator& other) const {
+            return m_index == other.m_index;
+        }
+
+      private:
+        const std::vector<NodeConnection>* m_connections = nullptr;
+        const uint32_t* m_index = nullptr;
+    };
+
+    ConnectionView() = default;
+    ConnectionView(const std::vector<NodeConnection>& connections,
+                   std::span<const uint32_t> indices)
+        : m_connections(&connections), m_indices(indices) {}
+
+    Iterator begin() const {
+        return Iterator(m_connections, m_indices.data());
+    }
+    Iterator end() const {
+        return Iterator(m_connections, m_indices.data() + m_indices.size());
+    }
+    size_t size() const {
+        return m_indices.size();
+    }
+    bool empty() const {
+        return m_indices.empty();
+    }
+    const NodeConnection& operator[](size_t i) const {
+        return (*m_connections)[m_indices[i]];
+    }
+
+    /**
+     * @brief 连接在 BlueprintGraph::getConnections() 中的下标
+     */
+    std::span<const uint32_t> indices() const {
+        return m_indices;
+    }
+
+  private:
+    const std::vector<NodeConnection>* m_connections = nullptr;
+    std::span<const uint32_t> m_indices;
+};
+
 /**
  * @brief 蓝图图表类 - 管理节点和连接关系
+ *
+ * 节点和连接各自维护ID哈希索引，每个节点维护输入/输出连接的邻接表，
+ * 查找与邻接查询均不扫描整个图表。删除采用与末尾元素交换的方式，
+ * 因此 getNodes()/getConnections() 的顺序在删除后可能变化。
  */
 class BlueprintGraph {
   public:
@@ -94,6 +177,14 @@ class BlueprintGraph {
         m_metadata = metadata;
     }
 
+    /**
+     * @brief 获取结构版本号
+     * 节点或连接变化时更新，进程内全局唯一，用于判断已编译的执行计划是否过期
+     */
+    uint64_t getRevision() const {
+        return m_revision;
+    }
+
     // 节点管理
 
     /**
@@ -111,6 +202,12 @@ class BlueprintGraph {
      */
     BaseNode* findNode(const std::string& nodeId) const;
 
+    /**
+     * @brief 根据ID查找节点下标
+     * @return 节点在 getNodes() 中的下标，不存在返回-1
+     */
+    int findNodeIndex(const std::string& nodeId) const;
+
     /**
      * @brief 获取所有节点
      */
@@ -172,15 +269,39 @@ class BlueprintGraph {
     }
 
     /**
-     * @brief 获取节点的输入连接
+     * @brief 获取节点的输入连接（复制）
      */
     std::vector<NodeConnection> getInputConnections(const std::string& nodeId) const;
 
     /**
-     * @brief 获取节点的输出连接
+     * @brief 获取节点的输出连接（复制）
      */
     std::vector<NodeConnection> getOutputConnections(const std::string& nodeId) const;
 
+    /**
+     * @brief 获取节点的输入连接视图（不复制）
+     */
+    ConnectionView getInputConnectionsView(const std::string& nodeId) const;
+
+    /**
+     * @brief 获取节点的输出连接视图（不复制）
+     */
+    ConnectionView getOutputConnectionsView(const std::string& nodeId) const;
+
+    /**
+     * @brief 按节点下标获取输入连接视图
+     */
+    ConnectionView getInputConnectionsView(size_t nodeIndex) const {
+        return ConnectionView(m_connections, m_adjacency[nodeIndex].inputs);
+    }
+
+    /**
+     * @brief 按节点下标获取输出连接视图
+     */
+    ConnectionView getOutputConnectionsView(size_t nodeIndex) const {
+        return ConnectionView(m_connections, m_adjacency[nodeIndex].outputs);
+    }
+
     /**
      * @brief 检查连接是否有效
      */
@@ -266,11 +387,17 @@ class BlueprintGraph {
 
     /**
      * @brief 导出为JSON字符串
+     *
+     * 写出图表标识、名称、元数据、节点（标识、类型、名称和已设置的输入常量）以及连接。
      */
     std::string exportToJson() const;
 
     /**
      * @brief 从JSON字符串导入
+     *
+     * 清空当前图表后恢复标识、名称和元数据。没有按类型创建节点的工厂，
+     * 节点或连接列表非空时报错并拒绝导入，图表保持不变。
+     * @return 是否成功
      */
     bool importFromJson(const std::string& json);
 
@@ -347,6 +474,14 @@ class BlueprintGraph {
     }
 
   private:
+    /**
+     * @brief 节点邻接表（连接在 m_connections 中的下标）
+     */
+    struct NodeAdjacency {
+        std::vector<uint32_t> inputs;   ///< 以该节点为目标的连接
+        std::vector<uint32_t> outputs;  ///< 以该节点为源的连接
+    };
+
     std::string m_id;          ///< 图表唯一标识
     std::string m_name;        ///< 图表名称
     GraphMetadata m_metadata;  ///< 图表元数据
@@ -354,6 +489,11 @@ class BlueprintGraph {
     std::vector<std::unique_ptr<BaseNode>> m_nodes;     ///< 节点列表
     std::vector<NodeConnection> m_connections;          ///< 连接列表
     std::map<std::string, BlueprintValue> m_variables;  ///< 图表变量
+    uint64_t m_revision = 0;                            ///< 结构版本号
+
+    std::unordered_map<std::string, uint32_t> m_nodeIndex;        ///< 节点ID -> 下标
+    std::unordered_map<std::string, uint32_t> m_connectionIndex;  ///< 连接ID -> 下标
+    std::vector<NodeAdjacency> m_adjacency;                       ///< 与 m_nodes 一一对应
 
     // 事件回调
     NodeAddedCallback m_nodeAddedCallback;
@@ -361,17 +501,25 @@ class BlueprintGraph {
     ConnectionAddedCallback m_connectionAddedCallback;
     ConnectionRemovedCallback m_connectionRemovedCallback;
 
+    /**
+     * @brief 标记结构已变化，分配新的版本号
+     */
+    void touchRevision();
+
     /**
      * @brief 生成唯一的图表ID
      */
     static std::string generateGraphId();
 
     /**
-     * @brief 深度优先搜索检查循环
+     * @brief 从邻接表中移除指定连接下标
+     */
+    static void eraseAdjacency(std::vector<uint32_t>& list, uint32_t connectionIndex);
+
+    /**
+     * @brief 把邻接表中的连接下标替换为新下标
      */
-    bool dfsCheckCycle(const std::string& nodeId,
-                       std::map<std::string, int>& visited,
-                       std::map<std::string, int>& recursionStack) const;
+    static void replaceAdjacency(std::vector<uint32_t>& list, uint32_t from, uint32_t to);
 };
 
 }  // namespace blueprint
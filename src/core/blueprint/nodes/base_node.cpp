@@ -16,76 +16,78 @@ namespace blueprint {
 BaseNode::BaseNode(const std::string& id, NodeType type) 
     : m_id(id), m_type(type), m_state(NodeState::Idle) {
     m_name = NodeUtils::getNodeTypeName(type);
-    initializePorts();
-    Logger::debug("Created node: " + m_id + " (" + m_name + ")");
+    // 端口由派生类构造函数调用 initializePorts() 创建（基类构造期间虚函数尚未就绪）
+    ONEDAY_LOG_DEBUG("Created node: {} ({})", m_id, m_name);
 }
 
 const NodePort* BaseNode::findInputPort(const std::string& portId) const {
-    auto it = std::find_if(m_inputPorts.begin(), m_inputPorts.end(),
-        [&portId](const NodePort& port) { return port.id == portId; });
-    return it != m_inputPorts.end() ? &(*it) : nullptr;
+    int slot = findInputSlot(portId);
+    return slot >= 0 ? &m_inputPorts[slot] : nullptr;
 }
 
 const NodePort* BaseNode::findOutputPort(const std::string& portId) const {
-    auto it = std::find_if(m_outputPorts.begin(), m_outputPorts.end(),
-        [&portId](const NodePort& port) { return port.id == portId; });
-    return it != m_outputPorts.end() ? &(*it) : nullptr;
+    int slot = findOutputSlot(portId);
+    return slot >= 0 ? &m_outputPorts[slot] : nullptr;
 }
 
-void BaseNode::setInputValue(const std::string& portId, const BlueprintValue& value) {
-    const NodePort* port = findInputPort(portId);
-    if (port) {
-        // 类型检查
-        if (port->dataType != DataType::None && value.getType() != port->dataType) {
-            // 尝试类型转换
-            BlueprintValue convertedValue;
-            if (DataTypeUtils::tryConvert(value, port->dataType, convertedValue)) {
-                m_inputValues[portId] = convertedValue;
-            } else {
-                Logger::warning("Type mismatch for input port " + portId + " in node " + m_id);
-                return;
-            }
-        } else {
-            m_inputValues[portId] = value;
+int BaseNode::findInputSlot(const std::string& portId) const {
+    for (size_t i = 0; i < m_inputPorts.size(); ++i) {
+        if (m_inputPorts[i].id == portId) {
+            return static_cast<int>(i);
         }
-        Logger::debug("Set input value for port " + portId + " in node " + m_id);
-    } else {
-        Logger::error("Input port " + portId + " not found in node " + m_id);
     }
+    return -1;
 }
 
-BlueprintValue BaseNode::getInputValue(const std::string& portId) const {
-    auto it = m_inputValues.find(portId);
-    if (it != m_inputValues.end()) {
-        return it->second;
+int BaseNode::findOutputSlot(const std::string& portId) const {
+    for (size_t i = 0; i < m_outputPorts.size(); ++i) {
+        if (m_outputPorts[i].id == portId) {
+            return static_cast<int>(i);
+        }
     }
-    
-    // 返回端口的默认值
-    const NodePort* port = findInputPort(portId);
-    if (port && !port->defaultValue.isEmpty()) {
-        return port->defaultValue;
+    return -1;
+}
+
+void BaseNode::setInputValue(const std::string& portId, const BlueprintValue& value) {
+    int slot = findInputSlot(portId);
+    if (slot >= 0) {
+        setInputValue(slot, value);
+        ONEDAY_LOG_DEBUG("Set input value for port {} in node {}", portId, m_id);
+    } else {
+        Logger::error("Input port {} not found in node {}", portId, m_id);
     }
-    
-    // 返回类型的默认值
-    if (port) {
-        return DataTypeUtils::getDefaultValue(port->dataType);
+}
+
+void BaseNode::setInputValue(int slot, const BlueprintValue& value) {
+    const NodePort& port = m_inputPorts[slot];
+    // 类型检查
+    if (port.dataType != DataType::None && value.getType() != port.dataType) {
+        // 尝试类型转换
+        BlueprintValue convertedValue;
+        if (DataTypeUtils::tryConvert(value, port.dataType, convertedValue)) {
+            m_inputValues[slot] = std::move(convertedValue);
+        } else {
+            Logger::warning("Type mismatch for input port {} in node {}", port.id, m_id);
+        }
+        return;
     }
-    
-    return BlueprintValue();
+    m_inputValues[slot] = value;
+}
+
+BlueprintValue BaseNode::getInputValue(const std::string& portId) const {
+    int slot = findInputSlot(portId);
+    return slot >= 0 ? getInputValue(slot) : BlueprintValue();
+}
+
+const BlueprintValue& BaseNode::getInputValue(int slot) const {
+    const BlueprintValue& value = m_inputValues[slot];
+    // 未设置时返回端口的默认值
+    return value.isEmpty() ? m_inputPorts[slot].defaultValue : value;
 }
 
 BlueprintValue BaseNode::getOutputValue(const std::string& portId) const {
-    auto it = m_outputValues.find(portId);
-    if (it != m_outputValues.end()) {
-        return it->second;
-    }
-    
-    const NodePort* port = findOutputPort(portId);
-    if (port) {
-        return DataTypeUtils::getDefaultValue(port->dataType);
-    }
-    
-    return BlueprintValue();
+    int slot = findOutputSlot(portId);
+    return slot >= 0 ? getOutputValue(slot) : BlueprintValue();
 }
 
 bool BaseNode::canExecute() const {
@@ -94,12 +96,9 @@ bool BaseNode::canExecute() const {
     }
     
     // 检查必需的输入端口是否都有值
-    for (const auto& port : m_inputPorts) {
-        if (port.isRequired) {
-            auto it = m_inputValues.find(port.id);
-            if (it == m_inputValues.end() || it->second.isEmpty()) {
-                return false;
-            }
+    for (size_t i = 0; i < m_inputPorts.size(); ++i) {
+        if (m_inputPorts[i].isRequired && m_inputValues[i].isEmpty()) {
+            return false;
         }
     }
     
@@ -124,8 +123,6 @@ NodeExecutionResult BaseNode::execute(ExecutionContext& context) {
         
         if (result.success) {
             setState(NodeState::Completed);
-            // 复制输出值
-            result.outputValues = m_outputValues;
         } else {
             setState(NodeState::Error);
         }
@@ -139,26 +136,25 @@ NodeExecutionResult BaseNode::execute(ExecutionContext& context) {
     auto endTime = std::chrono::high_resolution_clock::now();
     result.executionTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
     
-    Logger::debug("Node " + m_id + " executed in " + std::to_string(result.executionTime) + "ms");
+    ONEDAY_LOG_DEBUG("Node {} executed in {}ms", m_id, result.executionTime);
     
     return result;
 }
 
 void BaseNode::reset() {
     setState(NodeState::Idle);
-    m_outputValues.clear();
-    Logger::debug("Reset node: " + m_id);
+    for (size_t i = 0; i < m_outputPorts.size(); ++i) {
+        m_outputValues[i] = m_outputPorts[i].defaultValue;
+    }
+    ONEDAY_LOG_DEBUG("Reset node: {}", m_id);
 }
 
 bool BaseNode::validate(std::string& errorMessage) const {
     // 检查必需的输入端口
-    for (const auto& port : m_inputPorts) {
-        if (port.isRequired) {
-            auto it = m_inputValues.find(port.id);
-            if (it == m_inputValues.end() || it->second.isEmpty()) {
-                errorMessage = "Required input port '" + port.name + "' is not connected";
-                return false;
-            }
+    for (size_t i = 0; i < m_inputPorts.size(); ++i) {
+        if (m_inputPorts[i].isRequired && m_inputValues[i].isEmpty()) {
+            errorMessage = "Required input port '" + m_inputPorts[i].name + "' is not connected";
+            return false;
         }
     }
     
@@ -174,8 +170,10 @@ std::map<std::string, BlueprintValue> BaseNode::serialize() const {
     data["description"] = BlueprintValue(m_description);
     
     // 序列化输入值
-    for (const auto& pair : m_inputValues) {
-        data["input_" + pair.first] = pair.second;
+    for (size_t i = 0; i < m_inputPorts.size(); ++i) {
+        if (!m_inputValues[i].isEmpty()) {
+            data["input_" + m_inputPorts[i].id] = m_inputValues[i];
+        }
     }
     
     return data;
@@ -196,39 +194,48 @@ bool BaseNode::deserialize(const std::map<std::string, BlueprintValue>& data) {
         // 反序列化输入值
         for (const auto& pair : data) {
             if (pair.first.substr(0, 6) == "input_") {
-                std::string portId = pair.first.substr(6);
-                m_inputValues[portId] = pair.second;
+                int slot = findInputSlot(pair.first.substr(6));
+                if (slot >= 0) {
+                    m_inputValues[slot] = pair.second;
+                }
             }
         }
         
         return true;
     } catch (const std::exception& e) {
-        Logger::error("Failed to deserialize node " + m_id + ": " + e.what());
+        Logger::error("Failed to deserialize node {}: {}", m_id, e.what());
         return false;
     }
 }
 
-void BaseNode::addInputPort(const std::string& id, const std::string& name, DataType type, bool required) {
+int BaseNode::addInputPort(const std::string& id, const std::string& name, DataType type, bool required) {
     NodePort port(id, name, type, PortType::Input);
     port.isRequired = required;
     port.defaultValue = DataTypeUtils::getDefaultValue(type);
     m_inputPorts.push_back(port);
-    Logger::debug("Added input port: " + id + " to node " + m_id);
+    m_inputValues.emplace_back();
+    ONEDAY_LOG_DEBUG("Added input port: {} to node {}", id, m_id);
+    return static_cast<int>(m_inputPorts.size()) - 1;
 }
 
-void BaseNode::addOutputPort(const std::string& id, const std::string& name, DataType type) {
+int BaseNode::addOutputPort(const std::string& id, const std::string& name, DataType type) {
     NodePort port(id, name, type, PortType::Output);
+    // 执行流输出默认处于未触发状态
+    port.defaultValue = type == DataType::Execution ? BlueprintValue(ExecutionToken(false))
+                                                    : DataTypeUtils::getDefaultValue(type);
     m_outputPorts.push_back(port);
-    Logger::debug("Added output port: " + id + " to node " + m_id);
+    m_outputValues.push_back(port.defaultValue);
+    ONEDAY_LOG_DEBUG("Added output port: {} to node {}", id, m_id);
+    return static_cast<int>(m_outputPorts.size()) - 1;
 }
 
 void BaseNode::setOutputValue(const std::string& portId, const BlueprintValue& value) {
-    const NodePort* port = findOutputPort(portId);
-    if (port) {
-        m_outputValues[portId] = value;
-        Logger::debug("Set output value for port " + portId + " in node " + m_id);
+    int slot = findOutputSlot(portId);
+    if (slot >= 0) {
+        m_outputValues[slot] = value;
+        ONEDAY_LOG_DEBUG("Set output value for port {} in node {}", portId, m_id);
     } else {
-        Logger::error("Output port " + portId + " not found in node " + m_id);
+        Logger::error("Output port {} not found in node {}", portId, m_id);
     }
 }
 
@@ -76,7 +76,7 @@ struct NodeExecutionResult {
     bool success = false;           ///< 是否执行成功
     std::string errorMessage;       ///< 错误信息
     double executionTime = 0.0;     ///< 执行时间（毫秒）
-    std::map<std::string, BlueprintValue> outputValues; ///< 输出值
+    double suspendTime = 0.0;       ///< 挂起时间（秒），大于0时执行流在该时间后才继续（仅执行流节点）
 };
 
 /**
@@ -186,25 +186,61 @@ public:
     const NodePort* findOutputPort(const std::string& portId) const;
     
     /**
-     * @brief 设置输入值
+     * @brief 根据ID查找输入端口槽位
+     * @return 槽位索引，不存在返回-1
+     */
+    int findInputSlot(const std::string& portId) const;
+    
+    /**
+     * @brief 根据ID查找输出端口槽位
+     * @return 槽位索引，不存在返回-1
+     */
+    int findOutputSlot(const std::string& portId) const;
+    
+    /**
+     * @brief 设置输入值（按端口ID，编辑器和序列化使用）
      */
     void setInputValue(const std::string& portId, const BlueprintValue& value);
     
     /**
-     * @brief 获取输入值
+     * @brief 设置输入值（按槽位，执行路径使用）
+     */
+    void setInputValue(int slot, const BlueprintValue& value);
+    
+    /**
+     * @brief 获取输入值（按端口ID）
      */
     BlueprintValue getInputValue(const std::string& portId) const;
     
     /**
-     * @brief 获取输出值
+     * @brief 获取输入值（按槽位），未设置时返回端口默认值
+     */
+    const BlueprintValue& getInputValue(int slot) const;
+    
+    /**
+     * @brief 获取输出值（按端口ID）
      */
     BlueprintValue getOutputValue(const std::string& portId) const;
     
+    /**
+     * @brief 获取输出值（按槽位）
+     */
+    const BlueprintValue& getOutputValue(int slot) const {
+        return m_outputValues[slot];
+    }
+    
     /**
      * @brief 检查是否可以执行
      */
     virtual bool canExecute() const;
     
+    /**
+     * @brief 是否可以与同一波前的其他纯数据节点并行执行
+     *
+     * 默认不可以；只读取输入端口、不访问执行上下文和其他共享状态的节点重写为 true。
+     */
+    virtual bool isParallelSafe() const { return false; }
+    
     /**
      * @brief 执行节点
      */
@@ -238,26 +274,35 @@ public:
 protected:
     /**
      * @brief 添加输入端口
+     * @return 端口槽位索引（按声明顺序从0递增）
      */
-    void addInputPort(const std::string& id, const std::string& name, DataType type, bool required = false);
+    int addInputPort(const std::string& id, const std::string& name, DataType type, bool required = false);
     
     /**
      * @brief 添加输出端口
+     * @return 端口槽位索引（按声明顺序从0递增）
      */
-    void addOutputPort(const std::string& id, const std::string& name, DataType type);
+    int addOutputPort(const std::string& id, const std::string& name, DataType type);
     
     /**
-     * @brief 设置输出值
+     * @brief 设置输出值（按端口ID）
      */
     void setOutputValue(const std::string& portId, const BlueprintValue& value);
     
+    /**
+     * @brief 设置输出值（按槽位）
+     */
+    void setOutputValue(int slot, BlueprintValue value) {
+        m_outputValues[slot] = std::move(value);
+    }
+    
     /**
      * @brief 执行节点逻辑（子类实现）
      */
     virtual NodeExecutionResult executeInternal(ExecutionContext& context) = 0;
     
     /**
-     * @brief 初始化端口（子类实现）
+     * @brief 初始化端口（子类实现，须在派生类构造函数中调用）
      */
     virtual void initializePorts() = 0;
 
@@ -271,8 +316,9 @@ private:
     std::vector<NodePort> m_inputPorts;                 ///< 输入端口列表
     std::vector<NodePort> m_outputPorts;                ///< 输出端口列表
     
-    std::map<std::string, BlueprintValue> m_inputValues;  ///< 输入值缓存
-    std::map<std::string, BlueprintValue> m_outputValues; ///< 输出值缓存
+    // 端口值按槽位连续存放，与端口列表一一对应
+    std::vector<BlueprintValue> m_inputValues;          ///< 输入值（空值表示未设置）
+    std::vector<BlueprintValue> m_outputValues;         ///< 输出值
 };
 
 /**
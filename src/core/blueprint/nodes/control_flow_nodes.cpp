@@ -1,8 +1,7 @@
 #include "control_flow_nodes.h"
 #include "../execution_context.h"
 #include "../../common/logger.h"
-#include <thread>
-#include <chrono>
+#include <algorithm>
 
 using oneday::core::Logger;
 
@@ -10,10 +9,30 @@ namespace oneday {
 namespace core {
 namespace blueprint {
 
+namespace {
+
+// 端口槽位，与对应节点 initializePorts() 中的声明顺序一致
+constexpr int kStartExecOut = 0;     // StartNode
+constexpr int kBranchCondition = 1;  // BranchNode
+constexpr int kBranchTrue = 0;
+constexpr int kBranchFalse = 1;
+constexpr int kLoopCount = 1;        // LoopNode
+constexpr int kLoopBody = 0;
+constexpr int kLoopCompleted = 1;
+constexpr int kLoopIndex = 2;
+constexpr int kDelayTime = 1;        // DelayNode
+constexpr int kDelayExecOut = 0;
+constexpr int kGateOpen = 1;         // GateNode
+constexpr int kGateExecOut = 0;
+
+}  // namespace
+
+
 // StartNode 实现
 
 StartNode::StartNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Start) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> StartNode::clone() const {
@@ -25,7 +44,7 @@ NodeExecutionResult StartNode::executeInternal(ExecutionContext& context) {
     result.success = true;
     
     // 设置执行流输出
-    setOutputValue("exec_out", BlueprintValue(ExecutionToken(true)));
+    setOutputValue(kStartExecOut, BlueprintValue(ExecutionToken(true)));
     
     Logger::info("Start node executed");
     return result;
@@ -40,6 +59,7 @@ void StartNode::initializePorts() {
 
 EndNode::EndNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::End) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> EndNode::clone() const {
@@ -63,6 +83,7 @@ void EndNode::initializePorts() {
 
 BranchNode::BranchNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Branch) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> BranchNode::clone() const {
@@ -74,7 +95,7 @@ NodeExecutionResult BranchNode::executeInternal(ExecutionContext& context) {
     result.success = true;
     
     // 获取条件值
-    BlueprintValue conditionValue = getInputValue("condition");
+    const BlueprintValue& conditionValue = getInputValue(kBranchCondition);
     bool condition = false;
     
     if (conditionValue.is<bool>()) {
@@ -89,13 +110,13 @@ NodeExecutionResult BranchNode::executeInternal(ExecutionContext& context) {
     
     // 根据条件设置输出
     if (condition) {
-        setOutputValue("true_exec", BlueprintValue(ExecutionToken(true)));
-        setOutputValue("false_exec", BlueprintValue(ExecutionToken(false)));
-        Logger::debug("Branch node: condition is true");
+        setOutputValue(kBranchTrue, BlueprintValue(ExecutionToken(true)));
+        setOutputValue(kBranchFalse, BlueprintValue(ExecutionToken(false)));
+        ONEDAY_LOG_DEBUG("Branch node: condition is true");
     } else {
-        setOutputValue("true_exec", BlueprintValue(ExecutionToken(false)));
-        setOutputValue("false_exec", BlueprintValue(ExecutionToken(true)));
-        Logger::debug("Branch node: condition is false");
+        setOutputValue(kBranchTrue, BlueprintValue(ExecutionToken(false)));
+        setOutputValue(kBranchFalse, BlueprintValue(ExecutionToken(true)));
+        ONEDAY_LOG_DEBUG("Branch node: condition is false");
     }
     
     return result;
@@ -113,6 +134,7 @@ void BranchNode::initializePorts() {
 
 LoopNode::LoopNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Loop) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> LoopNode::clone() const {
@@ -130,24 +152,24 @@ NodeExecutionResult LoopNode::executeInternal(ExecutionContext& context) {
     result.success = true;
     
     // 获取循环次数
-    BlueprintValue countValue = getInputValue("count");
+    const BlueprintValue& countValue = getInputValue(kLoopCount);
     if (countValue.is<int>()) {
         m_loopCount = std::max(1, countValue.get<int>());
     }
     
     // 设置当前索引输出
-    setOutputValue("index", BlueprintValue(m_currentIndex));
+    setOutputValue(kLoopIndex, BlueprintValue(m_currentIndex));
     
     // 检查是否继续循环
     if (m_currentIndex < m_loopCount) {
-        setOutputValue("loop_body", BlueprintValue(ExecutionToken(true)));
-        setOutputValue("completed", BlueprintValue(ExecutionToken(false)));
+        setOutputValue(kLoopBody, BlueprintValue(ExecutionToken(true)));
+        setOutputValue(kLoopCompleted, BlueprintValue(ExecutionToken(false)));
         m_currentIndex++;
-        Logger::debug("Loop node: iteration " + std::to_string(m_currentIndex) + "/" + std::to_string(m_loopCount));
+        ONEDAY_LOG_DEBUG("Loop node: iteration {}/{}", m_currentIndex, m_loopCount);
     } else {
-        setOutputValue("loop_body", BlueprintValue(ExecutionToken(false)));
-        setOutputValue("completed", BlueprintValue(ExecutionToken(true)));
-        Logger::debug("Loop node: completed");
+        setOutputValue(kLoopBody, BlueprintValue(ExecutionToken(false)));
+        setOutputValue(kLoopCompleted, BlueprintValue(ExecutionToken(true)));
+        ONEDAY_LOG_DEBUG("Loop node: completed");
     }
     
     return result;
@@ -171,6 +193,7 @@ void LoopNode::reset() {
 
 DelayNode::DelayNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Delay) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> DelayNode::clone() const {
@@ -188,19 +211,19 @@ NodeExecutionResult DelayNode::executeInternal(ExecutionContext& context) {
     result.success = true;
     
     // 获取延迟时间
-    BlueprintValue delayValue = getInputValue("delay");
+    const BlueprintValue& delayValue = getInputValue(kDelayTime);
     if (delayValue.is<float>()) {
         m_delayTime = std::max(0.0f, delayValue.get<float>());
     }
     
-    // 执行延迟
+    // 不阻塞执行线程：请求引擎挂起执行流，到时间后再从 exec_out 继续
     if (m_delayTime > 0.0f) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(m_delayTime * 1000)));
-        Logger::debug("Delay node: waited " + std::to_string(m_delayTime) + " seconds");
+        result.suspendTime = m_delayTime;
+        ONEDAY_LOG_DEBUG("Delay node: suspending for {} seconds", m_delayTime);
     }
     
     // 设置输出
-    setOutputValue("exec_out", BlueprintValue(ExecutionToken(true)));
+    setOutputValue(kDelayExecOut, BlueprintValue(ExecutionToken(true)));
     
     return result;
 }
@@ -217,6 +240,7 @@ void DelayNode::initializePorts() {
 SequenceNode::SequenceNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Sequence");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> SequenceNode::clone() const {
@@ -236,12 +260,12 @@ NodeExecutionResult SequenceNode::executeInternal(ExecutionContext& context) {
     result.success = true;
     
     // 按顺序激活所有输出
+    // 输出端口按序号声明，槽位即序号
     for (int i = 0; i < m_outputCount; ++i) {
-        std::string portId = "exec_out_" + std::to_string(i);
-        setOutputValue(portId, BlueprintValue(ExecutionToken(true)));
+        setOutputValue(i, BlueprintValue(ExecutionToken(true)));
     }
     
-    Logger::debug("Sequence node: activated " + std::to_string(m_outputCount) + " outputs");
+    ONEDAY_LOG_DEBUG("Sequence node: activated {} outputs", m_outputCount);
     return result;
 }
 
@@ -260,6 +284,7 @@ void SequenceNode::initializePorts() {
 GateNode::GateNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Gate");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> GateNode::clone() const {
@@ -277,18 +302,18 @@ NodeExecutionResult GateNode::executeInternal(ExecutionContext& context) {
     result.success = true;
     
     // 获取门的状态
-    BlueprintValue openValue = getInputValue("open");
+    const BlueprintValue& openValue = getInputValue(kGateOpen);
     if (openValue.is<bool>()) {
         m_isOpen = openValue.get<bool>();
     }
     
     // 根据门的状态决定是否通过执行流
     if (m_isOpen) {
-        setOutputValue("exec_out", BlueprintValue(ExecutionToken(true)));
-        Logger::debug("Gate node: gate is open, execution continues");
+        setOutputValue(kGateExecOut, BlueprintValue(ExecutionToken(true)));
+        ONEDAY_LOG_DEBUG("Gate node: gate is open, execution continues");
     } else {
-        setOutputValue("exec_out", BlueprintValue(ExecutionToken(false)));
-        Logger::debug("Gate node: gate is closed, execution blocked");
+        setOutputValue(kGateExecOut, BlueprintValue(ExecutionToken(false)));
+        ONEDAY_LOG_DEBUG("Gate node: gate is closed, execution blocked");
     }
     
     return result;
@@ -82,6 +82,8 @@ private:
 
 /**
  * @brief 延迟节点 - 延迟指定时间后继续执行
+ *
+ * 不阻塞执行线程：节点返回挂起时间，由引擎（或 AsyncScheduler）在到期后恢复执行流。
  */
 class DelayNode : public BaseNode {
 public:
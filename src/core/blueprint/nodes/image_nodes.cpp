@@ -0,0 +1,125 @@
+#include "image_nodes.h"
+#include "../execution_context.h"
+#include "../../common/logger.h"
+#include "../../image/template_matcher.h"
+
+using oneday::core::Logger;
+
+namespace oneday {
+namespace core {
+namespace blueprint {
+
+namespace {
+
+// 端口槽位，与 initializePorts() 中的声明顺序一致
+constexpr int kExecIn = 0;
+constexpr int kFrame = 1;
+constexpr int kTemplate = 2;
+constexpr int kExecOut = 0;
+constexpr int kFound = 1;
+constexpr int kPosition = 2;
+constexpr int kScore = 3;
+
+}  // namespace
+
+// TemplateMatchNode 实现
+
+TemplateMatchNode::TemplateMatchNode(const std::string& id)
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
+    setName("Template Match");
+    initializePorts();
+}
+
+std::unique_ptr<BaseNode> TemplateMatchNode::clone() const {
+    auto cloned = std::make_unique<TemplateMatchNode>();
+    cloned->m_matcher = m_matcher;
+    cloned->m_templateName = m_templateName;
+    return cloned;
+}
+
+void TemplateMatchNode::setMatcher(std::shared_ptr<image::TemplateMatcher> matcher) {
+    m_matcher = std::move(matcher);
+}
+
+void TemplateMatchNode::setTemplateName(const std::string& name) {
+    m_templateName = name;
+}
+
+NodeExecutionResult TemplateMatchNode::executeInternal(ExecutionContext& context) {
+    NodeExecutionResult result;
+    result.success = true;
+
+    const BlueprintValue& execInput = getInputValue(kExecIn);
+    if (!execInput.is<ExecutionToken>() || !execInput.get<ExecutionToken>().valid) {
+        result.success = false;
+        result.errorMessage = "Invalid execution input";
+        return result;
+    }
+
+    if (!m_matcher) {
+        result.success = false;
+        result.errorMessage = "Template matcher is not set";
+        return result;
+    }
+
+    const ObjectReference* frameInput = getInputValue(kFrame).getIf<ObjectReference>();
+    if (frameInput == nullptr || !*frameInput) {
+        result.success = false;
+        result.errorMessage = "Invalid frame input";
+        return result;
+    }
+    const std::shared_ptr<const cv::Mat> frame = frameInput->as<const cv::Mat>();
+    if (!frame) {
+        result.success = false;
+        result.errorMessage = "Frame input is not a cv::Mat";
+        Logger::error("Template match node: frame input is not a cv::Mat ({})",
+                      frameInput->type().name());
+        return result;
+    }
+    if (frame->empty()) {
+        result.success = false;
+        result.errorMessage = "Invalid frame input";
+        return result;
+    }
+
+    const std::string* nameInput = getInputValue(kTemplate).getIf<std::string>();
+    const std::string& name = nameInput && !nameInput->empty() ? *nameInput : m_templateName;
+    if (!m_matcher->hasTemplate(name)) {
+        result.success = false;
+        result.errorMessage = "Template not found: " + name;
+        Logger::error("Template match node: template not found: {}", name);
+        return result;
+    }
+
+    if (!m_matcher->setFrame(frame)) {
+        result.success = false;
+        result.errorMessage = "Failed to prepare frame";
+        return result;
+    }
+    const image::TemplateMatch match = m_matcher->match(name);
+
+    const cv::Rect& location = match.location;
+    setOutputValue(kExecOut, BlueprintValue(ExecutionToken(true)));
+    setOutputValue(kFound, BlueprintValue(match.found));
+    setOutputValue(kPosition, BlueprintValue(Vector2(location.x + location.width * 0.5f,
+                                                     location.y + location.height * 0.5f)));
+    setOutputValue(kScore, BlueprintValue(static_cast<float>(match.score)));
+
+    ONEDAY_LOG_DEBUG("Template match node: {} found={} score={:.3f}", name, match.found, match.score);
+    return result;
+}
+
+void TemplateMatchNode::initializePorts() {
+    addInputPort("exec_in", "Execute", DataType::Execution, true);
+    addInputPort("frame", "Frame", DataType::Object, true);
+    addInputPort("template", "Template", DataType::String, false);
+
+    addOutputPort("exec_out", "Execute", DataType::Execution);
+    addOutputPort("found", "Found", DataType::Boolean);
+    addOutputPort("position", "Position", DataType::Vector2);
+    addOutputPort("score", "Score", DataType::Float);
+}
+
+} // namespace blueprint
+} // namespace core
+} // namespace oneday
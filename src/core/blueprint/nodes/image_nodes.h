@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+
+#include "base_node.h"
+
+namespace oneday {
+namespace image {
+class TemplateMatcher;
+}  // namespace image
+
+namespace core {
+namespace blueprint {
+
+/**
+ * @brief 模板匹配节点 - 在帧中查找已注册的模板
+ *
+ * frame 输入是由 std::shared_ptr<cv::Mat> 构造的对象引用，其他类型的对象报节点错误。
+ * 同一帧对象只构建一次帧金字塔，因此多个共用匹配器的节点在同一帧上依次执行时
+ * 不会重复预处理。
+ * 输出的 position 为匹配区域中心（原帧像素坐标）。
+ */
+class TemplateMatchNode : public BaseNode {
+public:
+    explicit TemplateMatchNode(const std::string& id = "");
+
+    std::unique_ptr<BaseNode> clone() const override;
+
+    /**
+     * @brief 设置使用的模板匹配器（可由多个节点共享）
+     */
+    void setMatcher(std::shared_ptr<image::TemplateMatcher> matcher);
+
+    /**
+     * @brief 设置默认模板名（template 输入为空时使用）
+     */
+    void setTemplateName(const std::string& name);
+
+    /**
+     * @brief 获取默认模板名
+     */
+    const std::string& getTemplateName() const { return m_templateName; }
+
+protected:
+    NodeExecutionResult executeInternal(ExecutionContext& context) override;
+    void initializePorts() override;
+
+private:
+    std::shared_ptr<image::TemplateMatcher> m_matcher;  ///< 模板匹配器
+    std::string m_templateName;                         ///< 默认模板名
+};
+
+} // namespace blueprint
+} // namespace core
+} // namespace oneday
@@ -9,10 +9,28 @@ namespace oneday {
 namespace core {
 namespace blueprint {
 
+namespace {
+
+// 端口槽位，与对应节点 initializePorts() 中的声明顺序一致
+constexpr int kInputA = 0;           // 二元运算节点
+constexpr int kInputB = 1;
+constexpr int kInputSingle = 0;      // NotNode / IsTypeNode
+constexpr int kSelectCondition = 0;  // SelectNode
+constexpr int kSelectTrue = 1;
+constexpr int kSelectFalse = 2;
+constexpr int kRangeValue = 0;       // InRangeNode
+constexpr int kRangeMin = 1;
+constexpr int kRangeMax = 2;
+constexpr int kOutputResult = 0;     // 所有节点的唯一输出
+
+}  // namespace
+
 // AndNode 实现
 
 AndNode::AndNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::And) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::And) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> AndNode::clone() const {
     return std::make_unique<AndNode>();
@@ -22,14 +40,13 @@ NodeExecutionResult AndNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    bool a = getInputValue("a").get<bool>();
-    bool b = getInputValue("b").get<bool>();
+    bool a = getInputValue(kInputA).get<bool>();
+    bool b = getInputValue(kInputB).get<bool>();
     bool output = a && b;
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("And node: " + std::to_string(a) + " && " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("And node: {} && {} = {}", a, b, output);
     return result;
 }
 
@@ -42,7 +59,9 @@ void AndNode::initializePorts() {
 // OrNode 实现
 
 OrNode::OrNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Or) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Or) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> OrNode::clone() const {
     return std::make_unique<OrNode>();
@@ -52,14 +71,13 @@ NodeExecutionResult OrNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    bool a = getInputValue("a").get<bool>();
-    bool b = getInputValue("b").get<bool>();
+    bool a = getInputValue(kInputA).get<bool>();
+    bool b = getInputValue(kInputB).get<bool>();
     bool output = a || b;
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Or node: " + std::to_string(a) + " || " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Or node: {} || {} = {}", a, b, output);
     return result;
 }
 
@@ -72,7 +90,9 @@ void OrNode::initializePorts() {
 // NotNode 实现
 
 NotNode::NotNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Not) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Not) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> NotNode::clone() const {
     return std::make_unique<NotNode>();
@@ -82,12 +102,12 @@ NodeExecutionResult NotNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    bool input = getInputValue("input").get<bool>();
+    bool input = getInputValue(kInputSingle).get<bool>();
     bool output = !input;
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Not node: !" + std::to_string(input) + " = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Not node: !{} = {}", input, output);
     return result;
 }
 
@@ -99,7 +119,9 @@ void NotNode::initializePorts() {
 // CompareNode 实现
 
 CompareNode::CompareNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Compare) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Compare) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> CompareNode::clone() const {
     auto cloned = std::make_unique<CompareNode>();
@@ -115,13 +137,13 @@ NodeExecutionResult CompareNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    BlueprintValue a = getInputValue("a");
-    BlueprintValue b = getInputValue("b");
+    const BlueprintValue& a = getInputValue(kInputA);
+    const BlueprintValue& b = getInputValue(kInputB);
 
     bool comparisonResult = performComparison(a, b);
-    setOutputValue("result", BlueprintValue(comparisonResult));
+    setOutputValue(kOutputResult, BlueprintValue(comparisonResult));
 
-    Logger::debug("Compare node: comparison result = " + std::to_string(comparisonResult));
+    ONEDAY_LOG_DEBUG("Compare node: comparison result = {}", comparisonResult);
     return result;
 }
 
@@ -207,6 +229,7 @@ bool CompareNode::performComparison(const BlueprintValue& a, const BlueprintValu
 XorNode::XorNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Xor");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> XorNode::clone() const {
@@ -217,14 +240,13 @@ NodeExecutionResult XorNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    bool a = getInputValue("a").get<bool>();
-    bool b = getInputValue("b").get<bool>();
+    bool a = getInputValue(kInputA).get<bool>();
+    bool b = getInputValue(kInputB).get<bool>();
     bool output = a ^ b;  // 异或操作
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Xor node: " + std::to_string(a) + " ^ " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Xor node: {} ^ {} = {}", a, b, output);
     return result;
 }
 
@@ -239,6 +261,7 @@ void XorNode::initializePorts() {
 SelectNode::SelectNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Select");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> SelectNode::clone() const {
@@ -249,14 +272,14 @@ NodeExecutionResult SelectNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    bool condition = getInputValue("condition").get<bool>();
-    BlueprintValue trueValue = getInputValue("true_value");
-    BlueprintValue falseValue = getInputValue("false_value");
+    bool condition = getInputValue(kSelectCondition).get<bool>();
+    const BlueprintValue& trueValue = getInputValue(kSelectTrue);
+    const BlueprintValue& falseValue = getInputValue(kSelectFalse);
 
     BlueprintValue selectedValue = condition ? trueValue : falseValue;
-    setOutputValue("result", selectedValue);
+    setOutputValue(kOutputResult, selectedValue);
 
-    Logger::debug("Select node: selected " + std::string(condition ? "true" : "false") + " value");
+    ONEDAY_LOG_DEBUG("Select node: selected {} value", condition ? "true" : "false");
     return result;
 }
 
@@ -272,6 +295,7 @@ void SelectNode::initializePorts() {
 InRangeNode::InRangeNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("In Range");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> InRangeNode::clone() const {
@@ -287,29 +311,28 @@ NodeExecutionResult InRangeNode::executeInternal(ExecutionContext& context) {
     float maxValue = 0.0f;
 
     // 获取并转换值
-    BlueprintValue valueInput = getInputValue("value");
+    const BlueprintValue& valueInput = getInputValue(kRangeValue);
     if (valueInput.is<int>())
         value = static_cast<float>(valueInput.get<int>());
     else if (valueInput.is<float>())
         value = valueInput.get<float>();
 
-    BlueprintValue minInput = getInputValue("min");
+    const BlueprintValue& minInput = getInputValue(kRangeMin);
     if (minInput.is<int>())
         minValue = static_cast<float>(minInput.get<int>());
     else if (minInput.is<float>())
         minValue = minInput.get<float>();
 
-    BlueprintValue maxInput = getInputValue("max");
+    const BlueprintValue& maxInput = getInputValue(kRangeMax);
     if (maxInput.is<int>())
         maxValue = static_cast<float>(maxInput.get<int>());
     else if (maxInput.is<float>())
         maxValue = maxInput.get<float>();
 
     bool inRange = (value >= minValue) && (value <= maxValue);
-    setOutputValue("result", BlueprintValue(inRange));
+    setOutputValue(kOutputResult, BlueprintValue(inRange));
 
-    Logger::debug("In Range node: " + std::to_string(value) + " in [" + std::to_string(minValue) +
-                  ", " + std::to_string(maxValue) + "] = " + std::to_string(inRange));
+    ONEDAY_LOG_DEBUG("In Range node: {} in [{}, {}] = {}", value, minValue, maxValue, inRange);
     return result;
 }
 
@@ -325,6 +348,7 @@ void InRangeNode::initializePorts() {
 IsTypeNode::IsTypeNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Is Type");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> IsTypeNode::clone() const {
@@ -341,14 +365,14 @@ NodeExecutionResult IsTypeNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    BlueprintValue input = getInputValue("input");
+    const BlueprintValue& input = getInputValue(kInputSingle);
     bool isTargetType = (input.getType() == m_targetType);
 
-    setOutputValue("result", BlueprintValue(isTargetType));
+    setOutputValue(kOutputResult, BlueprintValue(isTargetType));
 
-    Logger::debug("Is Type node: input type is " + DataTypeUtils::getTypeName(input.getType()) +
-                  ", target type is " + DataTypeUtils::getTypeName(m_targetType) +
-                  ", result = " + std::to_string(isTargetType));
+    ONEDAY_LOG_DEBUG("Is Type node: input type is {}, target type is {}, result = {}",
+                     DataTypeUtils::getTypeName(input.getType()),
+                     DataTypeUtils::getTypeName(m_targetType), isTargetType);
     return result;
 }
 
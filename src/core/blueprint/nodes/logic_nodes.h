@@ -14,6 +14,7 @@ public:
     explicit AndNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -28,6 +29,7 @@ public:
     explicit OrNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -42,6 +44,7 @@ public:
     explicit NotNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -68,6 +71,7 @@ public:
     explicit CompareNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
     
     /**
      * @brief 设置比较操作类型
@@ -100,6 +104,7 @@ public:
     explicit XorNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -114,6 +119,7 @@ public:
     explicit MultiAndNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
     
     /**
      * @brief 设置输入数量
@@ -136,6 +142,7 @@ public:
     explicit MultiOrNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
     
     /**
      * @brief 设置输入数量
@@ -158,6 +165,7 @@ public:
     explicit SelectNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -172,6 +180,7 @@ public:
     explicit InRangeNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -186,6 +195,7 @@ public:
     explicit IsTypeNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
     
     /**
      * @brief 设置要检查的类型
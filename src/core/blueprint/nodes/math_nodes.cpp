@@ -13,6 +13,41 @@ namespace oneday {
 namespace core {
 namespace blueprint {
 
+namespace {
+
+// 端口槽位，与对应节点 initializePorts() 中的声明顺序一致
+constexpr int kInputA = 0;         // 二元运算节点
+constexpr int kInputB = 1;
+constexpr int kInputT = 2;         // LerpNode
+constexpr int kInputSingle = 0;    // SqrtNode / AbsNode / TrigNode
+constexpr int kInputBase = 0;      // PowerNode
+constexpr int kInputExponent = 1;
+constexpr int kClampValue = 0;     // ClampNode
+constexpr int kClampMin = 1;
+constexpr int kClampMax = 2;
+constexpr int kRandomMin = 0;      // RandomNode
+constexpr int kRandomMax = 1;
+constexpr int kOutputResult = 0;   // 标量节点的唯一输出 / VectorMathNode 的向量输出
+constexpr int kOutputScalar = 1;   // VectorMathNode 的标量输出
+
+}  // namespace
+
+// 辅助函数：读取向量（Vector2 提升为 z=0 的 Vector3）
+bool getVectorValue(const BlueprintValue& value, Vector3& out, bool& is2D) {
+    if (value.is<Vector3>()) {
+        out = value.get<Vector3>();
+        is2D = false;
+        return true;
+    }
+    if (value.is<Vector2>()) {
+        Vector2 v = value.get<Vector2>();
+        out = Vector3(v.x, v.y, 0.0f);
+        is2D = true;
+        return true;
+    }
+    return false;
+}
+
 // 辅助函数：获取数值（支持int和float）
 float getNumericValue(const BlueprintValue& value) {
     if (value.is<int>()) {
@@ -26,7 +61,9 @@ float getNumericValue(const BlueprintValue& value) {
 // AddNode 实现
 
 AddNode::AddNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Add) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Add) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> AddNode::clone() const {
     return std::make_unique<AddNode>();
@@ -36,14 +73,13 @@ NodeExecutionResult AddNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
     float output = a + b;
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Add node: " + std::to_string(a) + " + " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Add node: {} + {} = {}", a, b, output);
     return result;
 }
 
@@ -56,7 +92,9 @@ void AddNode::initializePorts() {
 // SubtractNode 实现
 
 SubtractNode::SubtractNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Subtract) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Subtract) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> SubtractNode::clone() const {
     return std::make_unique<SubtractNode>();
@@ -66,14 +104,13 @@ NodeExecutionResult SubtractNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
     float output = a - b;
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Subtract node: " + std::to_string(a) + " - " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Subtract node: {} - {} = {}", a, b, output);
     return result;
 }
 
@@ -86,7 +123,9 @@ void SubtractNode::initializePorts() {
 // MultiplyNode 实现
 
 MultiplyNode::MultiplyNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Multiply) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Multiply) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> MultiplyNode::clone() const {
     return std::make_unique<MultiplyNode>();
@@ -96,14 +135,13 @@ NodeExecutionResult MultiplyNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
     float output = a * b;
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Multiply node: " + std::to_string(a) + " * " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Multiply node: {} * {} = {}", a, b, output);
     return result;
 }
 
@@ -116,7 +154,9 @@ void MultiplyNode::initializePorts() {
 // DivideNode 实现
 
 DivideNode::DivideNode(const std::string& id)
-    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Divide) {}
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Divide) {
+    initializePorts();
+}
 
 std::unique_ptr<BaseNode> DivideNode::clone() const {
     return std::make_unique<DivideNode>();
@@ -126,8 +166,8 @@ NodeExecutionResult DivideNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
 
     if (std::abs(b) < 1e-6f) {
         result.success = false;
@@ -137,10 +177,9 @@ NodeExecutionResult DivideNode::executeInternal(ExecutionContext& context) {
     }
 
     float output = a / b;
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Divide node: " + std::to_string(a) + " / " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Divide node: {} / {} = {}", a, b, output);
     return result;
 }
 
@@ -155,6 +194,7 @@ void DivideNode::initializePorts() {
 ModuloNode::ModuloNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Modulo");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> ModuloNode::clone() const {
@@ -165,8 +205,8 @@ NodeExecutionResult ModuloNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    int a = getInputValue("a").get<int>();
-    int b = getInputValue("b").get<int>();
+    int a = getInputValue(kInputA).get<int>();
+    int b = getInputValue(kInputB).get<int>();
 
     if (b == 0) {
         result.success = false;
@@ -176,10 +216,9 @@ NodeExecutionResult ModuloNode::executeInternal(ExecutionContext& context) {
     }
 
     int output = a % b;
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Modulo node: " + std::to_string(a) + " % " + std::to_string(b) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Modulo node: {} % {} = {}", a, b, output);
     return result;
 }
 
@@ -194,6 +233,7 @@ void ModuloNode::initializePorts() {
 PowerNode::PowerNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Power");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> PowerNode::clone() const {
@@ -204,8 +244,8 @@ NodeExecutionResult PowerNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float base = getNumericValue(getInputValue("base"));
-    float exponent = getNumericValue(getInputValue("exponent"));
+    float base = getNumericValue(getInputValue(kInputBase));
+    float exponent = getNumericValue(getInputValue(kInputExponent));
 
     float output = std::pow(base, exponent);
 
@@ -216,10 +256,9 @@ NodeExecutionResult PowerNode::executeInternal(ExecutionContext& context) {
         return result;
     }
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Power node: " + std::to_string(base) + " ^ " + std::to_string(exponent) + " = " +
-                  std::to_string(output));
+    ONEDAY_LOG_DEBUG("Power node: {} ^ {} = {}", base, exponent, output);
     return result;
 }
 
@@ -234,6 +273,7 @@ void PowerNode::initializePorts() {
 SqrtNode::SqrtNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Square Root");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> SqrtNode::clone() const {
@@ -244,7 +284,7 @@ NodeExecutionResult SqrtNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float input = getNumericValue(getInputValue("input"));
+    float input = getNumericValue(getInputValue(kInputSingle));
 
     if (input < 0.0f) {
         result.success = false;
@@ -254,9 +294,9 @@ NodeExecutionResult SqrtNode::executeInternal(ExecutionContext& context) {
     }
 
     float output = std::sqrt(input);
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Sqrt node: sqrt(" + std::to_string(input) + ") = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Sqrt node: sqrt({}) = {}", input, output);
     return result;
 }
 
@@ -270,6 +310,7 @@ void SqrtNode::initializePorts() {
 AbsNode::AbsNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Absolute");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> AbsNode::clone() const {
@@ -280,12 +321,12 @@ NodeExecutionResult AbsNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float input = getNumericValue(getInputValue("input"));
+    float input = getNumericValue(getInputValue(kInputSingle));
     float output = std::abs(input);
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Abs node: abs(" + std::to_string(input) + ") = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Abs node: abs({}) = {}", input, output);
     return result;
 }
 
@@ -299,6 +340,7 @@ void AbsNode::initializePorts() {
 MinNode::MinNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Minimum");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> MinNode::clone() const {
@@ -309,14 +351,13 @@ NodeExecutionResult MinNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
     float output = std::min(a, b);
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Min node: min(" + std::to_string(a) + ", " + std::to_string(b) +
-                  ") = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Min node: min({}, {}) = {}", a, b, output);
     return result;
 }
 
@@ -331,6 +372,7 @@ void MinNode::initializePorts() {
 MaxNode::MaxNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Maximum");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> MaxNode::clone() const {
@@ -341,14 +383,13 @@ NodeExecutionResult MaxNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
     float output = std::max(a, b);
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Max node: max(" + std::to_string(a) + ", " + std::to_string(b) +
-                  ") = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Max node: max({}, {}) = {}", a, b, output);
     return result;
 }
 
@@ -363,6 +404,7 @@ void MaxNode::initializePorts() {
 ClampNode::ClampNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Clamp");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> ClampNode::clone() const {
@@ -373,15 +415,14 @@ NodeExecutionResult ClampNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float value = getNumericValue(getInputValue("value"));
-    float minVal = getNumericValue(getInputValue("min"));
-    float maxVal = getNumericValue(getInputValue("max"));
+    float value = getNumericValue(getInputValue(kClampValue));
+    float minVal = getNumericValue(getInputValue(kClampMin));
+    float maxVal = getNumericValue(getInputValue(kClampMax));
 
     float output = std::clamp(value, minVal, maxVal);
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Clamp node: clamp(" + std::to_string(value) + ", " + std::to_string(minVal) +
-                  ", " + std::to_string(maxVal) + ") = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Clamp node: clamp({}, {}, {}) = {}", value, minVal, maxVal, output);
     return result;
 }
 
@@ -397,6 +438,7 @@ void ClampNode::initializePorts() {
 LerpNode::LerpNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Lerp");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> LerpNode::clone() const {
@@ -407,18 +449,17 @@ NodeExecutionResult LerpNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float a = getNumericValue(getInputValue("a"));
-    float b = getNumericValue(getInputValue("b"));
-    float t = getNumericValue(getInputValue("t"));
+    float a = getNumericValue(getInputValue(kInputA));
+    float b = getNumericValue(getInputValue(kInputB));
+    float t = getNumericValue(getInputValue(kInputT));
 
     // 限制t在[0,1]范围内
     t = std::clamp(t, 0.0f, 1.0f);
 
     float output = a + t * (b - a);
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Lerp node: lerp(" + std::to_string(a) + ", " + std::to_string(b) + ", " +
-                  std::to_string(t) + ") = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Lerp node: lerp({}, {}, {}) = {}", a, b, t, output);
     return result;
 }
 
@@ -434,6 +475,7 @@ void LerpNode::initializePorts() {
 TrigNode::TrigNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Trigonometry");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> TrigNode::clone() const {
@@ -450,7 +492,7 @@ NodeExecutionResult TrigNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float input = getNumericValue(getInputValue("input"));
+    float input = getNumericValue(getInputValue(kInputSingle));
     float output = 0.0f;
 
     switch (m_function) {
@@ -484,9 +526,9 @@ NodeExecutionResult TrigNode::executeInternal(ExecutionContext& context) {
             break;
     }
 
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Trig node: function result = " + std::to_string(output));
+    ONEDAY_LOG_DEBUG("Trig node: function result = {}", output);
     return result;
 }
 
@@ -500,6 +542,7 @@ void TrigNode::initializePorts() {
 RandomNode::RandomNode(const std::string& id)
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Random");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> RandomNode::clone() const {
@@ -510,18 +553,17 @@ NodeExecutionResult RandomNode::executeInternal(ExecutionContext& context) {
     NodeExecutionResult result;
     result.success = true;
 
-    float minVal = getNumericValue(getInputValue("min"));
-    float maxVal = getNumericValue(getInputValue("max"));
+    float minVal = getNumericValue(getInputValue(kRandomMin));
+    float maxVal = getNumericValue(getInputValue(kRandomMax));
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // 每个线程独立的随机数引擎（纯数据节点可能在线程池中并行执行）
+    thread_local std::mt19937 gen(std::random_device{}());
     std::uniform_real_distribution<float> dis(minVal, maxVal);
 
     float output = dis(gen);
-    setOutputValue("result", BlueprintValue(output));
+    setOutputValue(kOutputResult, BlueprintValue(output));
 
-    Logger::debug("Random node: generated " + std::to_string(output) + " in range [" +
-                  std::to_string(minVal) + ", " + std::to_string(maxVal) + "]");
+    ONEDAY_LOG_DEBUG("Random node: generated {} in range [{}, {}]", output, minVal, maxVal);
     return result;
 }
 
@@ -531,6 +573,103 @@ void RandomNode::initializePorts() {
     addOutputPort("result", "Result", DataType::Float);
 }
 
+// VectorMathNode 实现
+
+VectorMathNode::VectorMathNode(const std::string& id)
+    : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
+    setName("Vector Math");
+    initializePorts();
+}
+
+std::unique_ptr<BaseNode> VectorMathNode::clone() const {
+    auto cloned = std::make_unique<VectorMathNode>();
+    cloned->m_operation = m_operation;
+    return cloned;
+}
+
+void VectorMathNode::setOperation(VectorOperation op) {
+    m_operation = op;
+}
+
+NodeExecutionResult VectorMathNode::executeInternal(ExecutionContext& context) {
+    NodeExecutionResult result;
+    result.success = true;
+
+    Vector3 a;
+    Vector3 b;
+    bool aIs2D = false;
+    bool bIs2D = false;
+    if (!getVectorValue(getInputValue(kInputA), a, aIs2D)) {
+        result.success = false;
+        result.errorMessage = "Input A is not a vector";
+        return result;
+    }
+
+    const bool binary = m_operation != VectorOperation::Length &&
+                        m_operation != VectorOperation::Normalize;
+    if (binary && !getVectorValue(getInputValue(kInputB), b, bIs2D)) {
+        result.success = false;
+        result.errorMessage = "Input B is not a vector";
+        return result;
+    }
+
+    Vector3 vector;
+    float scalar = 0.0f;
+    switch (m_operation) {
+        case VectorOperation::Add:
+            vector = Vector3(a.x + b.x, a.y + b.y, a.z + b.z);
+            break;
+        case VectorOperation::Subtract:
+            vector = Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+            break;
+        case VectorOperation::Multiply:
+            vector = Vector3(a.x * b.x, a.y * b.y, a.z * b.z);
+            break;
+        case VectorOperation::Dot:
+            scalar = a.x * b.x + a.y * b.y + a.z * b.z;
+            break;
+        case VectorOperation::Cross:
+            vector = Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+            aIs2D = bIs2D = false;  // 叉积结果总是三维向量
+            break;
+        case VectorOperation::Length:
+            scalar = std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z);
+            break;
+        case VectorOperation::Normalize: {
+            scalar = std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z);
+            if (scalar > 1e-6f) {
+                vector = Vector3(a.x / scalar, a.y / scalar, a.z / scalar);
+            }
+            break;
+        }
+        case VectorOperation::Distance: {
+            float dx = a.x - b.x;
+            float dy = a.y - b.y;
+            float dz = a.z - b.z;
+            scalar = std::sqrt(dx * dx + dy * dy + dz * dz);
+            break;
+        }
+    }
+
+    // 两个输入都是二维向量时输出二维向量
+    if (aIs2D && (!binary || bIs2D)) {
+        setOutputValue(kOutputResult, BlueprintValue(Vector2(vector.x, vector.y)));
+    } else {
+        setOutputValue(kOutputResult, BlueprintValue(vector));
+    }
+    setOutputValue(kOutputScalar, BlueprintValue(scalar));
+
+    ONEDAY_LOG_DEBUG("Vector math node: scalar result = {}", scalar);
+    return result;
+}
+
+void VectorMathNode::initializePorts() {
+    addInputPort("a", "A", DataType::None, true);  // Vector2 或 Vector3
+    addInputPort("b", "B", DataType::None, false);
+    addOutputPort("result", "Result", DataType::None);
+    addOutputPort("scalar", "Scalar", DataType::Float);
+}
+
 }  // namespace blueprint
 }  // namespace core
 }  // namespace oneday
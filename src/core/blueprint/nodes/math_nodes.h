@@ -14,6 +14,7 @@ public:
     explicit AddNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -28,6 +29,7 @@ public:
     explicit SubtractNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -42,6 +44,7 @@ public:
     explicit MultiplyNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -56,6 +59,7 @@ public:
     explicit DivideNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -70,6 +74,7 @@ public:
     explicit ModuloNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -84,6 +89,7 @@ public:
     explicit PowerNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -98,6 +104,7 @@ public:
     explicit SqrtNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -112,6 +119,7 @@ public:
     explicit AbsNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -126,6 +134,7 @@ public:
     explicit MinNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -140,6 +149,7 @@ public:
     explicit MaxNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -154,6 +164,7 @@ public:
     explicit ClampNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -168,6 +179,7 @@ public:
     explicit LerpNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -194,6 +206,7 @@ public:
     explicit TrigNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
     
     /**
      * @brief 设置三角函数类型
@@ -216,6 +229,7 @@ public:
     explicit RandomNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
 
 protected:
     NodeExecutionResult executeInternal(ExecutionContext& context) override;
@@ -241,6 +255,7 @@ public:
     explicit VectorMathNode(const std::string& id = "");
     
     std::unique_ptr<BaseNode> clone() const override;
+    bool isParallelSafe() const override { return true; }
     
     /**
      * @brief 设置向量操作类型
@@ -8,20 +8,62 @@ namespace oneday {
 namespace core {
 namespace blueprint {
 
+
+namespace {
+
+// 端口槽位，与对应节点 initializePorts() 中的声明顺序一致
+constexpr int kExecIn = 0;             // 带执行流节点的执行流输入
+constexpr int kExecOut = 0;            // 带执行流节点的执行流输出
+constexpr int kNameOnly = 0;           // 纯数据节点的变量名输入
+constexpr int kNameAfterExec = 1;      // 带执行流节点的变量名输入
+constexpr int kGetValue = 0;           // GetVariableNode
+constexpr int kSetValue = 2;           // SetVariableNode
+constexpr int kSetValueOut = 1;
+constexpr int kIncrementAmount = 2;    // IncrementVariableNode
+constexpr int kIncrementNewValue = 1;
+constexpr int kExistsResult = 0;       // VariableExistsNode
+constexpr int kDeletedResult = 1;      // DeleteVariableNode
+constexpr int kAllNames = 0;           // GetAllVariablesNode
+constexpr int kAllCount = 1;
+
+VariableId resolveVariableName(const std::string& name) {
+    return name.empty() ? kInvalidVariableId : VariableNameTable::instance().intern(name);
+}
+
+/**
+ * @brief 解析要访问的变量：变量名输入优先，否则使用节点预先解析的变量ID
+ */
+VariableId resolveVariable(const BlueprintValue& nameInput, VariableId presetId) {
+    const std::string* name = nameInput.getIf<std::string>();
+    return name && !name->empty() ? resolveVariableName(*name) : presetId;
+}
+
+/**
+ * @brief 变量名（仅用于日志输出）
+ */
+[[maybe_unused]] const std::string& variableName(VariableId id) {
+    return VariableNameTable::instance().getName(id);
+}
+
+}  // namespace
+
 // GetVariableNode 实现
 
 GetVariableNode::GetVariableNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::GetVariable) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> GetVariableNode::clone() const {
     auto cloned = std::make_unique<GetVariableNode>();
     cloned->m_variableName = m_variableName;
+    cloned->m_variableId = m_variableId;
     return cloned;
 }
 
 void GetVariableNode::setVariableName(const std::string& name) {
     m_variableName = name;
+    m_variableId = resolveVariableName(name);
 }
 
 NodeExecutionResult GetVariableNode::executeInternal(ExecutionContext& context) {
@@ -29,23 +71,18 @@ NodeExecutionResult GetVariableNode::executeInternal(ExecutionContext& context)
     result.success = true;
     
     // 从输入获取变量名（如果有的话）
-    BlueprintValue nameInput = getInputValue("variable_name");
-    std::string varName = m_variableName;
-    if (nameInput.is<std::string>() && !nameInput.get<std::string>().empty()) {
-        varName = nameInput.get<std::string>();
-    }
-    
-    if (varName.empty()) {
+    const VariableId variable = resolveVariable(getInputValue(kNameOnly), m_variableId);
+    if (variable == kInvalidVariableId) {
         result.success = false;
         result.errorMessage = "Variable name is empty";
         return result;
     }
     
     // 从执行上下文获取变量值
-    BlueprintValue value = context.getVariable(varName);
-    setOutputValue("value", value);
+    const BlueprintValue& value = context.getVariable(variable);
+    setOutputValue(kGetValue, value);
     
-    Logger::debug("Get variable: " + varName + " = " + value.toString());
+    ONEDAY_LOG_DEBUG("Get variable: {} = {}", variableName(variable), value);
     return result;
 }
 
@@ -58,16 +95,19 @@ void GetVariableNode::initializePorts() {
 
 SetVariableNode::SetVariableNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::SetVariable) {
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> SetVariableNode::clone() const {
     auto cloned = std::make_unique<SetVariableNode>();
     cloned->m_variableName = m_variableName;
+    cloned->m_variableId = m_variableId;
     return cloned;
 }
 
 void SetVariableNode::setVariableName(const std::string& name) {
     m_variableName = name;
+    m_variableId = resolveVariableName(name);
 }
 
 NodeExecutionResult SetVariableNode::executeInternal(ExecutionContext& context) {
@@ -75,7 +115,7 @@ NodeExecutionResult SetVariableNode::executeInternal(ExecutionContext& context)
     result.success = true;
     
     // 获取执行流输入
-    BlueprintValue execInput = getInputValue("exec_in");
+    const BlueprintValue& execInput = getInputValue(kExecIn);
     if (!execInput.is<ExecutionToken>() || !execInput.get<ExecutionToken>().valid) {
         result.success = false;
         result.errorMessage = "Invalid execution input";
@@ -83,29 +123,24 @@ NodeExecutionResult SetVariableNode::executeInternal(ExecutionContext& context)
     }
     
     // 从输入获取变量名（如果有的话）
-    BlueprintValue nameInput = getInputValue("variable_name");
-    std::string varName = m_variableName;
-    if (nameInput.is<std::string>() && !nameInput.get<std::string>().empty()) {
-        varName = nameInput.get<std::string>();
-    }
-    
-    if (varName.empty()) {
+    const VariableId variable = resolveVariable(getInputValue(kNameAfterExec), m_variableId);
+    if (variable == kInvalidVariableId) {
         result.success = false;
         result.errorMessage = "Variable name is empty";
         return result;
     }
     
     // 获取要设置的值
-    BlueprintValue value = getInputValue("value");
+    const BlueprintValue& value = getInputValue(kSetValue);
     
     // 设置变量到执行上下文
-    context.setVariable(varName, value);
+    context.setVariable(variable, value);
     
     // 设置执行流输出
-    setOutputValue("exec_out", BlueprintValue(ExecutionToken(true)));
-    setOutputValue("value", value);
+    setOutputValue(kExecOut, BlueprintValue(ExecutionToken(true)));
+    setOutputValue(kSetValueOut, value);
     
-    Logger::debug("Set variable: " + varName + " = " + value.toString());
+    ONEDAY_LOG_DEBUG("Set variable: {} = {}", variableName(variable), value);
     return result;
 }
 
@@ -123,16 +158,19 @@ void SetVariableNode::initializePorts() {
 IncrementVariableNode::IncrementVariableNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Increment Variable");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> IncrementVariableNode::clone() const {
     auto cloned = std::make_unique<IncrementVariableNode>();
     cloned->m_variableName = m_variableName;
+    cloned->m_variableId = m_variableId;
     return cloned;
 }
 
 void IncrementVariableNode::setVariableName(const std::string& name) {
     m_variableName = name;
+    m_variableId = resolveVariableName(name);
 }
 
 NodeExecutionResult IncrementVariableNode::executeInternal(ExecutionContext& context) {
@@ -140,21 +178,16 @@ NodeExecutionResult IncrementVariableNode::executeInternal(ExecutionContext& con
     result.success = true;
     
     // 获取变量名
-    BlueprintValue nameInput = getInputValue("variable_name");
-    std::string varName = m_variableName;
-    if (nameInput.is<std::string>() && !nameInput.get<std::string>().empty()) {
-        varName = nameInput.get<std::string>();
-    }
-    
-    if (varName.empty()) {
+    const VariableId variable = resolveVariable(getInputValue(kNameAfterExec), m_variableId);
+    if (variable == kInvalidVariableId) {
         result.success = false;
         result.errorMessage = "Variable name is empty";
         return result;
     }
     
     // 获取当前变量值
-    BlueprintValue currentValue = context.getVariable(varName);
-    BlueprintValue incrementValue = getInputValue("increment");
+    BlueprintValue currentValue = context.getVariable(variable);
+    const BlueprintValue& incrementValue = getInputValue(kIncrementAmount);
     
     // 执行增量操作
     BlueprintValue newValue;
@@ -171,13 +204,14 @@ NodeExecutionResult IncrementVariableNode::executeInternal(ExecutionContext& con
     }
     
     // 设置新值
-    context.setVariable(varName, newValue);
+    context.setVariable(variable, newValue);
     
     // 设置输出
-    setOutputValue("exec_out", BlueprintValue(ExecutionToken(true)));
-    setOutputValue("new_value", newValue);
+    setOutputValue(kExecOut, BlueprintValue(ExecutionToken(true)));
+    setOutputValue(kIncrementNewValue, newValue);
     
-    Logger::debug("Increment variable: " + varName + " from " + currentValue.toString() + " to " + newValue.toString());
+    ONEDAY_LOG_DEBUG("Increment variable: {} from {} to {}",
+                     variableName(variable), currentValue, newValue);
     return result;
 }
 
@@ -195,16 +229,19 @@ void IncrementVariableNode::initializePorts() {
 VariableExistsNode::VariableExistsNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Variable Exists");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> VariableExistsNode::clone() const {
     auto cloned = std::make_unique<VariableExistsNode>();
     cloned->m_variableName = m_variableName;
+    cloned->m_variableId = m_variableId;
     return cloned;
 }
 
 void VariableExistsNode::setVariableName(const std::string& name) {
     m_variableName = name;
+    m_variableId = resolveVariableName(name);
 }
 
 NodeExecutionResult VariableExistsNode::executeInternal(ExecutionContext& context) {
@@ -212,23 +249,18 @@ NodeExecutionResult VariableExistsNode::executeInternal(ExecutionContext& contex
     result.success = true;
     
     // 获取变量名
-    BlueprintValue nameInput = getInputValue("variable_name");
-    std::string varName = m_variableName;
-    if (nameInput.is<std::string>() && !nameInput.get<std::string>().empty()) {
-        varName = nameInput.get<std::string>();
-    }
-    
-    if (varName.empty()) {
+    const VariableId variable = resolveVariable(getInputValue(kNameOnly), m_variableId);
+    if (variable == kInvalidVariableId) {
         result.success = false;
         result.errorMessage = "Variable name is empty";
         return result;
     }
     
     // 检查变量是否存在
-    bool exists = context.hasVariable(varName);
-    setOutputValue("exists", BlueprintValue(exists));
+    bool exists = context.hasVariable(variable);
+    setOutputValue(kExistsResult, BlueprintValue(exists));
     
-    Logger::debug("Variable exists check: " + varName + " = " + std::to_string(exists));
+    ONEDAY_LOG_DEBUG("Variable exists check: {} = {}", variableName(variable), exists);
     return result;
 }
 
@@ -242,16 +274,19 @@ void VariableExistsNode::initializePorts() {
 DeleteVariableNode::DeleteVariableNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Delete Variable");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> DeleteVariableNode::clone() const {
     auto cloned = std::make_unique<DeleteVariableNode>();
     cloned->m_variableName = m_variableName;
+    cloned->m_variableId = m_variableId;
     return cloned;
 }
 
 void DeleteVariableNode::setVariableName(const std::string& name) {
     m_variableName = name;
+    m_variableId = resolveVariableName(name);
 }
 
 NodeExecutionResult DeleteVariableNode::executeInternal(ExecutionContext& context) {
@@ -259,26 +294,21 @@ NodeExecutionResult DeleteVariableNode::executeInternal(ExecutionContext& contex
     result.success = true;
     
     // 获取变量名
-    BlueprintValue nameInput = getInputValue("variable_name");
-    std::string varName = m_variableName;
-    if (nameInput.is<std::string>() && !nameInput.get<std::string>().empty()) {
-        varName = nameInput.get<std::string>();
-    }
-    
-    if (varName.empty()) {
+    const VariableId variable = resolveVariable(getInputValue(kNameAfterExec), m_variableId);
+    if (variable == kInvalidVariableId) {
         result.success = false;
         result.errorMessage = "Variable name is empty";
         return result;
     }
     
     // 删除变量
-    bool deleted = context.deleteVariable(varName);
+    bool deleted = context.deleteVariable(variable);
     
     // 设置输出
-    setOutputValue("exec_out", BlueprintValue(ExecutionToken(true)));
-    setOutputValue("deleted", BlueprintValue(deleted));
+    setOutputValue(kExecOut, BlueprintValue(ExecutionToken(true)));
+    setOutputValue(kDeletedResult, BlueprintValue(deleted));
     
-    Logger::debug("Delete variable: " + varName + " = " + std::to_string(deleted));
+    ONEDAY_LOG_DEBUG("Delete variable: {} = {}", variableName(variable), deleted);
     return result;
 }
 
@@ -295,6 +325,7 @@ void DeleteVariableNode::initializePorts() {
 GetAllVariablesNode::GetAllVariablesNode(const std::string& id) 
     : BaseNode(id.empty() ? NodeUtils::generateNodeId() : id, NodeType::Custom) {
     setName("Get All Variables");
+    initializePorts();
 }
 
 std::unique_ptr<BaseNode> GetAllVariablesNode::clone() const {
@@ -314,10 +345,10 @@ NodeExecutionResult GetAllVariablesNode::executeInternal(ExecutionContext& conte
         nameArray.push_back(BlueprintValue(name));
     }
     
-    setOutputValue("variable_names", BlueprintValue(nameArray));
-    setOutputValue("count", BlueprintValue(static_cast<int>(variableNames.size())));
+    setOutputValue(kAllNames, BlueprintValue(nameArray));
+    setOutputValue(kAllCount, BlueprintValue(static_cast<int>(variableNames.size())));
     
-    Logger::debug("Get all variables: found " + std::to_string(variableNames.size()) + " variables");
+    ONEDAY_LOG_DEBUG("Get all variables: found {} variables", variableNames.size());
     return result;
 }
 
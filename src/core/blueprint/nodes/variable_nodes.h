@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base_node.h"
+#include "../execution_context.h"
 
 namespace oneday {
 namespace core {
@@ -31,6 +32,7 @@ protected:
 
 private:
     std::string m_variableName;
+    VariableId m_variableId = kInvalidVariableId;  ///< 设置变量名时解析出的变量ID
 };
 
 /**
@@ -58,6 +60,7 @@ protected:
 
 private:
     std::string m_variableName;
+    VariableId m_variableId = kInvalidVariableId;  ///< 设置变量名时解析出的变量ID
 };
 
 /**
@@ -85,6 +88,7 @@ protected:
 
 private:
     std::string m_variableName;
+    VariableId m_variableId = kInvalidVariableId;  ///< 设置变量名时解析出的变量ID
 };
 
 /**
@@ -107,6 +111,7 @@ protected:
 
 private:
     std::string m_variableName;
+    VariableId m_variableId = kInvalidVariableId;  ///< 设置变量名时解析出的变量ID
 };
 
 /**
@@ -129,6 +134,7 @@ protected:
 
 private:
     std::string m_variableName;
+    VariableId m_variableId = kInvalidVariableId;  ///< 设置变量名时解析出的变量ID
 };
 
 /**
@@ -10,6 +10,11 @@ namespace core {
 std::shared_ptr<spdlog::logger> Logger::logger_;
 
 void Logger::initialize() {
+    // spdlog 不允许重复注册同名 logger，重复初始化时保留已有的 logger
+    if (logger_) {
+        return;
+    }
+
     try {
         // 创建控制台输出sink
         auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
@@ -49,31 +54,36 @@ void Logger::setLevel(Level level) {
     }
 }
 
-void Logger::info(const std::string& message) {
+void Logger::trace(std::string_view message) {
+    if (logger_)
+        logger_->trace(message);
+}
+
+void Logger::info(std::string_view message) {
     if (logger_)
         logger_->info(message);
 }
 
-void Logger::debug(const std::string& message) {
+void Logger::debug(std::string_view message) {
     if (logger_)
         logger_->debug(message);
 }
 
-void Logger::warn(const std::string& message) {
+void Logger::warn(std::string_view message) {
     if (logger_)
         logger_->warn(message);
 }
 
-void Logger::warning(const std::string& message) {
+void Logger::warning(std::string_view message) {
     warn(message);  // 调用warn方法
 }
 
-void Logger::error(const std::string& message) {
+void Logger::error(std::string_view message) {
     if (logger_)
         logger_->error(message);
 }
 
-void Logger::critical(const std::string& message) {
+void Logger::critical(std::string_view message) {
     if (logger_)
         logger_->critical(message);
 }
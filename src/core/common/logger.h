@@ -4,20 +4,52 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace oneday {
 namespace core {
 
+/**
+ * @brief 编译期日志级别（对应 Logger::Level 的数值）
+ *
+ * 低于该级别的 ONEDAY_LOG_TRACE / ONEDAY_LOG_DEBUG 调用在预处理阶段被整体移除，参数不会求值。
+ * Release 构建（定义 NDEBUG）默认移除 trace 和 debug，可在编译选项中覆盖。
+ */
+#ifndef ONEDAY_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define ONEDAY_LOG_ACTIVE_LEVEL 2
+#else
+#define ONEDAY_LOG_ACTIVE_LEVEL 0
+#endif
+#endif
+
+#if ONEDAY_LOG_ACTIVE_LEVEL <= 0
+#define ONEDAY_LOG_TRACE(...) ::oneday::core::Logger::trace(__VA_ARGS__)
+#else
+#define ONEDAY_LOG_TRACE(...) static_cast<void>(0)
+#endif
+
+#if ONEDAY_LOG_ACTIVE_LEVEL <= 1
+#define ONEDAY_LOG_DEBUG(...) ::oneday::core::Logger::debug(__VA_ARGS__)
+#else
+#define ONEDAY_LOG_DEBUG(...) static_cast<void>(0)
+#endif
+
 /**
  * @brief 日志系统
  * 基于spdlog的高性能日志记录
+ *
+ * 带参数的重载使用 fmt 格式字符串（如 Logger::info("Loaded {} items", count)），
+ * 日志级别未启用时直接返回，不会格式化参数；热路径上应优先使用这些重载或 ONEDAY_LOG_* 宏，
+ * 而不是在调用处拼接字符串。
  */
 class Logger {
   public:
     enum class Level { Trace = 0, Debug = 1, Info = 2, Warn = 3, Error = 4, Critical = 5 };
 
     /**
-     * @brief 初始化日志系统
+     * @brief 初始化日志系统（已初始化时不做任何事）
      */
     static void initialize();
 
@@ -31,44 +63,121 @@ class Logger {
      */
     static void setLevel(Level level);
 
+    /**
+     * @brief 检查指定级别的日志是否会被记录
+     */
+    static bool shouldLog(Level level) {
+        return logger_ && logger_->should_log(static_cast<spdlog::level::level_enum>(level));
+    }
+
+    /**
+     * @brief 记录跟踪日志
+     */
+    static void trace(std::string_view message);
+
     /**
      * @brief 记录信息日志
      */
-    static void info(const std::string& message);
+    static void info(std::string_view message);
 
     /**
      * @brief 记录调试日志
      */
-    static void debug(const std::string& message);
+    static void debug(std::string_view message);
 
     /**
      * @brief 记录警告日志
      */
-    static void warn(const std::string& message);
+    static void warn(std::string_view message);
 
     /**
      * @brief 记录警告信息（别名）
      */
-    static void warning(const std::string& message);
+    static void warning(std::string_view message);
 
     /**
      * @brief 记录错误日志
      */
-    static void error(const std::string& message);
+    static void error(std::string_view message);
 
     /**
      * @brief 记录严重错误日志
      */
-    static void critical(const std::string& message);
+    static void critical(std::string_view message);
 
     /**
      * @brief 刷新日志缓冲区
      */
     static void flush();
 
+    /**
+     * @brief 格式化记录跟踪日志
+     */
+    template <typename Arg, typename... Args>
+    static void trace(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::trace, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化记录调试日志
+     */
+    template <typename Arg, typename... Args>
+    static void debug(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::debug, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化记录信息日志
+     */
+    template <typename Arg, typename... Args>
+    static void info(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::info, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化记录警告日志
+     */
+    template <typename Arg, typename... Args>
+    static void warn(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::warn, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化记录警告日志（别名）
+     */
+    template <typename Arg, typename... Args>
+    static void warning(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::warn, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化记录错误日志
+     */
+    template <typename Arg, typename... Args>
+    static void error(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::err, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化记录严重错误日志
+     */
+    template <typename Arg, typename... Args>
+    static void critical(spdlog::format_string_t<Arg, Args...> format, Arg&& arg, Args&&... args) {
+        log(spdlog::level::critical, format, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
   private:
     Logger() = default;
     static std::shared_ptr<spdlog::logger> logger_;
+
+    template <typename... Args>
+    static void log(spdlog::level::level_enum level,
+                    spdlog::format_string_t<Args...> format,
+                    Args&&... args) {
+        if (logger_ && logger_->should_log(level)) {
+            logger_->log(level, format, std::forward<Args>(args)...);
+        }
+    }
 };
 
 }  // namespace core
@@ -1,21 +1,23 @@
 #pragma once
 
 #include <algorithm>
-#include <execution>
+#include <cstddef>
 #include <functional>
-#include <future>
-#include <mutex>
+#include <iterator>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "thread_pool.h"
+
 namespace oneday::common {
 
 /**
  * @brief 并行计算工具类 - 替代TBB功能
  *
- * 使用C++17标准库的并行算法和线程池提供高性能并行计算
- * 专门针对游戏脚本场景优化
+ * 所有并行算法都运行在进程级常驻工作窃取线程池（ThreadPool::instance()）上，
+ * 不再为每次调用创建线程，适合每帧调用的小粒度工作负载
  */
 class ParallelUtils {
   public:
@@ -33,16 +35,15 @@ class ParallelUtils {
      * @param start 起始索引
      * @param end 结束索引
      * @param func 执行函数 void(size_t index)
+     *
+     * 在进程级常驻线程池上按区间拆分执行，调用线程同样参与计算。
      */
     template <typename Func>
     static void parallel_for(size_t start, size_t end, Func&& func) {
         if (end <= start)
             return;
 
-        const size_t numThreads = getRecommendedThreadCount();
-        const size_t totalWork = end - start;
-
-        if (totalWork < numThreads || numThreads == 1) {
+        if (shouldRunSerial(end - start)) {
             // 工作量小或单线程，直接执行
             for (size_t i = start; i < end; ++i) {
                 func(i);
@@ -50,43 +51,29 @@ class ParallelUtils {
             return;
         }
 
-        // 多线程并行执行
-        std::vector<std::future<void>> futures;
-        const size_t workPerThread = totalWork / numThreads;
-
-        for (size_t t = 0; t < numThreads; ++t) {
-            size_t threadStart = start + t * workPerThread;
-            size_t threadEnd = (t == numThreads - 1) ? end : threadStart + workPerThread;
-
-            futures.emplace_back(std::async(std::launch::async, [threadStart, threadEnd, &func]() {
-                for (size_t i = threadStart; i < threadEnd; ++i) {
+        ThreadPool& pool = ThreadPool::instance();
+        pool.parallelForRange(
+            start,
+            end,
+            [&func](size_t rangeStart, size_t rangeEnd) {
+                for (size_t i = rangeStart; i < rangeEnd; ++i) {
                     func(i);
                 }
-            }));
-        }
-
-        // 等待所有线程完成
-        for (auto& future : futures) {
-            future.wait();
-        }
+            },
+            pool.autoGrainSize(end - start));
     }
 
     /**
      * @brief 并行处理容器 - 替代tbb::parallel_for_each
-     * @param container 容器
+     * @param container 容器（需支持随机访问）
      * @param func 处理函数
      */
     template <typename Container, typename Func>
     static void parallel_for_each(Container& container, Func&& func) {
-        if constexpr (std::is_same_v<std::execution::parallel_unsequenced_policy,
-                                     decltype(std::execution::par_unseq)>) {
-            // 使用C++17并行算法（如果支持）
-            std::for_each(std::execution::par_unseq, container.begin(), container.end(), func);
-        } else {
-            // 回退到自定义并行实现
-            parallel_for(
-                0, container.size(), [&container, &func](size_t i) { func(container[i]); });
-        }
+        auto first = std::begin(container);
+        parallel_for(0, std::size(container), [&first, &func](size_t i) {
+            func(first[static_cast<std::ptrdiff_t>(i)]);
+        });
     }
 
     /**
@@ -99,37 +86,33 @@ class ParallelUtils {
     static void parallel_transform(const InputContainer& input,
                                    OutputContainer& output,
                                    Func&& func) {
-        output.resize(input.size());
-
-        if constexpr (std::is_same_v<std::execution::parallel_unsequenced_policy,
-                                     decltype(std::execution::par_unseq)>) {
-            // 使用C++17并行算法
-            std::transform(
-                std::execution::par_unseq, input.begin(), input.end(), output.begin(), func);
-        } else {
-            // 自定义并行实现
-            parallel_for(0, input.size(), [&input, &output, &func](size_t i) {
-                output[i] = func(input[i]);
-            });
-        }
+        output.resize(std::size(input));
+
+        auto in = std::begin(input);
+        auto out = std::begin(output);
+        parallel_for(0, std::size(input), [&in, &out, &func](size_t i) {
+            const auto offset = static_cast<std::ptrdiff_t>(i);
+            out[offset] = func(in[offset]);
+        });
     }
 
     /**
      * @brief 并行归约 - 替代tbb::parallel_reduce
      * @param container 容器
      * @param init 初始值
-     * @param reduce_func 归约函数
+     * @param reduce_func 归约函数，需满足结合律，也用于合并各区间的部分结果
      * @return 归约结果
+     *
+     * 第一个区间从 init 开始累积，其余区间从各自的首元素开始，因此 init 只计入一次；
+     * 元素无法转换为 T 时各区间都从 init 开始（与旧实现一致）。
      */
     template <typename Container, typename T, typename ReduceFunc>
     static T parallel_reduce(const Container& container, T init, ReduceFunc&& reduce_func) {
-        if (container.empty())
+        const size_t totalWork = std::size(container);
+        if (totalWork == 0)
             return init;
 
-        const size_t numThreads = getRecommendedThreadCount();
-        const size_t totalWork = container.size();
-
-        if (totalWork < numThreads || numThreads == 1) {
+        if (shouldRunSerial(totalWork)) {
             // 单线程归约
             T result = init;
             for (const auto& item : container) {
@@ -138,76 +121,71 @@ class ParallelUtils {
             return result;
         }
 
-        // 多线程并行归约
-        std::vector<std::future<T>> futures;
-        const size_t workPerThread = totalWork / numThreads;
-
-        for (size_t t = 0; t < numThreads; ++t) {
-            size_t threadStart = t * workPerThread;
-            size_t threadEnd = (t == numThreads - 1) ? totalWork : threadStart + workPerThread;
-
-            futures.emplace_back(std::async(
-                std::launch::async, [&container, threadStart, threadEnd, init, &reduce_func]() {
-                    T localResult = init;
-                    for (size_t i = threadStart; i < threadEnd; ++i) {
-                        localResult = reduce_func(localResult, container[i]);
+        ThreadPool& pool = ThreadPool::instance();
+        const size_t grainSize = pool.autoGrainSize(totalWork);
+        const size_t chunkCount = (totalWork + grainSize - 1) / grainSize;
+
+        // 包一层结构体，避免 T 为 bool 时 std::vector<bool> 的位打包导致并发写冲突
+        struct Partial {
+            T value;
+        };
+        std::vector<Partial> partials(chunkCount, Partial{init});
+
+        auto first = std::begin(container);
+        pool.parallelFor(
+            chunkCount,
+            [&](size_t chunk) {
+                size_t i = chunk * grainSize;
+                const size_t chunkEnd = std::min(i + grainSize, totalWork);
+                T localResult = init;
+                if constexpr (std::is_constructible_v<T, decltype(first[0])>) {
+                    if (chunk > 0) {
+                        localResult = T(first[static_cast<std::ptrdiff_t>(i++)]);
                     }
-                    return localResult;
-                }));
-        }
-
-        // 合并结果
-        T finalResult = init;
-        for (auto& future : futures) {
-            finalResult = reduce_func(finalResult, future.get());
+                }
+                for (; i < chunkEnd; ++i) {
+                    localResult = reduce_func(localResult, first[static_cast<std::ptrdiff_t>(i)]);
+                }
+                partials[chunk].value = std::move(localResult);
+            },
+            1);
+
+        // 按区间顺序合并结果
+        T finalResult = std::move(partials[0].value);
+        for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            finalResult = reduce_func(finalResult, partials[chunk].value);
         }
 
         return finalResult;
     }
 
     /**
-     * @brief 简单的线程池任务执行
+     * @brief 在常驻线程池上执行一组任务并等待完成
      * @param tasks 任务列表
+     *
+     * 任务抛出的第一个异常会在调用线程重新抛出。
      */
     template <typename Func>
     static void execute_tasks(std::vector<Func>& tasks) {
         if (tasks.empty())
             return;
 
-        const size_t numThreads =
-            std::min(static_cast<size_t>(getRecommendedThreadCount()), tasks.size());
-
-        if (numThreads == 1) {
-            // 单线程执行
+        if (shouldRunSerial(tasks.size())) {
             for (auto& task : tasks) {
                 task();
             }
             return;
         }
 
-        // 多线程执行
-        std::vector<std::future<void>> futures;
-        size_t taskIndex = 0;
-
-        for (size_t t = 0; t < numThreads; ++t) {
-            futures.emplace_back(
-                std::async(std::launch::async, [&tasks, &taskIndex, numThreads, t]() {
-                    for (size_t i = t; i < tasks.size(); i += numThreads) {
-                        tasks[i]();
-                    }
-                }));
-        }
-
-        // 等待所有任务完成
-        for (auto& future : futures) {
-            future.wait();
-        }
+        ThreadPool::instance().parallelFor(tasks.size(), [&tasks](size_t i) { tasks[i](); }, 1);
     }
 
     // === 性能监控和调试功能 ===
 
     /**
      * @brief 执行并行计算性能基准测试
+     *
+     * 在不同数据规模下对比常驻线程池实现与旧的 std::async 实现，结果输出到日志。
      */
     static void benchmark_parallel_performance();
 
@@ -237,6 +215,15 @@ class ParallelUtils {
      * @brief 重置任务计数器
      */
     static void reset_task_counter();
+
+  private:
+    /**
+     * @brief 工作量少于线程数或只有单个工作线程时串行执行，避免调度开销
+     */
+    static bool shouldRunSerial(size_t totalWork) {
+        const size_t numThreads = getRecommendedThreadCount();
+        return totalWork < numThreads || numThreads == 1;
+    }
 };
 
 }  // namespace oneday::common
@@ -0,0 +1,273 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "logger.h"
+#include "parallel_utils.h"
+
+namespace oneday::common {
+
+namespace {
+
+thread_local const ThreadPool* t_currentPool = nullptr;  ///< 当前线程所属的线程池
+thread_local int t_workerIndex = -1;                      ///< 当前线程在所属池中的编号
+
+/**
+ * @brief 等待中的线程找不到可执行任务时的轮询间隔
+ *
+ * 等待期间新入队的任务不会唤醒等待者，定期醒来重新尝试窃取；任务组完成时会立即唤醒。
+ */
+constexpr std::chrono::microseconds kHelpPollInterval(100);
+
+/**
+ * @brief 从队列尾部（本线程）或头部（窃取）取出一个任务
+ */
+template <typename Queue>
+bool takeTask(Queue& queue, ThreadPool::Task& task, bool fromBack) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    if (fromBack) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+    } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+    }
+    return true;
+}
+
+/**
+ * @brief 递归二分区间：右半放入队列供窃取，左半继续就地拆分，最后执行剩余的最小区间
+ */
+void splitRange(ThreadPool::TaskGroup& group,
+                size_t begin,
+                size_t end,
+                const ThreadPool::RangeFunction& body,
+                size_t grainSize) {
+    while (end - begin > grainSize) {
+        const size_t middle = begin + (end - begin) / 2;
+        group.run([&group, middle, end, &body, grainSize]() {
+            splitRange(group, middle, end, body, grainSize);
+        });
+        end = middle;
+    }
+    body(begin, end);
+}
+
+}  // namespace
+
+// TaskGroup 实现
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool)
+    : m_pool(pool), m_state(std::make_shared<State>()) {}
+
+ThreadPool::TaskGroup::~TaskGroup() {
+    waitAll();
+}
+
+void ThreadPool::TaskGroup::run(Task task) {
+    m_state->pending.fetch_add(1, std::memory_order_relaxed);
+    m_pool.push([state = m_state, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->error) {
+                state->error = std::current_exception();
+            }
+        }
+
+        if (state->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.notify_all();
+        }
+    });
+}
+
+void ThreadPool::TaskGroup::wait() {
+    waitAll();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        error = std::exchange(m_state->error, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::TaskGroup::waitAll() {
+    State& state = *m_state;
+    Task task;
+    while (state.pending.load(std::memory_order_acquire) != 0) {
+        // 帮忙执行任务（不限于本组），嵌套等待的工作线程因此不会空占线程
+        if (m_pool.tryAcquire(task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.finished.wait_for(lock, kHelpPollInterval, [&state]() {
+            return state.pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+}
+
+// ThreadPool 实现
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        threadCount = ParallelUtils::getRecommendedThreadCount();
+    }
+
+    m_queues.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        m_queues.push_back(std::make_unique<TaskQueue>());
+    }
+    m_workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+    ONEDAY_LOG_DEBUG("Thread pool started with {} workers", threadCount);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+bool ThreadPool::isWorkerThread() const {
+    return currentWorkerIndex() >= 0;
+}
+
+void ThreadPool::submit(Task task) {
+    push([task = std::move(task)]() {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            oneday::core::Logger::error("Unhandled exception in thread pool task: {}", e.what());
+        } catch (...) {
+            oneday::core::Logger::error("Unhandled unknown exception in thread pool task");
+        }
+    });
+}
+
+void ThreadPool::parallelFor(size_t count,
+                             const std::function<void(size_t)>& func,
+                             size_t grainSize) {
+    parallelForRange(
+        0,
+        count,
+        [&func](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                func(i);
+            }
+        },
+        grainSize);
+}
+
+void ThreadPool::parallelForRange(size_t begin,
+                                  size_t end,
+                                  const RangeFunction& body,
+                                  size_t grainSize) {
+    if (end <= begin) {
+        return;
+    }
+    grainSize = std::max<size_t>(1, grainSize);
+
+    if (m_workers.empty() || end - begin <= grainSize) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group(*this);
+    splitRange(group, begin, end, body, grainSize);
+    group.wait();
+}
+
+size_t ThreadPool::autoGrainSize(size_t count, size_t minGrainSize) const {
+    const size_t chunks = (m_workers.size() + 1) * 8;
+    return std::max<size_t>({1, minGrainSize, count / chunks});
+}
+
+void ThreadPool::push(Task task) {
+    const int index = currentWorkerIndex();
+    TaskQueue& queue = index >= 0 ? *m_queues[index] : m_injectQueue;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // 与 workerLoop 中先登记休眠再检查任务数配对：两者至少有一方能看到对方的修改
+    m_queuedTasks.fetch_add(1);
+    if (m_sleepers.load() > 0) {
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_wakeCondition.notify_one();
+    }
+}
+
+bool ThreadPool::tryAcquire(Task& task) {
+    const int index = currentWorkerIndex();
+    bool found = (index >= 0 && takeTask(*m_queues[index], task, true)) ||
+                 takeTask(m_injectQueue, task, false);
+
+    // 从下一个工作线程开始依次窃取，分散竞争
+    const size_t queueCount = m_queues.size();
+    const size_t first = index >= 0 ? static_cast<size_t>(index) + 1 : 0;
+    for (size_t k = 0; !found && k < queueCount; ++k) {
+        const size_t victim = (first + k) % queueCount;
+        if (static_cast<int>(victim) != index) {
+            found = takeTask(*m_queues[victim], task, false);
+        }
+    }
+
+    if (found) {
+        m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return found;
+}
+
+int ThreadPool::currentWorkerIndex() const {
+    return t_currentPool == this ? t_workerIndex : -1;
+}
+
+void ThreadPool::workerLoop(unsigned int index) {
+    t_currentPool = this;
+    t_workerIndex = static_cast<int>(index);
+
+    Task task;
+    for (;;) {
+        if (tryAcquire(task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wakeCondition.wait(lock, [this]() { return m_stopping || m_queuedTasks.load() > 0; });
+        m_sleepers.fetch_sub(1);
+        if (m_stopping && m_queuedTasks.load() == 0) {
+            return;  // 停止且队列已清空
+        }
+    }
+}
+
+}  // namespace oneday::common
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oneday::common {
+
+/**
+ * @brief 常驻工作窃取线程池
+ *
+ * 工作线程在池的生命周期内常驻，避免 std::async 每次并行都创建和销毁线程。
+ * 每个工作线程拥有自己的任务双端队列：本线程从尾部取任务（LIFO，缓存友好），
+ * 空闲线程从其他队列头部窃取（FIFO，优先拿到最大的未拆分区间）。
+ * 外部线程提交的任务进入共享注入队列。
+ *
+ * 等待（TaskGroup::wait、parallelFor）的线程会帮忙执行队列中的任务，
+ * 因此在工作线程内部嵌套并行也不会死锁。
+ */
+class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    /**
+     * @brief 任务组 - 提交一批任务并等待它们全部完成
+     *
+     * 可在任意线程（包括任务内部）向同一任务组追加任务。
+     * 析构时若仍有未完成任务会先等待（不重新抛出异常）。
+     */
+    class TaskGroup {
+      public:
+        explicit TaskGroup(ThreadPool& pool = ThreadPool::instance());
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /**
+         * @brief 提交任务到线程池
+         */
+        void run(Task task);
+
+        /**
+         * @brief 等待全部任务完成，等待期间当前线程帮忙执行任务
+         *
+         * 任务抛出的第一个异常会在这里重新抛出。
+         */
+        void wait();
+
+      private:
+        struct State {
+            std::atomic<size_t> pending{0};  ///< 未完成的任务数量
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr error;  ///< 第一个任务异常
+        };
+
+        ThreadPool& m_pool;
+        std::shared_ptr<State> m_state;  ///< 与已提交任务共享，任务结束前保持有效
+
+        void waitAll();
+    };
+
+    /**
+     * @brief 构造函数
+     * @param threadCount 工作线程数量（0 表示使用推荐线程数）
+     */
+    explicit ThreadPool(unsigned int threadCount = 0);
+
+    /**
+     * @brief 析构函数 - 等待已提交任务完成后停止工作线程
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 获取进程级共享线程池
+     */
+    static ThreadPool& instance();
+
+    /**
+     * @brief 获取工作线程数量
+     */
+    unsigned int getThreadCount() const {
+        return static_cast<unsigned int>(m_workers.size());
+    }
+
+    /**
+     * @brief 检查当前线程是否为本线程池的工作线程
+     */
+    bool isWorkerThread() const;
+
+    /**
+     * @brief 提交异步任务（不等待完成）
+     * @param task 任务函数
+     */
+    void submit(Task task);
+
+    /**
+     * @brief 并行执行 [0, count) 并等待全部完成
+     * @param count 任务数量
+     * @param func 执行函数 void(size_t index)
+     * @param grainSize 不再继续拆分的最小连续任务数量
+     *
+     * 任务抛出的第一个异常会在调用线程重新抛出。
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& func, size_t grainSize = 1);
+
+    /**
+     * @brief 把 [begin, end) 递归二分为不小于 grainSize 的区间并行执行，等待全部完成
+     * @param body 区间函数 void(size_t begin, size_t end)，每个区间调用一次
+     *
+     * 拆出的右半区间放入当前线程的队列供其他线程窃取，左半区间继续就地拆分执行。
+     */
+    void parallelForRange(size_t begin, size_t end, const RangeFunction& body, size_t grainSize);
+
+    /**
+     * @brief 根据工作量和线程数选择区间粒度（约每线程 8 个区间）
+     * @param count 元素数量
+     * @param minGrainSize 粒度下限
+     */
+    size_t autoGrainSize(size_t count, size_t minGrainSize = 1) const;
+
+  private:
+    /**
+     * @brief 单个任务队列
+     */
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> m_workers;               ///< 工作线程
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;  ///< 每个工作线程的本地队列
+    TaskQueue m_injectQueue;                           ///< 外部线程提交的任务
+
+    std::atomic<size_t> m_queuedTasks{0};     ///< 已入队但尚未被取走的任务数量
+    std::atomic<unsigned int> m_sleepers{0};  ///< 正在休眠的工作线程数量
+    std::mutex m_sleepMutex;                  ///< 休眠/唤醒锁
+    std::condition_variable m_wakeCondition;  ///< 任务到达通知
+    bool m_stopping = false;                  ///< 停止标志（受 m_sleepMutex 保护）
+
+    /**
+     * @brief 任务入队：工作线程放入自己的队列尾部，其他线程放入注入队列
+     */
+    void push(Task task);
+
+    /**
+     * @brief 取一个任务：本地队列尾部、注入队列、其他工作线程队列头部依次尝试
+     */
+    bool tryAcquire(Task& task);
+
+    /**
+     * @brief 当前线程在本池中的工作线程编号（非工作线程返回 -1）
+     */
+    int currentWorkerIndex() const;
+
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop(unsigned int index);
+};
+
+}  // namespace oneday::common
@@ -46,8 +46,7 @@ QPixmap ScreenCapture::captureScreen() {
     if (screenshot.isNull()) {
         Logger::error("Failed to capture screen");
     } else {
-        Logger::debug("Screen captured: " + std::to_string(screenshot.width()) + "x" + 
-                     std::to_string(screenshot.height()));
+        ONEDAY_LOG_DEBUG("Screen captured: {}x{}", screenshot.width(), screenshot.height());
     }
     
     return screenshot;
@@ -64,8 +63,7 @@ QPixmap ScreenCapture::captureWindow(QWidget* window) {
     if (screenshot.isNull()) {
         Logger::error("Failed to capture window");
     } else {
-        Logger::debug("Window captured: " + std::to_string(screenshot.width()) + "x" + 
-                     std::to_string(screenshot.height()));
+        ONEDAY_LOG_DEBUG("Window captured: {}x{}", screenshot.width(), screenshot.height());
     }
     
     return screenshot;
@@ -84,9 +82,8 @@ QPixmap ScreenCapture::captureRegion(const QRect& region) {
     if (screenshot.isNull()) {
         Logger::error("Failed to capture region");
     } else {
-        Logger::debug("Region captured: " + std::to_string(region.x()) + "," + 
-                     std::to_string(region.y()) + " " + 
-                     std::to_string(region.width()) + "x" + std::to_string(region.height()));
+        ONEDAY_LOG_DEBUG("Region captured: {},{} {}x{}",
+                         region.x(), region.y(), region.width(), region.height());
     }
     
     return screenshot;
@@ -174,7 +171,7 @@ void ScreenCapture::startCapture() {
     m_isCapturing = true;
     m_captureTimer->start(m_captureInterval);
     
-    Logger::info("Screen capture started with interval " + std::to_string(m_captureInterval) + "ms");
+    Logger::info("Screen capture started with interval {}ms", m_captureInterval);
     emit captureStarted();
 }
 
@@ -197,7 +194,7 @@ void ScreenCapture::setCaptureInterval(int intervalMs) {
         m_captureTimer->setInterval(m_captureInterval);
     }
     
-    Logger::info("Capture interval set to " + std::to_string(m_captureInterval) + "ms");
+    Logger::info("Capture interval set to {}ms", m_captureInterval);
 }
 
 int ScreenCapture::getCaptureInterval() const {
@@ -210,9 +207,8 @@ bool ScreenCapture::isCapturing() const {
 
 void ScreenCapture::setCaptureRegion(const QRect& region) {
     m_captureRegion = region;
-    Logger::info("Capture region set to " + std::to_string(region.x()) + "," + 
-                std::to_string(region.y()) + " " + 
-                std::to_string(region.width()) + "x" + std::to_string(region.height()));
+    Logger::info("Capture region set to {},{} {}x{}",
+                 region.x(), region.y(), region.width(), region.height());
 }
 
 QRect ScreenCapture::getCaptureRegion() const {
@@ -232,9 +228,9 @@ bool ScreenCapture::saveScreenshot(const QString& filename) {
     
     bool success = screenshot.save(filename);
     if (success) {
-        Logger::info("Screenshot saved to: " + filename.toStdString());
+        Logger::info("Screenshot saved to: {}", filename.toStdString());
     } else {
-        Logger::error("Failed to save screenshot to: " + filename.toStdString());
+        Logger::error("Failed to save screenshot to: {}", filename.toStdString());
     }
     
     return success;
@@ -248,9 +244,9 @@ bool ScreenCapture::saveWindowScreenshot(QWidget* window, const QString& filenam
     
     bool success = screenshot.save(filename);
     if (success) {
-        Logger::info("Window screenshot saved to: " + filename.toStdString());
+        Logger::info("Window screenshot saved to: {}", filename.toStdString());
     } else {
-        Logger::error("Failed to save window screenshot to: " + filename.toStdString());
+        Logger::error("Failed to save window screenshot to: {}", filename.toStdString());
     }
     
     return success;
@@ -264,9 +260,9 @@ bool ScreenCapture::saveRegionScreenshot(const QRect& region, const QString& fil
     
     bool success = screenshot.save(filename);
     if (success) {
-        Logger::info("Region screenshot saved to: " + filename.toStdString());
+        Logger::info("Region screenshot saved to: {}", filename.toStdString());
     } else {
-        Logger::error("Failed to save region screenshot to: " + filename.toStdString());
+        Logger::error("Failed to save region screenshot to: {}", filename.toStdString());
     }
     
     return success;
@@ -354,7 +350,7 @@ QPixmap ScreenCapture::captureWindowByHandle(HWND hwnd) {
     DeleteDC(hdcMemDC);
     ReleaseDC(hwnd, hdcWindow);
     
-    Logger::debug("Window captured by handle: " + std::to_string(width) + "x" + std::to_string(height));
+    ONEDAY_LOG_DEBUG("Window captured by handle: {}x{}", width, height);
     return pixmap;
 }
 
@@ -375,7 +371,7 @@ std::vector<HWND> ScreenCapture::findWindowsByTitle(const QString& title) {
         return TRUE;
     }, reinterpret_cast<LPARAM>(&std::make_pair(title, &windows)));
     
-    Logger::info("Found " + std::to_string(windows.size()) + " windows with title containing: " + title.toStdString());
+    Logger::info("Found {} windows with title containing: {}", windows.size(), title.toStdString());
     return windows;
 }
 #endif
@@ -0,0 +1,281 @@
+#include "cascade_registry.h"
+
+#include <opencv2/imgproc.hpp>
+#include <opencv2/objdetect.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+#include "../common/logger.h"
+#include "../common/parallel_utils.h"
+
+using oneday::common::ParallelUtils;
+using oneday::core::Logger;
+
+namespace oneday::image {
+
+/**
+ * @brief 已注册的分类器：文件内容和各线程的分类器副本
+ */
+struct CascadeRegistry::Entry {
+    std::string name;     ///< 分类器名称
+    std::string path;     ///< 文件路径
+    std::string content;  ///< 文件内容
+
+    std::mutex cloneMutex;  ///< 保护 clones
+    std::unordered_map<std::thread::id, std::unique_ptr<cv::CascadeClassifier>> clones;  ///< 各线程的副本
+
+    /**
+     * @brief 获取当前线程的分类器副本，第一次使用时构建（失败时返回 nullptr）
+     */
+    cv::CascadeClassifier* acquire() {
+        const std::thread::id thread = std::this_thread::get_id();
+        {
+            std::lock_guard<std::mutex> lock(cloneMutex);
+            auto it = clones.find(thread);
+            if (it != clones.end()) {
+                return it->second.get();
+            }
+        }
+
+        // 在锁外解析，多个线程第一次使用时可以同时构建各自的副本
+        auto classifier = std::make_unique<cv::CascadeClassifier>();
+        if (!build(*classifier)) {
+            Logger::error("Failed to load cascade classifier: {}", path);
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(cloneMutex);
+        return clones.emplace(thread, std::move(classifier)).first->second.get();
+    }
+
+    bool build(cv::CascadeClassifier& classifier) const {
+        cv::FileStorage storage(content, cv::FileStorage::READ | cv::FileStorage::MEMORY);
+        if (storage.isOpened() && classifier.read(storage.getFirstTopLevelNode())) {
+            return true;
+        }
+        // 旧格式的分类器只能从文件加载
+        return classifier.load(path);
+    }
+};
+
+namespace {
+
+double normalizedScale(const CascadeDetectOptions& options) {
+    return std::clamp(options.downscale, 0.05, 1.0);
+}
+
+cv::Size scaleSize(const cv::Size& size, double scale) {
+    if (size.empty()) {
+        return cv::Size();
+    }
+    return cv::Size(cvRound(size.width * scale), cvRound(size.height * scale));
+}
+
+}  // namespace
+
+CascadeRegistry& CascadeRegistry::instance() {
+    static CascadeRegistry registry;
+    return registry;
+}
+
+CascadeRegistry::CascadeRegistry() = default;
+
+CascadeRegistry::~CascadeRegistry() = default;
+
+bool CascadeRegistry::load(const std::string& name, const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        Logger::error("Failed to open cascade classifier: {}", path);
+        return false;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->name = name;
+    entry->path = path;
+    entry->content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    // 在加载线程上构建第一个副本，顺便校验文件
+    if (!entry->acquire()) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries[name] = std::move(entry);
+    Logger::info("Cascade classifier loaded: {} ({})", name, path);
+    return true;
+}
+
+bool CascadeRegistry::has(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_entries.find(name) != m_entries.end();
+}
+
+bool CascadeRegistry::remove(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    return m_entries.erase(name) > 0;
+}
+
+void CascadeRegistry::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+std::vector<cv::Rect> CascadeRegistry::detect(const std::string& name,
+                                              const cv::Mat& gray,
+                                              const CascadeDetectOptions& options) const {
+    if (gray.empty()) {
+        Logger::error("Input image is empty");
+        return {};
+    }
+
+    const std::shared_ptr<Entry> entry = find(name);
+    if (!entry) {
+        Logger::error("Cascade classifier not found: {}", name);
+        return {};
+    }
+    return detectInGray(*entry, gray, options);
+}
+
+std::vector<std::vector<cv::Rect>> CascadeRegistry::detectBatch(
+    const cv::Mat& frame, const std::vector<CascadeRequest>& requests, bool equalize) const {
+    std::vector<std::vector<cv::Rect>> results(requests.size());
+
+    // 不能用线程局部缓冲区：调用线程在 parallel_for 中等待时会执行其他排队任务，
+    // 其中再次调用 detectBatch 会覆盖仍被本批任务读取的图像
+    cv::Mat gray;
+    if (!preprocess(frame, gray, equalize)) {
+        return results;
+    }
+
+    std::vector<std::shared_ptr<Entry>> entries(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        entries[i] = find(requests[i].cascade);
+        if (!entries[i]) {
+            Logger::error("Cascade classifier not found: {}", requests[i].cascade);
+        }
+    }
+
+    // 整帧请求按缩放比例共享缩小后的图像
+    std::vector<double> scales;
+    std::vector<cv::Mat> scaledFrames;
+    std::vector<int> scaledIndex(requests.size(), -1);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const double scale = normalizedScale(requests[i].options);
+        if (!entries[i] || !requests[i].options.roi.empty() || scale >= 1.0) {
+            continue;
+        }
+        auto it = std::find(scales.begin(), scales.end(), scale);
+        if (it == scales.end()) {
+            scales.push_back(scale);
+            scaledFrames.emplace_back();
+            cv::resize(gray, scaledFrames.back(), cv::Size(), scale, scale, cv::INTER_AREA);
+            it = scales.end() - 1;
+        }
+        scaledIndex[i] = static_cast<int>(it - scales.begin());
+    }
+
+    ParallelUtils::parallel_for(0, requests.size(), [&](size_t i) {
+        if (!entries[i]) {
+            return;
+        }
+        const CascadeDetectOptions& options = requests[i].options;
+        if (scaledIndex[i] >= 0) {
+            const size_t index = static_cast<size_t>(scaledIndex[i]);
+            results[i] = detectScaled(*entries[i], scaledFrames[index], scales[index], cv::Point(),
+                                      options);
+        } else {
+            results[i] = detectInGray(*entries[i], gray, options);
+        }
+    });
+
+    ONEDAY_LOG_DEBUG("Cascade batch: {} requests on {}x{} frame", requests.size(), frame.cols,
+                     frame.rows);
+    return results;
+}
+
+bool CascadeRegistry::preprocess(const cv::Mat& frame, cv::Mat& gray, bool equalize) {
+    if (frame.empty()) {
+        Logger::error("Input image is empty");
+        return false;
+    }
+
+    switch (frame.channels()) {
+        case 1:
+            if (equalize) {
+                cv::equalizeHist(frame, gray);
+            } else {
+                frame.copyTo(gray);
+            }
+            return true;
+        case 3:
+            cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+            break;
+        case 4:
+            cv::cvtColor(frame, gray, cv::COLOR_BGRA2GRAY);
+            break;
+        default:
+            Logger::error("Unsupported frame format ({} channels)", frame.channels());
+            return false;
+    }
+
+    if (equalize) {
+        cv::equalizeHist(gray, gray);
+    }
+    return true;
+}
+
+std::shared_ptr<CascadeRegistry::Entry> CascadeRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_entries.find(name);
+    return it != m_entries.end() ? it->second : nullptr;
+}
+
+std::vector<cv::Rect> CascadeRegistry::detectInGray(Entry& entry,
+                                                    const cv::Mat& gray,
+                                                    const CascadeDetectOptions& options) {
+    const cv::Rect bounds(0, 0, gray.cols, gray.rows);
+    const cv::Rect region = options.roi.empty() ? bounds : options.roi & bounds;
+    if (region.empty()) {
+        return {};
+    }
+
+    const double scale = normalizedScale(options);
+    if (scale >= 1.0) {
+        return detectScaled(entry, gray(region), 1.0, region.tl(), options);
+    }
+
+    thread_local cv::Mat scaled;
+    cv::resize(gray(region), scaled, cv::Size(), scale, scale, cv::INTER_AREA);
+    return detectScaled(entry, scaled, scale, region.tl(), options);
+}
+
+std::vector<cv::Rect> CascadeRegistry::detectScaled(Entry& entry,
+                                                    const cv::Mat& image,
+                                                    double scale,
+                                                    cv::Point offset,
+                                                    const CascadeDetectOptions& options) {
+    std::vector<cv::Rect> objects;
+    cv::CascadeClassifier* classifier = entry.acquire();
+    if (!classifier || image.empty()) {
+        return objects;
+    }
+
+    classifier->detectMultiScale(image, objects, std::max(options.scaleFactor, 1.01),
+                                 options.minNeighbors, 0, scaleSize(options.minSize, scale),
+                                 scaleSize(options.maxSize, scale));
+
+    // 映射回原图坐标
+    const double inverse = 1.0 / scale;
+    for (cv::Rect& object : objects) {
+        object = cv::Rect(cvRound(object.x * inverse) + offset.x,
+                          cvRound(object.y * inverse) + offset.y,
+                          cvRound(object.width * inverse),
+                          cvRound(object.height * inverse));
+    }
+    return objects;
+}
+
+}  // namespace oneday::image
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oneday::image {
+
+/**
+ * @brief 级联检测选项
+ */
+struct CascadeDetectOptions {
+    double scaleFactor = 1.1;             ///< 检测窗口逐级放大的比例（越大级数越少、越快）
+    int minNeighbors = 3;                 ///< 保留检测结果所需的最少相邻命中数
+    cv::Size minSize = cv::Size(30, 30);  ///< 最小目标尺寸（原图像素）
+    cv::Size maxSize;                     ///< 最大目标尺寸（原图像素，空表示不限制）
+    double downscale = 1.0;               ///< 检测前对区域的缩放比例（0.5 表示在半分辨率上检测）
+    cv::Rect roi;                         ///< 检测区域（原图坐标，空表示整帧）
+};
+
+/**
+ * @brief 批量检测中的单个请求
+ */
+struct CascadeRequest {
+    std::string cascade;           ///< 级联分类器名称
+    CascadeDetectOptions options;  ///< 检测选项
+};
+
+/**
+ * @brief Haar 级联分类器注册表
+ *
+ * 每个分类器文件只读取一次，内容缓存在内存中；cv::CascadeClassifier 的检测不是线程安全的，
+ * 因此每个线程在第一次使用某个分类器时从内存内容构建自己的副本，之后一直复用。
+ *
+ * 检测输入是预处理后的灰度图（见 preprocess()），同一帧上的多个分类器共享一份预处理结果。
+ */
+class CascadeRegistry {
+  public:
+    /**
+     * @brief 获取进程级共享注册表
+     */
+    static CascadeRegistry& instance();
+
+    CascadeRegistry();
+    ~CascadeRegistry();
+
+    CascadeRegistry(const CascadeRegistry&) = delete;
+    CascadeRegistry& operator=(const CascadeRegistry&) = delete;
+
+    /**
+     * @brief 加载并注册分类器（同名分类器会被替换）
+     * @param name 分类器名称
+     * @param path 分类器 XML 文件路径
+     * @return 是否加载成功
+     */
+    bool load(const std::string& name, const std::string& path);
+
+    /**
+     * @brief 检查分类器是否已注册
+     */
+    bool has(const std::string& name) const;
+
+    /**
+     * @brief 移除分类器（正在进行的检测不受影响）
+     * @return 分类器是否存在
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * @brief 移除所有分类器
+     */
+    void clear();
+
+    /**
+     * @brief 在预处理后的灰度图上检测
+     * @param name 分类器名称
+     * @param gray 预处理后的 8 位灰度图
+     * @param options 检测选项
+     * @return 检测到的矩形（原图坐标，分类器不存在时为空）
+     */
+    std::vector<cv::Rect> detect(const std::string& name,
+                                 const cv::Mat& gray,
+                                 const CascadeDetectOptions& options = CascadeDetectOptions()) const;
+
+    /**
+     * @brief 对同一帧执行多个检测请求
+     * @param frame 原始帧（灰度或 BGR/BGRA）
+     * @param requests 检测请求
+     * @param equalize 预处理时是否做直方图均衡化
+     * @return 与请求一一对应的检测结果
+     *
+     * 帧只转换（和均衡化）一次；整帧请求按缩放比例共享缩小后的图像；各请求在常驻线程池上并行执行。
+     */
+    std::vector<std::vector<cv::Rect>> detectBatch(const cv::Mat& frame,
+                                                   const std::vector<CascadeRequest>& requests,
+                                                   bool equalize = true) const;
+
+    /**
+     * @brief 把帧转换为检测用的灰度图
+     * @param frame 原始帧
+     * @param gray 输出灰度图（复用缓冲区）
+     * @param equalize 是否做直方图均衡化
+     * @return 帧是否有效
+     */
+    static bool preprocess(const cv::Mat& frame, cv::Mat& gray, bool equalize = true);
+
+  private:
+    struct Entry;
+
+    std::shared_ptr<Entry> find(const std::string& name) const;
+    static std::vector<cv::Rect> detectInGray(Entry& entry,
+                                              const cv::Mat& gray,
+                                              const CascadeDetectOptions& options);
+    static std::vector<cv::Rect> detectScaled(Entry& entry,
+                                              const cv::Mat& image,
+                                              double scale,
+                                              cv::Point offset,
+                                              const CascadeDetectOptions& options);
+
+    mutable std::shared_mutex m_mutex;                                  ///< 保护 m_entries
+    std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;  ///< 已注册的分类器
+};
+
+}  // namespace oneday::image
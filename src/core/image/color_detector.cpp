@@ -0,0 +1,318 @@
+#include "color_detector.h"
+
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+#include "../common/logger.h"
+#include "../common/parallel_utils.h"
+
+using oneday::common::ParallelUtils;
+using oneday::core::Logger;
+
+namespace oneday::image {
+
+namespace {
+
+constexpr int kRowsPerBlock = 16;  // 每个并行任务处理的行数
+
+/**
+ * @brief 取值是否落在范围内（wrap 为 true 时下限大于上限表示跨越 0 的区间）
+ */
+bool inRange(int value, double lower, double upper, bool wrap) {
+    if (wrap && lower > upper) {
+        return value >= lower || value <= upper;
+    }
+    return value >= lower && value <= upper;
+}
+
+}  // namespace
+
+ColorDetector::ColorDetector(const ColorDetectOptions& options) : m_options(options) {}
+
+ColorDetector::~ColorDetector() = default;
+
+int ColorDetector::addColor(const std::string& name, const std::vector<ColorRange>& ranges) {
+    if (ranges.empty()) {
+        Logger::error("Color {} has no ranges", name);
+        return -1;
+    }
+    if (findColor(name) >= 0) {
+        Logger::error("Color already exists: {}", name);
+        return -1;
+    }
+    if (m_ranges.size() + ranges.size() > static_cast<size_t>(kMaxRanges)) {
+        Logger::error("Too many color ranges (at most {})", kMaxRanges);
+        return -1;
+    }
+
+    Color color;
+    color.name = name;
+    for (const ColorRange& range : ranges) {
+        color.bits |= 1u << m_ranges.size();
+        m_ranges.push_back(range);
+    }
+    m_colors.push_back(std::move(color));
+    rebuildTables();
+
+    ONEDAY_LOG_DEBUG("Color added: {} ({} ranges)", name, ranges.size());
+    return static_cast<int>(m_colors.size()) - 1;
+}
+
+void ColorDetector::clear() {
+    m_colors.clear();
+    m_ranges.clear();
+    rebuildTables();
+}
+
+int ColorDetector::findColor(const std::string& name) const {
+    for (size_t i = 0; i < m_colors.size(); ++i) {
+        if (m_colors[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void ColorDetector::setOptions(const ColorDetectOptions& options) {
+    const bool spaceChanged = options.useHsv != m_options.useHsv;
+    m_options = options;
+    if (spaceChanged) {
+        rebuildTables();
+    }
+}
+
+bool ColorDetector::computeMasks(const cv::Mat& frame) {
+    if (frame.empty()) {
+        Logger::error("Input image is empty");
+        return false;
+    }
+    if (frame.depth() != CV_8U || (frame.channels() != 3 && frame.channels() != 4)) {
+        Logger::error("Color detection requires an 8-bit BGR or BGRA image");
+        return false;
+    }
+    if (m_colors.empty()) {
+        Logger::error("No colors to detect");
+        return false;
+    }
+
+    const cv::Rect bounds(0, 0, frame.cols, frame.rows);
+    const cv::Rect region = m_options.roi.empty() ? bounds : m_options.roi & bounds;
+    if (region.empty()) {
+        Logger::error("Detection region is outside the image");
+        return false;
+    }
+    m_region = region;
+    for (Color& color : m_colors) {
+        color.mask.create(region.size(), CV_8UC1);
+    }
+
+    const cv::Mat source = frame(region);
+    const bool useHsv = m_options.useHsv;
+    const int width = region.width;
+    const size_t blocks = static_cast<size_t>((region.height + kRowsPerBlock - 1) / kRowsPerBlock);
+
+    ParallelUtils::parallel_for(0, blocks, [&](size_t block) {
+        // 行块的颜色转换结果和范围位按线程复用
+        thread_local cv::Mat bgr;
+        thread_local cv::Mat hsv;
+        thread_local std::vector<uint32_t> bits;
+        bits.resize(static_cast<size_t>(width));
+
+        const int rowBegin = static_cast<int>(block) * kRowsPerBlock;
+        const int rowEnd = std::min(rowBegin + kRowsPerBlock, region.height);
+        cv::Mat pixels = source.rowRange(rowBegin, rowEnd);
+        if (useHsv) {
+            if (pixels.channels() == 4) {
+                cv::cvtColor(pixels, bgr, cv::COLOR_BGRA2BGR);
+                pixels = bgr;
+            }
+            cv::cvtColor(pixels, hsv, cv::COLOR_BGR2HSV);
+            pixels = hsv;
+        }
+
+        const int channels = pixels.channels();
+        const uint32_t* table0 = m_tables[0];
+        const uint32_t* table1 = m_tables[1];
+        const uint32_t* table2 = m_tables[2];
+        uint32_t* hits = bits.data();
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            const uchar* pixel = pixels.ptr<uchar>(y - rowBegin);
+            for (int x = 0; x < width; ++x, pixel += channels) {
+                hits[x] = table0[pixel[0]] & table1[pixel[1]] & table2[pixel[2]];
+            }
+
+            // 每个颜色的掩码是对范围位的一次按位判断，循环可由编译器向量化
+            for (Color& color : m_colors) {
+                const uint32_t colorBits = color.bits;
+                uchar* mask = color.mask.ptr<uchar>(y);
+                for (int x = 0; x < width; ++x) {
+                    mask[x] = (hits[x] & colorBits) != 0 ? 255 : 0;
+                }
+            }
+        }
+    });
+
+    return true;
+}
+
+const cv::Mat& ColorDetector::getMask(int color) const {
+    if (color < 0 || color >= static_cast<int>(m_colors.size())) {
+        return m_empty;
+    }
+    return m_colors[static_cast<size_t>(color)].mask;
+}
+
+std::vector<ColorBlob> ColorDetector::detect(const cv::Mat& frame) {
+    if (!computeMasks(frame)) {
+        return {};
+    }
+
+    const int connectivity = m_options.connectivity == 4 ? 4 : 8;
+    const int minArea = std::max(m_options.minArea, 1);
+    const cv::Point offset = m_region.tl();
+    std::vector<std::vector<ColorBlob>> perColor(m_colors.size());
+
+    ParallelUtils::parallel_for(0, m_colors.size(), [&](size_t index) {
+        Color& color = m_colors[index];
+        const int count = cv::connectedComponentsWithStats(color.mask, color.labels, color.stats,
+                                                           color.centroids, connectivity, CV_32S);
+        std::vector<ColorBlob>& blobs = perColor[index];
+        for (int label = 1; label < count; ++label) {
+            const int area = color.stats.at<int>(label, cv::CC_STAT_AREA);
+            if (area < minArea) {
+                continue;
+            }
+            ColorBlob blob;
+            blob.color = static_cast<int>(index);
+            blob.area = area;
+            blob.boundingBox = cv::Rect(color.stats.at<int>(label, cv::CC_STAT_LEFT) + offset.x,
+                                        color.stats.at<int>(label, cv::CC_STAT_TOP) + offset.y,
+                                        color.stats.at<int>(label, cv::CC_STAT_WIDTH),
+                                        color.stats.at<int>(label, cv::CC_STAT_HEIGHT));
+            blob.centroid = cv::Point2d(color.centroids.at<double>(label, 0) + offset.x,
+                                        color.centroids.at<double>(label, 1) + offset.y);
+            blobs.push_back(blob);
+        }
+        std::sort(blobs.begin(), blobs.end(),
+                  [](const ColorBlob& a, const ColorBlob& b) { return a.area > b.area; });
+    });
+
+    std::vector<ColorBlob> result;
+    for (const auto& blobs : perColor) {
+        result.insert(result.end(), blobs.begin(), blobs.end());
+    }
+
+    ONEDAY_LOG_DEBUG("Color detection: {} blobs in {}x{} region", result.size(), m_region.width,
+                     m_region.height);
+    return result;
+}
+
+void ColorDetector::rebuildTables() {
+    for (int channel = 0; channel < 3; ++channel) {
+        // 只有 HSV 的色相通道允许跨越 0 的区间
+        const bool wrap = m_options.useHsv && channel == 0;
+        for (int value = 0; value < 256; ++value) {
+            uint32_t bits = 0;
+            for (size_t i = 0; i < m_ranges.size(); ++i) {
+                if (inRange(value, m_ranges[i].lower[channel], m_ranges[i].upper[channel], wrap)) {
+                    bits |= 1u << i;
+                }
+            }
+            m_tables[channel][value] = bits;
+        }
+    }
+}
+
+BlobTracker::BlobTracker(const BlobTrackerOptions& options) : m_options(options) {}
+
+const std::vector<TrackedBlob>& BlobTracker::update(const std::vector<ColorBlob>& blobs) {
+    // 候选匹配：同颜色且预测位置在最大距离内，按距离从近到远贪心分配
+    std::vector<std::tuple<double, size_t, size_t>> candidates;
+    for (size_t t = 0; t < m_tracks.size(); ++t) {
+        const TrackedBlob& track = m_tracks[t];
+        const cv::Point2d predicted =
+            track.blob.centroid + track.velocity * static_cast<double>(track.missedFrames + 1);
+        for (size_t b = 0; b < blobs.size(); ++b) {
+            if (blobs[b].color != track.blob.color) {
+                continue;
+            }
+            const double distance = cv::norm(blobs[b].centroid - predicted);
+            if (distance <= m_options.maxDistance) {
+                candidates.emplace_back(distance, t, b);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    const double smoothing = std::clamp(m_options.smoothing, 0.0, 1.0);
+    std::vector<bool> trackMatched(m_tracks.size(), false);
+    std::vector<bool> blobMatched(blobs.size(), false);
+    for (const auto& [distance, t, b] : candidates) {
+        if (trackMatched[t] || blobMatched[b]) {
+            continue;
+        }
+        trackMatched[t] = true;
+        blobMatched[b] = true;
+
+        TrackedBlob& track = m_tracks[t];
+        const cv::Point2d displacement = (blobs[b].centroid - track.blob.centroid) *
+                                         (1.0 / static_cast<double>(track.missedFrames + 1));
+        track.velocity = displacement * smoothing + track.velocity * (1.0 - smoothing);
+        track.blob = blobs[b];
+        track.missedFrames = 0;
+        ++track.age;
+    }
+
+    for (size_t t = 0; t < m_tracks.size(); ++t) {
+        if (!trackMatched[t]) {
+            ++m_tracks[t].missedFrames;
+            ++m_tracks[t].age;
+        }
+    }
+    m_tracks.erase(std::remove_if(m_tracks.begin(), m_tracks.end(),
+                                  [this](const TrackedBlob& track) {
+                                      return track.missedFrames > m_options.maxMissedFrames;
+                                  }),
+                   m_tracks.end());
+
+    for (size_t b = 0; b < blobs.size(); ++b) {
+        if (!blobMatched[b]) {
+            TrackedBlob track;
+            track.id = m_nextId++;
+            track.blob = blobs[b];
+            track.age = 1;
+            m_tracks.push_back(track);
+        }
+    }
+    return m_tracks;
+}
+
+const TrackedBlob* BlobTracker::find(int id) const {
+    for (const TrackedBlob& track : m_tracks) {
+        if (track.id == id) {
+            return &track;
+        }
+    }
+    return nullptr;
+}
+
+cv::Rect BlobTracker::predictRegion(int id, int margin) const {
+    const TrackedBlob* track = find(id);
+    if (!track) {
+        return cv::Rect();
+    }
+
+    const cv::Point2d shift = track->velocity * static_cast<double>(track->missedFrames + 1);
+    const cv::Rect& box = track->blob.boundingBox;
+    return cv::Rect(box.x + cvRound(shift.x) - margin, box.y + cvRound(shift.y) - margin,
+                    box.width + 2 * margin, box.height + 2 * margin);
+}
+
+void BlobTracker::reset() {
+    m_tracks.clear();
+    m_nextId = 1;
+}
+
+}  // namespace oneday::image
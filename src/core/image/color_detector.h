@@ -0,0 +1,198 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace oneday::image {
+
+/**
+ * @brief 颜色范围（闭区间）
+ *
+ * HSV 模式下通道依次为 H(0-179)、S、V，H 的下限大于上限时表示跨越 0 的色相区间（例如红色 170-10）；
+ * BGR 模式下通道依次为 B、G、R。
+ */
+struct ColorRange {
+    cv::Scalar lower;  ///< 各通道下限
+    cv::Scalar upper;  ///< 各通道上限
+};
+
+/**
+ * @brief 颜色检测参数
+ */
+struct ColorDetectOptions {
+    bool useHsv = true;    ///< 在 HSV 空间判断（否则直接在 BGR 空间判断）
+    int minArea = 10;      ///< 保留的最小色块面积（像素）
+    int connectivity = 8;  ///< 连通域邻接方式（4 或 8）
+    cv::Rect roi;          ///< 检测区域（空表示整帧）
+};
+
+/**
+ * @brief 检测到的色块
+ */
+struct ColorBlob {
+    int color = -1;        ///< 颜色索引（addColor 的返回值）
+    cv::Point2d centroid;  ///< 质心（原图坐标）
+    int area = 0;          ///< 面积（像素）
+    cv::Rect boundingBox;  ///< 外接矩形（原图坐标）
+};
+
+/**
+ * @brief 多颜色范围检测器
+ *
+ * 每个颜色由一个或多个范围组成，所有范围在一次遍历中完成判断：每个范围占一位，
+ * 预先为三个通道各建 256 项的位掩码查找表，像素命中的范围为三次查表结果按位与，
+ * 与范围数量无关。行块在常驻线程池上并行，HSV 转换按行块调用 cv::cvtColor，
+ * 各颜色的二值掩码由位掩码一次写出，随后各颜色并行做连通域分析。
+ */
+class ColorDetector {
+  public:
+    static constexpr int kMaxRanges = 32;  ///< 所有颜色的范围总数上限
+
+    explicit ColorDetector(const ColorDetectOptions& options = ColorDetectOptions());
+    ~ColorDetector();
+
+    /**
+     * @brief 添加要检测的颜色
+     * @param name 颜色名称
+     * @param ranges 颜色范围（像素落在任一范围内即属于该颜色）
+     * @return 颜色索引，失败时为 -1
+     */
+    int addColor(const std::string& name, const std::vector<ColorRange>& ranges);
+
+    /**
+     * @brief 移除所有颜色
+     */
+    void clear();
+
+    /**
+     * @brief 获取颜色数量
+     */
+    size_t getColorCount() const { return m_colors.size(); }
+
+    /**
+     * @brief 按名称查找颜色索引，不存在时返回 -1
+     */
+    int findColor(const std::string& name) const;
+
+    /**
+     * @brief 设置检测参数
+     */
+    void setOptions(const ColorDetectOptions& options);
+
+    /**
+     * @brief 获取检测参数
+     */
+    const ColorDetectOptions& getOptions() const { return m_options; }
+
+    /**
+     * @brief 计算各颜色的二值掩码
+     * @param frame 输入图像（BGR 或 BGRA，8 位）
+     * @return 是否成功
+     */
+    bool computeMasks(const cv::Mat& frame);
+
+    /**
+     * @brief 获取最近一次计算的颜色掩码（与检测区域同尺寸，命中为 255）
+     */
+    const cv::Mat& getMask(int color) const;
+
+    /**
+     * @brief 检测所有颜色的色块
+     * @param frame 输入图像（BGR 或 BGRA，8 位）
+     * @return 色块列表，同一颜色按面积从大到小排列
+     */
+    std::vector<ColorBlob> detect(const cv::Mat& frame);
+
+  private:
+    /**
+     * @brief 要检测的颜色
+     */
+    struct Color {
+        std::string name;   ///< 颜色名称
+        uint32_t bits = 0;  ///< 该颜色的范围位
+        cv::Mat mask;       ///< 二值掩码（帧间复用）
+        cv::Mat labels;     ///< 连通域标签
+        cv::Mat stats;      ///< 连通域统计
+        cv::Mat centroids;  ///< 连通域质心
+    };
+
+    void rebuildTables();
+
+    ColorDetectOptions m_options;      ///< 检测参数
+    std::vector<Color> m_colors;       ///< 颜色
+    std::vector<ColorRange> m_ranges;  ///< 所有范围（下标即范围位）
+    uint32_t m_tables[3][256] = {};    ///< 各通道取值命中的范围位
+    cv::Rect m_region;                 ///< 最近一次计算的检测区域
+    cv::Mat m_empty;                   ///< 无效颜色时返回的空掩码
+};
+
+/**
+ * @brief 色块跟踪参数
+ */
+struct BlobTrackerOptions {
+    double maxDistance = 40.0;  ///< 预测位置与色块质心的最大匹配距离（像素）
+    int maxMissedFrames = 5;    ///< 连续丢失超过该帧数后删除跟踪
+    double smoothing = 0.5;     ///< 速度平滑系数（0-1，越大越跟随最新位移）
+};
+
+/**
+ * @brief 被跟踪的色块
+ */
+struct TrackedBlob {
+    int id = 0;            ///< 跟踪编号（跟踪期间不变）
+    ColorBlob blob;        ///< 最近一次匹配到的色块
+    cv::Point2d velocity;  ///< 每帧位移
+    int age = 0;           ///< 已跟踪的帧数
+    int missedFrames = 0;  ///< 连续丢失的帧数
+};
+
+/**
+ * @brief 帧间色块跟踪
+ *
+ * 按「上一位置 + 速度」预测每个跟踪的位置，与本帧同颜色色块按距离从近到远贪心匹配。
+ * 每帧开销与色块数量的平方成正比，适合血条、小地图标记等少量目标。
+ */
+class BlobTracker {
+  public:
+    explicit BlobTracker(const BlobTrackerOptions& options = BlobTrackerOptions());
+
+    /**
+     * @brief 用本帧检测结果更新跟踪
+     * @param blobs 本帧的色块
+     * @return 当前所有跟踪（包括本帧丢失但尚未删除的）
+     */
+    const std::vector<TrackedBlob>& update(const std::vector<ColorBlob>& blobs);
+
+    /**
+     * @brief 获取当前所有跟踪
+     */
+    const std::vector<TrackedBlob>& getTracks() const { return m_tracks; }
+
+    /**
+     * @brief 按编号查找跟踪，不存在时返回 nullptr
+     */
+    const TrackedBlob* find(int id) const;
+
+    /**
+     * @brief 预测跟踪在下一帧的外接矩形并向外扩展，可作为下一帧的检测区域
+     * @param id 跟踪编号
+     * @param margin 扩展像素
+     * @return 预测区域，跟踪不存在时为空
+     */
+    cv::Rect predictRegion(int id, int margin) const;
+
+    /**
+     * @brief 清除所有跟踪
+     */
+    void reset();
+
+  private:
+    BlobTrackerOptions m_options;       ///< 跟踪参数
+    std::vector<TrackedBlob> m_tracks;  ///< 当前跟踪
+    int m_nextId = 1;                   ///< 下一个跟踪编号
+};
+
+}  // namespace oneday::image
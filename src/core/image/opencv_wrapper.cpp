@@ -5,6 +5,7 @@
 #include <opencv2/opencv.hpp>
 
 #include "../common/logger.h"
+#include "tiled_filter.h"
 
 using oneday::core::Logger;
 
@@ -12,7 +13,7 @@ namespace oneday::image {
 
 OpenCVWrapper::OpenCVWrapper() {
     Logger::info("OpenCV Wrapper initialized");
-    Logger::info("OpenCV Version: " + std::string(CV_VERSION));
+    Logger::info("OpenCV Version: {}", CV_VERSION);
 }
 
 OpenCVWrapper::~OpenCVWrapper() {
@@ -23,10 +24,9 @@ cv::Mat OpenCVWrapper::loadImage(const std::string& filename, int flags) {
     cv::Mat image = cv::imread(filename, flags);
 
     if (image.empty()) {
-        Logger::error("Failed to load image: " + filename);
+        Logger::error("Failed to load image: {}", filename);
     } else {
-        Logger::info("Image loaded successfully: " + filename + " (" + std::to_string(image.cols) +
-                     "x" + std::to_string(image.rows) + ")");
+        Logger::info("Image loaded successfully: {} ({}x{})", filename, image.cols, image.rows);
     }
 
     return image;
@@ -40,9 +40,9 @@ bool OpenCVWrapper::saveImage(const cv::Mat& image, const std::string& filename)
 
     bool success = cv::imwrite(filename, image);
     if (success) {
-        Logger::info("Image saved successfully: " + filename);
+        Logger::info("Image saved successfully: {}", filename);
     } else {
-        Logger::error("Failed to save image: " + filename);
+        Logger::error("Failed to save image: {}", filename);
     }
 
     return success;
@@ -57,9 +57,7 @@ cv::Mat OpenCVWrapper::resize(const cv::Mat& src, const cv::Size& dsize, int int
     cv::Mat dst;
     cv::resize(src, dst, dsize, 0, 0, interpolation);
 
-    Logger::debug("Image resized from " + std::to_string(src.cols) + "x" +
-                  std::to_string(src.rows) + " to " + std::to_string(dst.cols) + "x" +
-                  std::to_string(dst.rows));
+    ONEDAY_LOG_DEBUG("Image resized from {}x{} to {}x{}", src.cols, src.rows, dst.cols, dst.rows);
 
     return dst;
 }
@@ -73,7 +71,7 @@ cv::Mat OpenCVWrapper::convertColor(const cv::Mat& src, int code) {
     cv::Mat dst;
     cv::cvtColor(src, dst, code);
 
-    Logger::debug("Color conversion applied, code: " + std::to_string(code));
+    ONEDAY_LOG_DEBUG("Color conversion applied, code: {}", code);
     return dst;
 }
 
@@ -89,7 +87,7 @@ cv::Mat OpenCVWrapper::gaussianBlur(const cv::Mat& src,
     cv::Mat dst;
     cv::GaussianBlur(src, dst, ksize, sigmaX, sigmaY);
 
-    Logger::debug("Gaussian blur applied");
+    ONEDAY_LOG_DEBUG("Gaussian blur applied");
     return dst;
 }
 
@@ -113,7 +111,7 @@ cv::Mat OpenCVWrapper::cannyEdgeDetection(const cv::Mat& src,
 
     cv::Canny(gray, edges, threshold1, threshold2, apertureSize);
 
-    Logger::debug("Canny edge detection completed");
+    ONEDAY_LOG_DEBUG("Canny edge detection completed");
     return edges;
 }
 
@@ -140,7 +138,7 @@ std::vector<cv::Vec3f> OpenCVWrapper::houghCircles(const cv::Mat& src,
     std::vector<cv::Vec3f> circles;
     cv::HoughCircles(gray, circles, method, dp, minDist, param1, param2, minRadius, maxRadius);
 
-    Logger::info("Detected " + std::to_string(circles.size()) + " circles");
+    Logger::info("Detected {} circles", circles.size());
     return circles;
 }
 
@@ -160,7 +158,7 @@ std::vector<cv::Vec4i> OpenCVWrapper::houghLines(const cv::Mat& src,
     std::vector<cv::Vec4i> lines;
     cv::HoughLinesP(src, lines, rho, theta, threshold, 50, 10);
 
-    Logger::info("Detected " + std::to_string(lines.size()) + " lines");
+    Logger::info("Detected {} lines", lines.size());
     return lines;
 }
 
@@ -177,7 +175,7 @@ std::vector<std::vector<cv::Point>> OpenCVWrapper::findContours(const cv::Mat& s
 
     cv::findContours(src, contours, hierarchy, mode, method);
 
-    Logger::info("Found " + std::to_string(contours.size()) + " contours");
+    Logger::info("Found {} contours", contours.size());
     return contours;
 }
 
@@ -193,7 +191,7 @@ cv::Mat OpenCVWrapper::morphologyEx(const cv::Mat& src,
     cv::Mat dst;
     cv::morphologyEx(src, dst, op, kernel, cv::Point(-1, -1), iterations);
 
-    Logger::debug("Morphology operation applied");
+    ONEDAY_LOG_DEBUG("Morphology operation applied");
     return dst;
 }
 
@@ -206,7 +204,7 @@ cv::Mat OpenCVWrapper::threshold(const cv::Mat& src, double thresh, double maxva
     cv::Mat dst;
     cv::threshold(src, dst, thresh, maxval, type);
 
-    Logger::debug("Threshold applied: " + std::to_string(thresh));
+    ONEDAY_LOG_DEBUG("Threshold applied: {}", thresh);
     return dst;
 }
 
@@ -224,7 +222,59 @@ cv::Mat OpenCVWrapper::adaptiveThreshold(const cv::Mat& src,
     cv::Mat dst;
     cv::adaptiveThreshold(src, dst, maxValue, adaptiveMethod, thresholdType, blockSize, C);
 
-    Logger::debug("Adaptive threshold applied");
+    ONEDAY_LOG_DEBUG("Adaptive threshold applied");
+    return dst;
+}
+
+cv::Mat OpenCVWrapper::bilateralFilterTiled(const cv::Mat& src,
+                                            int d,
+                                            double sigmaColor,
+                                            double sigmaSpace) {
+    cv::Mat dst;
+    if (!TiledFilter::bilateralFilter(src, dst, d, sigmaColor, sigmaSpace)) {
+        return cv::Mat();
+    }
+
+    ONEDAY_LOG_DEBUG("Tiled bilateral filter applied");
+    return dst;
+}
+
+cv::Mat OpenCVWrapper::medianBlurTiled(const cv::Mat& src, int ksize) {
+    cv::Mat dst;
+    if (!TiledFilter::medianBlur(src, dst, ksize)) {
+        return cv::Mat();
+    }
+
+    ONEDAY_LOG_DEBUG("Tiled median blur applied with kernel size: {}", ksize);
+    return dst;
+}
+
+cv::Mat OpenCVWrapper::adaptiveThresholdTiled(const cv::Mat& src,
+                                              double maxValue,
+                                              int adaptiveMethod,
+                                              int thresholdType,
+                                              int blockSize,
+                                              double C) {
+    cv::Mat dst;
+    if (!TiledFilter::adaptiveThreshold(src, dst, maxValue, adaptiveMethod, thresholdType,
+                                        blockSize, C)) {
+        return cv::Mat();
+    }
+
+    ONEDAY_LOG_DEBUG("Tiled adaptive threshold applied");
+    return dst;
+}
+
+cv::Mat OpenCVWrapper::morphologyExTiled(const cv::Mat& src,
+                                         int op,
+                                         const cv::Mat& kernel,
+                                         int iterations) {
+    cv::Mat dst;
+    if (!TiledFilter::morphologyEx(src, dst, op, kernel, iterations)) {
+        return cv::Mat();
+    }
+
+    ONEDAY_LOG_DEBUG("Tiled morphology operation applied");
     return dst;
 }
 
@@ -252,7 +302,7 @@ cv::Mat OpenCVWrapper::equalizeHist(const cv::Mat& src) {
         cv::cvtColor(yuv, dst, cv::COLOR_YUV2BGR);
     }
 
-    Logger::debug("Histogram equalization applied");
+    ONEDAY_LOG_DEBUG("Histogram equalization applied");
     return dst;
 }
 
@@ -268,7 +318,7 @@ cv::Mat OpenCVWrapper::bilateralFilter(const cv::Mat& src,
     cv::Mat dst;
     cv::bilateralFilter(src, dst, d, sigmaColor, sigmaSpace);
 
-    Logger::debug("Bilateral filter applied");
+    ONEDAY_LOG_DEBUG("Bilateral filter applied");
     return dst;
 }
 
@@ -281,7 +331,7 @@ cv::Mat OpenCVWrapper::medianBlur(const cv::Mat& src, int ksize) {
     cv::Mat dst;
     cv::medianBlur(src, dst, ksize);
 
-    Logger::debug("Median blur applied with kernel size: " + std::to_string(ksize));
+    ONEDAY_LOG_DEBUG("Median blur applied with kernel size: {}", ksize);
     return dst;
 }
 
@@ -292,7 +342,7 @@ cv::Rect OpenCVWrapper::boundingRect(const std::vector<cv::Point>& points) {
     }
 
     cv::Rect rect = cv::boundingRect(points);
-    Logger::debug("Bounding rectangle calculated");
+    ONEDAY_LOG_DEBUG("Bounding rectangle calculated");
     return rect;
 }
 
@@ -303,7 +353,7 @@ double OpenCVWrapper::contourArea(const std::vector<cv::Point>& contour) {
     }
 
     double area = cv::contourArea(contour);
-    Logger::debug("Contour area calculated: " + std::to_string(area));
+    ONEDAY_LOG_DEBUG("Contour area calculated: {}", area);
     return area;
 }
 
@@ -314,7 +364,7 @@ double OpenCVWrapper::arcLength(const std::vector<cv::Point>& curve, bool closed
     }
 
     double length = cv::arcLength(curve, closed);
-    Logger::debug("Arc length calculated: " + std::to_string(length));
+    ONEDAY_LOG_DEBUG("Arc length calculated: {}", length);
     return length;
 }
 
@@ -329,7 +379,7 @@ std::vector<cv::Point> OpenCVWrapper::approxPolyDP(const std::vector<cv::Point>&
     std::vector<cv::Point> approx;
     cv::approxPolyDP(curve, approx, epsilon, closed);
 
-    Logger::debug("Polygon approximation completed, points: " + std::to_string(approx.size()));
+    ONEDAY_LOG_DEBUG("Polygon approximation completed, points: {}", approx.size());
     return approx;
 }
 
@@ -337,7 +387,7 @@ cv::Mat OpenCVWrapper::getStructuringElement(int shape,
                                              const cv::Size& ksize,
                                              const cv::Point& anchor) {
     cv::Mat element = cv::getStructuringElement(shape, ksize, anchor);
-    Logger::debug("Structuring element created");
+    ONEDAY_LOG_DEBUG("Structuring element created");
     return element;
 }
 
@@ -196,6 +196,49 @@ public:
     cv::Mat adaptiveThreshold(const cv::Mat& src, double maxValue, int adaptiveMethod, 
                              int thresholdType, int blockSize, double C);
     
+    // === 分块并行处理（大尺寸截图） ===
+    
+    /**
+     * @brief 分块并行双边滤波，结果与 bilateralFilter 一致
+     * @param src 源图像
+     * @param d 像素邻域直径
+     * @param sigmaColor 颜色空间标准差
+     * @param sigmaSpace 坐标空间标准差
+     * @return 滤波后的图像
+     */
+    cv::Mat bilateralFilterTiled(const cv::Mat& src, int d, double sigmaColor, double sigmaSpace);
+    
+    /**
+     * @brief 分块并行中值滤波，结果与 medianBlur 一致
+     * @param src 源图像
+     * @param ksize 核大小
+     * @return 滤波后的图像
+     */
+    cv::Mat medianBlurTiled(const cv::Mat& src, int ksize);
+    
+    /**
+     * @brief 分块并行自适应阈值处理，结果与 adaptiveThreshold 一致
+     * @param src 源图像
+     * @param maxValue 最大值
+     * @param adaptiveMethod 自适应方法
+     * @param thresholdType 阈值类型
+     * @param blockSize 块大小
+     * @param C 常数
+     * @return 处理后的图像
+     */
+    cv::Mat adaptiveThresholdTiled(const cv::Mat& src, double maxValue, int adaptiveMethod,
+                                  int thresholdType, int blockSize, double C);
+    
+    /**
+     * @brief 分块并行形态学操作，结果与 morphologyEx 一致
+     * @param src 源图像
+     * @param op 操作类型
+     * @param kernel 结构元素
+     * @param iterations 迭代次数
+     * @return 处理后的图像
+     */
+    cv::Mat morphologyExTiled(const cv::Mat& src, int op, const cv::Mat& kernel, int iterations = 1);
+    
     // === 直方图处理 ===
     
     /**
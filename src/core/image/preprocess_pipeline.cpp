@@ -0,0 +1,424 @@
+#include "preprocess_pipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "../common/logger.h"
+#include "../common/parallel_utils.h"
+
+using oneday::common::ParallelUtils;
+using oneday::core::Logger;
+
+namespace oneday::image {
+
+namespace {
+
+constexpr int kRowsPerBlock = 16;  // 合并遍历中每个并行任务处理的行数
+
+// cv::cvtColor 8 位灰度转换使用的定点系数（14 位小数）
+constexpr int kGrayShift = 14;
+constexpr int kGrayR = 4899;
+constexpr int kGrayG = 9617;
+constexpr int kGrayB = 1868;
+
+}  // namespace
+
+PreprocessPipeline::PreprocessPipeline() = default;
+
+PreprocessPipeline::~PreprocessPipeline() = default;
+
+PreprocessPipeline& PreprocessPipeline::resize(const cv::Size& size, int interpolation) {
+    Stage stage;
+    stage.type = StageType::Resize;
+    stage.size = size;
+    stage.code = interpolation;
+    return addStage(stage);
+}
+
+PreprocessPipeline& PreprocessPipeline::convertColor(int code) {
+    Stage stage;
+    stage.type = StageType::ConvertColor;
+    stage.code = code;
+    return addStage(stage);
+}
+
+PreprocessPipeline& PreprocessPipeline::gaussianBlur(const cv::Size& kernelSize,
+                                                     double sigmaX,
+                                                     double sigmaY) {
+    Stage stage;
+    stage.type = StageType::GaussianBlur;
+    stage.size = kernelSize;
+    stage.alpha = sigmaX;
+    stage.beta = sigmaY;
+    return addStage(stage);
+}
+
+PreprocessPipeline& PreprocessPipeline::adjustContrast(double alpha, int beta) {
+    Stage stage;
+    stage.type = StageType::AdjustContrast;
+    stage.alpha = alpha;
+    stage.beta = beta;
+    return addStage(stage);
+}
+
+PreprocessPipeline& PreprocessPipeline::equalizeHistogram() {
+    Stage stage;
+    stage.type = StageType::EqualizeHistogram;
+    return addStage(stage);
+}
+
+PreprocessPipeline& PreprocessPipeline::normalize(double scale,
+                                                  const cv::Scalar& mean,
+                                                  const cv::Scalar& stddev) {
+    Stage stage;
+    stage.type = StageType::Normalize;
+    stage.alpha = scale;
+    stage.mean = mean;
+    stage.stddev = stddev;
+    return addStage(stage);
+}
+
+void PreprocessPipeline::clear() {
+    m_stages.clear();
+    m_steps.clear();
+    m_passthrough.release();
+    m_compiled = false;
+}
+
+size_t PreprocessPipeline::getPassCount() {
+    if (!m_compiled) {
+        compile();
+    }
+    return m_steps.size();
+}
+
+bool PreprocessPipeline::prepare(const cv::Size& inputSize, int inputType) {
+    // 用同尺寸的空白帧跑一遍，让各步骤按实际输出尺寸分配缓冲区
+    const cv::Mat blank(inputSize, inputType, cv::Scalar::all(0));
+    return !run(blank).empty();
+}
+
+const cv::Mat& PreprocessPipeline::run(const cv::Mat& input) {
+    if (input.empty()) {
+        Logger::error("Input image is empty");
+        return m_empty;
+    }
+    if (!m_compiled) {
+        compile();
+    }
+    if (m_steps.empty()) {
+        input.copyTo(m_passthrough);
+        return m_passthrough;
+    }
+
+    const cv::Mat* current = &input;
+    for (Step& step : m_steps) {
+        const bool ok = step.ops.empty() ? runStep(step, *current) : runFused(step, *current);
+        if (!ok) {
+            return m_empty;
+        }
+        current = &step.output;
+    }
+    return *current;
+}
+
+PreprocessPipeline& PreprocessPipeline::addStage(const Stage& stage) {
+    m_stages.push_back(stage);
+    m_compiled = false;
+    return *this;
+}
+
+void PreprocessPipeline::compile() {
+    m_steps.clear();
+    for (const Stage& stage : m_stages) {
+        PixelOp op;
+        bool fusable = true;
+        switch (stage.type) {
+            case StageType::AdjustContrast:
+                op.kind = PixelOp::Kind::Affine;
+                op.alpha = stage.alpha;
+                op.beta = stage.beta;
+                break;
+            case StageType::Normalize:
+                op.kind = PixelOp::Kind::Normalize;
+                op.alpha = stage.alpha;
+                for (int c = 0; c < 4; ++c) {
+                    op.mean[c] = stage.mean[c];
+                    op.invStd[c] = stage.stddev[c] != 0.0 ? 1.0 / stage.stddev[c] : 1.0;
+                }
+                break;
+            case StageType::ConvertColor:
+                fusable = makeColorOp(stage.code, op);
+                break;
+            default:
+                fusable = false;
+                break;
+        }
+
+        if (!fusable) {
+            Step step;
+            step.stage = stage;
+            m_steps.push_back(std::move(step));
+        } else {
+            // 与前一个合并遍历相邻时并入同一遍
+            if (m_steps.empty() || m_steps.back().ops.empty()) {
+                m_steps.emplace_back();
+            }
+            m_steps.back().ops.push_back(op);
+        }
+    }
+    m_compiled = true;
+
+    ONEDAY_LOG_DEBUG("Preprocess pipeline compiled: {} stages in {} passes", m_stages.size(),
+                     m_steps.size());
+}
+
+bool PreprocessPipeline::runStep(Step& step, const cv::Mat& input) {
+    const Stage& stage = step.stage;
+    switch (stage.type) {
+        case StageType::Resize:
+            cv::resize(input, step.output, stage.size, 0, 0, stage.code);
+            return true;
+        case StageType::ConvertColor:
+            cv::cvtColor(input, step.output, stage.code);
+            return true;
+        case StageType::GaussianBlur:
+            cv::GaussianBlur(input, step.output, stage.size, stage.alpha, stage.beta);
+            return true;
+        case StageType::EqualizeHistogram:
+            if (input.depth() != CV_8U) {
+                Logger::error("Histogram equalization requires an 8-bit image");
+                return false;
+            }
+            if (input.channels() == 1) {
+                cv::equalizeHist(input, step.output);
+                return true;
+            }
+            if (input.channels() != 3) {
+                Logger::error("Histogram equalization requires 1 or 3 channels");
+                return false;
+            }
+            // 彩色图只均衡亮度通道，YUV 图和亮度通道都使用步骤自己的缓冲区
+            cv::cvtColor(input, step.scratch, cv::COLOR_BGR2YUV);
+            cv::extractChannel(step.scratch, step.channel, 0);
+            cv::equalizeHist(step.channel, step.channel);
+            cv::insertChannel(step.channel, step.scratch, 0);
+            cv::cvtColor(step.scratch, step.output, cv::COLOR_YUV2BGR);
+            return true;
+        default:
+            Logger::error("Unexpected preprocess stage");
+            return false;
+    }
+}
+
+bool PreprocessPipeline::runFused(Step& step, const cv::Mat& input) {
+    const int depth = input.depth();
+    if (depth != CV_8U && depth != CV_32F) {
+        Logger::error("Preprocess pipeline supports 8-bit and float images only");
+        return false;
+    }
+
+    // 先按通道数检查整条操作链，得到输出类型和行缓冲所需的最大通道数
+    int channels = input.channels();
+    int maxChannels = channels;
+    bool integral = depth == CV_8U;
+    for (const PixelOp& op : step.ops) {
+        if (op.inChannels != 0 && op.inChannels != channels) {
+            Logger::error("Preprocess stage expects {} channels, got {}", op.inChannels, channels);
+            return false;
+        }
+        if (op.outChannels != 0) {
+            channels = op.outChannels;
+        }
+        if (op.kind == PixelOp::Kind::Normalize) {
+            integral = false;
+        }
+        maxChannels = std::max(maxChannels, channels);
+    }
+    if (maxChannels > 4) {
+        Logger::error("Preprocess pipeline supports up to 4 channels");
+        return false;
+    }
+
+    const int outputDepth = integral ? CV_8U : CV_32F;
+    step.output.create(input.size(), CV_MAKETYPE(outputDepth, channels));
+
+    const int rows = input.rows;
+    const int cols = input.cols;
+    const int inputChannels = input.channels();
+    const size_t blocks = static_cast<size_t>((rows + kRowsPerBlock - 1) / kRowsPerBlock);
+    const std::vector<PixelOp>& ops = step.ops;
+    cv::Mat& output = step.output;
+
+    ParallelUtils::parallel_for(0, blocks, [&](size_t block) {
+        // 两个行缓冲在线程内复用，每行在缓存中完成整条操作链
+        thread_local std::vector<float> buffer;
+        const size_t rowSize = static_cast<size_t>(cols) * static_cast<size_t>(maxChannels);
+        if (buffer.size() < rowSize * 2) {
+            buffer.resize(rowSize * 2);
+        }
+
+        const int rowBegin = static_cast<int>(block) * kRowsPerBlock;
+        const int rowEnd = std::min(rowBegin + kRowsPerBlock, rows);
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            float* current = buffer.data();
+            float* next = buffer.data() + rowSize;
+            int cn = inputChannels;
+            bool rowIntegral = depth == CV_8U;
+
+            const int inputCount = cols * cn;
+            if (depth == CV_8U) {
+                const uchar* src = input.ptr<uchar>(y);
+                for (int i = 0; i < inputCount; ++i) {
+                    current[i] = src[i];
+                }
+            } else {
+                std::memcpy(current, input.ptr<float>(y), sizeof(float) * inputCount);
+            }
+
+            for (const PixelOp& op : ops) {
+                const int count = cols * cn;
+                switch (op.kind) {
+                    case PixelOp::Kind::Affine: {
+                        const float alpha = static_cast<float>(op.alpha);
+                        const float beta = static_cast<float>(op.beta);
+                        if (rowIntegral) {
+                            // 与 convertTo 到 8 位一致：就近取整（偶数舍入）后饱和
+                            for (int i = 0; i < count; ++i) {
+                                current[i] = std::clamp(std::nearbyint(current[i] * alpha + beta),
+                                                        0.0f, 255.0f);
+                            }
+                        } else {
+                            for (int i = 0; i < count; ++i) {
+                                current[i] = current[i] * alpha + beta;
+                            }
+                        }
+                        break;
+                    }
+                    case PixelOp::Kind::Mix: {
+                        const int outCn = op.outChannels;
+                        for (int x = 0; x < cols; ++x) {
+                            const float* pixel = current + x * cn;
+                            float* out = next + x * outCn;
+                            for (int k = 0; k < outCn; ++k) {
+                                out[k] = pixel[op.source[k]];
+                            }
+                        }
+                        std::swap(current, next);
+                        cn = outCn;
+                        break;
+                    }
+                    case PixelOp::Kind::Gray: {
+                        const int r = op.source[0];
+                        const int g = op.source[1];
+                        const int b = op.source[2];
+                        if (rowIntegral) {
+                            // 与 cv::cvtColor 的 8 位定点实现逐位一致
+                            for (int x = 0; x < cols; ++x) {
+                                const float* pixel = current + x * cn;
+                                const int value = static_cast<int>(pixel[r]) * kGrayR +
+                                                  static_cast<int>(pixel[g]) * kGrayG +
+                                                  static_cast<int>(pixel[b]) * kGrayB +
+                                                  (1 << (kGrayShift - 1));
+                                next[x] = static_cast<float>(value >> kGrayShift);
+                            }
+                        } else {
+                            for (int x = 0; x < cols; ++x) {
+                                const float* pixel = current + x * cn;
+                                next[x] = 0.299f * pixel[r] + 0.587f * pixel[g] + 0.114f * pixel[b];
+                            }
+                        }
+                        std::swap(current, next);
+                        cn = 1;
+                        break;
+                    }
+                    case PixelOp::Kind::Normalize: {
+                        const float scale = static_cast<float>(op.alpha);
+                        float mean[4];
+                        float invStd[4];
+                        for (int k = 0; k < 4; ++k) {
+                            mean[k] = static_cast<float>(op.mean[k]);
+                            invStd[k] = static_cast<float>(op.invStd[k]);
+                        }
+                        if (cn == 1) {
+                            for (int i = 0; i < count; ++i) {
+                                current[i] = (current[i] * scale - mean[0]) * invStd[0];
+                            }
+                        } else {
+                            for (int x = 0; x < cols; ++x) {
+                                float* pixel = current + x * cn;
+                                for (int k = 0; k < cn; ++k) {
+                                    pixel[k] = (pixel[k] * scale - mean[k]) * invStd[k];
+                                }
+                            }
+                        }
+                        rowIntegral = false;
+                        break;
+                    }
+                }
+            }
+
+            const int outputCount = cols * cn;
+            if (outputDepth == CV_8U) {
+                uchar* dst = output.ptr<uchar>(y);
+                for (int i = 0; i < outputCount; ++i) {
+                    dst[i] = static_cast<uchar>(current[i]);
+                }
+            } else {
+                std::memcpy(output.ptr<float>(y), current, sizeof(float) * outputCount);
+            }
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief 把可合并的颜色转换码翻译为逐像素操作（其他转换码返回 false）
+ */
+bool PreprocessPipeline::makeColorOp(int code, PixelOp& op) {
+    using Kind = PixelOp::Kind;
+    auto gray = [&op](int channels, int r, int g, int b) {
+        op.kind = Kind::Gray;
+        op.inChannels = channels;
+        op.outChannels = 1;
+        op.source[0] = r;
+        op.source[1] = g;
+        op.source[2] = b;
+        return true;
+    };
+    auto mix = [&op](int inChannels, int outChannels, std::initializer_list<int> source) {
+        op.kind = Kind::Mix;
+        op.inChannels = inChannels;
+        op.outChannels = outChannels;
+        std::copy(source.begin(), source.end(), op.source);
+        return true;
+    };
+
+    // 注意 OpenCV 中互逆的重排转换码数值相同（如 BGR2RGB == RGB2BGR），每个数值只能出现一次
+    switch (code) {
+        case cv::COLOR_BGR2GRAY:
+            return gray(3, 2, 1, 0);
+        case cv::COLOR_RGB2GRAY:
+            return gray(3, 0, 1, 2);
+        case cv::COLOR_BGRA2GRAY:
+            return gray(4, 2, 1, 0);
+        case cv::COLOR_RGBA2GRAY:
+            return gray(4, 0, 1, 2);
+        case cv::COLOR_BGR2RGB:
+            return mix(3, 3, {2, 1, 0});
+        case cv::COLOR_BGRA2BGR:
+            return mix(4, 3, {0, 1, 2});
+        case cv::COLOR_BGRA2RGB:
+            return mix(4, 3, {2, 1, 0});
+        case cv::COLOR_BGRA2RGBA:
+            return mix(4, 4, {2, 1, 0, 3});
+        case cv::COLOR_GRAY2BGR:
+            return mix(1, 3, {0, 0, 0});
+        default:
+            return false;
+    }
+}
+
+}  // namespace oneday::image
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <vector>
+
+namespace oneday::image {
+
+/**
+ * @brief 声明式预处理流水线
+ *
+ * 先用链式调用描述处理阶段，之后每帧调用 run()。每个处理步骤的输出缓冲区由流水线持有并在帧间复用，
+ * 帧尺寸不变时不再分配内存（可用 prepare() 提前分配）。
+ *
+ * 相邻的逐像素阶段（对比度/亮度、通道重排与灰度转换、归一化）合并为一次遍历：每行读入一次，
+ * 在 L1 中的行缓冲上依次应用各阶段后写出一次，行内循环可由编译器向量化，行块在常驻线程池上并行。
+ * 合并后的结果与逐个调用 ImageProcessor 对应方法一致（8 位中间结果同样取整并饱和）。
+ *
+ * 示例：
+ * @code
+ * PreprocessPipeline pipeline;
+ * pipeline.resize({640, 360}).adjustContrast(1.2, 10).convertColor(cv::COLOR_BGR2GRAY)
+ *         .normalize(1.0 / 255.0);
+ * const cv::Mat& input = pipeline.run(frame);
+ * @endcode
+ */
+class PreprocessPipeline {
+  public:
+    PreprocessPipeline();
+    ~PreprocessPipeline();
+
+    /**
+     * @brief 调整尺寸（同 ImageProcessor::resize）
+     */
+    PreprocessPipeline& resize(const cv::Size& size, int interpolation = cv::INTER_LINEAR);
+
+    /**
+     * @brief 转换颜色空间（通道重排和转灰度可以合并，其他转换码单独调用 cv::cvtColor）
+     */
+    PreprocessPipeline& convertColor(int code);
+
+    /**
+     * @brief 高斯模糊（同 ImageProcessor::applyGaussianBlur）
+     */
+    PreprocessPipeline& gaussianBlur(const cv::Size& kernelSize, double sigmaX, double sigmaY = 0);
+
+    /**
+     * @brief 对比度和亮度调整 alpha * x + beta（同 ImageProcessor::enhanceContrast）
+     */
+    PreprocessPipeline& adjustContrast(double alpha, int beta = 0);
+
+    /**
+     * @brief 直方图均衡化（同 ImageProcessor::applyHistogramEqualization，彩色图只均衡亮度）
+     */
+    PreprocessPipeline& equalizeHistogram();
+
+    /**
+     * @brief 归一化为浮点图：(x * scale - mean[c]) / stddev[c]
+     */
+    PreprocessPipeline& normalize(double scale,
+                                  const cv::Scalar& mean = cv::Scalar::all(0),
+                                  const cv::Scalar& stddev = cv::Scalar::all(1));
+
+    /**
+     * @brief 移除所有阶段并释放缓冲区
+     */
+    void clear();
+
+    /**
+     * @brief 获取声明的阶段数量
+     */
+    size_t getStageCount() const { return m_stages.size(); }
+
+    /**
+     * @brief 获取合并后每帧实际执行的遍数
+     */
+    size_t getPassCount();
+
+    /**
+     * @brief 按输入尺寸和类型预先分配所有中间缓冲区
+     * @return 流水线对该输入是否有效
+     */
+    bool prepare(const cv::Size& inputSize, int inputType);
+
+    /**
+     * @brief 处理一帧
+     * @param input 输入图像（8 位或 32 位浮点）
+     * @return 输出图像，由流水线持有，下次 run() 时被覆盖；出错时为空
+     */
+    const cv::Mat& run(const cv::Mat& input);
+
+  private:
+    /**
+     * @brief 阶段类型
+     */
+    enum class StageType {
+        Resize,
+        ConvertColor,
+        GaussianBlur,
+        AdjustContrast,
+        EqualizeHistogram,
+        Normalize
+    };
+
+    /**
+     * @brief 声明的阶段
+     */
+    struct Stage {
+        StageType type = StageType::Resize;  ///< 阶段类型
+        cv::Size size;                       ///< Resize 目标尺寸 / GaussianBlur 核大小
+        int code = 0;                        ///< Resize 插值方式 / ConvertColor 转换码
+        double alpha = 1.0;                  ///< 对比度 / 归一化缩放 / sigmaX
+        double beta = 0.0;                   ///< 亮度 / sigmaY
+        cv::Scalar mean;                     ///< 归一化均值
+        cv::Scalar stddev;                   ///< 归一化标准差
+    };
+
+    /**
+     * @brief 合并遍历中的逐像素操作
+     */
+    struct PixelOp {
+        enum class Kind { Affine, Mix, Gray, Normalize } kind = Kind::Affine;
+        int inChannels = 0;               ///< 要求的输入通道数（0 表示任意）
+        int outChannels = 0;              ///< 输出通道数（0 表示与输入相同）
+        int source[4] = {0, 1, 2, 3};     ///< Mix：各输出通道取自的输入通道；Gray：R、G、B 所在通道
+        double alpha = 1.0;               ///< Affine 缩放 / Normalize 缩放
+        double beta = 0.0;                ///< Affine 偏移
+        double mean[4] = {0, 0, 0, 0};    ///< Normalize 均值
+        double invStd[4] = {1, 1, 1, 1};  ///< Normalize 标准差倒数
+    };
+
+    /**
+     * @brief 编译后的处理步骤（单个 OpenCV 调用或一次合并遍历）
+     */
+    struct Step {
+        Stage stage;               ///< 非合并步骤对应的阶段
+        std::vector<PixelOp> ops;  ///< 合并遍历的操作（为空表示非合并步骤）
+        cv::Mat output;            ///< 输出缓冲区（帧间复用）
+        cv::Mat scratch;           ///< 直方图均衡化的 YUV 图
+        cv::Mat channel;           ///< 直方图均衡化的亮度通道
+    };
+
+    PreprocessPipeline& addStage(const Stage& stage);
+    void compile();
+    bool runStep(Step& step, const cv::Mat& input);
+    bool runFused(Step& step, const cv::Mat& input);
+    static bool makeColorOp(int code, PixelOp& op);
+
+    std::vector<Stage> m_stages;  ///< 声明的阶段
+    std::vector<Step> m_steps;    ///< 编译后的步骤
+    bool m_compiled = false;      ///< m_steps 是否与 m_stages 一致
+    cv::Mat m_passthrough;        ///< 没有阶段时的输出
+    cv::Mat m_empty;              ///< 出错时返回的空图像
+};
+
+}  // namespace oneday::image
@@ -3,6 +3,7 @@
 #include <opencv2/opencv.hpp>
 
 #include "../common/logger.h"
+#include "cascade_registry.h"
 
 using oneday::core::Logger;
 
@@ -25,7 +26,7 @@ cv::Mat ImageProcessor::processImage(const cv::Mat& input) {
     cv::Mat result;
     input.copyTo(result);
 
-    Logger::debug("Image processed successfully");
+    ONEDAY_LOG_DEBUG("Image processed successfully");
     return result;
 }
 
@@ -38,8 +39,7 @@ cv::Mat ImageProcessor::resize(const cv::Mat& input, const cv::Size& size) {
     cv::Mat result;
     cv::resize(input, result, size);
 
-    Logger::debug("Image resized to " + std::to_string(size.width) + "x" +
-                  std::to_string(size.height));
+    ONEDAY_LOG_DEBUG("Image resized to {}x{}", size.width, size.height);
     return result;
 }
 
@@ -52,7 +52,7 @@ cv::Mat ImageProcessor::convertColorSpace(const cv::Mat& input, int code) {
     cv::Mat result;
     cv::cvtColor(input, result, code);
 
-    Logger::debug("Color space converted");
+    ONEDAY_LOG_DEBUG("Color space converted");
     return result;
 }
 
@@ -68,7 +68,7 @@ cv::Mat ImageProcessor::applyGaussianBlur(const cv::Mat& input,
     cv::Mat result;
     cv::GaussianBlur(input, result, kernelSize, sigmaX, sigmaY);
 
-    Logger::debug("Gaussian blur applied");
+    ONEDAY_LOG_DEBUG("Gaussian blur applied");
     return result;
 }
 
@@ -90,7 +90,7 @@ cv::Mat ImageProcessor::detectEdges(const cv::Mat& input, double threshold1, dou
     // Apply Canny edge detection
     cv::Canny(gray, edges, threshold1, threshold2);
 
-    Logger::debug("Edge detection completed");
+    ONEDAY_LOG_DEBUG("Edge detection completed");
     return edges;
 }
 
@@ -103,9 +103,9 @@ std::vector<cv::Rect> ImageProcessor::detectObjects(const cv::Mat& input,
         return objects;
     }
 
-    cv::CascadeClassifier cascade;
-    if (!cascade.load(cascadePath)) {
-        Logger::error("Failed to load cascade classifier: " + cascadePath);
+    // 分类器按路径注册到共享注册表，只在第一次使用时加载
+    CascadeRegistry& registry = CascadeRegistry::instance();
+    if (!registry.has(cascadePath) && !registry.load(cascadePath, cascadePath)) {
         return objects;
     }
 
@@ -116,9 +116,9 @@ std::vector<cv::Rect> ImageProcessor::detectObjects(const cv::Mat& input,
         gray = input;
     }
 
-    cascade.detectMultiScale(gray, objects, 1.1, 3, 0, cv::Size(30, 30));
+    objects = registry.detect(cascadePath, gray);
 
-    Logger::info("Detected " + std::to_string(objects.size()) + " objects");
+    Logger::info("Detected {} objects", objects.size());
     return objects;
 }
 
@@ -131,7 +131,7 @@ cv::Mat ImageProcessor::enhanceContrast(const cv::Mat& input, double alpha, int
     cv::Mat result;
     input.convertTo(result, -1, alpha, beta);
 
-    Logger::debug("Contrast enhanced");
+    ONEDAY_LOG_DEBUG("Contrast enhanced");
     return result;
 }
 
@@ -160,7 +160,7 @@ cv::Mat ImageProcessor::applyHistogramEqualization(const cv::Mat& input) {
         cv::cvtColor(yuv, result, cv::COLOR_YUV2BGR);
     }
 
-    Logger::debug("Histogram equalization applied");
+    ONEDAY_LOG_DEBUG("Histogram equalization applied");
     return result;
 }
 
@@ -172,9 +172,9 @@ bool ImageProcessor::saveImage(const cv::Mat& image, const std::string& filename
 
     bool success = cv::imwrite(filename, image);
     if (success) {
-        Logger::info("Image saved to: " + filename);
+        Logger::info("Image saved to: {}", filename);
     } else {
-        Logger::error("Failed to save image to: " + filename);
+        Logger::error("Failed to save image to: {}", filename);
     }
 
     return success;
@@ -184,10 +184,9 @@ cv::Mat ImageProcessor::loadImage(const std::string& filename, int flags) {
     cv::Mat image = cv::imread(filename, flags);
 
     if (image.empty()) {
-        Logger::error("Failed to load image: " + filename);
+        Logger::error("Failed to load image: {}", filename);
     } else {
-        Logger::info("Image loaded: " + filename + " (" + std::to_string(image.cols) + "x" +
-                     std::to_string(image.rows) + ")");
+        Logger::info("Image loaded: {} ({}x{})", filename, image.cols, image.rows);
     }
 
     return image;
@@ -69,7 +69,7 @@ public:
     /**
      * @brief 对象检测（使用Haar级联分类器）
      * @param input 输入图像
-     * @param cascadePath 级联分类器文件路径
+     * @param cascadePath 级联分类器文件路径（第一次使用时加载到 CascadeRegistry，之后复用）
      * @return 检测到的对象矩形列表
      */
     std::vector<cv::Rect> detectObjects(const cv::Mat& input, const std::string& cascadePath);
@@ -0,0 +1,535 @@
+#include "template_matcher.h"
+
+#include <opencv2/imgcodecs.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../common/logger.h"
+#include "../common/parallel_utils.h"
+
+using oneday::common::ParallelUtils;
+using oneday::core::Logger;
+
+namespace oneday::image {
+
+/**
+ * @brief 已注册的模板及其缓存
+ */
+struct TemplateMatcher::TemplateEntry {
+    std::string name;                ///< 模板名称
+    double threshold = 0.0;          ///< 匹配阈值
+    std::vector<cv::Mat> pyramid;    ///< 灰度金字塔（第 0 层为原分辨率）
+
+    cv::Mat spectrum;                ///< 最粗层零均值模板的频谱
+    int spectrumLevel = -1;          ///< 频谱对应的层
+    cv::Size spectrumSize;           ///< 频谱对应的 DFT 尺寸
+    double zeroMeanNorm = 0.0;       ///< 零均值模板的平方和
+
+    cv::Mat scores;                  ///< 分数图（复用的缓冲区）
+    cv::Mat product;                 ///< 频谱乘积（复用的缓冲区）
+    cv::Mat correlation;             ///< 互相关结果（复用的缓冲区）
+
+    cv::Rect lastLocation;           ///< 上次找到的位置
+    uint64_t lastSeenFrame = 0;      ///< 上次找到时的帧计数
+    bool tracked = false;            ///< 是否有可用的 ROI
+};
+
+namespace {
+
+/**
+ * @brief 粗层候选位置
+ */
+struct Candidate {
+    cv::Point position;
+    double score = 0.0;
+};
+
+bool isSupportedMethod(int method) {
+    return method == cv::TM_SQDIFF_NORMED || method == cv::TM_CCORR_NORMED ||
+           method == cv::TM_CCOEFF_NORMED;
+}
+
+/**
+ * @brief 转换为 8 位灰度图，复用 dst 的缓冲区
+ */
+bool toGray(const cv::Mat& src, cv::Mat& dst) {
+    switch (src.channels()) {
+        case 1:
+            if (src.depth() == CV_8U) {
+                src.copyTo(dst);
+            } else {
+                src.convertTo(dst, CV_8U);
+            }
+            return true;
+        case 3:
+            cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY);
+            return true;
+        case 4:
+            cv::cvtColor(src, dst, cv::COLOR_BGRA2GRAY);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool fits(const cv::Size& image, const cv::Size& templ) {
+    return image.width >= templ.width && image.height >= templ.height;
+}
+
+/**
+ * @brief 计算分数图，统一为“越大越相似”
+ */
+void computeScores(const cv::Mat& image, const cv::Mat& templ, int method, cv::Mat& scores) {
+    cv::matchTemplate(image, templ, scores, method);
+    if (method == cv::TM_SQDIFF_NORMED) {
+        cv::subtract(cv::Scalar::all(1.0), scores, scores);
+    }
+}
+
+/**
+ * @brief 在分数图中取最多 count 个不重叠的候选（会修改分数图）
+ */
+void extractCandidates(cv::Mat& scores,
+                       const cv::Size& templSize,
+                       int count,
+                       double minScore,
+                       std::vector<Candidate>& candidates) {
+    candidates.clear();
+    const cv::Rect bounds(0, 0, scores.cols, scores.rows);
+    for (int i = 0; i < count; ++i) {
+        double maxVal = 0.0;
+        cv::Point maxLoc;
+        cv::minMaxLoc(scores, nullptr, &maxVal, nullptr, &maxLoc);
+        if (maxVal < minScore) {
+            break;
+        }
+        candidates.push_back({maxLoc, maxVal});
+
+        // 抑制同一目标附近的位置，下一个候选必须与已选候选基本不重叠
+        const cv::Rect suppressed =
+            cv::Rect(maxLoc.x - templSize.width / 2, maxLoc.y - templSize.height / 2,
+                     templSize.width, templSize.height) &
+            bounds;
+        scores(suppressed).setTo(cv::Scalar::all(-std::numeric_limits<float>::max()));
+    }
+}
+
+}  // namespace
+
+TemplateMatcher::TemplateMatcher(const TemplateMatchOptions& options) {
+    setOptions(options);
+}
+
+TemplateMatcher::~TemplateMatcher() = default;
+
+void TemplateMatcher::setOptions(const TemplateMatchOptions& options) {
+    m_options = options;
+    if (!isSupportedMethod(m_options.method)) {
+        Logger::error("Unsupported template match method {}, using TM_CCOEFF_NORMED",
+                      m_options.method);
+        m_options.method = cv::TM_CCOEFF_NORMED;
+    }
+    m_options.pyramidLevels = std::max(0, m_options.pyramidLevels);
+    m_options.minCoarseSize = std::max(1, m_options.minCoarseSize);
+    m_options.coarseCandidates = std::max(1, m_options.coarseCandidates);
+    m_options.refineMargin = std::max(1, m_options.refineMargin);
+    m_options.roiMargin = std::max(0, m_options.roiMargin);
+
+    for (auto& entry : m_templates) {
+        buildTemplatePyramid(*entry);
+    }
+    m_levels.clear();
+    m_sharedFrame.reset();
+    m_hasFrame = false;
+    resetTracking();
+}
+
+bool TemplateMatcher::addTemplate(const std::string& name, const cv::Mat& image, double threshold) {
+    if (image.empty()) {
+        Logger::error("Template image is empty: {}", name);
+        return false;
+    }
+
+    auto entry = std::make_unique<TemplateEntry>();
+    entry->name = name;
+    entry->threshold = threshold < 0.0 ? m_options.threshold : threshold;
+    entry->pyramid.resize(1);
+    if (!toGray(image, entry->pyramid[0])) {
+        Logger::error("Unsupported template image format: {} ({} channels)", name, image.channels());
+        return false;
+    }
+    buildTemplatePyramid(*entry);
+
+    auto it = m_index.find(name);
+    if (it != m_index.end()) {
+        m_templates[it->second] = std::move(entry);
+    } else {
+        m_index.emplace(name, m_templates.size());
+        m_templates.push_back(std::move(entry));
+    }
+
+    ONEDAY_LOG_DEBUG("Template registered: {} ({}x{}, {} levels)", name, image.cols, image.rows,
+                     m_templates[m_index[name]]->pyramid.size());
+    return true;
+}
+
+bool TemplateMatcher::addTemplateFromFile(const std::string& name,
+                                          const std::string& filename,
+                                          double threshold) {
+    const cv::Mat image = cv::imread(filename, cv::IMREAD_UNCHANGED);
+    if (image.empty()) {
+        Logger::error("Failed to load template image: {}", filename);
+        return false;
+    }
+    return addTemplate(name, image, threshold);
+}
+
+bool TemplateMatcher::removeTemplate(const std::string& name) {
+    auto it = m_index.find(name);
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    m_templates.erase(m_templates.begin() + static_cast<std::ptrdiff_t>(it->second));
+    m_index.clear();
+    for (size_t i = 0; i < m_templates.size(); ++i) {
+        m_index.emplace(m_templates[i]->name, i);
+    }
+    return true;
+}
+
+bool TemplateMatcher::hasTemplate(const std::string& name) const {
+    return m_index.find(name) != m_index.end();
+}
+
+void TemplateMatcher::clear() {
+    m_templates.clear();
+    m_index.clear();
+}
+
+void TemplateMatcher::resetTracking() {
+    for (auto& entry : m_templates) {
+        entry->tracked = false;
+    }
+}
+
+bool TemplateMatcher::setFrame(const std::shared_ptr<const cv::Mat>& frame) {
+    if (frame && frame == m_sharedFrame && m_hasFrame) {
+        return true;
+    }
+    const bool valid = frame && setFrame(*frame);
+    m_sharedFrame = valid ? frame : nullptr;
+    return valid;
+}
+
+bool TemplateMatcher::setFrame(const cv::Mat& frame) {
+    m_sharedFrame.reset();
+    if (frame.empty()) {
+        Logger::error("Input image is empty");
+        m_hasFrame = false;
+        return false;
+    }
+
+    const size_t levelCount = static_cast<size_t>(m_options.pyramidLevels) + 1;
+    if (m_levels.size() < levelCount) {
+        m_levels.resize(levelCount);
+    }
+    if (!toGray(frame, m_levels[0].gray)) {
+        Logger::error("Unsupported frame format ({} channels)", frame.channels());
+        m_hasFrame = false;
+        return false;
+    }
+
+    // 帧太小时少建几层，缓冲区在帧尺寸不变时复用
+    size_t built = 1;
+    for (; built < levelCount; ++built) {
+        const cv::Mat& previous = m_levels[built - 1].gray;
+        if (previous.cols < 2 || previous.rows < 2) {
+            break;
+        }
+        cv::pyrDown(previous, m_levels[built].gray);
+    }
+    m_levels.resize(built);
+    for (auto& level : m_levels) {
+        level.hasSpectrum = false;
+    }
+
+    ++m_frameCounter;
+    m_hasFrame = true;
+    if (useSpectrum()) {
+        prepareSpectra();
+    }
+    return true;
+}
+
+TemplateMatch TemplateMatcher::match(const std::string& name) {
+    TemplateMatch result;
+    result.name = name;
+
+    auto it = m_index.find(name);
+    if (it == m_index.end()) {
+        Logger::error("Template not found: {}", name);
+        return result;
+    }
+    if (!m_hasFrame) {
+        Logger::error("No frame set for template matching");
+        return result;
+    }
+
+    matchEntry(*m_templates[it->second], result);
+    return result;
+}
+
+std::vector<TemplateMatch> TemplateMatcher::matchAll() {
+    std::vector<TemplateMatch> results(m_templates.size());
+    if (!m_hasFrame) {
+        Logger::error("No frame set for template matching");
+        for (size_t i = 0; i < m_templates.size(); ++i) {
+            results[i].name = m_templates[i]->name;
+        }
+        return results;
+    }
+
+    // 帧金字塔和频谱只读共享，每个模板只写自己的缓冲区和跟踪状态
+    ParallelUtils::parallel_for(0, m_templates.size(), [this, &results](size_t i) {
+        matchEntry(*m_templates[i], results[i]);
+    });
+    return results;
+}
+
+std::vector<TemplateMatch> TemplateMatcher::matchAll(const cv::Mat& frame) {
+    setFrame(frame);
+    return matchAll();
+}
+
+void TemplateMatcher::buildTemplatePyramid(TemplateEntry& entry) const {
+    entry.pyramid.resize(1);
+    for (int level = 1; level <= m_options.pyramidLevels; ++level) {
+        const cv::Mat& previous = entry.pyramid.back();
+        if (std::min(previous.cols, previous.rows) / 2 < m_options.minCoarseSize) {
+            break;
+        }
+        cv::Mat next;
+        cv::pyrDown(previous, next);
+        entry.pyramid.push_back(std::move(next));
+    }
+    entry.spectrum.release();
+    entry.spectrumLevel = -1;
+}
+
+void TemplateMatcher::matchEntry(TemplateEntry& entry, TemplateMatch& result) {
+    result.name = entry.name;
+    result.found = false;
+    result.fromRoi = false;
+
+    if (!matchInRoi(entry, result)) {
+        matchCoarseToFine(entry, result);
+    }
+
+    if (result.found) {
+        entry.lastLocation = result.location;
+        entry.lastSeenFrame = m_frameCounter;
+        entry.tracked = true;
+    } else if (entry.tracked &&
+               m_frameCounter - entry.lastSeenFrame > static_cast<uint64_t>(m_options.roiLifetimeFrames)) {
+        entry.tracked = false;
+    }
+}
+
+bool TemplateMatcher::matchInRoi(TemplateEntry& entry, TemplateMatch& result) {
+    if (!entry.tracked ||
+        m_frameCounter - entry.lastSeenFrame > static_cast<uint64_t>(m_options.roiLifetimeFrames)) {
+        return false;
+    }
+
+    const cv::Mat& frame = m_levels[0].gray;
+    const cv::Mat& templ = entry.pyramid[0];
+    const int margin = m_options.roiMargin;
+    const cv::Rect roi =
+        cv::Rect(entry.lastLocation.x - margin, entry.lastLocation.y - margin,
+                 templ.cols + 2 * margin, templ.rows + 2 * margin) &
+        cv::Rect(0, 0, frame.cols, frame.rows);
+    if (!fits(roi.size(), templ.size())) {
+        return false;
+    }
+
+    computeScores(frame(roi), templ, m_options.method, entry.scores);
+    double maxVal = 0.0;
+    cv::Point maxLoc;
+    cv::minMaxLoc(entry.scores, nullptr, &maxVal, nullptr, &maxLoc);
+    if (maxVal < entry.threshold) {
+        return false;
+    }
+
+    result.location = cv::Rect(roi.x + maxLoc.x, roi.y + maxLoc.y, templ.cols, templ.rows);
+    result.score = maxVal;
+    result.found = true;
+    result.fromRoi = true;
+    return true;
+}
+
+bool TemplateMatcher::matchCoarseToFine(TemplateEntry& entry, TemplateMatch& result) {
+    const int coarse =
+        std::min(static_cast<int>(entry.pyramid.size()), static_cast<int>(m_levels.size())) - 1;
+    if (!computeCoarseScores(entry, coarse)) {
+        return false;
+    }
+
+    // 只有一层时粗层分数就是最终分数，不放宽阈值
+    const double minScore = coarse > 0 ? entry.threshold - m_options.coarseSlack : entry.threshold;
+    std::vector<Candidate> candidates;
+    extractCandidates(entry.scores, entry.pyramid[coarse].size(), m_options.coarseCandidates,
+                      minScore, candidates);
+
+    const int margin = m_options.refineMargin;
+    Candidate best{cv::Point(), -std::numeric_limits<double>::max()};
+    for (Candidate candidate : candidates) {
+        bool valid = true;
+        for (int level = coarse - 1; level >= 0; --level) {
+            const cv::Mat& image = m_levels[level].gray;
+            const cv::Mat& templ = entry.pyramid[level];
+            const cv::Rect window =
+                cv::Rect(candidate.position.x * 2 - margin, candidate.position.y * 2 - margin,
+                         templ.cols + 2 * margin, templ.rows + 2 * margin) &
+                cv::Rect(0, 0, image.cols, image.rows);
+            if (!fits(window.size(), templ.size())) {
+                valid = false;
+                break;
+            }
+
+            computeScores(image(window), templ, m_options.method, entry.scores);
+            double maxVal = 0.0;
+            cv::Point maxLoc;
+            cv::minMaxLoc(entry.scores, nullptr, &maxVal, nullptr, &maxLoc);
+            candidate.position = window.tl() + maxLoc;
+            candidate.score = maxVal;
+        }
+        if (valid && candidate.score > best.score) {
+            best = candidate;
+        }
+    }
+
+    if (best.score == -std::numeric_limits<double>::max()) {
+        return false;
+    }
+    const cv::Mat& templ = entry.pyramid[0];
+    result.location = cv::Rect(best.position.x, best.position.y, templ.cols, templ.rows);
+    result.score = best.score;
+    result.found = best.score >= entry.threshold;
+    return result.found;
+}
+
+bool TemplateMatcher::computeCoarseScores(TemplateEntry& entry, int level) {
+    const cv::Mat& image = m_levels[level].gray;
+    const cv::Mat& templ = entry.pyramid[level];
+    if (!fits(image.size(), templ.size())) {
+        return false;
+    }
+    if (m_levels[level].hasSpectrum && correlateSpectrum(entry, level)) {
+        return true;
+    }
+    computeScores(image, templ, m_options.method, entry.scores);
+    return true;
+}
+
+bool TemplateMatcher::correlateSpectrum(TemplateEntry& entry, int level) {
+    const FrameLevel& frame = m_levels[level];
+    const cv::Mat& templ = entry.pyramid[level];
+    const cv::Size dftSize = frame.padded.size();
+
+    // 零均值模板的频谱按 DFT 尺寸缓存，帧尺寸不变时只在注册后的第一帧计算一次
+    if (entry.spectrumLevel != level || entry.spectrumSize != dftSize) {
+        cv::Mat zeroMean;
+        templ.convertTo(zeroMean, CV_32F);
+        cv::subtract(zeroMean, cv::mean(zeroMean), zeroMean);
+        entry.zeroMeanNorm = cv::norm(zeroMean, cv::NORM_L2SQR);
+
+        cv::Mat padded;
+        cv::copyMakeBorder(zeroMean, padded, 0, dftSize.height - templ.rows, 0,
+                           dftSize.width - templ.cols, cv::BORDER_CONSTANT, cv::Scalar::all(0));
+        cv::dft(padded, entry.spectrum, 0, templ.rows);
+        entry.spectrumLevel = level;
+        entry.spectrumSize = dftSize;
+    }
+    if (entry.zeroMeanNorm < 1e-6) {
+        // 纯色模板没有归一化相关系数的定义，交给 matchTemplate 处理
+        return false;
+    }
+
+    // 帧补零到 DFT 尺寸后，循环互相关在 [0, W - w] x [0, H - h] 内不会回绕，
+    // 结果即为模板与各窗口的（零均值）互相关
+    cv::mulSpectrums(frame.spectrum, entry.spectrum, entry.product, 0, true);
+    cv::dft(entry.product, entry.correlation,
+            cv::DFT_INVERSE | cv::DFT_SCALE | cv::DFT_REAL_OUTPUT);
+
+    const int cols = frame.gray.cols - templ.cols + 1;
+    const int rows = frame.gray.rows - templ.rows + 1;
+    const int tw = templ.cols;
+    const int th = templ.rows;
+    const double area = static_cast<double>(templ.total());
+    entry.scores.create(rows, cols, CV_32F);
+
+    // TM_CCOEFF_NORMED：分母用积分图求窗口方差
+    for (int y = 0; y < rows; ++y) {
+        const double* sumTop = frame.sum.ptr<double>(y);
+        const double* sumBottom = frame.sum.ptr<double>(y + th);
+        const double* sqTop = frame.sqsum.ptr<double>(y);
+        const double* sqBottom = frame.sqsum.ptr<double>(y + th);
+        const float* correlation = entry.correlation.ptr<float>(y);
+        float* out = entry.scores.ptr<float>(y);
+        for (int x = 0; x < cols; ++x) {
+            const double sum = sumBottom[x + tw] - sumBottom[x] - sumTop[x + tw] + sumTop[x];
+            const double sq = sqBottom[x + tw] - sqBottom[x] - sqTop[x + tw] + sqTop[x];
+            const double variance = sq - sum * sum / area;
+            const double denominator = variance * entry.zeroMeanNorm;
+            if (variance <= area * 1e-6 || denominator <= 0.0) {
+                out[x] = 0.0f;
+                continue;
+            }
+            const double score = correlation[x] / std::sqrt(denominator);
+            out[x] = static_cast<float>(std::clamp(score, -1.0, 1.0));
+        }
+    }
+    return true;
+}
+
+void TemplateMatcher::prepareSpectra() {
+    // 只为至少两个模板共用的粗层计算频谱，单个模板直接 matchTemplate 更省
+    std::vector<int> usage(m_levels.size(), 0);
+    for (const auto& entry : m_templates) {
+        const size_t coarse = std::min(entry->pyramid.size(), m_levels.size()) - 1;
+        if (coarse > 0) {
+            ++usage[coarse];
+        }
+    }
+
+    for (size_t index = 0; index < m_levels.size(); ++index) {
+        if (usage[index] < 2) {
+            continue;
+        }
+        FrameLevel& level = m_levels[index];
+        const cv::Mat& gray = level.gray;
+        const cv::Size dftSize(cv::getOptimalDFTSize(gray.cols), cv::getOptimalDFTSize(gray.rows));
+
+        level.padded.create(dftSize, CV_32F);
+        cv::Mat view = level.padded(cv::Rect(0, 0, gray.cols, gray.rows));
+        gray.convertTo(view, CV_32F);
+        if (dftSize.width > gray.cols) {
+            level.padded(cv::Rect(gray.cols, 0, dftSize.width - gray.cols, gray.rows)).setTo(0);
+        }
+        if (dftSize.height > gray.rows) {
+            level.padded(cv::Rect(0, gray.rows, dftSize.width, dftSize.height - gray.rows)).setTo(0);
+        }
+        cv::dft(level.padded, level.spectrum, 0, gray.rows);
+        cv::integral(gray, level.sum, level.sqsum, CV_64F, CV_64F);
+        level.hasSpectrum = true;
+    }
+}
+
+bool TemplateMatcher::useSpectrum() const {
+    return m_options.useFFT && m_options.method == cv::TM_CCOEFF_NORMED;
+}
+
+}  // namespace oneday::image
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oneday::image {
+
+/**
+ * @brief 模板匹配选项
+ */
+struct TemplateMatchOptions {
+    int pyramidLevels = 2;              ///< 金字塔降采样层数（0 表示只在原分辨率匹配）
+    int minCoarseSize = 8;              ///< 模板在最粗层的最小边长，决定模板实际使用的层数
+    int method = cv::TM_CCOEFF_NORMED;  ///< 匹配方法（仅支持归一化方法）
+    double threshold = 0.85;            ///< 默认匹配阈值（分数越高越相似）
+    double coarseSlack = 0.2;           ///< 粗层候选阈值比匹配阈值低的量
+    int coarseCandidates = 3;           ///< 粗层保留的候选数量
+    int refineMargin = 4;               ///< 逐层细化时候选位置周围的搜索余量（像素）
+    int roiMargin = 24;                 ///< ROI 搜索时在上次位置周围扩展的余量（像素）
+    int roiLifetimeFrames = 30;         ///< 目标丢失多少帧后不再使用 ROI
+    bool useFFT = true;                 ///< 粗层全帧搜索共享帧频谱（仅 TM_CCOEFF_NORMED）
+};
+
+/**
+ * @brief 单个模板的匹配结果
+ */
+struct TemplateMatch {
+    std::string name;      ///< 模板名称
+    bool found = false;    ///< 分数是否达到阈值
+    cv::Rect location;     ///< 最佳位置（原帧坐标）
+    double score = 0.0;    ///< 最佳分数（SQDIFF 方法换算为 1 - 差异）
+    bool fromRoi = false;  ///< 是否在上次位置附近的 ROI 内找到
+};
+
+/**
+ * @brief 多尺度模板匹配器
+ *
+ * 注册模板时预先计算灰度金字塔；每帧只构建一次帧金字塔（以及粗层频谱和积分图），
+ * 由所有模板共享。每个模板先在最粗层搜索少量候选，再逐层在候选附近细化到原分辨率。
+ * 最近找到过的模板先在上次位置附近的 ROI 内直接以原分辨率匹配，失败时才回退到全帧搜索。
+ *
+ * matchAll() 在常驻线程池上并行处理各模板。setFrame() 与匹配调用不能并发。
+ */
+class TemplateMatcher {
+  public:
+    /**
+     * @brief 构造函数
+     * @param options 匹配选项
+     */
+    explicit TemplateMatcher(const TemplateMatchOptions& options = TemplateMatchOptions());
+
+    /**
+     * @brief 析构函数
+     */
+    ~TemplateMatcher();
+
+    /**
+     * @brief 设置匹配选项（会清空已缓存的频谱和 ROI 状态，已注册的模板按新选项重建金字塔）
+     */
+    void setOptions(const TemplateMatchOptions& options);
+
+    /**
+     * @brief 获取匹配选项
+     */
+    const TemplateMatchOptions& getOptions() const { return m_options; }
+
+    /**
+     * @brief 注册模板（同名模板会被替换）
+     * @param name 模板名称
+     * @param image 模板图像（灰度或 BGR/BGRA）
+     * @param threshold 该模板的匹配阈值（小于 0 时使用选项中的默认阈值）
+     * @return 是否注册成功
+     */
+    bool addTemplate(const std::string& name, const cv::Mat& image, double threshold = -1.0);
+
+    /**
+     * @brief 从文件注册模板
+     * @param name 模板名称
+     * @param filename 图像文件名
+     * @param threshold 该模板的匹配阈值（小于 0 时使用默认阈值）
+     * @return 是否注册成功
+     */
+    bool addTemplateFromFile(const std::string& name,
+                             const std::string& filename,
+                             double threshold = -1.0);
+
+    /**
+     * @brief 移除模板
+     * @return 模板是否存在
+     */
+    bool removeTemplate(const std::string& name);
+
+    /**
+     * @brief 检查模板是否已注册
+     */
+    bool hasTemplate(const std::string& name) const;
+
+    /**
+     * @brief 获取已注册模板数量
+     */
+    size_t getTemplateCount() const { return m_templates.size(); }
+
+    /**
+     * @brief 移除所有模板
+     */
+    void clear();
+
+    /**
+     * @brief 清除所有模板的 ROI 跟踪状态（例如切换场景后）
+     */
+    void resetTracking();
+
+    /**
+     * @brief 设置当前帧：转换为灰度并构建帧金字塔，帧计数加一
+     * @param frame 采集的帧（灰度或 BGR/BGRA）
+     * @return 帧是否有效
+     */
+    bool setFrame(const cv::Mat& frame);
+
+    /**
+     * @brief 设置共享的帧对象（与当前帧是同一对象时直接返回，多个调用方共用匹配器时只建一次金字塔）
+     * @param frame 采集的帧，设置后不应再修改
+     * @return 帧是否有效
+     */
+    bool setFrame(const std::shared_ptr<const cv::Mat>& frame);
+
+    /**
+     * @brief 在当前帧中匹配单个模板
+     * @param name 模板名称
+     * @return 匹配结果（模板不存在或没有设置帧时 found 为 false）
+     */
+    TemplateMatch match(const std::string& name);
+
+    /**
+     * @brief 在当前帧中并行匹配所有模板
+     * @return 按注册顺序排列的匹配结果
+     */
+    std::vector<TemplateMatch> matchAll();
+
+    /**
+     * @brief 设置帧并匹配所有模板
+     */
+    std::vector<TemplateMatch> matchAll(const cv::Mat& frame);
+
+  private:
+    struct TemplateEntry;
+
+    /**
+     * @brief 单层帧数据（灰度图、积分图、频谱）
+     */
+    struct FrameLevel {
+        cv::Mat gray;       ///< 灰度图（CV_8U）
+        cv::Mat sum;        ///< 积分图（CV_64F，仅 FFT 路径）
+        cv::Mat sqsum;      ///< 平方积分图（CV_64F，仅 FFT 路径）
+        cv::Mat padded;     ///< 补零到 DFT 尺寸的浮点图
+        cv::Mat spectrum;   ///< 帧频谱（CCS 打包格式）
+        bool hasSpectrum = false;  ///< 本帧是否计算了频谱
+    };
+
+    void buildTemplatePyramid(TemplateEntry& entry) const;
+    void matchEntry(TemplateEntry& entry, TemplateMatch& result);
+    bool matchInRoi(TemplateEntry& entry, TemplateMatch& result);
+    bool matchCoarseToFine(TemplateEntry& entry, TemplateMatch& result);
+    bool computeCoarseScores(TemplateEntry& entry, int level);
+    bool correlateSpectrum(TemplateEntry& entry, int level);
+    void prepareSpectra();
+    bool useSpectrum() const;
+
+    TemplateMatchOptions m_options;                           ///< 匹配选项
+    std::vector<std::unique_ptr<TemplateEntry>> m_templates;  ///< 按注册顺序存放的模板
+    std::unordered_map<std::string, size_t> m_index;          ///< 名称到下标的映射
+    std::vector<FrameLevel> m_levels;                         ///< 当前帧金字塔
+    std::shared_ptr<const cv::Mat> m_sharedFrame;             ///< 通过共享对象设置的当前帧
+    uint64_t m_frameCounter = 0;                              ///< 已设置的帧数
+    bool m_hasFrame = false;                                  ///< 是否已设置帧
+};
+
+}  // namespace oneday::image
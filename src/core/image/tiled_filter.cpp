@@ -0,0 +1,222 @@
+#include "tiled_filter.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "../common/logger.h"
+#include "../common/parallel_utils.h"
+
+using oneday::common::ParallelUtils;
+using oneday::core::Logger;
+
+namespace oneday::image {
+
+namespace {
+
+constexpr int kTilesPerThread = 4;  ///< 自动分块时每个线程分到的块数
+constexpr int kMinTileExtent = 32;  ///< 自动分块的最小边长
+
+/**
+ * @brief 形态学操作在源图像上连续执行的遍数（开/闭运算先腐蚀再膨胀或相反）
+ */
+int morphologyPasses(int op) {
+    switch (op) {
+        case cv::MORPH_OPEN:
+        case cv::MORPH_CLOSE:
+        case cv::MORPH_TOPHAT:
+        case cv::MORPH_BLACKHAT:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+}  // namespace
+
+bool TiledFilter::bilateralFilter(const cv::Mat& src,
+                                  cv::Mat& dst,
+                                  int d,
+                                  double sigmaColor,
+                                  double sigmaSpace,
+                                  const TileOptions& options) {
+    if (src.depth() != CV_8U && src.depth() != CV_32F) {
+        Logger::error("Bilateral filter requires an 8-bit or 32-bit float image");
+        return false;
+    }
+
+    // 与 cv::bilateralFilter 计算半径的方式一致
+    const int radius = std::max(d > 0 ? d / 2 : cvRound(sigmaSpace * 1.5), 1);
+    return apply(
+        src, dst, src.type(), cv::Size(radius, radius),
+        [=](const cv::Mat& input, cv::Mat& output) {
+            cv::bilateralFilter(input, output, d, sigmaColor, sigmaSpace);
+        },
+        options);
+}
+
+bool TiledFilter::medianBlur(const cv::Mat& src,
+                             cv::Mat& dst,
+                             int ksize,
+                             const TileOptions& options) {
+    if (ksize < 3 || ksize % 2 == 0) {
+        Logger::error("Invalid median kernel size: {}", ksize);
+        return false;
+    }
+
+    return apply(
+        src, dst, src.type(), cv::Size(ksize / 2, ksize / 2),
+        [=](const cv::Mat& input, cv::Mat& output) { cv::medianBlur(input, output, ksize); },
+        options);
+}
+
+bool TiledFilter::adaptiveThreshold(const cv::Mat& src,
+                                    cv::Mat& dst,
+                                    double maxValue,
+                                    int adaptiveMethod,
+                                    int thresholdType,
+                                    int blockSize,
+                                    double C,
+                                    const TileOptions& options) {
+    if (src.type() != CV_8UC1) {
+        Logger::error("Adaptive threshold requires a single-channel 8-bit image");
+        return false;
+    }
+    if (blockSize < 3 || blockSize % 2 == 0) {
+        Logger::error("Invalid adaptive threshold block size: {}", blockSize);
+        return false;
+    }
+
+    return apply(
+        src, dst, CV_8UC1, cv::Size(blockSize / 2, blockSize / 2),
+        [=](const cv::Mat& input, cv::Mat& output) {
+            cv::adaptiveThreshold(input, output, maxValue, adaptiveMethod, thresholdType,
+                                  blockSize, C);
+        },
+        options);
+}
+
+bool TiledFilter::morphologyEx(const cv::Mat& src,
+                               cv::Mat& dst,
+                               int op,
+                               const cv::Mat& kernel,
+                               int iterations,
+                               const TileOptions& options) {
+    // 空核与 OpenCV 一致按 3x3 矩形处理；锚点在中心时每次迭代向各方向扩展半个核
+    const cv::Size kernelSize = kernel.empty() ? cv::Size(3, 3) : kernel.size();
+    const int passes = op == cv::MORPH_HITMISS ? 1 : morphologyPasses(op) * std::max(iterations, 1);
+    const cv::Size halo(kernelSize.width / 2 * passes, kernelSize.height / 2 * passes);
+
+    return apply(
+        src, dst, src.type(), halo,
+        [op, kernel, iterations](const cv::Mat& input, cv::Mat& output) {
+            cv::morphologyEx(input, output, op, kernel, cv::Point(-1, -1), iterations);
+        },
+        options);
+}
+
+bool TiledFilter::apply(const cv::Mat& src,
+                        cv::Mat& dst,
+                        int dstType,
+                        const cv::Size& halo,
+                        const TileFunction& function,
+                        const TileOptions& options) {
+    if (src.empty()) {
+        Logger::error("Input image is empty");
+        return false;
+    }
+    if (halo.width < 0 || halo.height < 0) {
+        Logger::error("Invalid tile halo: {}x{}", halo.width, halo.height);
+        return false;
+    }
+
+    const std::vector<cv::Rect> tiles =
+        src.total() < static_cast<size_t>(std::max(options.minTilePixels, 0))
+            ? std::vector<cv::Rect>{cv::Rect(0, 0, src.cols, src.rows)}
+            : makeTiles(src.size(), halo, options);
+
+    if (tiles.size() <= 1) {
+        cv::Mat output;
+        function(src, output);
+        if (output.size() != src.size() || output.type() != dstType) {
+            Logger::error("Tile function produced an unexpected output");
+            return false;
+        }
+        dst = output;
+        return true;
+    }
+
+    // 原地处理时各块还要读取邻块的原始像素，需要单独的输出图像
+    cv::Mat output;
+    if (dst.data == src.data) {
+        output.create(src.size(), dstType);
+    } else {
+        dst.create(src.size(), dstType);
+        output = dst;
+    }
+
+    const cv::Rect bounds(0, 0, src.cols, src.rows);
+    std::atomic<bool> succeeded{true};
+    ParallelUtils::parallel_for(0, tiles.size(), [&](size_t i) {
+        const cv::Rect& inner = tiles[i];
+        const cv::Rect outer = cv::Rect(inner.x - halo.width, inner.y - halo.height,
+                                        inner.width + 2 * halo.width,
+                                        inner.height + 2 * halo.height) &
+                               bounds;
+
+        // 块输出缓冲区按线程复用，帧尺寸不变时不再分配；滤波输出包含 halo，只复制内部区域
+        thread_local cv::Mat tileOutput;
+        function(src(outer), tileOutput);
+        if (tileOutput.size() != outer.size() || tileOutput.type() != dstType) {
+            succeeded = false;
+            return;
+        }
+        tileOutput(cv::Rect(inner.tl() - outer.tl(), inner.size())).copyTo(output(inner));
+    });
+
+    if (!succeeded) {
+        Logger::error("Tile function produced an unexpected output");
+        return false;
+    }
+    if (output.data != dst.data) {
+        dst = output;
+    }
+
+    ONEDAY_LOG_DEBUG("Tiled filter: {} tiles on {}x{} image, halo {}x{}", tiles.size(), src.cols,
+                     src.rows, halo.width, halo.height);
+    return true;
+}
+
+std::vector<cv::Rect> TiledFilter::makeTiles(const cv::Size& imageSize,
+                                             const cv::Size& halo,
+                                             const TileOptions& options) {
+    std::vector<cv::Rect> tiles;
+    if (imageSize.empty()) {
+        return tiles;
+    }
+
+    // 自动分块取整行宽的横条：输出 ROI 连续，只有上下两条 halo 被重复计算
+    int tileWidth = options.tileSize.width > 0 ? options.tileSize.width : imageSize.width;
+    int tileHeight = options.tileSize.height;
+    if (tileHeight <= 0) {
+        const int tileCount =
+            static_cast<int>(ParallelUtils::getRecommendedThreadCount()) * kTilesPerThread;
+        tileHeight = (imageSize.height + tileCount - 1) / tileCount;
+        tileHeight = std::max(tileHeight, kMinTileExtent);
+    }
+
+    // 块不小于两倍 halo，否则重复计算的像素会多于有效像素
+    tileWidth = std::min(std::max(tileWidth, 2 * halo.width), imageSize.width);
+    tileHeight = std::min(std::max(tileHeight, 2 * halo.height), imageSize.height);
+    tileWidth = std::max(tileWidth, 1);
+    tileHeight = std::max(tileHeight, 1);
+
+    for (int y = 0; y < imageSize.height; y += tileHeight) {
+        for (int x = 0; x < imageSize.width; x += tileWidth) {
+            tiles.emplace_back(x, y, std::min(tileWidth, imageSize.width - x),
+                               std::min(tileHeight, imageSize.height - y));
+        }
+    }
+    return tiles;
+}
+
+}  // namespace oneday::image
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace oneday::image {
+
+/**
+ * @brief 分块参数
+ */
+struct TileOptions {
+    cv::Size tileSize;             ///< 分块大小（0 表示自动：宽度取整行，高度按线程数划分约 4 块/线程）
+    int minTilePixels = 1 << 20;  ///< 图像像素数低于该值时直接整帧处理
+};
+
+/**
+ * @brief 分块并行的邻域滤波
+ *
+ * 把图像切成带重叠边（halo）的块，在常驻线程池上并行处理。每块从源图像的 ROI 视图读入
+ * 「内部区域 + halo」（不复制源图像），halo 宽度等于滤波半径（形态学按迭代次数和复合操作遍数累加）。
+ * 图像边缘处的块不向外扩展，由 OpenCV 按整帧调用时相同的边界方式处理，因此结果与整帧调用逐像素一致。
+ *
+ * OpenCV 滤波的输出与输入同尺寸，而输入必须包含 halo，所以每块先滤波到线程复用的块缓冲区，
+ * 再把内部区域复制到预先分配的输出图像对应的 ROI（每个输出像素只复制一次，不做整帧拼接）。
+ * 不直接滤波到输出 ROI：复合形态学操作和多次迭代会读取相邻块正在写入的输出像素。
+ */
+class TiledFilter {
+  public:
+    /**
+     * @brief 单块处理函数：对输入块做滤波，输出与输入同尺寸
+     *
+     * 输出是线程复用的块缓冲区，函数内部不能等待常驻线程池（例如调用 ParallelUtils），
+     * 否则等待期间同一线程执行的其他块会覆盖该缓冲区。
+     */
+    using TileFunction = std::function<void(const cv::Mat& input, cv::Mat& output)>;
+
+    /**
+     * @brief 分块双边滤波（同 cv::bilateralFilter）
+     *
+     * 8 位图像与整帧结果一致；32 位浮点图像的颜色权重表按每块的取值范围建立，结果有微小差异。
+     * @return 是否成功
+     */
+    static bool bilateralFilter(const cv::Mat& src,
+                                cv::Mat& dst,
+                                int d,
+                                double sigmaColor,
+                                double sigmaSpace,
+                                const TileOptions& options = TileOptions());
+
+    /**
+     * @brief 分块中值滤波（同 cv::medianBlur）
+     * @return 是否成功
+     */
+    static bool medianBlur(const cv::Mat& src,
+                           cv::Mat& dst,
+                           int ksize,
+                           const TileOptions& options = TileOptions());
+
+    /**
+     * @brief 分块自适应阈值（同 cv::adaptiveThreshold）
+     * @return 是否成功
+     */
+    static bool adaptiveThreshold(const cv::Mat& src,
+                                  cv::Mat& dst,
+                                  double maxValue,
+                                  int adaptiveMethod,
+                                  int thresholdType,
+                                  int blockSize,
+                                  double C,
+                                  const TileOptions& options = TileOptions());
+
+    /**
+     * @brief 分块形态学操作（同 cv::morphologyEx，锚点取核中心）
+     * @return 是否成功
+     */
+    static bool morphologyEx(const cv::Mat& src,
+                             cv::Mat& dst,
+                             int op,
+                             const cv::Mat& kernel,
+                             int iterations = 1,
+                             const TileOptions& options = TileOptions());
+
+    /**
+     * @brief 通用分块执行
+     * @param src 源图像
+     * @param dst 输出图像（按 src 尺寸和 dstType 分配，可以与 src 相同）
+     * @param dstType 输出类型
+     * @param halo 每块在各方向上需要的额外像素
+     * @param function 单块处理函数
+     * @param options 分块参数
+     * @return 是否成功
+     */
+    static bool apply(const cv::Mat& src,
+                      cv::Mat& dst,
+                      int dstType,
+                      const cv::Size& halo,
+                      const TileFunction& function,
+                      const TileOptions& options = TileOptions());
+
+    /**
+     * @brief 按图像尺寸和 halo 计算分块（只包含内部区域，互不重叠并覆盖整幅图像）
+     */
+    static std::vector<cv::Rect> makeTiles(const cv::Size& imageSize,
+                                           const cv::Size& halo,
+                                           const TileOptions& options = TileOptions());
+};
+
+}  // namespace oneday::image
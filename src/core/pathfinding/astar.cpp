@@ -1,16 +1,21 @@
 #include "astar.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <queue>
 #include <unordered_set>
 
 #include "../common/logger.h"
+#include "grid_directions.h"
 
 using oneday::core::Logger;
 
 namespace oneday::pathfinding {
 
+using grid::Direction;
+using grid::kDirections;
+
 AStar::AStar() {
     Logger::info("A* pathfinder initialized");
 }
@@ -20,26 +25,126 @@ AStar::~AStar() {
 }
 
 std::vector<Point> AStar::findPath(const Point& start, const Point& goal, const Map& map) {
-    Logger::info("Starting A* pathfinding from (" + std::to_string(start.x) + "," +
-                 std::to_string(start.y) + ") to (" + std::to_string(goal.x) + "," +
-                 std::to_string(goal.y) + ")");
+    std::vector<Point> path;
+    findPath(start, goal, map, path);
+    return path;
+}
+
+bool AStar::findPath(const Point& start,
+                     const Point& goal,
+                     const Map& map,
+                     std::vector<Point>& path) {
+    ONEDAY_LOG_DEBUG("Starting A* pathfinding from ({},{}) to ({},{})",
+                     start.x, start.y, goal.x, goal.y);
+    path.clear();
+    m_lastStats = PathfindingStats();
 
     // 检查起点和终点是否有效
     if (!map.isValidPosition(start) || !map.isValidPosition(goal)) {
         Logger::error("Invalid start or goal position");
-        return std::vector<Point>();
+        return false;
     }
 
     if (!map.isWalkable(start) || !map.isWalkable(goal)) {
         Logger::error("Start or goal position is not walkable");
-        return std::vector<Point>();
+        return false;
     }
 
     // 如果起点就是终点
     if (start == goal) {
-        return {start};
+        path.push_back(start);
+        m_lastStats.pathFound = true;
+        m_lastStats.pathLength = 1;
+        return true;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    const int iterations = m_searchMode == SearchMode::FlatWorkspace
+                               ? searchWorkspace(start, goal, map, path)
+                               : searchHashMap(start, goal, map, path);
+    auto endTime = std::chrono::steady_clock::now();
+
+    m_lastStats.nodesExplored = iterations;
+    m_lastStats.pathFound = !path.empty();
+    m_lastStats.pathLength = static_cast<int>(path.size());
+    m_lastStats.executionTime =
+        std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    if (!m_lastStats.pathFound) {
+        Logger::warning("No path found after {} iterations", iterations);
+        return false;
+    }
+    ONEDAY_LOG_DEBUG("Path found after {} iterations", iterations);
+    return true;
+}
+
+int AStar::searchWorkspace(const Point& start,
+                           const Point& goal,
+                           const Map& map,
+                           std::vector<Point>& path) {
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+
+    m_workspace.prepare(width, height);
+    IndexedHeap& openSet = m_workspace.getOpenList();
+
+    const uint32_t startIndex = m_workspace.toIndex(start);
+    const uint32_t goalIndex = m_workspace.toIndex(goal);
+    const double startHCost = calculateHeuristic(start, goal);
+    m_workspace.visit(startIndex, 0.0, SearchWorkspace::kNoParent);
+    openSet.push(startIndex, startHCost, startHCost);
+
+    int iterations = 0;
+    while (!openSet.empty()) {
+        const uint32_t current = openSet.pop().node;
+        m_workspace.close(current);
+        iterations++;
+
+        if (current == goalIndex) {
+            m_workspace.reconstructPath(goalIndex, path);
+            return iterations;
+        }
+
+        const Point position = m_workspace.toPoint(current);
+        const double currentGCost = m_workspace.getGCost(current);
+
+        for (const Direction& dir : kDirections) {
+            // 邻居最多越出地图一格，落在位平面的填充上，不需要边界检查
+            if (!grid::canMove(map, position.x, position.y, dir)) {
+                continue;
+            }
+            const int x = position.x + dir.dx;
+            const int y = position.y + dir.dy;
+
+            const uint32_t neighbor = static_cast<uint32_t>(y * width + x);
+            if (m_workspace.isClosed(neighbor)) {
+                continue;
+            }
+
+            // 已访问但未关闭的节点一定在开放列表中，代价更低时就地降低
+            const bool inOpenSet = m_workspace.isVisited(neighbor);
+            const double tentativeGCost = currentGCost + dir.cost;
+            if (inOpenSet && tentativeGCost >= m_workspace.getGCost(neighbor)) {
+                continue;
+            }
+
+            const double hCost = calculateHeuristic(Point{x, y}, goal);
+            m_workspace.visit(neighbor, tentativeGCost, static_cast<int32_t>(current));
+            if (inOpenSet) {
+                openSet.decreaseKey(neighbor, tentativeGCost + hCost, hCost);
+            } else {
+                openSet.push(neighbor, tentativeGCost + hCost, hCost);
+            }
+        }
     }
 
+    return iterations;
+}
+
+int AStar::searchHashMap(const Point& start,
+                         const Point& goal,
+                         const Map& map,
+                         std::vector<Point>& path) {
     // 初始化数据结构
     std::priority_queue<Node, std::vector<Node>, NodeComparator> openSet;
     std::unordered_set<Point, PointHash> closedSet;
@@ -76,8 +181,8 @@ std::vector<Point> AStar::findPath(const Point& start, const Point& goal, const
 
         // 检查是否到达目标
         if (current.position == goal) {
-            Logger::info("Path found after " + std::to_string(iterations) + " iterations");
-            return reconstructPath(current, allNodes);
+            reconstructPath(current, allNodes, path);
+            return iterations;
         }
 
         // 检查所有邻居
@@ -111,8 +216,7 @@ std::vector<Point> AStar::findPath(const Point& start, const Point& goal, const
         }
     }
 
-    Logger::warning("No path found after " + std::to_string(iterations) + " iterations");
-    return std::vector<Point>();
+    return iterations;
 }
 
 std::vector<Point> AStar::getNeighbors(const Point& point, const Map& map) {
@@ -148,7 +252,7 @@ double AStar::calculateHeuristic(const Point& from, const Point& to) {
     // 使用欧几里得距离作为启发式函数
     double dx = static_cast<double>(to.x - from.x);
     double dy = static_cast<double>(to.y - from.y);
-    return std::sqrt(dx * dx + dy * dy);
+    return m_heuristicWeight * std::sqrt(dx * dx + dy * dy);
 }
 
 double AStar::calculateDistance(const Point& from, const Point& to) {
@@ -164,10 +268,10 @@ double AStar::calculateDistance(const Point& from, const Point& to) {
     }
 }
 
-std::vector<Point> AStar::reconstructPath(
-    const Node& goalNode,
-    const std::unordered_map<Point, Node, PointHash>& allNodes) {
-    std::vector<Point> path;
+void AStar::reconstructPath(const Node& goalNode,
+                            const std::unordered_map<Point, Node, PointHash>& allNodes,
+                            std::vector<Point>& path) {
+    path.clear();
     Point current = goalNode.position;
 
     while (current.x != -1 && current.y != -1) {
@@ -184,88 +288,24 @@ std::vector<Point> AStar::reconstructPath(
     // 反转路径，使其从起点到终点
     std::reverse(path.begin(), path.end());
 
-    Logger::info("Path reconstructed with " + std::to_string(path.size()) + " points");
-    return path;
+    ONEDAY_LOG_DEBUG("Path reconstructed with {} points", path.size());
 }
 
 void AStar::setHeuristicWeight(double weight) {
     m_heuristicWeight = std::max(1.0, weight);
-    Logger::info("Heuristic weight set to " + std::to_string(m_heuristicWeight));
+    Logger::info("Heuristic weight set to {}", m_heuristicWeight);
 }
 
-double AStar::getHeuristicWeight() const {
-    return m_heuristicWeight;
+void AStar::setSearchMode(SearchMode mode) {
+    m_searchMode = mode;
 }
 
-std::vector<Point> AStar::smoothPath(const std::vector<Point>& path, const Map& map) {
-    if (path.size() <= 2) {
-        return path;
-    }
-
-    std::vector<Point> smoothedPath;
-    smoothedPath.push_back(path[0]);  // 添加起点
-
-    size_t current = 0;
-
-    while (current < path.size() - 1) {
-        size_t farthest = current + 1;
-
-        // 找到从当前点能直接到达的最远点
-        for (size_t i = current + 2; i < path.size(); ++i) {
-            if (hasLineOfSight(path[current], path[i], map)) {
-                farthest = i;
-            } else {
-                break;
-            }
-        }
-
-        smoothedPath.push_back(path[farthest]);
-        current = farthest;
-    }
-
-    Logger::info("Path smoothed from " + std::to_string(path.size()) + " to " +
-                 std::to_string(smoothedPath.size()) + " points");
-
-    return smoothedPath;
+AStar::SearchMode AStar::getSearchMode() const {
+    return m_searchMode;
 }
 
-bool AStar::hasLineOfSight(const Point& from, const Point& to, const Map& map) {
-    // 使用Bresenham直线算法检查视线
-    int dx = std::abs(to.x - from.x);
-    int dy = std::abs(to.y - from.y);
-    int x = from.x;
-    int y = from.y;
-
-    int x_inc = (to.x > from.x) ? 1 : -1;
-    int y_inc = (to.y > from.y) ? 1 : -1;
-
-    int error = dx - dy;
-
-    while (true) {
-        Point current = {x, y};
-
-        if (!map.isValidPosition(current) || !map.isWalkable(current)) {
-            return false;
-        }
-
-        if (x == to.x && y == to.y) {
-            break;
-        }
-
-        int error2 = 2 * error;
-
-        if (error2 > -dy) {
-            error -= dy;
-            x += x_inc;
-        }
-
-        if (error2 < dx) {
-            error += dx;
-            y += y_inc;
-        }
-    }
-
-    return true;
+double AStar::getHeuristicWeight() const {
+    return m_heuristicWeight;
 }
 
 PathfindingStats AStar::getLastPathfindingStats() const {
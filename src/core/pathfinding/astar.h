@@ -1,22 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
 #include "map.h"
+#include "pathfinding_algorithm.h"
+#include "search_workspace.h"
 
 namespace oneday::pathfinding {
 
-/**
- * @brief 路径查找统计信息
- */
-struct PathfindingStats {
-    int nodesExplored = 0;       ///< 探索的节点数
-    int pathLength = 0;          ///< 路径长度
-    double executionTime = 0.0;  ///< 执行时间（毫秒）
-    bool pathFound = false;      ///< 是否找到路径
-};
-
 /**
  * @brief A*算法节点
  */
@@ -42,21 +35,30 @@ struct NodeComparator {
 
 /**
  * @brief Point哈希函数
+ *
+ * 把两个坐标拼成 64 位整数后做乘法散列，避免 x ^ (y << 1) 在网格坐标上的大量冲突。
  */
 struct PointHash {
     std::size_t operator()(const Point& p) const {
-        return std::hash<int>()(p.x) ^ (std::hash<int>()(p.y) << 1);
+        const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32) |
+                             static_cast<uint32_t>(p.y);
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 16);
     }
 };
 
-// 前向声明
-class PathfindingAlgorithm;
-
 /**
  * @brief A*路径查找算法实现
  */
 class AStar : public PathfindingAlgorithm {
   public:
+    /**
+     * @brief 搜索模式
+     */
+    enum class SearchMode {
+        FlatWorkspace,  ///< 复用的平坦数组工作区 + 支持 decrease-key 的索引堆（默认）
+        HashMap         ///< 每次搜索新建优先队列和哈希表（旧实现，用于对比）
+    };
+
     /**
      * @brief 构造函数
      */
@@ -74,35 +76,67 @@ class AStar : public PathfindingAlgorithm {
      * @param map 地图
      * @return 路径点列表，如果没有找到路径则返回空列表
      */
-    std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map);
+    std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) override;
+
+    /**
+     * @brief 查找路径并写入调用方提供的缓冲区
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @param path 输出路径（复用其容量，未找到路径时清空）
+     * @return 是否找到路径
+     *
+     * FlatWorkspace 模式下，在同一张地图上重复查询不会分配内存。
+     */
+    bool findPath(const Point& start, const Point& goal, const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief 设置搜索模式
+     */
+    void setSearchMode(SearchMode mode);
+
+    /**
+     * @brief 获取搜索模式
+     */
+    SearchMode getSearchMode() const;
 
     /**
      * @brief 设置启发式函数权重
      * @param weight 权重值（>= 1.0）
      */
-    void setHeuristicWeight(double weight);
+    void setHeuristicWeight(double weight) override;
 
     /**
      * @brief 获取启发式函数权重
      * @return 权重值
      */
-    double getHeuristicWeight() const;
-
-    /**
-     * @brief 平滑路径（移除不必要的转折点）
-     * @param path 原始路径
-     * @param map 地图
-     * @return 平滑后的路径
-     */
-    std::vector<Point> smoothPath(const std::vector<Point>& path, const Map& map);
+    double getHeuristicWeight() const override;
 
     /**
      * @brief 获取上次路径查找的统计信息
      * @return 统计信息
      */
-    PathfindingStats getLastPathfindingStats() const;
+    PathfindingStats getLastPathfindingStats() const override;
 
   private:
+    /**
+     * @brief 平坦工作区搜索：每个节点最多扩展一次，开放列表中的节点就地降低代价
+     * @return 扩展的节点数
+     */
+    int searchWorkspace(const Point& start,
+                        const Point& goal,
+                        const Map& map,
+                        std::vector<Point>& path);
+
+    /**
+     * @brief 旧的哈希表搜索：重复压入节点，出队时跳过已关闭节点
+     * @return 扩展的节点数
+     */
+    int searchHashMap(const Point& start,
+                      const Point& goal,
+                      const Map& map,
+                      std::vector<Point>& path);
+
     /**
      * @brief 获取指定点的所有可行邻居
      * @param point 当前点
@@ -112,7 +146,7 @@ class AStar : public PathfindingAlgorithm {
     std::vector<Point> getNeighbors(const Point& point, const Map& map);
 
     /**
-     * @brief 计算启发式距离（欧几里得距离）
+     * @brief 计算启发式距离（加权欧几里得距离）
      * @param from 起点
      * @param to 终点
      * @return 启发式距离
@@ -131,23 +165,17 @@ class AStar : public PathfindingAlgorithm {
      * @brief 重构路径
      * @param goalNode 目标节点
      * @param allNodes 所有节点的映射
-     * @return 重构的路径
-     */
-    std::vector<Point> reconstructPath(const Node& goalNode,
-                                       const std::unordered_map<Point, Node, PointHash>& allNodes);
-
-    /**
-     * @brief 检查两点间是否有直线视线
-     * @param from 起点
-     * @param to 终点
-     * @param map 地图
-     * @return 是否有视线
+     * @param path 输出的路径
      */
-    bool hasLineOfSight(const Point& from, const Point& to, const Map& map);
+    void reconstructPath(const Node& goalNode,
+                         const std::unordered_map<Point, Node, PointHash>& allNodes,
+                         std::vector<Point>& path);
 
   private:
-    double m_heuristicWeight = 1.0;  ///< 启发式函数权重
-    PathfindingStats m_lastStats;    ///< 上次查找的统计信息
+    double m_heuristicWeight = 1.0;                       ///< 启发式函数权重
+    PathfindingStats m_lastStats;                         ///< 上次查找的统计信息
+    SearchMode m_searchMode = SearchMode::FlatWorkspace;  ///< 搜索模式
+    SearchWorkspace m_workspace;                          ///< 跨查询复用的搜索工作区
 };
 
 }  // namespace oneday::pathfinding
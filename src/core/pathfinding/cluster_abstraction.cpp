@@ -0,0 +1,503 @@
+#include "cluster_abstraction.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "../common/logger.h"
+#include "grid_directions.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+using grid::Direction;
+using grid::kDirections;
+
+namespace {
+
+/**
+ * @brief 入口长度达到该值时在两端各放一对过渡单元格，否则只在中点放一对
+ */
+constexpr int kLongEntranceLength = 6;
+
+bool pointLess(const Point& a, const Point& b) {
+    return a.y < b.y || (a.y == b.y && a.x < b.x);
+}
+
+}  // namespace
+
+// RegionSearch 实现
+
+int RegionSearch::run(const Map& map,
+                      const MapRegion& region,
+                      const Point& source,
+                      const Point* target) {
+    m_region = region;
+    m_regionWidth = region.bottomRight.x - region.topLeft.x + 1;
+    const int regionHeight = region.bottomRight.y - region.topLeft.y + 1;
+    const size_t cellCount = static_cast<size_t>(m_regionWidth) * regionHeight;
+    if (m_distances.size() < cellCount) {
+        m_distances.resize(cellCount);
+        m_parents.resize(cellCount);
+        m_stamps.resize(cellCount, 0);
+    }
+    m_openList.reserve(cellCount);
+    m_openList.clear();
+
+    m_generation += 2;
+    if (m_generation < 2) {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_generation = 2;
+    }
+
+    auto isWalkable = [&](int x, int y) {
+        return x >= region.topLeft.x && x <= region.bottomRight.x && y >= region.topLeft.y &&
+               y <= region.bottomRight.y && map.isWalkableUnchecked(x, y);
+    };
+
+    const uint32_t sourceIndex = toLocal(source.x, source.y);
+    m_distances[sourceIndex] = 0.0;
+    m_parents[sourceIndex] = -1;
+    m_stamps[sourceIndex] = m_generation;
+    m_openList.push(sourceIndex, 0.0, 0.0);
+
+    const int64_t targetIndex = target ? static_cast<int64_t>(toLocal(target->x, target->y)) : -1;
+    int expanded = 0;
+    while (!m_openList.empty()) {
+        const uint32_t current = m_openList.pop().node;
+        m_stamps[current] = m_generation + 1;
+        expanded++;
+        if (static_cast<int64_t>(current) == targetIndex) {
+            break;
+        }
+
+        const int x = region.topLeft.x + static_cast<int>(current % m_regionWidth);
+        const int y = region.topLeft.y + static_cast<int>(current / m_regionWidth);
+        const double distance = m_distances[current];
+        for (const Direction& dir : kDirections) {
+            if (!grid::canMove(x, y, dir.dx, dir.dy, isWalkable)) {
+                continue;
+            }
+            const int nx = x + dir.dx;
+            const int ny = y + dir.dy;
+
+            const uint32_t neighbor = toLocal(nx, ny);
+            const uint32_t stamp = m_stamps[neighbor];
+            if (stamp == m_generation + 1) {
+                continue;
+            }
+            const double tentative = distance + dir.cost;
+            if (stamp == m_generation) {
+                if (tentative < m_distances[neighbor]) {
+                    m_distances[neighbor] = tentative;
+                    m_parents[neighbor] = static_cast<int32_t>(current);
+                    m_openList.decreaseKey(neighbor, tentative, 0.0);
+                }
+                continue;
+            }
+
+            m_distances[neighbor] = tentative;
+            m_parents[neighbor] = static_cast<int32_t>(current);
+            m_stamps[neighbor] = m_generation;
+            m_openList.push(neighbor, tentative, 0.0);
+        }
+    }
+    return expanded;
+}
+
+double RegionSearch::getDistance(const Point& point) const {
+    if (point.x < m_region.topLeft.x || point.x > m_region.bottomRight.x ||
+        point.y < m_region.topLeft.y || point.y > m_region.bottomRight.y) {
+        return kUnreachable;
+    }
+    const uint32_t index = toLocal(point.x, point.y);
+    return m_stamps[index] >= m_generation ? m_distances[index] : kUnreachable;
+}
+
+void RegionSearch::appendPath(const Point& target, std::vector<Point>& path) {
+    m_scratch.clear();
+    for (int32_t index = static_cast<int32_t>(toLocal(target.x, target.y));
+         m_parents[index] != -1; index = m_parents[index]) {
+        m_scratch.push_back(Point{m_region.topLeft.x + index % m_regionWidth,
+                                  m_region.topLeft.y + index / m_regionWidth});
+    }
+    path.insert(path.end(), m_scratch.rbegin(), m_scratch.rend());
+}
+
+// ClusterAbstraction 实现
+
+ClusterAbstraction::ClusterAbstraction(int clusterSize) : m_clusterSize(std::max(2, clusterSize)) {}
+
+void ClusterAbstraction::setClusterSize(int clusterSize) {
+    clusterSize = std::max(2, clusterSize);
+    if (clusterSize != m_clusterSize) {
+        m_clusterSize = clusterSize;
+        m_revision = 0;
+    }
+}
+
+MapRegion ClusterAbstraction::getClusterRegion(int cluster) const {
+    const int left = (cluster % m_clustersX) * m_clusterSize;
+    const int top = (cluster / m_clustersX) * m_clusterSize;
+    return MapRegion{{left, top},
+                     {std::min(left + m_clusterSize, m_width) - 1,
+                      std::min(top + m_clusterSize, m_height) - 1}};
+}
+
+size_t ClusterAbstraction::getEntranceCount() const {
+    size_t count = 0;
+    for (const Cluster& cluster : m_clusters) {
+        count += cluster.entrances.size();
+    }
+    return count;
+}
+
+int ClusterAbstraction::synchronize(const Map& map) {
+    if (m_revision == map.getRevision()) {
+        return 0;
+    }
+
+    const bool sameLayout = m_revision != 0 && m_width == map.getWidth() &&
+                            m_height == map.getHeight();
+    if (!sameLayout || !map.getChangedRegions(m_revision, m_changedRegions)) {
+        rebuild(map);
+        return getClusterCount();
+    }
+
+    // 与变化区域重叠的簇：四条边都要重算，簇内距离也要重算
+    const size_t clusterCount = m_clusters.size();
+    std::vector<uint8_t> dirty(clusterCount, 0);
+    for (const MapRegion& region : m_changedRegions) {
+        const int left = std::max(0, region.topLeft.x) / m_clusterSize;
+        const int top = std::max(0, region.topLeft.y) / m_clusterSize;
+        const int right = std::min(m_width - 1, region.bottomRight.x) / m_clusterSize;
+        const int bottom = std::min(m_height - 1, region.bottomRight.y) / m_clusterSize;
+        for (int cy = top; cy <= bottom; ++cy) {
+            for (int cx = left; cx <= right; ++cx) {
+                dirty[cy * m_clustersX + cx] = 1;
+            }
+        }
+    }
+
+    // 公共边上的过渡单元格变化时，边另一侧的簇入口随之变化，也要重算
+    std::vector<uint8_t> recompute(dirty);
+    std::vector<uint8_t> eastDone(clusterCount, 0);
+    std::vector<uint8_t> southDone(clusterCount, 0);
+    auto updateBorder = [&](int owner, bool east) {
+        std::vector<uint8_t>& done = east ? eastDone : southDone;
+        if (done[owner]) {
+            return;
+        }
+        done[owner] = 1;
+        if (computeBorder(map, owner, east)) {
+            recompute[owner] = 1;
+            recompute[owner + (east ? 1 : m_clustersX)] = 1;
+        }
+    };
+    for (int cluster = 0; cluster < static_cast<int>(clusterCount); ++cluster) {
+        if (!dirty[cluster]) {
+            continue;
+        }
+        const int cx = cluster % m_clustersX;
+        const int cy = cluster / m_clustersX;
+        if (cx + 1 < m_clustersX) {
+            updateBorder(cluster, true);
+        }
+        if (cy + 1 < m_clustersY) {
+            updateBorder(cluster, false);
+        }
+        if (cx > 0) {
+            updateBorder(cluster - 1, true);
+        }
+        if (cy > 0) {
+            updateBorder(cluster - m_clustersX, false);
+        }
+    }
+
+    int recomputed = 0;
+    for (int cluster = 0; cluster < static_cast<int>(clusterCount); ++cluster) {
+        if (recompute[cluster]) {
+            computeCluster(map, cluster);
+            recomputed++;
+        }
+    }
+
+    m_revision = map.getRevision();
+    ONEDAY_LOG_DEBUG("Cluster abstraction updated: {} of {} clusters recomputed",
+                     recomputed, clusterCount);
+    return recomputed;
+}
+
+void ClusterAbstraction::serialize(std::vector<uint8_t>& out) const {
+    const int32_t layout[5] = {m_clusterSize, m_width, m_height, m_clustersX, m_clustersY};
+
+    // 先算出总字节数一次分配，再按偏移依次复制
+    size_t total = sizeof(layout);
+    for (size_t cluster = 0; cluster < m_clusters.size(); ++cluster) {
+        total += 3 * sizeof(uint32_t) +
+                 (m_clusters[cluster].entrances.size() + m_eastTransitions[cluster].size() +
+                  m_southTransitions[cluster].size()) * sizeof(Point) +
+                 m_clusters[cluster].distances.size() * sizeof(double);
+    }
+    out.resize(total);
+    size_t offset = 0;
+    const auto write = [&out, &offset](const void* data, size_t size) {
+        if (size != 0) {
+            std::memcpy(out.data() + offset, data, size);
+            offset += size;
+        }
+    };
+    write(layout, sizeof(layout));
+
+    // 每个簇：入口数、东边和南边过渡单元格数，然后是三组坐标和距离方阵
+    for (size_t cluster = 0; cluster < m_clusters.size(); ++cluster) {
+        const Cluster& entry = m_clusters[cluster];
+        const uint32_t counts[3] = {static_cast<uint32_t>(entry.entrances.size()),
+                                    static_cast<uint32_t>(m_eastTransitions[cluster].size()),
+                                    static_cast<uint32_t>(m_southTransitions[cluster].size())};
+        write(counts, sizeof(counts));
+        write(entry.entrances.data(), entry.entrances.size() * sizeof(Point));
+        write(m_eastTransitions[cluster].data(), m_eastTransitions[cluster].size() * sizeof(Point));
+        write(m_southTransitions[cluster].data(),
+              m_southTransitions[cluster].size() * sizeof(Point));
+        write(entry.distances.data(), entry.distances.size() * sizeof(double));
+    }
+}
+
+bool ClusterAbstraction::deserialize(const uint8_t* data, size_t size, const Map& map) {
+    size_t offset = 0;
+    const auto read = [&](void* target, size_t bytes) {
+        if (bytes > size - offset) {
+            return false;
+        }
+        std::memcpy(target, data + offset, bytes);
+        offset += bytes;
+        return true;
+    };
+
+    int32_t layout[5];
+    if (!read(layout, sizeof(layout))) {
+        Logger::error("Cluster abstraction data is truncated");
+        return false;
+    }
+    const auto [clusterSize, width, height, clustersX, clustersY] = layout;
+    // 先限制簇边长，下面的向上取整才不会溢出
+    if (clusterSize < 2 || width != map.getWidth() || height != map.getHeight() ||
+        clusterSize > std::max(width, height) ||
+        clustersX != (width + clusterSize - 1) / clusterSize ||
+        clustersY != (height + clusterSize - 1) / clusterSize) {
+        Logger::error("Cluster abstraction data does not match the map");
+        return false;
+    }
+
+    const size_t clusterCount = static_cast<size_t>(clustersX) * clustersY;
+    std::vector<Cluster> clusters(clusterCount);
+    std::vector<std::vector<Point>> eastTransitions(clusterCount);
+    std::vector<std::vector<Point>> southTransitions(clusterCount);
+    std::vector<int32_t> entranceSlots(static_cast<size_t>(width) * height, -1);
+    const auto readPoints = [&](std::vector<Point>& points, uint32_t count) {
+        if (count > (size - offset) / sizeof(Point)) {
+            return false;
+        }
+        points.resize(count);
+        read(points.data(), count * sizeof(Point));
+        return true;
+    };
+    const auto inRegion = [](const Point& point, const MapRegion& region) {
+        return point.x >= region.topLeft.x && point.x <= region.bottomRight.x &&
+               point.y >= region.topLeft.y && point.y <= region.bottomRight.y;
+    };
+    // 过渡单元格位于本簇的东边或南边上，与边外一格都可行走（computeBorder 的规则）
+    const auto validTransitions = [&](const std::vector<Point>& transitions,
+                                      const MapRegion& region, bool east) {
+        return std::all_of(transitions.begin(), transitions.end(), [&](const Point& point) {
+            const Point outside = east ? Point{point.x + 1, point.y} : Point{point.x, point.y + 1};
+            return inRegion(point, region) &&
+                   (east ? point.x == region.bottomRight.x : point.y == region.bottomRight.y) &&
+                   map.isWalkable(point) && map.isWalkable(outside);
+        });
+    };
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+        uint32_t counts[3];
+        Cluster& entry = clusters[cluster];
+        if (!read(counts, sizeof(counts)) || !readPoints(entry.entrances, counts[0]) ||
+            !readPoints(eastTransitions[cluster], counts[1]) ||
+            !readPoints(southTransitions[cluster], counts[2])) {
+            Logger::error("Cluster abstraction data is corrupt");
+            return false;
+        }
+        const uint64_t distanceCount = static_cast<uint64_t>(counts[0]) * counts[0];
+        if (distanceCount > (size - offset) / sizeof(double)) {
+            Logger::error("Cluster abstraction data is corrupt");
+            return false;
+        }
+        entry.distances.resize(distanceCount);
+        read(entry.distances.data(), distanceCount * sizeof(double));
+
+        // 入口槽位按所在簇的距离方阵索引，入口必须落在本簇内且不重复
+        const int left = static_cast<int>(cluster % clustersX) * clusterSize;
+        const int top = static_cast<int>(cluster / clustersX) * clusterSize;
+        const MapRegion region{{left, top},
+                               {std::min(left + clusterSize, width) - 1,
+                                std::min(top + clusterSize, height) - 1}};
+        for (uint32_t i = 0; i < counts[0]; ++i) {
+            const Point& entrance = entry.entrances[i];
+            if (!inRegion(entrance, region)) {
+                Logger::error("Cluster abstraction entrance lies outside its cluster");
+                return false;
+            }
+            int32_t& slot = entranceSlots[static_cast<size_t>(entrance.y) * width + entrance.x];
+            if (slot != -1) {
+                Logger::error("Cluster abstraction has a duplicate entrance");
+                return false;
+            }
+            slot = static_cast<int32_t>(i);
+        }
+        if (!validTransitions(eastTransitions[cluster], region, true) ||
+            !validTransitions(southTransitions[cluster], region, false)) {
+            Logger::error("Cluster abstraction has an invalid transition");
+            return false;
+        }
+    }
+
+    m_clusterSize = clusterSize;
+    m_width = width;
+    m_height = height;
+    m_clustersX = clustersX;
+    m_clustersY = clustersY;
+    m_clusters = std::move(clusters);
+    m_eastTransitions = std::move(eastTransitions);
+    m_southTransitions = std::move(southTransitions);
+    m_entranceSlots = std::move(entranceSlots);
+    m_revision = map.getRevision();
+    Logger::info("Cluster abstraction loaded: {}x{} clusters, {} entrances", m_clustersX,
+                 m_clustersY, getEntranceCount());
+    return true;
+}
+
+void ClusterAbstraction::rebuild(const Map& map) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    m_width = map.getWidth();
+    m_height = map.getHeight();
+    m_clustersX = (m_width + m_clusterSize - 1) / m_clusterSize;
+    m_clustersY = (m_height + m_clusterSize - 1) / m_clusterSize;
+    const size_t clusterCount = static_cast<size_t>(m_clustersX) * m_clustersY;
+
+    m_clusters.assign(clusterCount, Cluster());
+    m_eastTransitions.assign(clusterCount, std::vector<Point>());
+    m_southTransitions.assign(clusterCount, std::vector<Point>());
+    m_entranceSlots.assign(static_cast<size_t>(m_width) * m_height, -1);
+
+    for (int cluster = 0; cluster < static_cast<int>(clusterCount); ++cluster) {
+        if (cluster % m_clustersX + 1 < m_clustersX) {
+            computeBorder(map, cluster, true);
+        }
+        if (cluster / m_clustersX + 1 < m_clustersY) {
+            computeBorder(map, cluster, false);
+        }
+    }
+    for (int cluster = 0; cluster < static_cast<int>(clusterCount); ++cluster) {
+        computeCluster(map, cluster);
+    }
+
+    m_revision = map.getRevision();
+    auto endTime = std::chrono::steady_clock::now();
+    Logger::info("Cluster abstraction built: {}x{} clusters, {} entrances in {} ms", m_clustersX,
+                 m_clustersY, getEntranceCount(),
+                 std::chrono::duration<double, std::milli>(endTime - startTime).count());
+}
+
+bool ClusterAbstraction::computeBorder(const Map& map, int cluster, bool east) {
+    const MapRegion region = getClusterRegion(cluster);
+    auto isWalkable = [&map](int x, int y) { return map.isWalkableUnchecked(x, y); };
+
+    // 东边沿 y 扫描 x = right 列，南边沿 x 扫描 y = bottom 行；另一侧单元格在边外一格
+    const int first = east ? region.topLeft.y : region.topLeft.x;
+    const int last = east ? region.bottomRight.y : region.bottomRight.x;
+    auto insideCell = [&](int t) {
+        return east ? Point{region.bottomRight.x, t} : Point{t, region.bottomRight.y};
+    };
+    auto isOpen = [&](int t) {
+        const Point inside = insideCell(t);
+        return isWalkable(inside.x, inside.y) &&
+               (east ? isWalkable(inside.x + 1, inside.y) : isWalkable(inside.x, inside.y + 1));
+    };
+
+    std::vector<Point> transitions;
+    for (int t = first; t <= last;) {
+        if (!isOpen(t)) {
+            ++t;
+            continue;
+        }
+        const int runStart = t;
+        while (t <= last && isOpen(t)) {
+            ++t;
+        }
+        const int runEnd = t - 1;
+        if (runEnd - runStart + 1 >= kLongEntranceLength) {
+            transitions.push_back(insideCell(runStart));
+            transitions.push_back(insideCell(runEnd));
+        } else {
+            transitions.push_back(insideCell((runStart + runEnd) / 2));
+        }
+    }
+
+    std::vector<Point>& current = east ? m_eastTransitions[cluster] : m_southTransitions[cluster];
+    if (transitions == current) {
+        return false;
+    }
+    current.swap(transitions);
+    return true;
+}
+
+void ClusterAbstraction::computeCluster(const Map& map, int cluster) {
+    Cluster& entry = m_clusters[cluster];
+    for (const Point& entrance : entry.entrances) {
+        m_entranceSlots[static_cast<size_t>(entrance.y) * m_width + entrance.x] = -1;
+    }
+
+    // 本簇东边、南边的簇内一侧，加上西邻东边、北邻南边的簇外一侧
+    std::vector<Point>& entrances = entry.entrances;
+    entrances = m_eastTransitions[cluster];
+    entrances.insert(entrances.end(), m_southTransitions[cluster].begin(),
+                     m_southTransitions[cluster].end());
+    if (cluster % m_clustersX > 0) {
+        for (const Point& transition : m_eastTransitions[cluster - 1]) {
+            entrances.push_back(Point{transition.x + 1, transition.y});
+        }
+    }
+    if (cluster / m_clustersX > 0) {
+        for (const Point& transition : m_southTransitions[cluster - m_clustersX]) {
+            entrances.push_back(Point{transition.x, transition.y + 1});
+        }
+    }
+    std::sort(entrances.begin(), entrances.end(), pointLess);
+    entrances.erase(std::unique(entrances.begin(), entrances.end()), entrances.end());
+
+    const size_t count = entrances.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Point& entrance = entrances[i];
+        m_entranceSlots[static_cast<size_t>(entrance.y) * m_width + entrance.x] =
+            static_cast<int32_t>(i);
+    }
+
+    // 距离对称，从每个入口搜索一次填上三角和下三角
+    entry.distances.assign(count * count, RegionSearch::kUnreachable);
+    const MapRegion region = getClusterRegion(cluster);
+    for (size_t i = 0; i < count; ++i) {
+        entry.distances[i * count + i] = 0.0;
+        if (i + 1 == count) {
+            break;
+        }
+        m_search.run(map, region, entrances[i]);
+        for (size_t j = i + 1; j < count; ++j) {
+            const double distance = m_search.getDistance(entrances[j]);
+            entry.distances[i * count + j] = distance;
+            entry.distances[j * count + i] = distance;
+        }
+    }
+}
+
+}  // namespace oneday::pathfinding
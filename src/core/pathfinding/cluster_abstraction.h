@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "indexed_heap.h"
+#include "map.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 限定在矩形区域内的 Dijkstra 搜索
+ *
+ * 移动规则与 AStar 相同（8 方向，水平或垂直方向被阻挡时不能对角线移动），但不会走出区域。
+ * HPA* 用它计算簇内入口之间的距离、把起点和终点接入抽象图，以及把抽象路径细化为逐格路径。
+ * 缓冲区按区域大小复用，反复搜索同样大小的区域不会分配内存。
+ */
+class RegionSearch {
+  public:
+    static constexpr double kUnreachable = std::numeric_limits<double>::infinity();  ///< 不可达
+
+    /**
+     * @brief 从起点搜索区域
+     * @param map 地图
+     * @param region 搜索区域
+     * @param source 起点（必须在区域内且可行走）
+     * @param target 扩展到该点时提前结束；为 nullptr 时搜索整个区域
+     * @return 扩展的节点数
+     */
+    int run(const Map& map, const MapRegion& region, const Point& source,
+            const Point* target = nullptr);
+
+    /**
+     * @brief 获取起点到某点的最短距离
+     * @param point 区域内的点
+     * @return 距离，未到达时返回 kUnreachable
+     *
+     * 提前结束的搜索中只有目标点和已扩展节点的距离是最终值。
+     */
+    double getDistance(const Point& point) const;
+
+    /**
+     * @brief 把起点到目标点的路径（不含起点）追加到 path 末尾
+     * @param target 已到达的目标点
+     * @param path 输出路径
+     */
+    void appendPath(const Point& target, std::vector<Point>& path);
+
+  private:
+    /**
+     * @brief 区域内坐标对应的局部下标
+     */
+    uint32_t toLocal(int x, int y) const {
+        return static_cast<uint32_t>((y - m_region.topLeft.y) * m_regionWidth +
+                                     (x - m_region.topLeft.x));
+    }
+
+    std::vector<double> m_distances;  ///< 局部下标 -> 距离
+    std::vector<int32_t> m_parents;   ///< 局部下标 -> 父节点局部下标
+    std::vector<uint32_t> m_stamps;   ///< 世代状态戳（世代值为已访问，世代值 + 1 为已关闭）
+    uint32_t m_generation = 0;        ///< 当前搜索的世代
+    IndexedHeap m_openList;           ///< 开放列表
+    std::vector<Point> m_scratch;     ///< 回溯路径用的临时缓冲区
+    MapRegion m_region;               ///< 当前搜索区域
+    int m_regionWidth = 0;            ///< 当前搜索区域宽度
+};
+
+/**
+ * @brief HPA* 的簇抽象
+ *
+ * 把地图划分为 clusterSize x clusterSize 的簇。相邻簇的公共边上，两侧都可行走的连续单元格
+ * 组成一个入口：短入口在中点、长入口在两端各放一对过渡单元格，过渡单元格就是抽象图的节点。
+ * 每个簇保存其入口节点两两之间的簇内最短距离。
+ *
+ * 抽象按地图修订号缓存。synchronize() 通过 Map::getChangedRegions() 得到变化区域，
+ * 只重新计算与变化区域重叠的簇的四条边；只有这些簇和入口真正发生变化的相邻簇
+ * 需要重算簇内距离。无法得到完整变化记录时才完全重建。
+ */
+class ClusterAbstraction {
+  public:
+    /**
+     * @brief 构造函数
+     * @param clusterSize 簇的边长（单元格）
+     */
+    explicit ClusterAbstraction(int clusterSize = 16);
+
+    /**
+     * @brief 设置簇的边长（下次同步时完全重建）
+     */
+    void setClusterSize(int clusterSize);
+
+    int getClusterSize() const {
+        return m_clusterSize;
+    }
+
+    /**
+     * @brief 与地图同步：首次或无法增量更新时完全构建，否则只重算受影响的簇
+     * @param map 地图
+     * @return 本次重算簇内距离的簇数（抽象已是最新时为 0）
+     */
+    int synchronize(const Map& map);
+
+    /**
+     * @brief 获取已同步的地图修订号（0 表示尚未构建）
+     */
+    uint64_t getRevision() const {
+        return m_revision;
+    }
+
+    /**
+     * @brief 把抽象写成字节序列（本机字节序），用于随地图文件保存
+     * @param out 输出缓冲区（内容被替换）
+     */
+    void serialize(std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief 从 serialize() 写出的字节序列恢复抽象，并视为已与地图同步
+     * @param data 数据
+     * @param size 字节数
+     * @param map 保存抽象时的地图内容（尺寸必须一致）
+     * @return 是否恢复成功（数据无效时返回 false，抽象保持不变）
+     */
+    bool deserialize(const uint8_t* data, size_t size, const Map& map);
+
+    /**
+     * @brief 获取簇的数量
+     */
+    int getClusterCount() const {
+        return static_cast<int>(m_clusters.size());
+    }
+
+    /**
+     * @brief 获取点所在的簇
+     */
+    int getClusterIndex(const Point& point) const {
+        return (point.y / m_clusterSize) * m_clustersX + point.x / m_clusterSize;
+    }
+
+    /**
+     * @brief 获取簇覆盖的区域
+     */
+    MapRegion getClusterRegion(int cluster) const;
+
+    /**
+     * @brief 获取簇的入口节点
+     */
+    const std::vector<Point>& getEntrances(int cluster) const {
+        return m_clusters[cluster].entrances;
+    }
+
+    /**
+     * @brief 获取单元格在其簇入口列表中的位置
+     * @return 位置，不是入口节点时返回 -1
+     */
+    int getEntranceSlot(const Point& point) const {
+        return m_entranceSlots[static_cast<size_t>(point.y) * m_width + point.x];
+    }
+
+    /**
+     * @brief 获取簇内两个入口节点之间的距离
+     * @return 距离，簇内不连通时返回 RegionSearch::kUnreachable
+     */
+    double getDistance(int cluster, int from, int to) const {
+        const Cluster& entry = m_clusters[cluster];
+        return entry.distances[static_cast<size_t>(from) * entry.entrances.size() + to];
+    }
+
+    /**
+     * @brief 获取入口节点总数
+     */
+    size_t getEntranceCount() const;
+
+  private:
+    /**
+     * @brief 簇数据
+     */
+    struct Cluster {
+        std::vector<Point> entrances;   ///< 入口节点（按 y, x 排序）
+        std::vector<double> distances;  ///< 入口两两之间的簇内距离（行优先方阵）
+    };
+
+    /**
+     * @brief 完全重建
+     */
+    void rebuild(const Map& map);
+
+    /**
+     * @brief 重新计算簇的东边或南边上的过渡单元格
+     * @return 过渡单元格是否发生变化
+     */
+    bool computeBorder(const Map& map, int cluster, bool east);
+
+    /**
+     * @brief 根据四条边的过渡单元格收集入口节点，并重算簇内距离
+     */
+    void computeCluster(const Map& map, int cluster);
+
+    int m_clusterSize;        ///< 簇的边长
+    int m_clustersX = 0;      ///< 横向簇数
+    int m_clustersY = 0;      ///< 纵向簇数
+    int m_width = 0;          ///< 地图宽度
+    int m_height = 0;         ///< 地图高度
+    uint64_t m_revision = 0;  ///< 已同步的地图修订号（0 表示尚未构建）
+
+    std::vector<Cluster> m_clusters;                     ///< 簇数据
+    std::vector<std::vector<Point>> m_eastTransitions;   ///< 东边过渡单元格（簇内一侧）
+    std::vector<std::vector<Point>> m_southTransitions;  ///< 南边过渡单元格（簇内一侧）
+    std::vector<int32_t> m_entranceSlots;                ///< 单元格 -> 入口位置（非入口为 -1）
+    std::vector<MapRegion> m_changedRegions;             ///< 变化区域缓冲区
+    RegionSearch m_search;                               ///< 计算簇内距离用的搜索
+};
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,430 @@
+#include "dstar_lite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "../common/logger.h"
+#include "grid_directions.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+using grid::Direction;
+using grid::kDiagonalCost;
+using grid::kDirectionCount;
+using grid::kDirections;
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+constexpr double kCostEpsilon = 1e-9;  ///< 比较 rhs 是否经由某条边取得时的容差
+constexpr double kKeyScale = 1048576.0;  ///< k1 量化到 2^-20 的整数倍
+
+}  // namespace
+
+DStarLite::DStarLite() {
+    Logger::info("D* Lite pathfinder initialized");
+}
+
+DStarLite::~DStarLite() {
+    Logger::info("D* Lite pathfinder destroyed");
+}
+
+std::vector<Point> DStarLite::findPath(const Point& start, const Point& goal, const Map& map) {
+    std::vector<Point> path;
+    findPath(start, goal, map, path);
+    return path;
+}
+
+bool DStarLite::findPath(const Point& start,
+                         const Point& goal,
+                         const Map& map,
+                         std::vector<Point>& path) {
+    ONEDAY_LOG_DEBUG("Starting D* Lite pathfinding from ({},{}) to ({},{})",
+                     start.x, start.y, goal.x, goal.y);
+    path.clear();
+    m_lastStats = PathfindingStats();
+    m_lastReplanStats = ReplanStats();
+
+    // 检查起点和终点是否有效
+    if (!map.isValidPosition(start) || !map.isValidPosition(goal)) {
+        Logger::error("Invalid start or goal position");
+        return false;
+    }
+
+    if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+        Logger::error("Start or goal position is not walkable");
+        return false;
+    }
+
+    // 如果起点就是终点
+    if (start == goal) {
+        path.push_back(start);
+        m_lastStats.pathFound = true;
+        m_lastStats.pathLength = 1;
+        return true;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // 终点和地图尺寸不变且变化记录完整时，在保留的搜索状态上修复
+    const bool incremental = m_initialized && goal == m_goal && map.getWidth() == m_width &&
+                             map.getHeight() == m_height &&
+                             map.getChangedRegions(m_revision, m_mapChanges);
+    if (incremental) {
+        m_map = &map;
+        m_pending.insert(m_pending.end(), m_mapChanges.begin(), m_mapChanges.end());
+        m_lastReplanStats.incremental = true;
+    } else {
+        initialize(start, goal, map);
+    }
+    m_revision = map.getRevision();
+    const bool found = repair(start, path);
+
+    m_lastStats.executionTime = std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - startTime)
+                                    .count();
+    return found;
+}
+
+void DStarLite::notifyCellsChanged(const MapRegion& region) {
+    m_pending.push_back(region);
+}
+
+void DStarLite::notifyCellChanged(const Point& cell) {
+    m_pending.push_back(MapRegion{cell, cell});
+}
+
+bool DStarLite::replan(const Point& current, std::vector<Point>& path) {
+    path.clear();
+    m_lastStats = PathfindingStats();
+    m_lastReplanStats = ReplanStats();
+
+    if (!m_initialized) {
+        Logger::error("D* Lite replan requested before any search");
+        return false;
+    }
+
+    if (!m_map->isWalkable(current) || !m_map->isWalkable(m_goal)) {
+        Logger::error("Current or goal position is not walkable");
+        return false;
+    }
+
+    // 已到达终点
+    if (current == m_goal) {
+        path.push_back(current);
+        m_lastStats.pathFound = true;
+        m_lastStats.pathLength = 1;
+        return true;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // 调用方没有通知的修改由地图变化记录补上；记录不完整时退化为完整搜索
+    if (m_map->getWidth() == m_width && m_map->getHeight() == m_height &&
+        m_map->getChangedRegions(m_revision, m_mapChanges)) {
+        m_pending.insert(m_pending.end(), m_mapChanges.begin(), m_mapChanges.end());
+        m_lastReplanStats.incremental = true;
+    } else {
+        initialize(current, m_goal, *m_map);
+    }
+    m_revision = m_map->getRevision();
+    const bool found = repair(current, path);
+
+    m_lastStats.executionTime = std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - startTime)
+                                    .count();
+    return found;
+}
+
+void DStarLite::reset() {
+    m_initialized = false;
+    m_map = nullptr;
+    m_pending.clear();
+}
+
+void DStarLite::initialize(const Point& start, const Point& goal, const Map& map) {
+    m_map = &map;
+    m_width = map.getWidth();
+    m_height = map.getHeight();
+    const size_t cellCount = static_cast<size_t>(m_width) * static_cast<size_t>(m_height);
+    m_g.assign(cellCount, kInfinity);
+    m_rhs.assign(cellCount, kInfinity);
+    m_updateStamps.assign(cellCount, 0);
+    m_updateGeneration = 0;
+    m_openList.reserve(cellCount);
+    m_openList.clear();
+    m_pending.clear();
+
+    m_start = start;
+    m_lastStart = start;
+    m_goal = goal;
+    m_keyModifier = 0.0;
+
+    // 反向搜索：终点是源点
+    const uint32_t goalIndex = toIndex(goal);
+    m_rhs[goalIndex] = 0.0;
+    m_openList.push(goalIndex, calculateKey(goal, 0.0), 0.0);
+    m_initialized = true;
+}
+
+bool DStarLite::repair(const Point& start, std::vector<Point>& path) {
+    // 起点移动后，已在开放列表中的键值整体少算了 h(旧起点, 新起点)，用 km 补偿而不是重排
+    if (start != m_start) {
+        m_keyModifier += calculateHeuristic(m_lastStart, start);
+        m_lastStart = start;
+        m_start = start;
+    }
+
+    if (!m_pending.empty() && !applyChanges()) {
+        initialize(start, m_goal, *m_map);
+        m_lastReplanStats.incremental = false;
+    }
+
+    const int iterations = computeShortestPath();
+    const bool found = extractPath(path);
+
+    m_lastStats.nodesExplored = iterations;
+    m_lastStats.pathFound = found;
+    m_lastStats.pathLength = static_cast<int>(path.size());
+
+    if (!found) {
+        Logger::warning("No path found after {} iterations", iterations);
+        return false;
+    }
+    ONEDAY_LOG_DEBUG("Path found after {} iterations ({}, {} nodes updated)", iterations,
+                     m_lastReplanStats.incremental ? "incremental" : "full",
+                     m_lastReplanStats.updatedNodes);
+    return true;
+}
+
+bool DStarLite::applyChanges() {
+    // 区域外扩一格：单元格变化会改变它周围所有边（包括绕过它的对角线边）的代价
+    auto clampRegion = [this](const MapRegion& region) {
+        return MapRegion{
+            Point{std::max(std::min(region.topLeft.x, region.bottomRight.x) - 1, 0),
+                  std::max(std::min(region.topLeft.y, region.bottomRight.y) - 1, 0)},
+            Point{std::min(std::max(region.topLeft.x, region.bottomRight.x) + 1, m_width - 1),
+                  std::min(std::max(region.topLeft.y, region.bottomRight.y) + 1, m_height - 1)}};
+    };
+
+    size_t changedCells = 0;
+    for (const MapRegion& region : m_pending) {
+        const MapRegion area = clampRegion(region);
+        if (area.topLeft.x <= area.bottomRight.x && area.topLeft.y <= area.bottomRight.y) {
+            changedCells += static_cast<size_t>(area.bottomRight.x - area.topLeft.x + 1) *
+                            static_cast<size_t>(area.bottomRight.y - area.topLeft.y + 1);
+        }
+    }
+    m_lastReplanStats.changedCells = static_cast<int>(changedCells);
+    if (changedCells > m_g.size() / 4) {
+        ONEDAY_LOG_DEBUG("{} changed cells, falling back to a full search", changedCells);
+        return false;
+    }
+
+    if (++m_updateGeneration == 0) {
+        std::fill(m_updateStamps.begin(), m_updateStamps.end(), 0);
+        m_updateGeneration = 1;
+    }
+
+    const uint32_t goalIndex = toIndex(m_goal);
+    for (const MapRegion& region : m_pending) {
+        const MapRegion area = clampRegion(region);
+        for (int y = area.topLeft.y; y <= area.bottomRight.y; ++y) {
+            for (int x = area.topLeft.x; x <= area.bottomRight.x; ++x) {
+                const uint32_t node = toIndex(Point{x, y});
+                if (m_updateStamps[node] == m_updateGeneration) {
+                    continue;  // 重叠区域只更新一次
+                }
+                m_updateStamps[node] = m_updateGeneration;
+                m_lastReplanStats.updatedNodes++;
+                if (node != goalIndex) {
+                    m_rhs[node] = computeRhs(node);
+                }
+                updateVertex(node);
+            }
+        }
+    }
+    m_pending.clear();
+    return true;
+}
+
+int DStarLite::computeShortestPath() {
+    const uint32_t startIndex = toIndex(m_start);
+    const uint32_t goalIndex = toIndex(m_goal);
+
+    int iterations = 0;
+    while (!m_openList.empty()) {
+        const double startK2 = std::min(m_g[startIndex], m_rhs[startIndex]);
+        const double startK1 = calculateKey(m_start, startK2);
+        const IndexedHeap::Entry top = m_openList.top();
+        const bool beforeStart =
+            top.fCost < startK1 || (top.fCost == startK1 && top.hCost < startK2);
+        if (!beforeStart && m_rhs[startIndex] <= m_g[startIndex]) {
+            break;
+        }
+
+        const uint32_t node = top.node;
+        const Point position = toPoint(node);
+        const double k2 = std::min(m_g[node], m_rhs[node]);
+        const double k1 = calculateKey(position, k2);
+        if (top.fCost < k1 || (top.fCost == k1 && top.hCost < k2)) {
+            // 键值是起点移动前算的，按当前 km 更新后重新排队
+            m_openList.update(node, k1, k2);
+            continue;
+        }
+        iterations++;
+
+        if (m_g[node] > m_rhs[node]) {
+            // 过一致：g 降到 rhs，可能降低邻居的 rhs
+            m_g[node] = m_rhs[node];
+            m_openList.pop();
+            for (int direction = 0; direction < kDirectionCount; ++direction) {
+                const double cost = edgeCost(position, direction);
+                if (cost == kInfinity) {
+                    continue;
+                }
+                const uint32_t neighbor = toIndex(Point{position.x + kDirections[direction].dx,
+                                                        position.y + kDirections[direction].dy});
+                if (neighbor != goalIndex && cost + m_g[node] < m_rhs[neighbor]) {
+                    m_rhs[neighbor] = cost + m_g[node];
+                    updateVertex(neighbor);
+                }
+            }
+        } else {
+            // 欠一致：g 置为无穷大，经由本节点取得 rhs 的邻居需要重新计算
+            const double oldG = m_g[node];
+            m_g[node] = kInfinity;
+            updateVertex(node);
+            for (int direction = 0; direction < kDirectionCount; ++direction) {
+                const double cost = edgeCost(position, direction);
+                if (cost == kInfinity) {
+                    continue;
+                }
+                const uint32_t neighbor = toIndex(Point{position.x + kDirections[direction].dx,
+                                                        position.y + kDirections[direction].dy});
+                if (neighbor != goalIndex &&
+                    std::abs(m_rhs[neighbor] - (cost + oldG)) <= kCostEpsilon) {
+                    m_rhs[neighbor] = computeRhs(neighbor);
+                    updateVertex(neighbor);
+                }
+            }
+        }
+    }
+
+    return iterations;
+}
+
+double DStarLite::computeRhs(uint32_t node) const {
+    const Point position = toPoint(node);
+    double best = kInfinity;
+    for (int direction = 0; direction < kDirectionCount; ++direction) {
+        const double cost = edgeCost(position, direction);
+        if (cost == kInfinity) {
+            continue;
+        }
+        const Point next{position.x + kDirections[direction].dx,
+                         position.y + kDirections[direction].dy};
+        best = std::min(best, cost + m_g[toIndex(next)]);
+    }
+    return best;
+}
+
+void DStarLite::updateVertex(uint32_t node) {
+    if (m_g[node] != m_rhs[node]) {
+        const double k2 = std::min(m_g[node], m_rhs[node]);
+        const double k1 = calculateKey(toPoint(node), k2);
+        if (m_openList.contains(node)) {
+            m_openList.update(node, k1, k2);
+        } else {
+            m_openList.push(node, k1, k2);
+        }
+    } else if (m_openList.contains(node)) {
+        m_openList.remove(node);
+    }
+}
+
+bool DStarLite::extractPath(std::vector<Point>& path) const {
+    path.clear();
+    if (m_rhs[toIndex(m_start)] == kInfinity) {
+        return false;
+    }
+
+    // 每一步走向 c + g 最小的邻居；g 值沿路径严格下降，步数上限只是防御
+    const size_t maxSteps = m_g.size();
+    Point current = m_start;
+    path.push_back(current);
+    while (current != m_goal) {
+        double best = kInfinity;
+        Point next = current;
+        for (int direction = 0; direction < kDirectionCount; ++direction) {
+            const double cost = edgeCost(current, direction);
+            if (cost == kInfinity) {
+                continue;
+            }
+            const Point candidate{current.x + kDirections[direction].dx,
+                                  current.y + kDirections[direction].dy};
+            const double value = cost + m_g[toIndex(candidate)];
+            if (value < best) {
+                best = value;
+                next = candidate;
+            }
+        }
+        if (best == kInfinity || path.size() > maxSteps) {
+            path.clear();
+            return false;
+        }
+        current = next;
+        path.push_back(current);
+    }
+    return true;
+}
+
+double DStarLite::edgeCost(const Point& from, int direction) const {
+    const Direction& dir = kDirections[direction];
+    // from 在地图内，邻居最多越出一格，落在位平面的填充上
+    if (!m_map->isWalkableUnchecked(from.x, from.y) ||
+        !grid::canMove(*m_map, from.x, from.y, dir)) {
+        return kInfinity;
+    }
+    return dir.cost;
+}
+
+double DStarLite::calculateKey(const Point& position, double k2) const {
+    // 同一个实数值经不同的加法顺序得到的浮点数可能差一个舍入误差，键值相等时的次序
+    // 决定修复能否提前结束（k1 相同而 k2 更小的节点必须先扩展），因此把 k1 量化，
+    // 让实数意义上相等的键值在比较时也相等
+    const double k1 = k2 + calculateHeuristic(m_start, position) + m_keyModifier;
+    return std::round(k1 * kKeyScale) / kKeyScale;
+}
+
+double DStarLite::calculateHeuristic(const Point& from, const Point& to) const {
+    // 八方向距离：不高估实际代价且满足三角不等式，km 修正依赖后者
+    const int dx = std::abs(to.x - from.x);
+    const int dy = std::abs(to.y - from.y);
+    const int diagonal = std::min(dx, dy);
+    return m_heuristicWeight * (kDiagonalCost * diagonal + (std::max(dx, dy) - diagonal));
+}
+
+ReplanStats DStarLite::getLastReplanStats() const {
+    return m_lastReplanStats;
+}
+
+void DStarLite::setHeuristicWeight(double weight) {
+    m_heuristicWeight = std::max(1.0, weight);
+    m_initialized = false;  // 已排队的键值按旧权重计算
+    Logger::info("Heuristic weight set to {}", m_heuristicWeight);
+}
+
+double DStarLite::getHeuristicWeight() const {
+    return m_heuristicWeight;
+}
+
+PathfindingStats DStarLite::getLastPathfindingStats() const {
+    return m_lastStats;
+}
+
+}  // namespace oneday::pathfinding
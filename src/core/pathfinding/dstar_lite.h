@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "indexed_heap.h"
+#include "map.h"
+#include "pathfinding_algorithm.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 增量重规划的统计信息
+ */
+struct ReplanStats {
+    bool incremental = false;  ///< 是否在保留的搜索状态上修复（否则为完整搜索）
+    int changedCells = 0;      ///< 本次处理的变化区域的面积之和
+    int updatedNodes = 0;      ///< 因变化重新计算 rhs 的节点数
+};
+
+/**
+ * @brief D* Lite 增量路径查找算法
+ *
+ * 从终点向起点反向搜索，为每个单元格保存 g 值和 rhs 值（一步前瞻值）。
+ * 起点移动或单元格变化后不重新搜索，只把受影响的节点重新放入开放列表，
+ * 扩展范围限于代价确实发生变化的区域（LPA* 的增量修复加上起点移动时的 km 修正）。
+ * 移动规则和代价与 AStar 相同，返回的路径代价等于 A* 的最优代价。
+ *
+ * 单元格变化有两个来源：
+ * - findPath() 每次调用时读取地图的变化记录（Map::getChangedRegions），
+ *   终点不变时自动增量修复，因此可以直接交给 PathPlanner 使用；
+ * - notifyCellsChanged() 由调用方显式通知，随后用 replan() 从新位置修复。
+ *   replan() 同样读取地图的变化记录，通知只是提示，漏掉的修改不会被忽略。
+ *
+ * 终点改变、地图尺寸改变或变化记录不完整时退化为一次完整搜索；
+ * 变化单元格超过地图的四分之一时也直接完整搜索，这时修复并不比重新搜索便宜。
+ */
+class DStarLite : public PathfindingAlgorithm {
+  public:
+    /**
+     * @brief 构造函数
+     */
+    DStarLite();
+
+    /**
+     * @brief 析构函数
+     */
+    ~DStarLite();
+
+    /**
+     * @brief 查找从起点到终点的路径
+     * @param start 起点（通常是移动中的当前位置）
+     * @param goal 终点
+     * @param map 地图
+     * @return 路径点列表，如果没有找到路径则返回空列表
+     */
+    std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) override;
+
+    /**
+     * @brief 查找路径并写入调用方提供的缓冲区
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @param path 输出路径（复用其容量，未找到路径时清空）
+     * @return 是否找到路径
+     */
+    bool findPath(const Point& start, const Point& goal, const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief 通知单元格发生了变化（在下一次 replan() 时处理）
+     * @param region 变化区域（包含两个角点）
+     */
+    void notifyCellsChanged(const MapRegion& region);
+
+    /**
+     * @brief 通知单个单元格发生了变化
+     * @param cell 单元格
+     */
+    void notifyCellChanged(const Point& cell);
+
+    /**
+     * @brief 从当前位置出发，按已通知的变化修复上次 findPath() 的搜索
+     * @param current 当前位置
+     * @param path 输出路径（复用其容量，未找到路径时清空）
+     * @return 是否找到路径；尚未调用过 findPath() 时返回 false
+     *
+     * 使用上次 findPath() 的地图，调用方需保证其仍然存在。
+     * 此后的修改从地图变化记录中读取，不要求都已通过 notifyCellsChanged() 通知。
+     */
+    bool replan(const Point& current, std::vector<Point>& path);
+
+    /**
+     * @brief 丢弃保留的搜索状态，下一次查询完整搜索
+     */
+    void reset();
+
+    /**
+     * @brief 获取上次查询的重规划统计信息
+     */
+    ReplanStats getLastReplanStats() const;
+
+    /**
+     * @brief 设置启发式函数权重
+     * @param weight 权重值（>= 1.0，大于 1 时路径不保证最优）
+     */
+    void setHeuristicWeight(double weight) override;
+
+    /**
+     * @brief 获取启发式函数权重
+     * @return 权重值
+     */
+    double getHeuristicWeight() const override;
+
+    /**
+     * @brief 获取上次路径查找的统计信息
+     * @return 统计信息（nodesExplored 为本次新扩展的节点数）
+     */
+    PathfindingStats getLastPathfindingStats() const override;
+
+  private:
+    /**
+     * @brief 为新的起点、终点和地图重置全部搜索状态
+     */
+    void initialize(const Point& start, const Point& goal, const Map& map);
+
+    /**
+     * @brief 移动起点、处理待处理的变化并修复搜索，输出路径
+     * @return 是否找到路径
+     */
+    bool repair(const Point& start, std::vector<Point>& path);
+
+    /**
+     * @brief 重新计算变化区域（外扩一格）内节点的 rhs 值
+     * @return 是否完成增量处理；变化过多时改为完整重置并返回 false
+     */
+    bool applyChanges();
+
+    /**
+     * @brief 扩展节点直到起点局部一致
+     * @return 扩展的节点数
+     */
+    int computeShortestPath();
+
+    /**
+     * @brief 由后继节点的 g 值重新计算 rhs 值
+     */
+    double computeRhs(uint32_t node) const;
+
+    /**
+     * @brief 按 g 与 rhs 是否一致把节点放入或移出开放列表
+     */
+    void updateVertex(uint32_t node);
+
+    /**
+     * @brief 沿 g 值下降最快的方向从起点走到终点
+     */
+    bool extractPath(std::vector<Point>& path) const;
+
+    /**
+     * @brief 从 from 沿 kDirections[direction] 走一步的代价（不可通行时为无穷大）
+     */
+    double edgeCost(const Point& from, int direction) const;
+
+    /**
+     * @brief 计算键值的第一项 k1 = k2 + h(起点, position) + km
+     * @param position 节点位置
+     * @param k2 键值的第二项 min(g, rhs)
+     */
+    double calculateKey(const Point& position, double k2) const;
+
+    /**
+     * @brief 计算启发式距离（加权八方向距离，满足三角不等式）
+     */
+    double calculateHeuristic(const Point& from, const Point& to) const;
+
+    uint32_t toIndex(const Point& point) const {
+        return static_cast<uint32_t>(point.y * m_width + point.x);
+    }
+
+    Point toPoint(uint32_t index) const {
+        return Point{static_cast<int>(index % static_cast<uint32_t>(m_width)),
+                     static_cast<int>(index / static_cast<uint32_t>(m_width))};
+    }
+
+  private:
+    double m_heuristicWeight = 1.0;  ///< 启发式函数权重
+    PathfindingStats m_lastStats;    ///< 上次查找的统计信息
+    ReplanStats m_lastReplanStats;   ///< 上次查找的重规划统计信息
+
+    const Map* m_map = nullptr;  ///< 搜索状态对应的地图
+    int m_width = 0;             ///< 地图宽度
+    int m_height = 0;            ///< 地图高度
+    uint64_t m_revision = 0;     ///< 已处理到的地图修订号
+    bool m_initialized = false;  ///< 是否保留有效的搜索状态
+    Point m_start;               ///< 当前起点
+    Point m_goal;                ///< 终点（反向搜索的源点）
+    Point m_lastStart;           ///< 上次累加 km 时的起点
+    double m_keyModifier = 0.0;  ///< 起点移动累计的键值修正（km）
+
+    std::vector<double> m_g;               ///< 每个单元格的 g 值（到终点的距离）
+    std::vector<double> m_rhs;             ///< 每个单元格的一步前瞻值
+    IndexedHeap m_openList;                ///< 按 (k1, k2) 排序的开放列表
+    std::vector<MapRegion> m_pending;      ///< 待处理的变化区域
+    std::vector<MapRegion> m_mapChanges;   ///< 读取地图变化记录用的缓冲区
+    std::vector<uint32_t> m_updateStamps;  ///< 单次修复中节点是否已更新（世代戳）
+    uint32_t m_updateGeneration = 0;       ///< 当前修复的世代
+};
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,376 @@
+#include "flow_field.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include "../common/logger.h"
+#include "../common/thread_pool.h"
+#include "grid_directions.h"
+
+using oneday::common::ThreadPool;
+
+namespace oneday::pathfinding {
+
+using grid::Direction;
+using grid::kDirectionCount;
+using grid::kDirections;
+using grid::kOpposite;
+
+namespace {
+
+constexpr size_t kParallelFrontier = 2048;  ///< 波前达到该大小时并行松弛
+constexpr size_t kChunkSize = 512;          ///< 并行松弛每个分块的最少节点数
+
+int64_t bucketOf(double distance) {
+    return static_cast<int64_t>(distance);
+}
+
+/**
+ * @brief 对单元格的每条可通行边调用 visit(方向下标, 邻居下标, 边代价)
+ *
+ * 单元格在地图内，邻居最多越出一格，落在位平面的填充上。
+ */
+template <typename Visit>
+void forEachEdge(const Map& map, int width, uint32_t node, Visit&& visit) {
+    const int x = static_cast<int>(node % static_cast<uint32_t>(width));
+    const int y = static_cast<int>(node / static_cast<uint32_t>(width));
+    for (int i = 0; i < kDirectionCount; ++i) {
+        const Direction& dir = kDirections[i];
+        if (!grid::canMove(map, x, y, dir)) {
+            continue;
+        }
+        visit(i, static_cast<uint32_t>((y + dir.dy) * width + x + dir.dx), dir.cost);
+    }
+}
+
+double elapsedMilliseconds(std::chrono::high_resolution_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     since)
+        .count();
+}
+
+}  // namespace
+
+FlowField::FlowField() = default;
+
+void FlowField::build(const Map& map, const Point& goal) {
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    m_goal = goal;
+    m_width = map.getWidth();
+    m_height = map.getHeight();
+    m_revision = map.getRevision();
+    m_built = true;
+
+    const size_t cellCount = static_cast<size_t>(m_width) * static_cast<size_t>(m_height);
+    m_distances.assign(cellCount, kUnreachable);
+    m_directions.assign(cellCount, -1);
+    m_stamps.assign(cellCount, 0);
+    m_invalid.assign(cellCount, 0);
+    m_generation = 0;
+
+    m_seeds.clear();
+    if (map.isWalkable(goal)) {
+        const uint32_t goalIndex = toIndex(goal.x, goal.y);
+        m_distances[goalIndex] = 0.0;
+        m_seeds.emplace_back(0.0, goalIndex);
+    }
+    propagate(map);
+
+    // 每个单元格的方向只读取邻居的最终距离，按行并行
+    auto updateRows = [this, &map](size_t begin, size_t end) {
+        for (size_t node = begin * m_width; node < end * m_width; ++node) {
+            updateDirection(map, static_cast<uint32_t>(node));
+        }
+    };
+    ThreadPool& pool = ThreadPool::instance();
+    if (m_parallel && pool.getThreadCount() > 0) {
+        pool.parallelForRange(0, m_height, updateRows, pool.autoGrainSize(m_height, 16));
+    } else {
+        updateRows(0, m_height);
+    }
+
+    m_lastStats = FlowFieldStats();
+    m_lastStats.cellsUpdated = static_cast<int>(m_settled.size());
+    m_lastStats.executionTime = elapsedMilliseconds(startTime);
+    ONEDAY_LOG_DEBUG("Flow field to ({},{}) built: {} reachable cells in {} ms", goal.x, goal.y,
+                     m_settled.size(), m_lastStats.executionTime);
+}
+
+int FlowField::synchronize(const Map& map, const Point& goal) {
+    if (!m_built || goal != m_goal || map.getWidth() != m_width || map.getHeight() != m_height) {
+        build(map, goal);
+        return m_lastStats.cellsUpdated;
+    }
+    if (map.getRevision() == m_revision) {
+        m_lastStats = FlowFieldStats();
+        m_lastStats.incremental = true;
+        return 0;
+    }
+    if (!map.getChangedRegions(m_revision, m_changes)) {
+        build(map, goal);
+        return m_lastStats.cellsUpdated;
+    }
+
+    // 变化过多时修复并不比重新构建便宜
+    const size_t cellCount = m_distances.size();
+    size_t changedCells = 0;
+    for (const MapRegion& region : m_changes) {
+        changedCells += static_cast<size_t>(region.bottomRight.x - region.topLeft.x + 1) *
+                        static_cast<size_t>(region.bottomRight.y - region.topLeft.y + 1);
+    }
+    if (changedCells > cellCount / 4) {
+        build(map, goal);
+        return m_lastStats.cellsUpdated;
+    }
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    m_revision = map.getRevision();
+    invalidate(m_changes);
+    for (uint32_t node : m_invalidated) {
+        m_distances[node] = kUnreachable;
+        m_directions[node] = -1;
+    }
+
+    // 作废的单元格从仍然有效的邻居取初始距离，再一起传播
+    const uint32_t goalIndex = toIndex(m_goal.x, m_goal.y);
+    m_seeds.clear();
+    for (uint32_t node : m_invalidated) {
+        const int x = static_cast<int>(node % static_cast<uint32_t>(m_width));
+        const int y = static_cast<int>(node / static_cast<uint32_t>(m_width));
+        if (!map.isWalkableUnchecked(x, y)) {
+            continue;
+        }
+        double best = node == goalIndex ? 0.0 : kUnreachable;
+        forEachEdge(map, m_width, node, [this, &best](int, uint32_t neighbor, double cost) {
+            if (!m_invalid[neighbor]) {
+                best = std::min(best, cost + m_distances[neighbor]);
+            }
+        });
+        if (best != kUnreachable) {
+            m_distances[node] = best;
+            m_seeds.emplace_back(best, node);
+        }
+    }
+    std::sort(m_seeds.begin(), m_seeds.end());
+    propagate(map);
+
+    // 距离没有变化、流向也不经过作废区域的单元格，原来的方向仍然指向最短路径
+    int updated = static_cast<int>(m_invalidated.size());
+    for (uint32_t node : m_settled) {
+        updated += m_invalid[node] ? 0 : 1;
+        updateDirection(map, node);
+    }
+    for (uint32_t node : m_invalidated) {
+        m_invalid[node] = 0;
+        updateDirection(map, node);
+    }
+
+    m_lastStats = FlowFieldStats();
+    m_lastStats.incremental = true;
+    m_lastStats.cellsUpdated = updated;
+    m_lastStats.executionTime = elapsedMilliseconds(startTime);
+    ONEDAY_LOG_DEBUG("Flow field to ({},{}) repaired: {} cells updated in {} ms", m_goal.x,
+                     m_goal.y, updated, m_lastStats.executionTime);
+    return updated;
+}
+
+void FlowField::setParallel(bool parallel) {
+    m_parallel = parallel;
+}
+
+double FlowField::getDistance(const Point& point) const {
+    if (!m_built || point.x < 0 || point.y < 0 || point.x >= m_width || point.y >= m_height) {
+        return kUnreachable;
+    }
+    return m_distances[toIndex(point.x, point.y)];
+}
+
+Point FlowField::getNextStep(const Point& point) const {
+    if (point == m_goal) {
+        return isReachable(point) ? point : Point{-1, -1};
+    }
+    if (!m_built || point.x < 0 || point.y < 0 || point.x >= m_width || point.y >= m_height) {
+        return Point{-1, -1};
+    }
+    const int8_t direction = m_directions[toIndex(point.x, point.y)];
+    if (direction < 0) {
+        return Point{-1, -1};
+    }
+    return Point{point.x + kDirections[direction].dx, point.y + kDirections[direction].dy};
+}
+
+bool FlowField::extractPath(const Point& start, std::vector<Point>& path) const {
+    path.clear();
+    if (!isReachable(start)) {
+        return false;
+    }
+
+    // 每一步距离严格下降，必然走到终点
+    Point current = start;
+    path.push_back(current);
+    while (current != m_goal) {
+        current = getNextStep(current);
+        if (current.x < 0) {
+            path.clear();
+            return false;
+        }
+        path.push_back(current);
+    }
+    return true;
+}
+
+void FlowField::propagate(const Map& map) {
+    if (++m_generation == 0) {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_generation = 1;
+    }
+    m_settled.clear();
+    for (auto& bucket : m_buckets) {
+        bucket.clear();
+    }
+
+    size_t nextSeed = 0;
+    int64_t bucket = 0;
+    while (true) {
+        // 三个桶都空时跳到下一个初始节点所在的桶
+        if (m_buckets[0].empty() && m_buckets[1].empty() && m_buckets[2].empty()) {
+            if (nextSeed == m_seeds.size()) {
+                break;
+            }
+            bucket = bucketOf(m_seeds[nextSeed].first);
+        }
+        std::vector<uint32_t>& current = m_buckets[bucket % 3];
+        for (; nextSeed < m_seeds.size() && bucketOf(m_seeds[nextSeed].first) == bucket;
+             ++nextSeed) {
+            current.push_back(m_seeds[nextSeed].second);
+        }
+
+        // 同一节点可能被放入多次，只保留距离仍落在本桶、且尚未定型的一份
+        m_frontier.clear();
+        for (uint32_t node : current) {
+            if (m_stamps[node] != m_generation && bucketOf(m_distances[node]) == bucket) {
+                m_stamps[node] = m_generation;
+                m_frontier.push_back(node);
+            }
+        }
+        current.clear();
+        m_settled.insert(m_settled.end(), m_frontier.begin(), m_frontier.end());
+        if (!m_frontier.empty()) {
+            relaxFrontier(map, bucket);
+        }
+        ++bucket;
+    }
+}
+
+void FlowField::relaxFrontier(const Map& map, int64_t bucket) {
+    std::vector<uint32_t>& nearBucket = m_buckets[(bucket + 1) % 3];
+    std::vector<uint32_t>& farBucket = m_buckets[(bucket + 2) % 3];
+
+    ThreadPool& pool = ThreadPool::instance();
+    if (!m_parallel || m_frontier.size() < kParallelFrontier || pool.getThreadCount() == 0) {
+        for (uint32_t node : m_frontier) {
+            const double distance = m_distances[node];
+            forEachEdge(map, m_width, node, [&](int, uint32_t neighbor, double cost) {
+                const double candidate = distance + cost;
+                if (candidate < m_distances[neighbor]) {
+                    m_distances[neighbor] = candidate;
+                    (bucketOf(candidate) == bucket + 1 ? nearBucket : farBucket)
+                        .push_back(neighbor);
+                }
+            });
+        }
+        return;
+    }
+
+    // 波前节点的距离都已定型，互不影响；多个节点同时改进同一邻居时用原子比较交换取最小值
+    const size_t chunkCount = std::min<size_t>(m_frontier.size() / kChunkSize,
+                                               (pool.getThreadCount() + 1) * 4);
+    if (m_chunkPushes.size() < chunkCount) {
+        m_chunkPushes.resize(chunkCount);
+    }
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        auto& pushes = m_chunkPushes[chunk];
+        pushes[0].clear();
+        pushes[1].clear();
+        const size_t begin = m_frontier.size() * chunk / chunkCount;
+        const size_t end = m_frontier.size() * (chunk + 1) / chunkCount;
+        for (size_t i = begin; i < end; ++i) {
+            const double distance = m_distances[m_frontier[i]];
+            forEachEdge(map, m_width, m_frontier[i], [&](int, uint32_t neighbor, double cost) {
+                const double candidate = distance + cost;
+                std::atomic_ref<double> target(m_distances[neighbor]);
+                double current = target.load(std::memory_order_relaxed);
+                while (candidate < current) {
+                    if (target.compare_exchange_weak(current, candidate,
+                                                     std::memory_order_relaxed)) {
+                        pushes[bucketOf(candidate) == bucket + 1 ? 0 : 1].push_back(neighbor);
+                        break;
+                    }
+                }
+            });
+        }
+    });
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const auto& pushes = m_chunkPushes[chunk];
+        nearBucket.insert(nearBucket.end(), pushes[0].begin(), pushes[0].end());
+        farBucket.insert(farBucket.end(), pushes[1].begin(), pushes[1].end());
+    }
+}
+
+void FlowField::updateDirection(const Map& map, uint32_t node) {
+    m_directions[node] = -1;
+    if (m_distances[node] == kUnreachable || node == toIndex(m_goal.x, m_goal.y)) {
+        return;
+    }
+    // 距离是精确的最短距离：总有邻居满足 代价 + 距离 = 当前距离，取最小者即下降方向
+    double best = kUnreachable;
+    forEachEdge(map, m_width, node, [&](int direction, uint32_t neighbor, double cost) {
+        const double value = cost + m_distances[neighbor];
+        if (value < best) {
+            best = value;
+            m_directions[node] = static_cast<int8_t>(direction);
+        }
+    });
+}
+
+void FlowField::invalidate(const std::vector<MapRegion>& regions) {
+    // 变化单元格外扩一格：这些单元格的边（包括对角线的拐角规则）可能改变
+    m_invalidated.clear();
+    for (const MapRegion& region : regions) {
+        const int left = std::max(region.topLeft.x - 1, 0);
+        const int top = std::max(region.topLeft.y - 1, 0);
+        const int right = std::min(region.bottomRight.x + 1, m_width - 1);
+        const int bottom = std::min(region.bottomRight.y + 1, m_height - 1);
+        for (int y = top; y <= bottom; ++y) {
+            for (int x = left; x <= right; ++x) {
+                const uint32_t node = toIndex(x, y);
+                if (!m_invalid[node]) {
+                    m_invalid[node] = 1;
+                    m_invalidated.push_back(node);
+                }
+            }
+        }
+    }
+
+    // 流向作废单元格的邻居也作废，直到流向树的整棵下游子树
+    for (size_t i = 0; i < m_invalidated.size(); ++i) {
+        const uint32_t node = m_invalidated[i];
+        const int x = static_cast<int>(node % static_cast<uint32_t>(m_width));
+        const int y = static_cast<int>(node / static_cast<uint32_t>(m_width));
+        for (int direction = 0; direction < kDirectionCount; ++direction) {
+            const int nx = x + kDirections[direction].dx;
+            const int ny = y + kDirections[direction].dy;
+            if (nx < 0 || ny < 0 || nx >= m_width || ny >= m_height) {
+                continue;
+            }
+            const uint32_t neighbor = toIndex(nx, ny);
+            if (!m_invalid[neighbor] && m_directions[neighbor] == kOpposite[direction]) {
+                m_invalid[neighbor] = 1;
+                m_invalidated.push_back(neighbor);
+            }
+        }
+    }
+}
+
+}  // namespace oneday::pathfinding
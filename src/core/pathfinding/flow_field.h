@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "map.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 流场构建统计信息
+ */
+struct FlowFieldStats {
+    bool incremental = false;    ///< 是否为增量修复（否则为完整构建）
+    int cellsUpdated = 0;        ///< 重新计算距离的单元格数
+    double executionTime = 0.0;  ///< 执行时间（毫秒）
+};
+
+/**
+ * @brief 以终点为源点的距离场和流场
+ *
+ * 从终点做一次整图 Dijkstra（移动规则和代价与 AStar 相同），再为每个单元格记下
+ * 走向终点的下一步方向。任意多个单位去同一个终点时，每个单位每一步只需 O(1) 查表，
+ * 沿流场走出的路径代价等于 A* 的最优代价。
+ *
+ * 边的代价只有 1 和 sqrt(2)，因此按距离的整数部分分桶：处理第 k 个桶时桶内节点的距离
+ * 都已是最终值，新放入的节点只会落在第 k+1 或 k+2 个桶，三个循环使用的桶即可代替堆。
+ * 同一个桶的节点互不影响，波前较大时在线程池上并行松弛。
+ *
+ * synchronize() 通过 Map::getChangedRegions() 增量修复：把变化区域（外扩一格）以及
+ * 流向经过这些单元格的所有单元格作废，再从作废区域的边界重新传播。
+ */
+class FlowField {
+  public:
+    static constexpr double kUnreachable = std::numeric_limits<double>::infinity();  ///< 不可达
+
+    /**
+     * @brief 构造函数
+     */
+    FlowField();
+
+    /**
+     * @brief 为终点完整构建距离场和流场
+     * @param map 地图
+     * @param goal 终点（不可行走时所有单元格都不可达）
+     */
+    void build(const Map& map, const Point& goal);
+
+    /**
+     * @brief 使流场与地图和终点同步
+     * @param map 地图
+     * @param goal 终点
+     * @return 重新计算距离的单元格数（已是最新时为 0）
+     *
+     * 终点改变、尚未构建、地图尺寸改变或变化记录不完整时完整构建；
+     * 变化区域超过地图的四分之一时也完整构建。
+     */
+    int synchronize(const Map& map, const Point& goal);
+
+    /**
+     * @brief 设置是否在线程池上并行传播（默认启用）
+     */
+    void setParallel(bool parallel);
+
+    /**
+     * @brief 是否已构建
+     */
+    bool isBuilt() const {
+        return m_built;
+    }
+
+    /**
+     * @brief 获取终点
+     */
+    const Point& getGoal() const {
+        return m_goal;
+    }
+
+    /**
+     * @brief 获取单元格到终点的最短距离
+     * @return 距离，不可达或不在地图内时返回 kUnreachable
+     */
+    double getDistance(const Point& point) const;
+
+    /**
+     * @brief 单元格能否到达终点
+     */
+    bool isReachable(const Point& point) const {
+        return getDistance(point) != kUnreachable;
+    }
+
+    /**
+     * @brief 获取从单元格走向终点的下一步（O(1) 查表）
+     * @return 下一个单元格；在终点时返回终点本身，不可达时返回 (-1, -1)
+     */
+    Point getNextStep(const Point& point) const;
+
+    /**
+     * @brief 沿流场输出从起点到终点的逐格路径
+     * @param start 起点
+     * @param path 输出路径（不可达时清空）
+     * @return 是否可达
+     */
+    bool extractPath(const Point& start, std::vector<Point>& path) const;
+
+    /**
+     * @brief 获取上次构建或同步的统计信息
+     */
+    FlowFieldStats getLastStats() const {
+        return m_lastStats;
+    }
+
+  private:
+    /**
+     * @brief 从 m_seeds（按距离升序）出发按桶传播，距离已写入 m_distances
+     */
+    void propagate(const Map& map);
+
+    /**
+     * @brief 松弛一个桶的波前，新节点按距离放入对应的桶
+     */
+    void relaxFrontier(const Map& map, int64_t bucket);
+
+    /**
+     * @brief 重新计算单元格的下一步方向
+     */
+    void updateDirection(const Map& map, uint32_t node);
+
+    /**
+     * @brief 标记变化区域（外扩一格）及其流向下游的单元格，写入 m_invalidated
+     */
+    void invalidate(const std::vector<MapRegion>& regions);
+
+    uint32_t toIndex(int x, int y) const {
+        return static_cast<uint32_t>(y * m_width + x);
+    }
+
+  private:
+    bool m_built = false;        ///< 是否已构建
+    bool m_parallel = true;      ///< 是否并行传播
+    Point m_goal;                ///< 终点
+    int m_width = 0;             ///< 地图宽度
+    int m_height = 0;            ///< 地图高度
+    uint64_t m_revision = 0;     ///< 流场对应的地图修订号
+    FlowFieldStats m_lastStats;  ///< 上次构建或同步的统计信息
+
+    std::vector<double> m_distances;   ///< 每个单元格到终点的距离
+    std::vector<int8_t> m_directions;  ///< 每个单元格的下一步方向（-1 表示无）
+    std::vector<uint32_t> m_stamps;    ///< 传播中已定型的节点（世代戳）
+    uint32_t m_generation = 0;         ///< 当前传播的世代
+
+    std::array<std::vector<uint32_t>, 3> m_buckets;    ///< 循环使用的距离桶
+    std::vector<uint32_t> m_frontier;                   ///< 当前桶去重后的波前
+    std::vector<uint32_t> m_settled;                    ///< 本次传播定型的节点
+    std::vector<std::pair<double, uint32_t>> m_seeds;   ///< 传播的初始节点（距离，下标）
+    std::vector<std::array<std::vector<uint32_t>, 2>> m_chunkPushes;  ///< 并行松弛各分块的新节点
+    std::vector<uint8_t> m_invalid;                     ///< 增量修复中作废的单元格
+    std::vector<uint32_t> m_invalidated;                ///< 作废单元格列表
+    std::vector<MapRegion> m_changes;                   ///< 读取地图变化记录用的缓冲区
+};
+
+}  // namespace oneday::pathfinding
@@ -1,6 +1,8 @@
 #include "geometry_utils.h"
 #include "../common/logger.h"
 
+using oneday::core::Logger;
+
 namespace oneday::pathfinding {
 
 // 静态成员函数实现
@@ -8,7 +10,7 @@ bool GeometryUtils::pointInPolygon(const Point2D& point, const Polygon& polygon)
     try {
         return bg::within(point, polygon);
     } catch (const std::exception& e) {
-        Logger::error("Error in pointInPolygon: " + std::string(e.what()));
+        Logger::error("Error in pointInPolygon: {}", e.what());
         return false;
     }
 }
@@ -17,7 +19,7 @@ bool GeometryUtils::polygonsIntersect(const Polygon& a, const Polygon& b) {
     try {
         return bg::intersects(a, b);
     } catch (const std::exception& e) {
-        Logger::error("Error in polygonsIntersect: " + std::string(e.what()));
+        Logger::error("Error in polygonsIntersect: {}", e.what());
         return false;
     }
 }
@@ -26,7 +28,7 @@ float GeometryUtils::distance(const Point2D& a, const Point2D& b) {
     try {
         return static_cast<float>(bg::distance(a, b));
     } catch (const std::exception& e) {
-        Logger::error("Error in distance calculation: " + std::string(e.what()));
+        Logger::error("Error in distance calculation: {}", e.what());
         return 0.0f;
     }
 }
@@ -39,7 +41,7 @@ bool GeometryUtils::lineIntersectsPolygon(const Point2D& start, const Point2D& e
         bg::append(line, end);
         return bg::intersects(line, polygon);
     } catch (const std::exception& e) {
-        Logger::error("Error in lineIntersectsPolygon: " + std::string(e.what()));
+        Logger::error("Error in lineIntersectsPolygon: {}", e.what());
         return true; // 安全起见，假设相交
     }
 }
@@ -50,7 +52,7 @@ Polygon GeometryUtils::simplifyPolygon(const Polygon& polygon, float tolerance)
         bg::simplify(polygon, simplified, static_cast<double>(tolerance));
         return simplified;
     } catch (const std::exception& e) {
-        Logger::error("Error in simplifyPolygon: " + std::string(e.what()));
+        Logger::error("Error in simplifyPolygon: {}", e.what());
         return polygon; // 返回原始多边形
     }
 }
@@ -59,7 +61,7 @@ float GeometryUtils::polygonArea(const Polygon& polygon) {
     try {
         return static_cast<float>(bg::area(polygon));
     } catch (const std::exception& e) {
-        Logger::error("Error in polygonArea: " + std::string(e.what()));
+        Logger::error("Error in polygonArea: {}", e.what());
         return 0.0f;
     }
 }
@@ -80,7 +82,7 @@ std::vector<Polygon> GeometryUtils::bufferPolygon(const Polygon& polygon, float
         }
         return polygons;
     } catch (const std::exception& e) {
-        Logger::error("Error in bufferPolygon: " + std::string(e.what()));
+        Logger::error("Error in bufferPolygon: {}", e.what());
         return {polygon}; // 返回原始多边形
     }
 }
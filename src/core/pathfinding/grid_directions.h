@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+#include "map.h"
+
+namespace oneday::pathfinding::grid {
+
+/**
+ * @brief 移动方向及其代价
+ */
+struct Direction {
+    int dx;
+    int dy;
+    double cost;
+};
+
+constexpr double kDiagonalCost = 1.4142135623730951;  ///< sqrt(2)
+
+/**
+ * @brief 8方向移动（包括对角线），边是无向的，前驱和后继相同
+ *
+ * 前 4 个为直线方向，后 4 个为对角线方向；顺序固定，kOpposite 和按下标保存方向的算法依赖它。
+ */
+constexpr Direction kDirections[] = {{-1, 0, 1.0},
+                                     {1, 0, 1.0},
+                                     {0, -1, 1.0},
+                                     {0, 1, 1.0},
+                                     {-1, -1, kDiagonalCost},
+                                     {-1, 1, kDiagonalCost},
+                                     {1, -1, kDiagonalCost},
+                                     {1, 1, kDiagonalCost}};
+
+constexpr int kDirectionCount = 8;  ///< 方向数
+
+/**
+ * @brief 每个方向的反方向在 kDirections 中的下标
+ */
+constexpr int8_t kOpposite[kDirectionCount] = {1, 0, 3, 2, 7, 6, 5, 4};
+
+/**
+ * @brief 是否可以从 (x, y) 走一步到 (x + dx, y + dy)
+ * @param isWalkable 单元格可行走判断，形如 bool(int x, int y)
+ *
+ * 目标单元格必须可行走；对角线移动时两侧的直线邻格也必须可行走（不能切过障碍物的拐角）。
+ */
+template <typename IsWalkable>
+inline bool canMove(int x, int y, int dx, int dy, IsWalkable&& isWalkable) {
+    if (!isWalkable(x + dx, y + dy)) {
+        return false;
+    }
+    // 如果水平或垂直方向被阻挡，则不能对角线移动
+    return dx == 0 || dy == 0 || (isWalkable(x + dx, y) && isWalkable(x, y + dy));
+}
+
+/**
+ * @brief 是否可以从地图内的 (x, y) 沿 dir 走一步（邻居最多越出地图一格，落在位平面的填充上）
+ */
+inline bool canMove(const Map& map, int x, int y, const Direction& dir) {
+    return canMove(x, y, dir.dx, dir.dy,
+                   [&map](int cx, int cy) { return map.isWalkableUnchecked(cx, cy); });
+}
+
+}  // namespace oneday::pathfinding::grid
@@ -0,0 +1,241 @@
+#include "hpa_star.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "../common/logger.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+namespace {
+
+/**
+ * @brief 跨簇过渡边的方向（过渡单元格对总是水平或垂直相邻）
+ */
+constexpr Point kCrossings[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+}  // namespace
+
+HPAStar::HPAStar(int clusterSize) : m_abstraction(clusterSize) {
+    Logger::info("HPA* pathfinder initialized");
+}
+
+HPAStar::~HPAStar() {
+    Logger::info("HPA* pathfinder destroyed");
+}
+
+std::vector<Point> HPAStar::findPath(const Point& start, const Point& goal, const Map& map) {
+    std::vector<Point> path;
+    findPath(start, goal, map, path);
+    return path;
+}
+
+bool HPAStar::findPath(const Point& start,
+                       const Point& goal,
+                       const Map& map,
+                       std::vector<Point>& path) {
+    ONEDAY_LOG_DEBUG("Starting HPA* pathfinding from ({},{}) to ({},{})",
+                     start.x, start.y, goal.x, goal.y);
+    path.clear();
+    m_lastStats = PathfindingStats();
+
+    // 检查起点和终点是否有效
+    if (!map.isValidPosition(start) || !map.isValidPosition(goal)) {
+        Logger::error("Invalid start or goal position");
+        return false;
+    }
+
+    if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+        Logger::error("Start or goal position is not walkable");
+        return false;
+    }
+
+    // 如果起点就是终点
+    if (start == goal) {
+        path.push_back(start);
+        m_lastStats.pathFound = true;
+        m_lastStats.pathLength = 1;
+        return true;
+    }
+
+    // 抽象图的构建和增量更新不计入单次查询
+    m_abstraction.synchronize(map);
+
+    auto startTime = std::chrono::steady_clock::now();
+    int iterations = searchAbstract(start, goal, map);
+    if (!m_abstractPath.empty()) {
+        iterations += refinePath(map, path);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    m_lastStats.nodesExplored = iterations;
+    m_lastStats.pathFound = !path.empty();
+    m_lastStats.pathLength = static_cast<int>(path.size());
+    m_lastStats.executionTime =
+        std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    if (!m_lastStats.pathFound) {
+        Logger::warning("No path found after {} iterations", iterations);
+        return false;
+    }
+    ONEDAY_LOG_DEBUG("Path found after {} iterations ({} abstract nodes)",
+                     iterations, m_abstractPath.size());
+    return true;
+}
+
+int HPAStar::searchAbstract(const Point& start, const Point& goal, const Map& map) {
+    m_abstractPath.clear();
+
+    // 起点和终点各做一次簇内搜索，得到它们到本簇入口的距离
+    const int startCluster = m_abstraction.getClusterIndex(start);
+    const int goalCluster = m_abstraction.getClusterIndex(goal);
+    int iterations = m_startSearch.run(map, m_abstraction.getClusterRegion(startCluster), start);
+    iterations += m_goalSearch.run(map, m_abstraction.getClusterRegion(goalCluster), goal);
+
+    m_workspace.prepare(map.getWidth(), map.getHeight());
+    IndexedHeap& openSet = m_workspace.getOpenList();
+
+    const uint32_t startIndex = m_workspace.toIndex(start);
+    const uint32_t goalIndex = m_workspace.toIndex(goal);
+    const double startHCost = calculateHeuristic(start, goal);
+    m_workspace.visit(startIndex, 0.0, SearchWorkspace::kNoParent);
+    openSet.push(startIndex, startHCost, startHCost);
+
+    while (!openSet.empty()) {
+        const uint32_t current = openSet.pop().node;
+        m_workspace.close(current);
+        iterations++;
+
+        if (current == goalIndex) {
+            m_workspace.reconstructPath(goalIndex, m_abstractPath);
+            break;
+        }
+
+        const Point position = m_workspace.toPoint(current);
+        const double currentGCost = m_workspace.getGCost(current);
+        auto relax = [&](const Point& next, double cost) {
+            const uint32_t successor = m_workspace.toIndex(next);
+            if (m_workspace.isClosed(successor)) {
+                return;
+            }
+            const bool inOpenSet = m_workspace.isVisited(successor);
+            const double tentativeGCost = currentGCost + cost;
+            if (inOpenSet && tentativeGCost >= m_workspace.getGCost(successor)) {
+                return;
+            }
+            const double hCost = calculateHeuristic(next, goal);
+            m_workspace.visit(successor, tentativeGCost, static_cast<int32_t>(current));
+            if (inOpenSet) {
+                openSet.decreaseKey(successor, tentativeGCost + hCost, hCost);
+            } else {
+                openSet.push(successor, tentativeGCost + hCost, hCost);
+            }
+        };
+
+        const int cluster = m_abstraction.getClusterIndex(position);
+        const std::vector<Point>& entrances = m_abstraction.getEntrances(cluster);
+        const int slot = m_abstraction.getEntranceSlot(position);
+
+        // 簇内边：起点使用临时搜索的结果，入口节点使用预计算的距离
+        if (current == startIndex) {
+            for (const Point& entrance : entrances) {
+                const double distance = m_startSearch.getDistance(entrance);
+                if (entrance != start && distance != RegionSearch::kUnreachable) {
+                    relax(entrance, distance);
+                }
+            }
+        } else if (slot >= 0) {
+            for (int other = 0; other < static_cast<int>(entrances.size()); ++other) {
+                const double distance = m_abstraction.getDistance(cluster, slot, other);
+                if (other != slot && distance != RegionSearch::kUnreachable) {
+                    relax(entrances[other], distance);
+                }
+            }
+        }
+
+        // 跨簇边：相邻簇中紧挨着的入口节点
+        if (slot >= 0) {
+            for (const Point& crossing : kCrossings) {
+                const Point next{position.x + crossing.x, position.y + crossing.y};
+                if (map.isValidPosition(next) && m_abstraction.getClusterIndex(next) != cluster &&
+                    m_abstraction.getEntranceSlot(next) >= 0) {
+                    relax(next, 1.0);
+                }
+            }
+        }
+
+        // 终点所在簇内的节点可以直接连到终点
+        if (cluster == goalCluster) {
+            const double distance = m_goalSearch.getDistance(position);
+            if (distance != RegionSearch::kUnreachable) {
+                relax(goal, distance);
+            }
+        }
+    }
+
+    return iterations;
+}
+
+int HPAStar::refinePath(const Map& map, std::vector<Point>& path) {
+    int iterations = 0;
+    path.clear();
+    path.push_back(m_abstractPath.front());
+    for (size_t i = 1; i < m_abstractPath.size(); ++i) {
+        const Point& from = m_abstractPath[i - 1];
+        const Point& to = m_abstractPath[i];
+        const int cluster = m_abstraction.getClusterIndex(from);
+        if (m_abstraction.getClusterIndex(to) != cluster) {
+            path.push_back(to);  // 跨簇边只有一步
+            continue;
+        }
+        iterations += m_refineSearch.run(map, m_abstraction.getClusterRegion(cluster), from, &to);
+        m_refineSearch.appendPath(to, path);
+    }
+    return iterations;
+}
+
+int HPAStar::precompute(const Map& map) {
+    return m_abstraction.synchronize(map);
+}
+
+void HPAStar::setClusterSize(int clusterSize) {
+    m_abstraction.setClusterSize(clusterSize);
+}
+
+int HPAStar::getClusterSize() const {
+    return m_abstraction.getClusterSize();
+}
+
+const ClusterAbstraction& HPAStar::getAbstraction() const {
+    return m_abstraction;
+}
+
+ClusterAbstraction& HPAStar::getAbstraction() {
+    return m_abstraction;
+}
+
+double HPAStar::calculateHeuristic(const Point& from, const Point& to) const {
+    // 与 AStar 相同的加权欧几里得距离
+    double dx = static_cast<double>(to.x - from.x);
+    double dy = static_cast<double>(to.y - from.y);
+    return m_heuristicWeight * std::sqrt(dx * dx + dy * dy);
+}
+
+void HPAStar::setHeuristicWeight(double weight) {
+    m_heuristicWeight = std::max(1.0, weight);
+    Logger::info("Heuristic weight set to {}", m_heuristicWeight);
+}
+
+double HPAStar::getHeuristicWeight() const {
+    return m_heuristicWeight;
+}
+
+PathfindingStats HPAStar::getLastPathfindingStats() const {
+    return m_lastStats;
+}
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+
+#include "cluster_abstraction.h"
+#include "map.h"
+#include "pathfinding_algorithm.h"
+#include "search_workspace.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 分层 A*（HPA*）路径查找算法
+ *
+ * 先在 ClusterAbstraction 的抽象图（簇入口节点 + 簇内距离边 + 跨簇过渡边）上做 A*，
+ * 再把抽象路径逐段在簇内细化为逐格路径。起点和终点通过各自簇内的一次 Dijkstra 临时接入抽象图。
+ * 远距离查询只需扩展少量抽象节点，代价是路径不保证最优（通常比最优路径长几个百分点）。
+ *
+ * 抽象图按地图缓存：每次查询前与地图同步，地图修改后只重算受影响的簇。
+ */
+class HPAStar : public PathfindingAlgorithm {
+  public:
+    /**
+     * @brief 构造函数
+     * @param clusterSize 簇的边长（单元格）
+     */
+    explicit HPAStar(int clusterSize = 16);
+
+    /**
+     * @brief 析构函数
+     */
+    ~HPAStar();
+
+    /**
+     * @brief 查找从起点到终点的路径
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @return 路径点列表，如果没有找到路径则返回空列表
+     */
+    std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) override;
+
+    /**
+     * @brief 查找路径并写入调用方提供的缓冲区
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @param path 输出路径（复用其容量，未找到路径时清空）
+     * @return 是否找到路径
+     */
+    bool findPath(const Point& start, const Point& goal, const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief 使抽象图与地图同步（否则在下一次查询时同步）
+     * @param map 地图
+     * @return 重算的簇数
+     */
+    int precompute(const Map& map);
+
+    /**
+     * @brief 设置簇的边长（下次查询时重建抽象图）
+     */
+    void setClusterSize(int clusterSize);
+
+    /**
+     * @brief 获取簇的边长
+     */
+    int getClusterSize() const;
+
+    /**
+     * @brief 获取簇抽象
+     */
+    const ClusterAbstraction& getAbstraction() const;
+
+    /**
+     * @brief 获取可修改的簇抽象（用于导入预计算的抽象，如 MapFile::loadAbstraction）
+     */
+    ClusterAbstraction& getAbstraction();
+
+    /**
+     * @brief 设置启发式函数权重
+     * @param weight 权重值（>= 1.0）
+     */
+    void setHeuristicWeight(double weight) override;
+
+    /**
+     * @brief 获取启发式函数权重
+     * @return 权重值
+     */
+    double getHeuristicWeight() const override;
+
+    /**
+     * @brief 获取上次路径查找的统计信息
+     * @return 统计信息
+     */
+    PathfindingStats getLastPathfindingStats() const override;
+
+  private:
+    /**
+     * @brief 在抽象图上搜索，找到时把抽象路径写入 m_abstractPath
+     * @return 扩展的节点数（含接入起点和终点的簇内搜索）
+     */
+    int searchAbstract(const Point& start, const Point& goal, const Map& map);
+
+    /**
+     * @brief 把抽象路径细化为逐格路径
+     * @return 簇内搜索扩展的节点数
+     */
+    int refinePath(const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief 计算启发式距离（加权欧几里得距离）
+     */
+    double calculateHeuristic(const Point& from, const Point& to) const;
+
+  private:
+    double m_heuristicWeight = 1.0;     ///< 启发式函数权重
+    PathfindingStats m_lastStats;       ///< 上次查找的统计信息
+    ClusterAbstraction m_abstraction;   ///< 按地图缓存的簇抽象
+    SearchWorkspace m_workspace;        ///< 抽象图搜索工作区（按单元格下标索引）
+    RegionSearch m_startSearch;         ///< 起点所在簇的搜索
+    RegionSearch m_goalSearch;          ///< 终点所在簇的搜索
+    RegionSearch m_refineSearch;        ///< 细化路径用的簇内搜索
+    std::vector<Point> m_abstractPath;  ///< 上次找到的抽象路径
+};
+
+}  // namespace oneday::pathfinding
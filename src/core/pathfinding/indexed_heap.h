@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 支持 decrease-key 的索引二叉最小堆
+ *
+ * 元素是网格节点下标，按 (fCost, hCost) 字典序排列（F 值相同时优先 H 值较小的节点）。
+ * 每个节点在堆中的位置记录在位置数组中，判断节点是否在堆内时核对该位置上的节点，
+ * 因此位置数组在多次搜索之间无需清空，clear() 是 O(1) 的。
+ */
+class IndexedHeap {
+  public:
+    /**
+     * @brief 堆元素
+     */
+    struct Entry {
+        double fCost = 0.0;  ///< 总代价
+        double hCost = 0.0;  ///< 启发式代价（F 值相同时的次序）
+        uint32_t node = 0;   ///< 节点下标
+    };
+
+    /**
+     * @brief 确保位置数组能容纳 [0, nodeCount) 的节点下标
+     */
+    void reserve(size_t nodeCount) {
+        if (m_positions.size() < nodeCount) {
+            m_positions.resize(nodeCount);
+        }
+    }
+
+    /**
+     * @brief 清空堆（保留已分配的内存）
+     */
+    void clear() {
+        m_heap.clear();
+    }
+
+    bool empty() const {
+        return m_heap.empty();
+    }
+
+    size_t size() const {
+        return m_heap.size();
+    }
+
+    /**
+     * @brief 检查节点是否在堆中
+     */
+    bool contains(uint32_t node) const {
+        const uint32_t position = m_positions[node];
+        return position < m_heap.size() && m_heap[position].node == node;
+    }
+
+    /**
+     * @brief 获取代价最小的元素
+     */
+    const Entry& top() const {
+        return m_heap.front();
+    }
+
+    /**
+     * @brief 插入节点（调用方保证节点不在堆中）
+     */
+    void push(uint32_t node, double fCost, double hCost) {
+        m_heap.push_back(Entry{fCost, hCost, node});
+        siftUp(m_heap.size() - 1);
+    }
+
+    /**
+     * @brief 降低堆中节点的代价
+     */
+    void decreaseKey(uint32_t node, double fCost, double hCost) {
+        const uint32_t position = m_positions[node];
+        m_heap[position].fCost = fCost;
+        m_heap[position].hCost = hCost;
+        siftUp(position);
+    }
+
+    /**
+     * @brief 节点在堆中则降低代价，否则插入
+     */
+    void pushOrDecrease(uint32_t node, double fCost, double hCost) {
+        if (contains(node)) {
+            decreaseKey(node, fCost, hCost);
+        } else {
+            push(node, fCost, hCost);
+        }
+    }
+
+    /**
+     * @brief 修改堆中节点的代价（可升可降）
+     */
+    void update(uint32_t node, double fCost, double hCost) {
+        const uint32_t position = m_positions[node];
+        const Entry previous = m_heap[position];
+        m_heap[position].fCost = fCost;
+        m_heap[position].hCost = hCost;
+        if (less(m_heap[position], previous)) {
+            siftUp(position);
+        } else {
+            siftDown(position);
+        }
+    }
+
+    /**
+     * @brief 从堆中移除节点（调用方保证节点在堆中）
+     */
+    void remove(uint32_t node) {
+        const uint32_t position = m_positions[node];
+        const Entry last = m_heap.back();
+        m_heap.pop_back();
+        if (position < m_heap.size()) {
+            // 末尾元素填到空位后可能需要上浮或下沉
+            place(position, last);
+            siftUp(position);
+            siftDown(m_positions[last.node]);
+        }
+    }
+
+    /**
+     * @brief 弹出代价最小的元素
+     */
+    Entry pop() {
+        const Entry result = m_heap.front();
+        const Entry last = m_heap.back();
+        m_heap.pop_back();
+        if (!m_heap.empty()) {
+            m_heap.front() = last;
+            m_positions[last.node] = 0;
+            siftDown(0);
+        }
+        return result;
+    }
+
+  private:
+    std::vector<Entry> m_heap;          ///< 堆数组
+    std::vector<uint32_t> m_positions;  ///< 节点下标 -> 堆中位置（仅对堆内节点有效）
+
+    static bool less(const Entry& a, const Entry& b) {
+        return a.fCost < b.fCost || (a.fCost == b.fCost && a.hCost < b.hCost);
+    }
+
+    void place(size_t position, const Entry& entry) {
+        m_heap[position] = entry;
+        m_positions[entry.node] = static_cast<uint32_t>(position);
+    }
+
+    void siftUp(size_t position) {
+        const Entry entry = m_heap[position];
+        while (position > 0) {
+            const size_t parent = (position - 1) / 2;
+            if (!less(entry, m_heap[parent])) {
+                break;
+            }
+            place(position, m_heap[parent]);
+            position = parent;
+        }
+        place(position, entry);
+    }
+
+    void siftDown(size_t position) {
+        const Entry entry = m_heap[position];
+        const size_t count = m_heap.size();
+        for (;;) {
+            size_t child = position * 2 + 1;
+            if (child >= count) {
+                break;
+            }
+            if (child + 1 < count && less(m_heap[child + 1], m_heap[child])) {
+                ++child;
+            }
+            if (!less(m_heap[child], entry)) {
+                break;
+            }
+            place(position, m_heap[child]);
+            position = child;
+        }
+        place(position, entry);
+    }
+};
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,449 @@
+#include "jps.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "../common/logger.h"
+#include "grid_directions.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+namespace {
+
+using grid::kDiagonalCost;
+
+constexpr int kDirectionCount = 8;  ///< 方向数
+constexpr int kNoDirection = -1;    ///< 起点没有到达方向
+
+/**
+ * @brief 8 个方向的单位位移，按顺时针排列，偶数编号为直线方向
+ *
+ * 相邻编号相差 45 度，直线方向 d 两侧的对角线方向是 d ± 1，垂直方向是 d ± 2。
+ */
+constexpr int kDx[kDirectionCount] = {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr int kDy[kDirectionCount] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+/**
+ * @brief 位移对应的方向编号
+ */
+int directionOf(int dx, int dy) {
+    for (int d = 0; d < kDirectionCount; ++d) {
+        if (kDx[d] == dx && kDy[d] == dy) {
+            return d;
+        }
+    }
+    return kNoDirection;
+}
+
+}  // namespace
+
+JumpPointSearch::JumpPointSearch(JumpMode mode) : m_jumpMode(mode) {
+    Logger::info("Jump point search pathfinder initialized");
+}
+
+JumpPointSearch::~JumpPointSearch() {
+    Logger::info("Jump point search pathfinder destroyed");
+}
+
+std::vector<Point> JumpPointSearch::findPath(const Point& start,
+                                             const Point& goal,
+                                             const Map& map) {
+    std::vector<Point> path;
+    findPath(start, goal, map, path);
+    return path;
+}
+
+bool JumpPointSearch::findPath(const Point& start,
+                               const Point& goal,
+                               const Map& map,
+                               std::vector<Point>& path) {
+    ONEDAY_LOG_DEBUG("Starting JPS pathfinding from ({},{}) to ({},{})",
+                     start.x, start.y, goal.x, goal.y);
+    path.clear();
+    m_lastStats = PathfindingStats();
+
+    // 检查起点和终点是否有效
+    if (!map.isValidPosition(start) || !map.isValidPosition(goal)) {
+        Logger::error("Invalid start or goal position");
+        return false;
+    }
+
+    if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+        Logger::error("Start or goal position is not walkable");
+        return false;
+    }
+
+    // 如果起点就是终点
+    if (start == goal) {
+        path.push_back(start);
+        m_lastStats.pathFound = true;
+        m_lastStats.pathLength = 1;
+        return true;
+    }
+
+    // 距离表按地图缓存，构建时间不计入单次查询
+    if (m_jumpMode == JumpMode::Precomputed) {
+        ensureJumpTable(map);
+    }
+    bindMap(map);
+
+    auto startTime = std::chrono::steady_clock::now();
+    const int iterations = search(start, goal);
+    if (!m_jumpPoints.empty()) {
+        expandJumpPoints(path);
+    }
+    auto endTime = std::chrono::steady_clock::now();
+
+    m_lastStats.nodesExplored = iterations;
+    m_lastStats.pathFound = !path.empty();
+    m_lastStats.pathLength = static_cast<int>(path.size());
+    m_lastStats.executionTime =
+        std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    if (!m_lastStats.pathFound) {
+        Logger::warning("No path found after {} iterations", iterations);
+        return false;
+    }
+    ONEDAY_LOG_DEBUG("Path found after {} iterations ({} jump points)",
+                     iterations, m_jumpPoints.size());
+    return true;
+}
+
+int JumpPointSearch::search(const Point& start, const Point& goal) {
+    m_jumpPoints.clear();
+    m_workspace.prepare(m_width, m_height);
+    IndexedHeap& openSet = m_workspace.getOpenList();
+
+    const uint32_t startIndex = m_workspace.toIndex(start);
+    const uint32_t goalIndex = m_workspace.toIndex(goal);
+    const double startHCost = calculateHeuristic(start, goal);
+    m_workspace.visit(startIndex, 0.0, SearchWorkspace::kNoParent);
+    openSet.push(startIndex, startHCost, startHCost);
+
+    int directions[kDirectionCount];
+    int iterations = 0;
+    while (!openSet.empty()) {
+        const uint32_t current = openSet.pop().node;
+        m_workspace.close(current);
+        iterations++;
+
+        if (current == goalIndex) {
+            m_workspace.reconstructPath(goalIndex, m_jumpPoints);
+            return iterations;
+        }
+
+        const Point position = m_workspace.toPoint(current);
+        const double currentGCost = m_workspace.getGCost(current);
+
+        // 由父跳点到当前跳点的方向决定剪枝
+        int arrival = kNoDirection;
+        const int32_t parent = m_workspace.getParent(current);
+        if (parent != SearchWorkspace::kNoParent) {
+            const Point from = m_workspace.toPoint(static_cast<uint32_t>(parent));
+            arrival = directionOf(sign(position.x - from.x), sign(position.y - from.y));
+        }
+
+        const int directionCount = prunedDirections(position, arrival, directions);
+        for (int i = 0; i < directionCount; ++i) {
+            const int direction = directions[i];
+            Point jumpPoint;
+            if (!jump(position, direction, goal, jumpPoint)) {
+                continue;
+            }
+
+            const uint32_t successor = m_workspace.toIndex(jumpPoint);
+            if (m_workspace.isClosed(successor)) {
+                continue;
+            }
+
+            // 跳点与当前节点在同一直线或对角线上
+            const int steps = std::max(std::abs(jumpPoint.x - position.x),
+                                       std::abs(jumpPoint.y - position.y));
+            const double stepCost = direction % 2 == 1 ? kDiagonalCost : 1.0;
+            const double tentativeGCost = currentGCost + steps * stepCost;
+
+            const bool inOpenSet = m_workspace.isVisited(successor);
+            if (inOpenSet && tentativeGCost >= m_workspace.getGCost(successor)) {
+                continue;
+            }
+
+            const double hCost = calculateHeuristic(jumpPoint, goal);
+            m_workspace.visit(successor, tentativeGCost, static_cast<int32_t>(current));
+            if (inOpenSet) {
+                openSet.decreaseKey(successor, tentativeGCost + hCost, hCost);
+            } else {
+                openSet.push(successor, tentativeGCost + hCost, hCost);
+            }
+        }
+    }
+
+    return iterations;
+}
+
+int JumpPointSearch::prunedDirections(const Point& position, int arrival, int* directions) const {
+    if (arrival == kNoDirection) {
+        for (int d = 0; d < kDirectionCount; ++d) {
+            directions[d] = d;
+        }
+        return kDirectionCount;
+    }
+
+    auto rotate = [arrival](int offset) {
+        return (arrival + offset + kDirectionCount) % kDirectionCount;
+    };
+    directions[0] = arrival;
+    if (arrival % 2 == 1) {
+        // 对角线前进：同一对角线和它的两个分量方向
+        directions[1] = rotate(-1);
+        directions[2] = rotate(1);
+        return 3;
+    }
+
+    // 直线前进：某一侧的强制邻居存在时才转向该侧（侧方和前斜方），
+    // 否则侧方单元格经由来路侧面的对角线移动到达不会更差
+    int count = 1;
+    const int dx = kDx[arrival];
+    const int dy = kDy[arrival];
+    for (int side : {-2, 2}) {
+        const int sx = kDx[rotate(side)];
+        const int sy = kDy[rotate(side)];
+        if (isWalkable(position.x + sx, position.y + sy) &&
+            !isWalkable(position.x - dx + sx, position.y - dy + sy)) {
+            directions[count++] = rotate(side);
+            directions[count++] = rotate(side / 2);
+        }
+    }
+    return count;
+}
+
+bool JumpPointSearch::jump(const Point& from,
+                           int direction,
+                           const Point& goal,
+                           Point& jumpPoint) const {
+    if (m_jumpMode == JumpMode::Precomputed) {
+        return lookupJump(from, direction, goal, jumpPoint);
+    }
+    if (direction % 2 == 0) {
+        return scanStraight(from.x, from.y, kDx[direction], kDy[direction], goal, jumpPoint);
+    }
+    return scanDiagonal(from.x, from.y, kDx[direction], kDy[direction], goal, jumpPoint);
+}
+
+bool JumpPointSearch::scanStraight(int x, int y, int dx, int dy, const Point& goal,
+                                   Point& jumpPoint) const {
+    for (;;) {
+        x += dx;
+        y += dy;
+        if (!isWalkable(x, y)) {
+            return false;
+        }
+        if ((x == goal.x && y == goal.y) || hasForcedNeighbor(x, y, dx, dy)) {
+            jumpPoint = Point{x, y};
+            return true;
+        }
+    }
+}
+
+bool JumpPointSearch::scanDiagonal(int x, int y, int dx, int dy, const Point& goal,
+                                   Point& jumpPoint) const {
+    Point straightJumpPoint;
+    while (canMoveDiagonally(x, y, dx, dy)) {
+        x += dx;
+        y += dy;
+        // 终点，或者两个分量方向上能跳到跳点（含终点）的单元格
+        if ((x == goal.x && y == goal.y) ||
+            scanStraight(x, y, dx, 0, goal, straightJumpPoint) ||
+            scanStraight(x, y, 0, dy, goal, straightJumpPoint)) {
+            jumpPoint = Point{x, y};
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JumpPointSearch::lookupJump(const Point& from,
+                                 int direction,
+                                 const Point& goal,
+                                 Point& jumpPoint) const {
+    const size_t cell = static_cast<size_t>(from.y) * m_width + from.x;
+    const int32_t distance = m_jumpDistances[cell * kDirectionCount + direction];
+    const int reach = std::abs(distance);  // 正值是到跳点的步数，非正值是撞墙前能走的步数
+    const int dx = kDx[direction];
+    const int dy = kDy[direction];
+    const int goalDx = goal.x - from.x;
+    const int goalDy = goal.y - from.y;
+
+    if (direction % 2 == 0) {
+        // 终点在前方同一直线上，且不远于跳点或墙
+        const int goalSteps = dx != 0 ? goalDx * dx : goalDy * dy;
+        const bool onLine = dx != 0 ? goalDy == 0 : goalDx == 0;
+        if (onLine && goalSteps > 0 && goalSteps <= reach) {
+            jumpPoint = goal;
+            return true;
+        }
+    } else if (sign(goalDx) == dx && sign(goalDy) == dy) {
+        // 终点在该对角线象限内：沿对角线走到与终点同行或同列的单元格
+        const int steps = std::min(std::abs(goalDx), std::abs(goalDy));
+        if (steps <= reach) {
+            const Point target{from.x + steps * dx, from.y + steps * dy};
+            if (target == goal) {
+                jumpPoint = goal;
+                return true;
+            }
+
+            // 从该单元格沿直线能到达终点时，它就是跳点
+            const bool horizontal = std::abs(goalDx) > steps;
+            const int straight = horizontal ? directionOf(dx, 0) : directionOf(0, dy);
+            const int remaining = horizontal ? std::abs(goalDx) - steps : std::abs(goalDy) - steps;
+            const size_t targetCell = static_cast<size_t>(target.y) * m_width + target.x;
+            const int32_t straightDistance =
+                m_jumpDistances[targetCell * kDirectionCount + straight];
+            if (remaining <= std::abs(straightDistance)) {
+                jumpPoint = target;
+                return true;
+            }
+        }
+    }
+
+    if (distance <= 0) {
+        return false;
+    }
+    jumpPoint = Point{from.x + distance * dx, from.y + distance * dy};
+    return true;
+}
+
+void JumpPointSearch::ensureJumpTable(const Map& map) {
+    const size_t cellCount =
+        static_cast<size_t>(map.getWidth()) * static_cast<size_t>(map.getHeight());
+    if (m_tableRevision == map.getRevision() &&
+        m_jumpDistances.size() == cellCount * kDirectionCount) {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    bindMap(map);
+    m_jumpDistances.assign(cellCount * kDirectionCount, 0);
+    auto distanceAt = [this](int x, int y, int direction) -> int32_t& {
+        const size_t cell = static_cast<size_t>(y) * m_width + x;
+        return m_jumpDistances[cell * kDirectionCount + direction];
+    };
+
+    // 先算直线方向，对角线方向依赖直线方向的结果。
+    // 逆着前进方向遍历，计算 (x, y) 时前方单元格的距离已经就绪。
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int direction = pass; direction < kDirectionCount; direction += 2) {
+            const int dx = kDx[direction];
+            const int dy = kDy[direction];
+            const bool diagonal = direction % 2 == 1;
+            for (int row = 0; row < m_height; ++row) {
+                const int y = dy > 0 ? m_height - 1 - row : row;
+                for (int column = 0; column < m_width; ++column) {
+                    const int x = dx > 0 ? m_width - 1 - column : column;
+                    if (!isWalkable(x, y)) {
+                        continue;
+                    }
+
+                    const int nx = x + dx;
+                    const int ny = y + dy;
+                    const bool canMove =
+                        diagonal ? canMoveDiagonally(x, y, dx, dy) : isWalkable(nx, ny);
+                    if (!canMove) {
+                        continue;  // 距离为 0：一步也走不了
+                    }
+
+                    const bool nextIsJumpPoint =
+                        diagonal ? distanceAt(nx, ny, directionOf(dx, 0)) > 0 ||
+                                       distanceAt(nx, ny, directionOf(0, dy)) > 0
+                                 : hasForcedNeighbor(nx, ny, dx, dy);
+                    const int32_t next = distanceAt(nx, ny, direction);
+                    distanceAt(x, y, direction) = nextIsJumpPoint ? 1
+                                                  : next > 0      ? next + 1
+                                                                  : next - 1;
+                }
+            }
+        }
+    }
+
+    m_tableRevision = map.getRevision();
+    auto endTime = std::chrono::steady_clock::now();
+    Logger::info("JPS+ jump table built for {}x{} map in {} ms", m_width, m_height,
+                 std::chrono::duration<double, std::milli>(endTime - startTime).count());
+}
+
+bool JumpPointSearch::hasForcedNeighbor(int x, int y, int dx, int dy) const {
+    // 侧面可走而来路的侧面被挡：绕过障碍物的拐角出现在这里
+    if (dx != 0) {
+        return (isWalkable(x, y - 1) && !isWalkable(x - dx, y - 1)) ||
+               (isWalkable(x, y + 1) && !isWalkable(x - dx, y + 1));
+    }
+    return (isWalkable(x - 1, y) && !isWalkable(x - 1, y - dy)) ||
+           (isWalkable(x + 1, y) && !isWalkable(x + 1, y - dy));
+}
+
+bool JumpPointSearch::canMoveDiagonally(int x, int y, int dx, int dy) const {
+    return grid::canMove(x, y, dx, dy, [this](int cx, int cy) { return isWalkable(cx, cy); });
+}
+
+void JumpPointSearch::bindMap(const Map& map) {
+    m_map = &map;
+    m_width = map.getWidth();
+    m_height = map.getHeight();
+}
+
+void JumpPointSearch::expandJumpPoints(std::vector<Point>& path) const {
+    path.clear();
+    path.push_back(m_jumpPoints.front());
+    for (size_t i = 1; i < m_jumpPoints.size(); ++i) {
+        Point current = path.back();
+        const Point& next = m_jumpPoints[i];
+        const int dx = sign(next.x - current.x);
+        const int dy = sign(next.y - current.y);
+        while (current != next) {
+            current.x += dx;
+            current.y += dy;
+            path.push_back(current);
+        }
+    }
+}
+
+void JumpPointSearch::setJumpMode(JumpMode mode) {
+    m_jumpMode = mode;
+}
+
+JumpPointSearch::JumpMode JumpPointSearch::getJumpMode() const {
+    return m_jumpMode;
+}
+
+void JumpPointSearch::precompute(const Map& map) {
+    ensureJumpTable(map);
+}
+
+double JumpPointSearch::calculateHeuristic(const Point& from, const Point& to) const {
+    // 与 AStar 相同的加权欧几里得距离
+    double dx = static_cast<double>(to.x - from.x);
+    double dy = static_cast<double>(to.y - from.y);
+    return m_heuristicWeight * std::sqrt(dx * dx + dy * dy);
+}
+
+void JumpPointSearch::setHeuristicWeight(double weight) {
+    m_heuristicWeight = std::max(1.0, weight);
+    Logger::info("Heuristic weight set to {}", m_heuristicWeight);
+}
+
+double JumpPointSearch::getHeuristicWeight() const {
+    return m_heuristicWeight;
+}
+
+PathfindingStats JumpPointSearch::getLastPathfindingStats() const {
+    return m_lastStats;
+}
+
+}  // namespace oneday::pathfinding
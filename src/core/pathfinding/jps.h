@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "map.h"
+#include "pathfinding_algorithm.h"
+#include "search_workspace.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 跳点搜索（Jump Point Search）路径查找算法
+ *
+ * 与 AStar 使用相同的移动规则（8 方向，水平或垂直方向被阻挡时不能对角线移动）和代价，
+ * 因此返回的路径代价与 A* 相同；但只把"跳点"放入开放列表，直线和对角线上的中间单元格
+ * 在跳跃过程中直接跳过，扩展的节点数通常比 A* 少一到两个数量级。
+ * 返回的路径会展开为逐格相邻的单元格序列，与 AStar 的输出格式一致。
+ *
+ * JumpMode::Precomputed 即 JPS+：预先计算每个单元格在 8 个方向上到下一个跳点（或墙）
+ * 的距离，搜索时用查表代替逐格扫描。距离表按地图缓存，地图修订号变化后自动重建。
+ */
+class JumpPointSearch : public PathfindingAlgorithm {
+  public:
+    /**
+     * @brief 跳跃方式
+     */
+    enum class JumpMode {
+        Scan,        ///< 搜索时逐格扫描（JPS，默认）
+        Precomputed  ///< 查预计算的跳跃距离表（JPS+）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param mode 跳跃方式
+     */
+    explicit JumpPointSearch(JumpMode mode = JumpMode::Scan);
+
+    /**
+     * @brief 析构函数
+     */
+    ~JumpPointSearch();
+
+    /**
+     * @brief 查找从起点到终点的路径
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @return 路径点列表，如果没有找到路径则返回空列表
+     */
+    std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) override;
+
+    /**
+     * @brief 查找路径并写入调用方提供的缓冲区
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @param path 输出路径（复用其容量，未找到路径时清空）
+     * @return 是否找到路径
+     */
+    bool findPath(const Point& start, const Point& goal, const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief 设置跳跃方式
+     */
+    void setJumpMode(JumpMode mode);
+
+    /**
+     * @brief 获取跳跃方式
+     */
+    JumpMode getJumpMode() const;
+
+    /**
+     * @brief 为地图预先构建 JPS+ 跳跃距离表（否则在第一次查询时构建）
+     * @param map 地图
+     */
+    void precompute(const Map& map);
+
+    /**
+     * @brief 设置启发式函数权重
+     * @param weight 权重值（>= 1.0）
+     */
+    void setHeuristicWeight(double weight) override;
+
+    /**
+     * @brief 获取启发式函数权重
+     * @return 权重值
+     */
+    double getHeuristicWeight() const override;
+
+    /**
+     * @brief 获取上次路径查找的统计信息
+     * @return 统计信息
+     */
+    PathfindingStats getLastPathfindingStats() const override;
+
+  private:
+    /**
+     * @brief 在开放列表上搜索跳点，找到时把跳点序列写入 m_jumpPoints
+     * @return 扩展的节点数
+     */
+    int search(const Point& start, const Point& goal);
+
+    /**
+     * @brief 根据到达方向剪枝后需要尝试跳跃的方向
+     * @param position 当前跳点
+     * @param arrival 从父跳点到达当前跳点的方向（起点为 -1）
+     * @param directions 输出方向编号（至少容纳 8 个）
+     * @return 方向数
+     */
+    int prunedDirections(const Point& position, int arrival, int* directions) const;
+
+    /**
+     * @brief 从单元格沿指定方向跳跃
+     * @param from 出发单元格
+     * @param direction 方向编号（0-7，偶数为直线方向）
+     * @param goal 终点
+     * @param jumpPoint 输出找到的跳点
+     * @return 是否找到跳点
+     */
+    bool jump(const Point& from, int direction, const Point& goal, Point& jumpPoint) const;
+
+    /**
+     * @brief 逐格扫描直线方向
+     */
+    bool scanStraight(int x, int y, int dx, int dy, const Point& goal, Point& jumpPoint) const;
+
+    /**
+     * @brief 逐格扫描对角线方向
+     */
+    bool scanDiagonal(int x, int y, int dx, int dy, const Point& goal, Point& jumpPoint) const;
+
+    /**
+     * @brief 查跳跃距离表
+     */
+    bool lookupJump(const Point& from, int direction, const Point& goal, Point& jumpPoint) const;
+
+    /**
+     * @brief 当前地图的距离表不存在或已过期时重建
+     */
+    void ensureJumpTable(const Map& map);
+
+    /**
+     * @brief 单元格沿直线方向前进时是否有强制邻居（即是否为跳点）
+     */
+    bool hasForcedNeighbor(int x, int y, int dx, int dy) const;
+
+    /**
+     * @brief 沿对角线方向从 (x, y) 走一步是否合法
+     */
+    bool canMoveDiagonally(int x, int y, int dx, int dy) const;
+
+    /**
+     * @brief 检查单元格是否可行走（x、y 可以越出地图一格，越界时返回 false）
+     */
+    bool isWalkable(int x, int y) const {
+        return m_map->isWalkableUnchecked(x, y);
+    }
+
+    /**
+     * @brief 绑定本次查询的地图
+     */
+    void bindMap(const Map& map);
+
+    /**
+     * @brief 把跳点序列展开为逐格相邻的路径
+     * @param path 输出路径
+     */
+    void expandJumpPoints(std::vector<Point>& path) const;
+
+    /**
+     * @brief 计算启发式距离（加权欧几里得距离）
+     */
+    double calculateHeuristic(const Point& from, const Point& to) const;
+
+  private:
+    double m_heuristicWeight = 1.0;             ///< 启发式函数权重
+    PathfindingStats m_lastStats;               ///< 上次查找的统计信息
+    JumpMode m_jumpMode;                        ///< 跳跃方式
+    SearchWorkspace m_workspace;                ///< 跨查询复用的搜索工作区
+    std::vector<Point> m_jumpPoints;            ///< 上次找到的跳点序列
+
+    const Map* m_map = nullptr;  ///< 当前查询的地图
+    int m_width = 0;             ///< 当前查询的地图宽度
+    int m_height = 0;            ///< 当前查询的地图高度
+
+    std::vector<int32_t> m_jumpDistances;  ///< JPS+ 距离表（每个单元格 8 个方向连续存放）
+    uint64_t m_tableRevision = 0;          ///< 距离表对应的地图修订号（0 表示尚未构建）
+};
+
+}  // namespace oneday::pathfinding
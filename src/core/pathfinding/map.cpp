@@ -1,17 +1,245 @@
 #include "map.h"
 
 #include "../common/logger.h"
+#include "map_file.h"
 
 using oneday::core::Logger;
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ONEDAY_MAP_SSE2 1
+#endif
+
 namespace oneday::pathfinding {
 
+namespace {
+
+/**
+ * @brief 分配一个全局唯一的地图修订号
+ */
+uint64_t nextRevision() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * @brief 变化记录的最大条数，超出时丢弃较早的一半
+ */
+constexpr size_t kMaxChangeLog = 1024;
+
+/**
+ * @brief 把点并入区域
+ */
+void extendRegion(MapRegion& region, const Point& point) {
+    region.topLeft.x = std::min(region.topLeft.x, point.x);
+    region.topLeft.y = std::min(region.topLeft.y, point.y);
+    region.bottomRight.x = std::max(region.bottomRight.x, point.x);
+    region.bottomRight.y = std::max(region.bottomRight.y, point.y);
+}
+
+/**
+ * @brief 一次比较的单元格数
+ */
+constexpr int kBlockSize = 16;
+
+/**
+ * @brief 比较连续 16 个单元格与给定类型
+ * @return 匹配位掩码（第 i 位对应 cells[i]）
+ */
+inline uint32_t matchBlock(const CellType* cells, CellType type) {
+#ifdef ONEDAY_MAP_SSE2
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells));
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(type));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < kBlockSize; ++i) {
+        mask |= static_cast<uint32_t>(cells[i] == type) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief 按块扫描 [0, count) 的单元格，对每个含匹配项的块调用 visit(offset, mask)
+ * @return visit 返回 false 时提前结束并返回 false
+ */
+template <typename Visitor>
+bool scanCells(const CellType* cells, int count, CellType type, Visitor&& visit) {
+    int offset = 0;
+    for (; offset + kBlockSize <= count; offset += kBlockSize) {
+        const uint32_t mask = matchBlock(cells + offset, type);
+        if (mask != 0 && !visit(offset, mask)) {
+            return false;
+        }
+    }
+    uint32_t tail = 0;
+    for (int i = 0; offset + i < count; ++i) {
+        tail |= static_cast<uint32_t>(cells[offset + i] == type) << i;
+    }
+    return tail == 0 || visit(offset, tail);
+}
+
+/**
+ * @brief 在 [begin, end) 中查找第一个类型等于（或不等于）type 的单元格
+ * @return 下标，找不到时返回 end
+ */
+int findInRow(const CellType* row, int begin, int end, CellType type, bool equal) {
+    int x = begin;
+    for (; x + kBlockSize <= end; x += kBlockSize) {
+        uint32_t mask = matchBlock(row + x, type);
+        if (!equal) {
+            mask = ~mask & 0xFFFFu;
+        }
+        if (mask != 0) {
+            return x + std::countr_zero(mask);
+        }
+    }
+    for (; x < end; ++x) {
+        if ((row[x] == type) == equal) {
+            return x;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief 从 x 向左查找类型等于 type 的连续单元格的起点（调用方保证 row[x] == type）
+ */
+int findRunStart(const CellType* row, int x, CellType type) {
+    while (x >= kBlockSize) {
+        // 检查 x 左侧紧邻的 16 个单元格，块内最高的不匹配位之后就是连续段的起点
+        const uint32_t mismatch = ~matchBlock(row + x - kBlockSize, type) & 0xFFFFu;
+        if (mismatch != 0) {
+            return x - kBlockSize + (31 - std::countl_zero(mismatch)) + 1;
+        }
+        x -= kBlockSize;
+    }
+    while (x > 0 && row[x - 1] == type) {
+        --x;
+    }
+    return x;
+}
+
+/**
+ * @brief 检查位序列中 [first, last] 的位是否全为 1
+ */
+bool isBitRunSet(const uint64_t* line, size_t first, size_t last) {
+    if ((first >> 6) == (last >> 6)) {
+        const uint64_t mask = (~0ull >> (63 - (last & 63))) & (~0ull << (first & 63));
+        return (line[first >> 6] & mask) == mask;
+    }
+    for (size_t word = first >> 6; word <= last >> 6; ++word) {
+        const size_t begin = word == first >> 6 ? (first & 63) : 0;
+        const size_t end = word == last >> 6 ? (last & 63) : 63;
+        const uint64_t mask = (~0ull >> (63 - end)) & (~0ull << begin);
+        if ((line[word] & mask) != mask) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 沿主方向逐段检查 Bresenham 直线
+ * @param lines 位平面（每条线是主方向上的一行或一列，含一格填充）
+ * @param lineWords 每条线的 64 位字数
+ * @param major 起点的主方向坐标
+ * @param minor 起点的次方向坐标
+ * @param majorEnd 终点的主方向坐标
+ * @param majorStep 主方向步进（±1）
+ * @param minorStep 次方向步进（±1）
+ * @param majorDelta 主方向距离
+ * @param minorDelta 次方向距离（不大于 majorDelta）
+ *
+ * 与逐格的 Bresenham（误差项初值 dx - dy）经过完全相同的单元格：主方向每步都前进，
+ * 次方向在误差项的两倍小于 majorDelta 时前进。同一条线上连续前进的步数可以由误差项
+ * 直接算出，因此每条线只做一次整字检查。
+ */
+bool traceLineRuns(const uint64_t* lines, size_t lineWords, int major, int minor, int majorEnd,
+                   int majorStep, int minorStep, int64_t majorDelta, int64_t minorDelta) {
+    int64_t error = majorDelta - minorDelta;
+    while (true) {
+        // 本条线上在次方向前进之前还要沿主方向前进的步数：每步 excess 减少 2 * minorDelta，
+        // 减到负数时次方向前进。斜率接近 1 时段很短，逐步减比做除法便宜
+        const int64_t remaining = std::abs(majorEnd - major);
+        int64_t steps = remaining;
+        if (minorDelta != 0) {
+            int64_t excess = 2 * error - majorDelta;
+            if (excess >= 8 * minorDelta) {
+                steps = excess / (2 * minorDelta) + 1;
+            } else {
+                for (steps = 0; excess >= 0; ++steps) {
+                    excess -= 2 * minorDelta;
+                }
+            }
+        }
+        const bool last = steps >= remaining;
+        const int runEnd = last ? majorEnd : major + majorStep * static_cast<int>(steps);
+        const uint64_t* line = lines + static_cast<size_t>(minor + 1) * lineWords;
+        if (!isBitRunSet(line, static_cast<size_t>(std::min(major, runEnd) + 1),
+                         static_cast<size_t>(std::max(major, runEnd) + 1))) {
+            return false;
+        }
+        if (last) {
+            return true;
+        }
+        major = runEnd + majorStep;
+        minor += minorStep;
+        error += majorDelta - (steps + 1) * minorDelta;
+    }
+}
+
+/**
+ * @brief 逐格检查 Bresenham 直线（两端都在地图内）
+ */
+bool traceLineCells(const Map& map, const Point& from, const Point& to) {
+    const int dx = std::abs(to.x - from.x);
+    const int dy = std::abs(to.y - from.y);
+    const int xStep = (to.x > from.x) ? 1 : -1;
+    const int yStep = (to.y > from.y) ? 1 : -1;
+    int x = from.x;
+    int y = from.y;
+    int error = dx - dy;
+
+    while (true) {
+        if (!map.isWalkableUnchecked(x, y)) {
+            return false;
+        }
+
+        if (x == to.x && y == to.y) {
+            return true;
+        }
+
+        const int error2 = 2 * error;
+
+        if (error2 > -dy) {
+            error -= dy;
+            x += xStep;
+        }
+
+        if (error2 < dx) {
+            error += dx;
+            y += yStep;
+        }
+    }
+}
+
+}  // namespace
+
 Map::Map(int width, int height)
-    : m_width(width), m_height(height), m_data(width * height, CellType::Walkable) {
-    Logger::info("Map created with size " + std::to_string(width) + "x" + std::to_string(height));
+    : m_width(width), m_height(height), m_data(width * height, CellType::Walkable),
+      m_revision(nextRevision()), m_changeLogBase(m_revision) {
+    rebuildWalkability();
+    Logger::info("Map created with size {}x{}", width, height);
 }
 
 Map::~Map() {
@@ -27,7 +255,91 @@ bool Map::isWalkable(const Point& point) const {
         return false;
     }
 
-    return getCellType(point) == CellType::Walkable;
+    return isWalkableUnchecked(point.x, point.y);
+}
+
+bool Map::hasLineOfSight(const Point& from, const Point& to) const {
+    if (!isValidPosition(from) || !isValidPosition(to)) {
+        return false;
+    }
+
+    // 使用Bresenham直线算法；两端都在地图内时经过的单元格也都在地图内，直接查位平面。
+    // 平均每段不足四格时（斜率接近对角线）整字检查省不下什么，逐格更快；
+    // 否则 x 为主方向时按行检查，y 为主方向时在按列的位平面上检查
+    const int dx = std::abs(to.x - from.x);
+    const int dy = std::abs(to.y - from.y);
+    if (std::max(dx, dy) < 4 * std::min(dx, dy)) {
+        return traceLineCells(*this, from, to);
+    }
+    const int xStep = (to.x > from.x) ? 1 : -1;
+    const int yStep = (to.y > from.y) ? 1 : -1;
+    if (dx >= dy) {
+        return traceLineRuns(m_walkableBits.data(), m_bitRowWords, from.x, from.y, to.x, xStep,
+                             yStep, dx, dy);
+    }
+    return traceLineRuns(m_walkableColumnBits.data(), m_bitColumnWords, from.y, from.x, to.y,
+                         yStep, xStep, dy, dx);
+}
+
+void Map::rebuildWalkability() {
+    m_bitRowWords = (static_cast<size_t>(m_width) + 2 + 63) / 64;
+    m_walkableBits.assign(m_bitRowWords * (static_cast<size_t>(m_height) + 2), 0);
+
+    for (int y = 0; y < m_height; ++y) {
+        uint64_t* row = &m_walkableBits[static_cast<size_t>(y + 1) * m_bitRowWords];
+        scanCells(&m_data[static_cast<size_t>(y) * m_width], m_width, CellType::Walkable,
+                  [row](int offset, uint32_t mask) {
+                      // 16 位掩码放到位 offset + 1 处，可能跨两个字
+                      const size_t bit = static_cast<size_t>(offset) + 1;
+                      row[bit >> 6] |= static_cast<uint64_t>(mask) << (bit & 63);
+                      if ((bit & 63) + kBlockSize > 64) {
+                          row[(bit >> 6) + 1] |= static_cast<uint64_t>(mask) >> (64 - (bit & 63));
+                      }
+                      return true;
+                  });
+    }
+
+    rebuildColumnBits();
+}
+
+void Map::rebuildColumnBits() {
+    // 按列的位平面由按行的位平面转置得到
+    m_bitColumnWords = (static_cast<size_t>(m_height) + 2 + 63) / 64;
+    m_walkableColumnBits.assign(m_bitColumnWords * (static_cast<size_t>(m_width) + 2), 0);
+    for (size_t y = 1; y <= static_cast<size_t>(m_height); ++y) {
+        const uint64_t* row = &m_walkableBits[y * m_bitRowWords];
+        const uint64_t bit = 1ull << (y & 63);
+        for (size_t word = 0; word < m_bitRowWords; ++word) {
+            for (uint64_t bits = row[word]; bits != 0; bits &= bits - 1) {
+                const size_t x = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+                m_walkableColumnBits[x * m_bitColumnWords + (y >> 6)] |= bit;
+            }
+        }
+    }
+}
+
+void Map::setWalkableSpan(int y, int begin, int end, bool walkable) {
+    uint64_t* row = &m_walkableBits[static_cast<size_t>(y + 1) * m_bitRowWords];
+    size_t bit = static_cast<size_t>(begin) + 1;
+    const size_t last = static_cast<size_t>(end) + 1;
+    while (bit < last) {
+        const size_t offset = bit & 63;
+        const size_t count = std::min<size_t>(64 - offset, last - bit);
+        const uint64_t mask = (count == 64 ? ~0ull : ((1ull << count) - 1)) << offset;
+        if (walkable) {
+            row[bit >> 6] |= mask;
+        } else {
+            row[bit >> 6] &= ~mask;
+        }
+        bit += count;
+    }
+
+    const size_t columnBit = static_cast<size_t>(y) + 1;
+    const uint64_t columnMask = 1ull << (columnBit & 63);
+    for (size_t x = static_cast<size_t>(begin) + 1; x < last; ++x) {
+        uint64_t& word = m_walkableColumnBits[x * m_bitColumnWords + (columnBit >> 6)];
+        word = walkable ? (word | columnMask) : (word & ~columnMask);
+    }
 }
 
 CellType Map::getCellType(const Point& point) const {
@@ -39,13 +351,65 @@ CellType Map::getCellType(const Point& point) const {
 }
 
 void Map::setCellType(const Point& point, CellType type) {
+    if (assignCell(point, type)) {
+        touch({point, point});
+    }
+}
+
+bool Map::assignCell(const Point& point, CellType type) {
     if (!isValidPosition(point)) {
-        Logger::warning("Attempted to set cell type at invalid position (" +
-                        std::to_string(point.x) + "," + std::to_string(point.y) + ")");
-        return;
+        Logger::warning("Attempted to set cell type at invalid position ({},{})", point.x, point.y);
+        return false;
     }
 
-    m_data[point.y * m_width + point.x] = type;
+    CellType& cell = m_data[point.y * m_width + point.x];
+    if (cell == type) {
+        return false;
+    }
+    cell = type;
+    setWalkableSpan(point.y, point.x, point.x + 1, type == CellType::Walkable);
+    return true;
+}
+
+void Map::touch(const MapRegion& region) {
+    m_revision = nextRevision();
+    if (m_changeLog.size() >= kMaxChangeLog) {
+        const size_t dropped = m_changeLog.size() / 2;
+        m_changeLogBase = m_changeLog[dropped - 1].revision;
+        m_changeLog.erase(m_changeLog.begin(), m_changeLog.begin() + dropped);
+    }
+    m_changeLog.push_back(ChangeRecord{m_revision, region});
+}
+
+void Map::resetHistory() {
+    m_revision = nextRevision();
+    m_changeLog.clear();
+    m_changeLogBase = m_revision;
+}
+
+bool Map::getChangedRegions(uint64_t sinceRevision, std::vector<MapRegion>& regions) const {
+    regions.clear();
+    if (sinceRevision == m_revision) {
+        return true;
+    }
+
+    // 记录按修订号递增，找到调用方同步时的那一条，之后的都是新的变化
+    size_t first = 0;
+    if (sinceRevision != m_changeLogBase) {
+        auto it = std::lower_bound(m_changeLog.begin(), m_changeLog.end(), sinceRevision,
+                                   [](const ChangeRecord& record, uint64_t revision) {
+                                       return record.revision < revision;
+                                   });
+        if (it == m_changeLog.end() || it->revision != sinceRevision) {
+            return false;
+        }
+        first = static_cast<size_t>(it - m_changeLog.begin()) + 1;
+    }
+
+    for (size_t i = first; i < m_changeLog.size(); ++i) {
+        regions.push_back(m_changeLog[i].region);
+    }
+    return true;
 }
 
 int Map::getWidth() const {
@@ -58,19 +422,20 @@ int Map::getHeight() const {
 
 void Map::clear(CellType fillType) {
     std::fill(m_data.begin(), m_data.end(), fillType);
-    Logger::info("Map cleared with fill type " + std::to_string(static_cast<int>(fillType)));
+    rebuildWalkability();
+    touch({{0, 0}, {m_width - 1, m_height - 1}});
+    Logger::info("Map cleared with fill type {}", static_cast<int>(fillType));
 }
 
 void Map::resize(int newWidth, int newHeight, CellType fillType) {
     if (newWidth <= 0 || newHeight <= 0) {
-        Logger::error("Invalid map dimensions: " + std::to_string(newWidth) + "x" +
-                      std::to_string(newHeight));
+        Logger::error("Invalid map dimensions: {}x{}", newWidth, newHeight);
         return;
     }
 
     std::vector<CellType> newData(newWidth * newHeight, fillType);
 
-    // ??????
+    // 复制原有数据
     int copyWidth = std::min(m_width, newWidth);
     int copyHeight = std::min(m_height, newHeight);
 
@@ -83,8 +448,10 @@ void Map::resize(int newWidth, int newHeight, CellType fillType) {
     m_width = newWidth;
     m_height = newHeight;
     m_data = std::move(newData);
+    rebuildWalkability();
+    resetHistory();
 
-    Logger::info("Map resized to " + std::to_string(newWidth) + "x" + std::to_string(newHeight));
+    Logger::info("Map resized to {}x{}", newWidth, newHeight);
 }
 
 void Map::setRectangle(const Point& topLeft, const Point& bottomRight, CellType type) {
@@ -94,19 +461,26 @@ void Map::setRectangle(const Point& topLeft, const Point& bottomRight, CellType
     Point normalizedBottomRight = {std::max(topLeft.x, bottomRight.x),
                                    std::max(topLeft.y, bottomRight.y)};
 
+    // 整个矩形只记录一次变化（实际改变的单元格的包围盒）
+    MapRegion changed{{m_width, m_height}, {-1, -1}};
     for (int y = normalizedTopLeft.y; y <= normalizedBottomRight.y; ++y) {
         for (int x = normalizedTopLeft.x; x <= normalizedBottomRight.x; ++x) {
-            setCellType({x, y}, type);
+            if (assignCell({x, y}, type)) {
+                extendRegion(changed, {x, y});
+            }
         }
     }
+    if (changed.bottomRight.x >= 0) {
+        touch(changed);
+    }
 
-    Logger::debug("Rectangle set from (" + std::to_string(normalizedTopLeft.x) + "," +
-                  std::to_string(normalizedTopLeft.y) + ") to (" +
-                  std::to_string(normalizedBottomRight.x) + "," +
-                  std::to_string(normalizedBottomRight.y) + ")");
+    ONEDAY_LOG_DEBUG("Rectangle set from ({},{}) to ({},{})",
+                     normalizedTopLeft.x, normalizedTopLeft.y, normalizedBottomRight.x,
+                     normalizedBottomRight.y);
 }
 
 void Map::setCircle(const Point& center, int radius, CellType type) {
+    MapRegion changed{{m_width, m_height}, {-1, -1}};
     for (int y = center.y - radius; y <= center.y + radius; ++y) {
         for (int x = center.x - radius; x <= center.x + radius; ++x) {
             Point point = {x, y};
@@ -116,19 +490,21 @@ void Map::setCircle(const Point& center, int radius, CellType type) {
                 int dy = y - center.y;
                 double distance = std::sqrt(dx * dx + dy * dy);
 
-                if (distance <= radius) {
-                    setCellType(point, type);
+                if (distance <= radius && assignCell(point, type)) {
+                    extendRegion(changed, point);
                 }
             }
         }
     }
+    if (changed.bottomRight.x >= 0) {
+        touch(changed);
+    }
 
-    Logger::debug("Circle set at (" + std::to_string(center.x) + "," + std::to_string(center.y) +
-                  ") with radius " + std::to_string(radius));
+    ONEDAY_LOG_DEBUG("Circle set at ({},{}) with radius {}", center.x, center.y, radius);
 }
 
 void Map::setLine(const Point& start, const Point& end, CellType type) {
-    // ??Bresenham????
+    // 使用Bresenham直线算法
     int dx = std::abs(end.x - start.x);
     int dy = std::abs(end.y - start.y);
     int x = start.x;
@@ -159,17 +535,16 @@ void Map::setLine(const Point& start, const Point& end, CellType type) {
         }
     }
 
-    Logger::debug("Line set from (" + std::to_string(start.x) + "," + std::to_string(start.y) +
-                  ") to (" + std::to_string(end.x) + "," + std::to_string(end.y) + ")");
+    ONEDAY_LOG_DEBUG("Line set from ({},{}) to ({},{})", start.x, start.y, end.x, end.y);
 }
 
 std::vector<Point> Map::getNeighbors(const Point& point, bool includeDiagonal) const {
     std::vector<Point> neighbors;
 
-    // 4????
+    // 4方向邻居
     const std::vector<Point> directions4 = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
 
-    // 8???????????
+    // 8方向邻居（包括对角线）
     const std::vector<Point> directions8 = {
         {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
 
@@ -187,221 +562,279 @@ std::vector<Point> Map::getNeighbors(const Point& point, bool includeDiagonal) c
 }
 
 std::vector<Point> Map::getWalkableNeighbors(const Point& point, bool includeDiagonal) const {
-    std::vector<Point> neighbors = getNeighbors(point, includeDiagonal);
-
-    // ??????????    neighbors.erase(
-        std::remove_if(neighbors.begin(), neighbors.end(),
-                      [this](const Point& p) {
-        return !isWalkable(p); }),
-        neighbors.end()
-    );
+    std::vector<Point> neighbors;
+    if (!isValidPosition(point)) {
+        neighbors = getNeighbors(point, includeDiagonal);
 
+        // 移除不可行走的邻居
+        neighbors.erase(std::remove_if(neighbors.begin(),
+                                       neighbors.end(),
+                                       [this](const Point& p) { return !isWalkable(p); }),
+                        neighbors.end());
         return neighbors;
-}
-
-bool Map::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        Logger::error("Failed to open map file: " + filename);
-        return false;
     }
 
-    std::string line;
-    std::vector<std::vector<CellType>> tempData;
-
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') {
-            continue;  // ????????        }
-
-            std::vector<CellType> row;
-            for (char c : line) {
-                switch (c) {
-                    case '.':
-                    case ' ':
-                        row.push_back(CellType::Walkable);
-                        break;
-                    case '#':
-                    case 'X':
-                        row.push_back(CellType::Obstacle);
-                        break;
-                    case 'S':
-                        row.push_back(CellType::Start);
-                        break;
-                    case 'G':
-                        row.push_back(CellType::Goal);
-                        break;
-                    default:
-                        row.push_back(CellType::Walkable);
-                        break;
-                }
-            }
+    // 地图内的点的邻居都落在位平面的填充范围内，不需要逐个检查边界
+    static constexpr Point kDirections4[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    static constexpr Point kDirections8[] = {
+        {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    const Point* directions = includeDiagonal ? kDirections8 : kDirections4;
+    const int count = includeDiagonal ? 8 : 4;
 
-            if (!row.empty()) {
-                tempData.push_back(row);
-            }
+    neighbors.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const Point neighbor{point.x + directions[i].x, point.y + directions[i].y};
+        if (isWalkableUnchecked(neighbor.x, neighbor.y)) {
+            neighbors.push_back(neighbor);
         }
+    }
 
-        file.close();
+    return neighbors;
+}
 
-        if (tempData.empty()) {
-            Logger::error("No valid data found in map file: " + filename);
+bool Map::loadFromFile(const std::string& filename) {
+    if (MapFile::isBinaryFile(filename)) {
+        MapFile file;
+        if (!file.open(filename) || !file.loadInto(*this)) {
             return false;
         }
+        Logger::info("Map loaded from binary file: {} ({}x{})", filename, m_width, m_height);
+        return true;
+    }
 
-        // ????????    m_height = static_cast<int>(tempData.size());
-        m_width = static_cast<int>(tempData[0].size());
-        m_data.resize(m_width * m_height);
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        Logger::error("Failed to open map file: {}", filename);
+        return false;
+    }
 
-        for (int y = 0; y < m_height; ++y) {
-            for (int x = 0; x < m_width && x < static_cast<int>(tempData[y].size()); ++x) {
-                m_data[y * m_width + x] = tempData[y][x];
+    // 整个文件一次读入，逐行查表解码，直接写入类型平面
+    const std::string content((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    file.close();
+
+    std::array<CellType, 256> decode;
+    decode.fill(CellType::Walkable);
+    decode[static_cast<unsigned char>('#')] = CellType::Obstacle;
+    decode[static_cast<unsigned char>('X')] = CellType::Obstacle;
+    decode[static_cast<unsigned char>('S')] = CellType::Start;
+    decode[static_cast<unsigned char>('G')] = CellType::Goal;
+
+    std::vector<CellType> data;
+    int width = 0;
+    int height = 0;
+    size_t lineStart = 0;
+    while (lineStart < content.size()) {
+        size_t lineEnd = content.find('\n', lineStart);
+        if (lineEnd == std::string::npos) {
+            lineEnd = content.size();
+        }
+        size_t length = lineEnd - lineStart;
+        if (length > 0 && content[lineStart + length - 1] == '\r') {
+            --length;
+        }
+        // 跳过空行和注释
+        if (length > 0 && content[lineStart] != '#') {
+            if (height == 0) {
+                width = static_cast<int>(length);
+            }
+            // 比第一行短的行用可行走补齐，长的截断
+            data.resize(data.size() + width, CellType::Walkable);
+            CellType* row = &data[static_cast<size_t>(height) * width];
+            const size_t copy = std::min<size_t>(length, width);
+            for (size_t x = 0; x < copy; ++x) {
+                row[x] = decode[static_cast<unsigned char>(content[lineStart + x])];
             }
+            ++height;
         }
+        lineStart = lineEnd + 1;
+    }
 
-        Logger::info("Map loaded from file: " + filename + " (" + std::to_string(m_width) + "x" +
-                     std::to_string(m_height) + ")");
-        return true;
+    if (height == 0) {
+        Logger::error("No valid data found in map file: {}", filename);
+        return false;
     }
 
-    bool Map::saveToFile(const std::string& filename) const {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            Logger::error("Failed to create map file: " + filename);
-            return false;
-        }
+    // 设置地图数据
+    m_width = width;
+    m_height = height;
+    m_data = std::move(data);
+    rebuildWalkability();
+    resetHistory();
 
-        for (int y = 0; y < m_height; ++y) {
-            for (int x = 0; x < m_width; ++x) {
-                CellType type = getCellType({x, y});
-
-                switch (type) {
-                    case CellType::Walkable:
-                        file << '.';
-                        break;
-                    case CellType::Obstacle:
-                        file << '#';
-                        break;
-                    case CellType::Start:
-                        file << 'S';
-                        break;
-                    case CellType::Goal:
-                        file << 'G';
-                        break;
-                    default:
-                        file << '.';
-                        break;
-                }
-            }
-            file << '\n';
-        }
-
-        file.close();
+    Logger::info("Map loaded from file: {} ({}x{})", filename, m_width, m_height);
+    return true;
+}
 
-        Logger::info("Map saved to file: " + filename);
-        return true;
+bool Map::saveToFile(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        Logger::error("Failed to create map file: {}", filename);
+        return false;
     }
 
-    std::string Map::toString() const {
-        std::ostringstream oss;
-
-        for (int y = 0; y < m_height; ++y) {
-            for (int x = 0; x < m_width; ++x) {
-                CellType type = getCellType({x, y});
-
-                switch (type) {
-                    case CellType::Walkable:
-                        oss << '.';
-                        break;
-                    case CellType::Obstacle:
-                        oss << '#';
-                        break;
-                    case CellType::Start:
-                        oss << 'S';
-                        break;
-                    case CellType::Goal:
-                        oss << 'G';
-                        break;
-                    default:
-                        oss << '?';
-                        break;
-                }
-            }
-            oss << '\n';
+    // 按行查表编码，每行写一次
+    std::array<char, 256> encode;
+    encode.fill('.');
+    encode[static_cast<uint8_t>(CellType::Obstacle)] = '#';
+    encode[static_cast<uint8_t>(CellType::Start)] = 'S';
+    encode[static_cast<uint8_t>(CellType::Goal)] = 'G';
+
+    std::string line(static_cast<size_t>(m_width) + 1, '\n');
+    for (int y = 0; y < m_height; ++y) {
+        const CellType* row = &m_data[static_cast<size_t>(y) * m_width];
+        for (int x = 0; x < m_width; ++x) {
+            line[x] = encode[static_cast<uint8_t>(row[x])];
         }
-
-        return oss.str();
+        // 以 '#' 开头的行会被当作注释，行首的障碍物改写成同义的 'X'
+        if (line[0] == '#') {
+            line[0] = 'X';
+        }
+        file.write(line.data(), static_cast<std::streamsize>(line.size()));
     }
 
-    void Map::printToConsole() const {
-        Logger::info("Map contents:\n" + toString());
+    file.close();
+    if (file.fail()) {
+        Logger::error("Failed to write map file: {}", filename);
+        return false;
     }
 
-    int Map::countCellsOfType(CellType type) const {
-        return static_cast<int>(std::count(m_data.begin(), m_data.end(), type));
+    Logger::info("Map saved to file: {}", filename);
+    return true;
+}
+
+std::string Map::toString() const {
+    std::ostringstream oss;
+
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            CellType type = getCellType({x, y});
+
+            switch (type) {
+                case CellType::Walkable:
+                    oss << '.';
+                    break;
+                case CellType::Obstacle:
+                    oss << '#';
+                    break;
+                case CellType::Start:
+                    oss << 'S';
+                    break;
+                case CellType::Goal:
+                    oss << 'G';
+                    break;
+                default:
+                    oss << '?';
+                    break;
+            }
+        }
+        oss << '\n';
     }
 
-    std::vector<Point> Map::findCellsOfType(CellType type) const {
-        std::vector<Point> points;
+    return oss.str();
+}
 
-        for (int y = 0; y < m_height; ++y) {
-            for (int x = 0; x < m_width; ++x) {
-                if (getCellType({x, y}) == type) {
-                    points.push_back({x, y});
-                }
-            }
+void Map::printToConsole() const {
+    Logger::info("Map contents:\n{}", toString());
+}
+
+int Map::countCellsOfType(CellType type) const {
+    // 可行走单元格直接数位平面（填充位为 0）
+    if (type == CellType::Walkable) {
+        int count = 0;
+        for (uint64_t word : m_walkableBits) {
+            count += std::popcount(word);
         }
+        return count;
+    }
+
+    // 类型平面没有填充，整张地图当作一行扫描
+    int count = 0;
+    scanCells(m_data.data(), static_cast<int>(m_data.size()), type, [&count](int, uint32_t mask) {
+        count += std::popcount(mask);
+        return true;
+    });
+    return count;
+}
 
-        return points;
+std::vector<Point> Map::findCellsOfType(CellType type) const {
+    std::vector<Point> points;
+
+    for (int y = 0; y < m_height; ++y) {
+        scanCells(&m_data[static_cast<size_t>(y) * m_width], m_width, type,
+                  [&points, y](int offset, uint32_t mask) {
+                      for (; mask != 0; mask &= mask - 1) {
+                          points.push_back({offset + std::countr_zero(mask), y});
+                      }
+                      return true;
+                  });
     }
 
-    Point Map::findFirstCellOfType(CellType type) const {
-        for (int y = 0; y < m_height; ++y) {
-            for (int x = 0; x < m_width; ++x) {
-                if (getCellType({x, y}) == type) {
-                    return {x, y};
-                }
-            }
-        }
+    return points;
+}
 
-        return {-1, -1};  // ????}
+Point Map::findFirstCellOfType(CellType type) const {
+    Point found{-1, -1};  // 未找到
+    scanCells(m_data.data(), static_cast<int>(m_data.size()), type,
+              [&found, this](int offset, uint32_t mask) {
+                  const int index = offset + std::countr_zero(mask);
+                  found = {index % m_width, index / m_width};
+                  return false;
+              });
+    return found;
+}
 
-        void Map::floodFill(const Point& start, CellType newType, CellType targetType) {
-            if (!isValidPosition(start)) {
-                return;
-            }
+void Map::floodFill(const Point& start, CellType newType, CellType targetType) {
+    if (!isValidPosition(start)) {
+        return;
+    }
 
-            if (targetType == CellType::Any) {
-                targetType = getCellType(start);
-            }
+    if (targetType == CellType::Any) {
+        targetType = getCellType(start);
+    }
 
-            if (getCellType(start) != targetType || targetType == newType) {
-                return;
-            }
+    if (getCellType(start) != targetType || targetType == newType) {
+        return;
+    }
 
-            std::vector<Point> stack;
-            stack.push_back(start);
+    // 扫描线填充（4 连通）：每次填满一整段，再在上下两行的同一范围内为每个连续段压入一个种子
+    const bool walkable = newType == CellType::Walkable;
+    MapRegion changed{start, start};
+    std::vector<Point> stack;
+    stack.push_back(start);
 
-            while (!stack.empty()) {
-                Point current = stack.back();
-                stack.pop_back();
+    while (!stack.empty()) {
+        const Point seed = stack.back();
+        stack.pop_back();
 
-                if (!isValidPosition(current) || getCellType(current) != targetType) {
-                    continue;
-                }
+        CellType* row = &m_data[static_cast<size_t>(seed.y) * m_width];
+        if (row[seed.x] != targetType) {
+            continue;
+        }
 
-                setCellType(current, newType);
+        const int left = findRunStart(row, seed.x, targetType);
+        const int right = findInRow(row, seed.x, m_width, targetType, false);
+        std::fill(row + left, row + right, newType);
+        setWalkableSpan(seed.y, left, right, walkable);
+        extendRegion(changed, {left, seed.y});
+        extendRegion(changed, {right - 1, seed.y});
 
-                // ??4????
-                std::vector<Point> neighbors = getNeighbors(current, false);
-                for (const Point& neighbor : neighbors) {
-                    if (isValidPosition(neighbor) && getCellType(neighbor) == targetType) {
-                        stack.push_back(neighbor);
-                    }
-                }
+        for (int ny : {seed.y - 1, seed.y + 1}) {
+            if (ny < 0 || ny >= m_height) {
+                continue;
+            }
+            const CellType* neighborRow = &m_data[static_cast<size_t>(ny) * m_width];
+            int x = findInRow(neighborRow, left, right, targetType, true);
+            while (x < right) {
+                stack.push_back({x, ny});
+                x = findInRow(neighborRow, x, right, targetType, false);
+                x = findInRow(neighborRow, x, right, targetType, true);
             }
-
-            Logger::debug("Flood fill completed from (" + std::to_string(start.x) + "," +
-                          std::to_string(start.y) + ")");
         }
+    }
+
+    touch(changed);
+    ONEDAY_LOG_DEBUG("Flood fill completed from ({},{})", start.x, start.y);
+}
 
-    }  // namespace oneday::pathfinding
+}  // namespace oneday::pathfinding
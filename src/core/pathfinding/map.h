@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -21,10 +22,18 @@ struct Point {
     }
 };
 
+/**
+ * @brief 地图上的矩形区域（包含两个角点）
+ */
+struct MapRegion {
+    Point topLeft;      ///< 左上角
+    Point bottomRight;  ///< 右下角
+};
+
 /**
  * @brief 地图单元格类型
  */
-enum class CellType {
+enum class CellType : int8_t {
     Walkable = 0,  ///< 可行走
     Obstacle = 1,  ///< 障碍物
     Start = 2,     ///< 起点
@@ -35,7 +44,12 @@ enum class CellType {
 /**
  * @brief 地图类
  * 
- * 表示2D网格地图，用于路径查找算法
+ * 表示2D网格地图，用于路径查找算法。
+ * 
+ * 单元格类型按字节存放（行优先，无填充）；另外维护一个可行走位平面，每个单元格 1 位，
+ * 四周各留一格恒为不可行走的填充，搜索算法用 isWalkableUnchecked() 查询邻居时无需边界检查。
+ * 位平面按行和按列各存一份，视线检查沿任一方向都能整字读取。
+ * 4096x4096 的地图占用 16 MB 类型平面加两份 2 MB 位平面。
  */
 class Map {
 public:
@@ -65,6 +79,32 @@ public:
      */
     bool isWalkable(const Point& point) const;
     
+    /**
+     * @brief 不做边界检查的可行走判断
+     * @param x 横坐标，取值范围 [-1, width]
+     * @param y 纵坐标，取值范围 [-1, height]
+     * @return 是否可行走（填充格总是不可行走）
+     *
+     * 地图内任意单元格的 8 个邻居都在取值范围内，可以直接查询。
+     */
+    bool isWalkableUnchecked(int x, int y) const {
+        const size_t bit = static_cast<size_t>(x + 1);
+        const size_t row = static_cast<size_t>(y + 1) * m_bitRowWords;
+        return (m_walkableBits[row + (bit >> 6)] >> (bit & 63)) & 1u;
+    }
+    
+    /**
+     * @brief 检查两点间的直线（Bresenham）是否只经过可行走的单元格
+     * @param from 起点
+     * @param to 终点
+     * @return 是否有视线；任一端点在地图外时返回 false
+     *
+     * 直线在每行（x 为主方向时）或每列（y 为主方向时）经过的单元格是连续的一段，
+     * 每段用位平面上的整字掩码一次检查，代价与段数而不是单元格数成正比；
+     * 接近对角线的直线每段只有一两格，仍逐格检查。
+     */
+    bool hasLineOfSight(const Point& from, const Point& to) const;
+    
     /**
      * @brief 获取单元格类型
      * @param point 位置
@@ -91,6 +131,32 @@ public:
      */
     int getHeight() const;
     
+    /**
+     * @brief 获取原始单元格数据（按 y * width + x 排列）
+     * @return 单元格数组
+     */
+    const std::vector<CellType>& getCells() const { return m_data; }
+    
+    /**
+     * @brief 获取地图内容的修订号
+     * @return 修订号
+     *
+     * 每次内容变化都会从全局计数器取一个新值，因此修订号在所有地图之间唯一，
+     * 算法可以用它判断按地图缓存的预处理数据（如 JPS+ 跳跃距离表）是否仍然有效。
+     */
+    uint64_t getRevision() const { return m_revision; }
+    
+    /**
+     * @brief 获取某个修订号之后内容发生变化的区域
+     * @param sinceRevision 调用方上次同步时的修订号
+     * @param regions 输出变化区域（按修改顺序，可能重叠）
+     * @return 是否能给出完整的变化记录；修订号不属于本地图的历史、记录已被截断
+     *         或地图尺寸发生过变化时返回 false，调用方应完全重建依赖地图内容的数据
+     *
+     * 按地图缓存的预处理数据（如 HPA* 的簇抽象）据此只重算受影响的部分。
+     */
+    bool getChangedRegions(uint64_t sinceRevision, std::vector<MapRegion>& regions) const;
+    
     /**
      * @brief 清空地图
      * @param fillType 填充类型
@@ -147,13 +213,13 @@ public:
     
     /**
      * @brief 从文件加载地图
-     * @param filename 文件名
+     * @param filename 文件名（二进制地图文件按文件头识别，否则按文本格式解析）
      * @return 是否加载成功
      */
     bool loadFromFile(const std::string& filename);
     
     /**
-     * @brief 保存地图到文件
+     * @brief 保存地图到文件（文本格式，便于手工编辑；二进制格式见 MapFile::save）
      * @param filename 文件名
      * @return 是否保存成功
      */
@@ -200,9 +266,58 @@ public:
     void floodFill(const Point& start, CellType newType, CellType targetType = CellType::Any);
 
 private:
+    friend class MapFile;  ///< 二进制地图文件直接读写类型平面和位平面
+    
     int m_width;                    ///< 地图宽度
     int m_height;                   ///< 地图高度
     std::vector<CellType> m_data;   ///< 地图数据
+    std::vector<uint64_t> m_walkableBits;        ///< 可行走位平面（含一格填充）
+    size_t m_bitRowWords;                        ///< 位平面每行的 64 位字数
+    std::vector<uint64_t> m_walkableColumnBits;  ///< 按列存放的可行走位平面（含一格填充）
+    size_t m_bitColumnWords;                     ///< 按列位平面每列的 64 位字数
+    uint64_t m_revision;            ///< 内容修订号
+    
+    /**
+     * @brief 一次内容变化的记录
+     */
+    struct ChangeRecord {
+        uint64_t revision;  ///< 变化后的修订号
+        MapRegion region;   ///< 变化区域
+    };
+    
+    std::vector<ChangeRecord> m_changeLog;  ///< 变化记录（按修订号递增，有上限）
+    uint64_t m_changeLogBase;               ///< 最早一条记录之前的修订号
+    
+    /**
+     * @brief 根据类型平面重建可行走位平面
+     */
+    void rebuildWalkability();
+    
+    /**
+     * @brief 根据按行位平面重建按列位平面
+     */
+    void rebuildColumnBits();
+    
+    /**
+     * @brief 更新一行中 [begin, end) 单元格的可行走位（两份位平面）
+     */
+    void setWalkableSpan(int y, int begin, int end, bool walkable);
+    
+    /**
+     * @brief 写入单元格（越界时记录警告）
+     * @return 单元格类型是否改变
+     */
+    bool assignCell(const Point& point, CellType type);
+    
+    /**
+     * @brief 标记区域内容已变化
+     */
+    void touch(const MapRegion& region);
+    
+    /**
+     * @brief 标记整张地图已变化并丢弃变化记录（尺寸改变或重新加载时）
+     */
+    void resetHistory();
 };
 
 } // namespace oneday::pathfinding
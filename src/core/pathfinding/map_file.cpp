@@ -0,0 +1,476 @@
+#include "map_file.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "../common/logger.h"
+#include "cluster_abstraction.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'D', 'M', 'A', 'P', '\0', '\r', '\n'};
+
+/**
+ * @brief 段的对齐字节数
+ */
+constexpr uint64_t kSectionAlignment = 64;
+
+uint64_t alignSection(uint64_t offset) {
+    return (offset + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+}
+
+/**
+ * @brief 可行走位平面每行的 64 位字数（与 Map 相同，含两格填充）
+ */
+size_t bitRowWords(int width) {
+    return (static_cast<size_t>(width) + 2 + 63) / 64;
+}
+
+/**
+ * @brief 打包字节 -> 4 个单元格（每个单元格一个字节，低地址在前）
+ */
+constexpr std::array<uint32_t, 256> makeUnpackTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t byte = 0; byte < 256; ++byte) {
+        uint32_t cells = 0;
+        for (uint32_t i = 0; i < 4; ++i) {
+            cells |= ((byte >> (2 * i)) & 3u) << (8 * i);
+        }
+        table[byte] = cells;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> kUnpackTable = makeUnpackTable();
+
+/**
+ * @brief 从打包单元格中取出从 index 开始的一段（小端，单元格 index 在最低两位）
+ * @param count 返回时为这一段中有效的单元格数（29 到 32 个，受字节内偏移限制）
+ */
+uint64_t loadPackedCells(const uint8_t* cells, size_t cellsSize, size_t index, int& count) {
+    const size_t offset = index >> 2;
+    uint64_t word = 0;
+    std::memcpy(&word, cells + offset, std::min<size_t>(sizeof(word), cellsSize - offset));
+    const int shift = static_cast<int>(index & 3) * 2;
+    count = 32 - shift / 2;
+    return word >> shift;
+}
+
+/**
+ * @brief 打包单元格 -> 可行走掩码：每个 Walkable（两位都为 0）的单元格对应结果中的一位
+ */
+uint64_t walkableMask(uint64_t packed) {
+    static_assert(static_cast<int>(CellType::Walkable) == 0, "walkable cells must pack to 00");
+    uint64_t bits = ~(packed | (packed >> 1)) & 0x5555555555555555ull;
+    // 把偶数位压缩到低 32 位
+    bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+    bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+    bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+    bits = (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+    return bits;
+}
+
+/**
+ * @brief 校验可行走位平面：填充位全为 0，其余位与单元格是否为 Walkable 一致
+ *
+ * 搜索依赖填充位为 0 省去边界检查，位平面与单元格不一致的文件不能使用。
+ * 每次从打包单元格中取一个 64 位字，得到约 32 个单元格的可行走位，拼成一行后整行比较。
+ */
+bool walkabilityMatchesCells(const uint8_t* cells, const uint64_t* bits, int width, int height) {
+    const size_t words = bitRowWords(width);
+    const size_t lastRow = (static_cast<size_t>(height) + 1) * words;
+    for (size_t word = 0; word < words; ++word) {
+        if (bits[word] != 0 || bits[lastRow + word] != 0) {
+            return false;
+        }
+    }
+
+    const size_t cellsSize = (static_cast<size_t>(width) * height + 3) / 4;
+    std::vector<uint64_t> expected(words);
+    size_t index = 0;
+    for (int y = 0; y < height; ++y) {
+        std::fill(expected.begin(), expected.end(), 0);
+        for (int x = 0; x < width;) {
+            int count = 0;
+            uint64_t mask = walkableMask(loadPackedCells(cells, cellsSize, index, count));
+            count = std::min(count, width - x);
+            mask &= (1ull << count) - 1;
+
+            // 位平面每行左侧有一格填充，单元格 x 对应位 x + 1
+            const size_t bit = static_cast<size_t>(x) + 1;
+            const int shift = static_cast<int>(bit & 63);
+            expected[bit >> 6] |= mask << shift;
+            if (shift + count > 64) {
+                expected[(bit >> 6) + 1] |= mask >> (64 - shift);
+            }
+            x += count;
+            index += static_cast<size_t>(count);
+        }
+        const uint64_t* row = bits + (static_cast<size_t>(y) + 1) * words;
+        if (std::memcmp(row, expected.data(), words * sizeof(uint64_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 写出对齐填充
+ */
+void padTo(std::ofstream& file, uint64_t& position, uint64_t target) {
+    static const char zeros[kSectionAlignment] = {};
+    file.write(zeros, static_cast<std::streamsize>(target - position));
+    position = target;
+}
+
+}  // namespace
+
+MapFile::MapFile() = default;
+
+MapFile::~MapFile() {
+    close();
+}
+
+MapFile::MapFile(MapFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MapFile& MapFile::operator=(MapFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+        m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+        m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+        m_header = std::exchange(other.m_header, nullptr);
+        m_cells = std::exchange(other.m_cells, nullptr);
+        m_walkableBits = std::exchange(other.m_walkableBits, nullptr);
+        m_bitRowWords = std::exchange(other.m_bitRowWords, 0);
+    }
+    return *this;
+}
+
+bool MapFile::open(const std::string& filename) {
+    close();
+    if constexpr (std::endian::native != std::endian::little) {
+        Logger::error("Binary map files are only supported on little-endian hosts");
+        return false;
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Logger::error("Failed to open map file: {}", filename);
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < sizeof(MapFileHeader)) {
+        CloseHandle(file);
+        Logger::error("Map file is too small: {}", filename);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        Logger::error("Failed to map map file: {}", filename);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_mapping = view;
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Logger::error("Failed to open map file: {}", filename);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MapFileHeader)) {
+        ::close(fd);
+        Logger::error("Map file is too small: {}", filename);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // 映射在文件描述符关闭后仍然有效
+    if (view == MAP_FAILED) {
+        Logger::error("Failed to map map file: {}", filename);
+        return false;
+    }
+    m_mapping = view;
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    const auto* base = static_cast<const uint8_t*>(m_mapping);
+    const auto* header = reinterpret_cast<const MapFileHeader*>(base);
+    const auto sectionFits = [this](uint64_t offset, uint64_t size) {
+        return offset % kSectionAlignment == 0 && offset <= m_size && size <= m_size - offset;
+    };
+    const uint64_t cellCount = static_cast<uint64_t>(std::max(header->width, 0)) *
+                               static_cast<uint64_t>(std::max(header->height, 0));
+    const uint64_t walkableSize = static_cast<uint64_t>(bitRowWords(header->width)) *
+                                  (static_cast<uint64_t>(header->height) + 2) * sizeof(uint64_t);
+
+    const char* error = nullptr;
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+        error = "not a binary map file";
+    } else if (header->version != kVersion || header->headerSize != sizeof(MapFileHeader)) {
+        error = "unsupported format version";
+    } else if (header->width <= 0 || header->height <= 0) {
+        error = "invalid dimensions";
+    } else if (header->cellsSize != (cellCount + 3) / 4 ||
+               !sectionFits(header->cellsOffset, header->cellsSize)) {
+        error = "corrupt cell section";
+    } else if (header->walkableSize != walkableSize ||
+               !sectionFits(header->walkableOffset, header->walkableSize)) {
+        error = "corrupt walkability section";
+    } else if (header->abstractionSize != 0 &&
+               !sectionFits(header->abstractionOffset, header->abstractionSize)) {
+        error = "corrupt abstraction section";
+    } else if (!walkabilityMatchesCells(
+                   base + header->cellsOffset,
+                   reinterpret_cast<const uint64_t*>(base + header->walkableOffset),
+                   header->width, header->height)) {
+        error = "walkability section does not match the cells";
+    }
+    if (error != nullptr) {
+        Logger::error("Failed to open map file {}: {}", filename, error);
+        close();
+        return false;
+    }
+
+    m_header = header;
+    m_cells = base + header->cellsOffset;
+    m_walkableBits = reinterpret_cast<const uint64_t*>(base + header->walkableOffset);
+    m_bitRowWords = bitRowWords(header->width);
+    ONEDAY_LOG_DEBUG("Map file mapped: {} ({}x{}, {} bytes)", filename, header->width,
+                     header->height, m_size);
+    return true;
+}
+
+void MapFile::close() {
+    if (m_mapping != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_mapping);
+        CloseHandle(m_mappingHandle);
+        CloseHandle(m_fileHandle);
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        munmap(m_mapping, m_size);
+#endif
+    }
+    m_mapping = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_cells = nullptr;
+    m_walkableBits = nullptr;
+    m_bitRowWords = 0;
+}
+
+bool MapFile::isOpen() const {
+    return m_header != nullptr;
+}
+
+int MapFile::getWidth() const {
+    return m_header ? m_header->width : 0;
+}
+
+int MapFile::getHeight() const {
+    return m_header ? m_header->height : 0;
+}
+
+bool MapFile::isValidPosition(const Point& point) const {
+    return m_header && point.x >= 0 && point.x < m_header->width && point.y >= 0 &&
+           point.y < m_header->height;
+}
+
+CellType MapFile::getCellType(const Point& point) const {
+    if (!isValidPosition(point)) {
+        return CellType::Obstacle;
+    }
+    const size_t index = static_cast<size_t>(point.y) * m_header->width + point.x;
+    return static_cast<CellType>((m_cells[index >> 2] >> ((index & 3) * 2)) & 3u);
+}
+
+bool MapFile::isWalkable(const Point& point) const {
+    return isValidPosition(point) && isWalkableUnchecked(point.x, point.y);
+}
+
+bool MapFile::hasAbstraction() const {
+    return m_header && m_header->abstractionSize != 0;
+}
+
+bool MapFile::loadInto(Map& map) const {
+    if (!isOpen()) {
+        Logger::error("Map file is not open");
+        return false;
+    }
+
+    const size_t count = static_cast<size_t>(m_header->width) * m_header->height;
+    map.m_width = m_header->width;
+    map.m_height = m_header->height;
+    map.m_data.resize(count);
+
+    // 每个打包字节查表展开成 4 个单元格，最后不满 4 个的字节单独处理
+    auto* out = reinterpret_cast<uint8_t*>(map.m_data.data());
+    const size_t fullBytes = count / 4;
+    for (size_t i = 0; i < fullBytes; ++i) {
+        std::memcpy(out + i * 4, &kUnpackTable[m_cells[i]], 4);
+    }
+    for (size_t index = fullBytes * 4; index < count; ++index) {
+        out[index] = static_cast<uint8_t>((m_cells[index >> 2] >> ((index & 3) * 2)) & 3u);
+    }
+
+    // 按行位平面与 Map 的布局相同且已在 open() 中校验，整段复制；按列位平面由它转置得到
+    map.m_bitRowWords = m_bitRowWords;
+    map.m_walkableBits.assign(m_walkableBits,
+                              m_walkableBits + m_header->walkableSize / sizeof(uint64_t));
+    map.rebuildColumnBits();
+    map.resetHistory();
+    return true;
+}
+
+bool MapFile::loadAbstraction(ClusterAbstraction& abstraction, const Map& map) const {
+    if (!hasAbstraction()) {
+        return false;
+    }
+    // 抽象只取决于可行走性：位平面与文件逐字相同才能把抽象视为已与地图同步
+    const size_t walkableWords = m_header->walkableSize / sizeof(uint64_t);
+    if (map.getWidth() != m_header->width || map.getHeight() != m_header->height ||
+        map.m_walkableBits.size() != walkableWords ||
+        !std::equal(map.m_walkableBits.begin(), map.m_walkableBits.end(), m_walkableBits)) {
+        Logger::error("Map does not match the map file the abstraction was saved with");
+        return false;
+    }
+    return abstraction.deserialize(
+        static_cast<const uint8_t*>(m_mapping) + m_header->abstractionOffset,
+        static_cast<size_t>(m_header->abstractionSize), map);
+}
+
+bool MapFile::save(const std::string& filename, const Map& map,
+                   const ClusterAbstraction* abstraction) {
+    std::vector<uint8_t> abstractionData;
+    if (abstraction != nullptr) {
+        if (abstraction->getRevision() != map.getRevision()) {
+            Logger::error("Cluster abstraction is not synchronized with the map, not saving");
+            return false;
+        }
+        abstraction->serialize(abstractionData);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Logger::error("Failed to create map file: {}", filename);
+        return false;
+    }
+
+    const std::vector<CellType>& cells = map.getCells();
+    const std::vector<uint64_t>& walkable = map.m_walkableBits;
+
+    MapFileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.headerSize = sizeof(MapFileHeader);
+    header.width = map.getWidth();
+    header.height = map.getHeight();
+    header.cellsOffset = alignSection(sizeof(MapFileHeader));
+    header.cellsSize = (cells.size() + 3) / 4;
+    header.walkableOffset = alignSection(header.cellsOffset + header.cellsSize);
+    header.walkableSize = walkable.size() * sizeof(uint64_t);
+    if (!abstractionData.empty()) {
+        header.abstractionOffset = alignSection(header.walkableOffset + header.walkableSize);
+        header.abstractionSize = abstractionData.size();
+    }
+
+    uint64_t position = 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position += sizeof(header);
+    padTo(file, position, header.cellsOffset);
+
+    // 单元格按块打包后写出，避免逐字节写文件
+    std::vector<uint8_t> packed;
+    packed.reserve(std::min<size_t>(header.cellsSize, 1 << 20));
+    const auto* raw = reinterpret_cast<const uint8_t*>(cells.data());
+    for (size_t index = 0; index < cells.size(); index += 4) {
+        uint8_t byte = 0;
+        for (size_t i = 0; i < 4 && index + i < cells.size(); ++i) {
+            byte |= static_cast<uint8_t>((raw[index + i] & 3u) << (2 * i));
+        }
+        packed.push_back(byte);
+        if (packed.size() == packed.capacity()) {
+            file.write(reinterpret_cast<const char*>(packed.data()),
+                       static_cast<std::streamsize>(packed.size()));
+            packed.clear();
+        }
+    }
+    file.write(reinterpret_cast<const char*>(packed.data()),
+               static_cast<std::streamsize>(packed.size()));
+    position += header.cellsSize;
+
+    padTo(file, position, header.walkableOffset);
+    file.write(reinterpret_cast<const char*>(walkable.data()),
+               static_cast<std::streamsize>(header.walkableSize));
+    position += header.walkableSize;
+
+    if (!abstractionData.empty()) {
+        padTo(file, position, header.abstractionOffset);
+        file.write(reinterpret_cast<const char*>(abstractionData.data()),
+                   static_cast<std::streamsize>(abstractionData.size()));
+    }
+
+    // 显式关闭后再检查流状态，缓冲区刷新到磁盘时的失败也要报告
+    file.close();
+    if (file.fail()) {
+        Logger::error("Failed to write map file: {}", filename);
+        return false;
+    }
+    Logger::info("Binary map saved to file: {} ({}x{}{})", filename, header.width, header.height,
+                 abstractionData.empty() ? "" : ", with cluster abstraction");
+    return true;
+}
+
+bool MapFile::isBinaryFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool MapFile::convert(const std::string& source, const std::string& destination) {
+    Map map(1, 1);
+    if (!map.loadFromFile(source)) {
+        return false;
+    }
+    return isBinaryFile(source) ? map.saveToFile(destination) : save(destination, map);
+}
+
+}  // namespace oneday::pathfinding
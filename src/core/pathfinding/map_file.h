@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "map.h"
+
+namespace oneday::pathfinding {
+
+class ClusterAbstraction;
+
+/**
+ * @brief 二进制地图文件的文件头（小端序，64 字节对齐）
+ *
+ * 各段都从 64 字节对齐的偏移开始：
+ * - 单元格段：每个单元格 2 位（CellType 0..3），按 y * width + x 连续存放，每字节 4 个单元格
+ * - 可行走段：与 Map 内部相同布局的按行位平面（四周各一格填充），可以直接按位查询
+ * - 抽象段（可选）：ClusterAbstraction::serialize() 写出的预计算簇抽象
+ */
+struct MapFileHeader {
+    char magic[8];               ///< 固定为 "ODMAP\0\r\n"
+    uint32_t version;            ///< 格式版本
+    uint32_t headerSize;         ///< 文件头字节数
+    int32_t width;               ///< 地图宽度
+    int32_t height;              ///< 地图高度
+    uint64_t cellsOffset;        ///< 单元格段偏移
+    uint64_t cellsSize;          ///< 单元格段字节数
+    uint64_t walkableOffset;     ///< 可行走段偏移
+    uint64_t walkableSize;       ///< 可行走段字节数
+    uint64_t abstractionOffset;  ///< 抽象段偏移（没有时为 0）
+    uint64_t abstractionSize;    ///< 抽象段字节数（没有时为 0）
+};
+
+static_assert(sizeof(MapFileHeader) == 72, "MapFileHeader layout must not change");
+
+/**
+ * @brief 内存映射的二进制地图文件
+ *
+ * open() 只映射文件并校验文件头、各段的范围以及可行走位平面（填充位为 0 且与单元格一致），
+ * 不复制数据；getCellType() 和 isWalkableUnchecked() 直接读取映射的页面，只需要查询地图的工具
+ * （或只读取部分区域的调用方）无需加载整张地图。loadInto() 把单元格解包到 Map 中，
+ * 可行走位平面整段复制。
+ *
+ * 文本格式（Map::saveToFile）仍然用于手工编辑，convert() 在两种格式间转换。
+ */
+class MapFile {
+  public:
+    static constexpr uint32_t kVersion = 1;  ///< 当前格式版本
+
+    /**
+     * @brief 构造未打开的文件
+     */
+    MapFile();
+
+    /**
+     * @brief 析构函数（解除映射）
+     */
+    ~MapFile();
+
+    MapFile(const MapFile&) = delete;
+    MapFile& operator=(const MapFile&) = delete;
+    MapFile(MapFile&& other) noexcept;
+    MapFile& operator=(MapFile&& other) noexcept;
+
+    /**
+     * @brief 映射并校验二进制地图文件
+     * @param filename 文件名
+     * @return 是否打开成功
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief 解除映射
+     */
+    void close();
+
+    /**
+     * @brief 是否已打开
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief 获取地图宽度
+     */
+    int getWidth() const;
+
+    /**
+     * @brief 获取地图高度
+     */
+    int getHeight() const;
+
+    /**
+     * @brief 检查位置是否在地图内
+     */
+    bool isValidPosition(const Point& point) const;
+
+    /**
+     * @brief 获取单元格类型（地图外返回 Obstacle）
+     */
+    CellType getCellType(const Point& point) const;
+
+    /**
+     * @brief 检查位置是否可行走
+     */
+    bool isWalkable(const Point& point) const;
+
+    /**
+     * @brief 不做边界检查的可行走判断（取值范围与 Map::isWalkableUnchecked 相同）
+     */
+    bool isWalkableUnchecked(int x, int y) const {
+        const size_t bit = static_cast<size_t>(x + 1);
+        const size_t row = static_cast<size_t>(y + 1) * m_bitRowWords;
+        return (m_walkableBits[row + (bit >> 6)] >> (bit & 63)) & 1u;
+    }
+
+    /**
+     * @brief 是否包含预计算的簇抽象
+     */
+    bool hasAbstraction() const;
+
+    /**
+     * @brief 把地图内容加载到 Map
+     * @param map 目标地图（尺寸随文件改变，修订历史重置）
+     * @return 是否加载成功
+     */
+    bool loadInto(Map& map) const;
+
+    /**
+     * @brief 导入预计算的簇抽象
+     * @param abstraction 目标簇抽象
+     * @param map 由 loadInto() 从本文件加载、之后未修改的地图
+     * @return 是否导入成功（没有抽象段、地图的可行走单元格与文件不一致或数据无效时返回 false，
+     *         抽象保持不变）
+     */
+    bool loadAbstraction(ClusterAbstraction& abstraction, const Map& map) const;
+
+    /**
+     * @brief 保存二进制地图文件
+     * @param filename 文件名
+     * @param map 地图
+     * @param abstraction 要一起保存的簇抽象（必须已与地图同步，nullptr 表示不保存）
+     * @return 是否保存成功
+     */
+    static bool save(const std::string& filename, const Map& map,
+                     const ClusterAbstraction* abstraction = nullptr);
+
+    /**
+     * @brief 检查文件是否以二进制地图文件的标识开头
+     */
+    static bool isBinaryFile(const std::string& filename);
+
+    /**
+     * @brief 在文本格式和二进制格式之间转换
+     * @param source 源文件（按文件内容识别格式）
+     * @param destination 目标文件（写成与源文件相反的格式）
+     * @return 是否转换成功
+     */
+    static bool convert(const std::string& source, const std::string& destination);
+
+  private:
+    void* m_mapping = nullptr;              ///< 映射的起始地址
+    size_t m_size = 0;                      ///< 映射的字节数
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;           ///< 文件句柄
+    void* m_mappingHandle = nullptr;        ///< 映射对象句柄
+#endif
+    const MapFileHeader* m_header = nullptr;  ///< 文件头
+    const uint8_t* m_cells = nullptr;         ///< 单元格段
+    const uint64_t* m_walkableBits = nullptr; ///< 可行走段
+    size_t m_bitRowWords = 0;                 ///< 位平面每行的 64 位字数
+};
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,1203 @@
+// 本文件中的耳切三角剖分（EarNode、EarClipper 及其辅助函数）移植自 mapbox/earcut
+// (https://github.com/mapbox/earcut)，按其 ISC 许可证保留以下版权和许可声明：
+//
+// ISC License
+//
+// Copyright (c) 2016, Mapbox
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted, provided that the above copyright notice
+// and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+// THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+// CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+// OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include "navmesh.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+#include "../common/logger.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+namespace {
+
+/**
+ * @brief 耳切法使用的环形双向链表节点
+ */
+struct EarNode {
+    uint32_t index;             ///< 顶点编号（桥接复制出的节点与原节点相同）
+    double x;                   ///< X 坐标
+    double y;                   ///< Y 坐标
+    EarNode* prev = nullptr;    ///< 环上的前一个节点
+    EarNode* next = nullptr;    ///< 环上的后一个节点
+    uint32_t z = 0;             ///< Z 序曲线值
+    EarNode* prevZ = nullptr;   ///< Z 序链表上的前一个节点
+    EarNode* nextZ = nullptr;   ///< Z 序链表上的后一个节点
+};
+
+/**
+ * @brief 有向面积的相反数：小于 0 表示 p -> q -> r 左转
+ */
+double area(const EarNode* p, const EarNode* q, const EarNode* r) {
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+bool equals(const EarNode* a, const EarNode* b) {
+    return a->x == b->x && a->y == b->y;
+}
+
+bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy,
+                     double px, double py) {
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+           (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+/**
+ * @brief 点是否在三角形 abc 内（与 a 重合的点不算，桥接边两端有重复顶点）
+ */
+bool pointInEar(const EarNode* a, const EarNode* b, const EarNode* c, const EarNode* p) {
+    return !(a->x == p->x && a->y == p->y) &&
+           pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y);
+}
+
+int sign(double value) {
+    return (value > 0.0) - (value < 0.0);
+}
+
+/**
+ * @brief 共线时 q 是否落在线段 pr 的范围内
+ */
+bool onSegment(const EarNode* p, const EarNode* q, const EarNode* r) {
+    return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) &&
+           q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+}
+
+bool intersects(const EarNode* p1, const EarNode* q1, const EarNode* p2, const EarNode* q2) {
+    const int o1 = sign(area(p1, q1, p2));
+    const int o2 = sign(area(p1, q1, q2));
+    const int o3 = sign(area(p2, q2, p1));
+    const int o4 = sign(area(p2, q2, q1));
+    return (o1 != o2 && o3 != o4) || (o1 == 0 && onSegment(p1, p2, q1)) ||
+           (o2 == 0 && onSegment(p1, q2, q1)) || (o3 == 0 && onSegment(p2, p1, q2)) ||
+           (o4 == 0 && onSegment(p2, q1, q2));
+}
+
+/**
+ * @brief 对角线 ab 在 a 处是否位于多边形内侧
+ */
+bool locallyInside(const EarNode* a, const EarNode* b) {
+    return area(a->prev, a, a->next) < 0.0
+               ? area(a, b, a->next) >= 0.0 && area(a, a->prev, b) >= 0.0
+               : area(a, b, a->prev) < 0.0 || area(a, a->next, b) < 0.0;
+}
+
+/**
+ * @brief 对角线 ab 的中点是否在多边形内（射线法）
+ */
+bool middleInside(const EarNode* a, const EarNode* b) {
+    const double px = (a->x + b->x) / 2.0;
+    const double py = (a->y + b->y) / 2.0;
+    bool inside = false;
+    const EarNode* p = a;
+    do {
+        if ((p->y > py) != (p->next->y > py) && p->next->y != p->y &&
+            px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x) {
+            inside = !inside;
+        }
+        p = p->next;
+    } while (p != a);
+    return inside;
+}
+
+/**
+ * @brief 对角线 ab 是否与多边形的边相交（不含以 a、b 为端点的边）
+ */
+bool intersectsPolygon(const EarNode* a, const EarNode* b) {
+    const EarNode* p = a;
+    do {
+        if (p->index != a->index && p->next->index != a->index && p->index != b->index &&
+            p->next->index != b->index && intersects(p, p->next, a, b)) {
+            return true;
+        }
+        p = p->next;
+    } while (p != a);
+    return false;
+}
+
+bool isValidDiagonal(const EarNode* a, const EarNode* b) {
+    return a->next->index != b->index && a->prev->index != b->index &&
+           !intersectsPolygon(a, b) &&
+           ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&
+             (area(a->prev, a, b->prev) != 0.0 || area(a, b->prev, b) != 0.0)) ||
+            (equals(a, b) && area(a->prev, a, a->next) > 0.0 && area(b->prev, b, b->next) > 0.0));
+}
+
+/**
+ * @brief 扇区 m 是否包含扇区 p（两者都在同一条桥接射线上时用于挑选桥接点）
+ */
+bool sectorContainsSector(const EarNode* m, const EarNode* p) {
+    return area(m->prev, m, p->prev) < 0.0 && area(p->next, m, m->next) < 0.0;
+}
+
+/**
+ * @brief 带洞多边形的耳切三角剖分（移植自 mapbox/earcut，见文件开头的许可声明）
+ *
+ * 外环逆时针、洞顺时针；每个洞从最左顶点向左找一个可见的外环顶点，用一对重复顶点
+ * 组成的桥接边连进外环。找不到耳朵时依次尝试：去掉重复和共线点、消除局部自相交、
+ * 沿一条合法对角线把多边形一分为二。顶点较多时用 Z 序曲线只检查耳朵边界框内的顶点。
+ */
+class EarClipper {
+  public:
+    /**
+     * @brief 三角剖分
+     * @param coords 顶点坐标（x0, y0, x1, y1, ...）
+     * @param ringStarts 各环的起始顶点（第一个为外环）
+     * @param firstIndex 第一个顶点的编号
+     * @param triangles 输出三角形（逆时针）
+     */
+    void triangulate(const std::vector<double>& coords, const std::vector<size_t>& ringStarts,
+                     uint32_t firstIndex, std::vector<std::array<uint32_t, 3>>& triangles) {
+        m_nodes.clear();
+        m_coords = &coords;
+        m_firstIndex = firstIndex;
+        m_triangles = &triangles;
+
+        const size_t vertexCount = coords.size() / 2;
+        const size_t outerEnd = ringStarts.size() > 1 ? ringStarts[1] : vertexCount;
+        EarNode* outer = linkedList(ringStarts[0], outerEnd, true);
+        if (outer == nullptr || outer->next == outer->prev) {
+            return;
+        }
+        if (ringStarts.size() > 1) {
+            outer = eliminateHoles(ringStarts, vertexCount, outer);
+        }
+
+        m_invSize = 0.0;
+        if (vertexCount > 80) {
+            double maxX = m_minX = coords[0];
+            double maxY = m_minY = coords[1];
+            for (size_t i = 2; i < outerEnd * 2; i += 2) {
+                m_minX = std::min(m_minX, coords[i]);
+                m_minY = std::min(m_minY, coords[i + 1]);
+                maxX = std::max(maxX, coords[i]);
+                maxY = std::max(maxY, coords[i + 1]);
+            }
+            const double size = std::max(maxX - m_minX, maxY - m_minY);
+            m_invSize = size != 0.0 ? 32767.0 / size : 0.0;
+        }
+        earcutLinked(outer, 0);
+    }
+
+  private:
+    EarNode* createNode(uint32_t index, double x, double y) {
+        EarNode& node = m_nodes.emplace_back();
+        node.index = index;
+        node.x = x;
+        node.y = y;
+        return &node;
+    }
+
+    EarNode* insertNode(size_t vertex, EarNode* last) {
+        EarNode* p = createNode(m_firstIndex + static_cast<uint32_t>(vertex),
+                                (*m_coords)[vertex * 2], (*m_coords)[vertex * 2 + 1]);
+        if (last == nullptr) {
+            p->prev = p;
+            p->next = p;
+        } else {
+            p->next = last->next;
+            p->prev = last;
+            last->next->prev = p;
+            last->next = p;
+        }
+        return p;
+    }
+
+    static void removeNode(EarNode* p) {
+        p->next->prev = p->prev;
+        p->prev->next = p->next;
+        if (p->prevZ != nullptr) {
+            p->prevZ->nextZ = p->nextZ;
+        }
+        if (p->nextZ != nullptr) {
+            p->nextZ->prevZ = p->prevZ;
+        }
+    }
+
+    /**
+     * @brief 把 [begin, end) 的顶点连成环，按需反转为指定方向
+     */
+    EarNode* linkedList(size_t begin, size_t end, bool counterClockwise) {
+        const std::vector<double>& c = *m_coords;
+        double doubleArea = 0.0;
+        for (size_t i = begin, j = end - 1; i < end; j = i++) {
+            doubleArea += (c[j * 2] - c[i * 2]) * (c[i * 2 + 1] + c[j * 2 + 1]);
+        }
+        EarNode* last = nullptr;
+        if (counterClockwise == (doubleArea > 0.0)) {
+            for (size_t i = begin; i < end; ++i) {
+                last = insertNode(i, last);
+            }
+        } else {
+            for (size_t i = end; i > begin; --i) {
+                last = insertNode(i - 1, last);
+            }
+        }
+        if (last != nullptr && equals(last, last->next)) {
+            removeNode(last);
+            last = last->next;
+        }
+        return last;
+    }
+
+    /**
+     * @brief 去掉重复点和共线点
+     */
+    static EarNode* filterPoints(EarNode* start, EarNode* end = nullptr) {
+        if (start == nullptr) {
+            return start;
+        }
+        if (end == nullptr) {
+            end = start;
+        }
+        EarNode* p = start;
+        bool again;
+        do {
+            again = false;
+            if (equals(p, p->next) || area(p->prev, p, p->next) == 0.0) {
+                removeNode(p);
+                p = end = p->prev;
+                if (p == p->next) {
+                    break;
+                }
+                again = true;
+            } else {
+                p = p->next;
+            }
+        } while (again || p != end);
+        return end;
+    }
+
+    void emit(const EarNode* a, const EarNode* b, const EarNode* c) {
+        m_triangles->push_back({a->index, b->index, c->index});
+    }
+
+    void earcutLinked(EarNode* ear, int pass) {
+        if (ear == nullptr) {
+            return;
+        }
+        if (pass == 0 && m_invSize != 0.0) {
+            indexCurve(ear);
+        }
+
+        EarNode* stop = ear;
+        while (ear->prev != ear->next) {
+            EarNode* prev = ear->prev;
+            EarNode* next = ear->next;
+            if (m_invSize != 0.0 ? isEarHashed(ear) : isEar(ear)) {
+                emit(prev, ear, next);
+                removeNode(ear);
+                // 跳过下一个顶点，减少细长三角形
+                ear = next->next;
+                stop = next->next;
+                continue;
+            }
+            ear = next;
+            if (ear == stop) {
+                if (pass == 0) {
+                    earcutLinked(filterPoints(ear), 1);
+                } else if (pass == 1) {
+                    earcutLinked(cureLocalIntersections(filterPoints(ear)), 2);
+                } else {
+                    splitEarcut(ear);
+                }
+                break;
+            }
+        }
+    }
+
+    static bool isEar(const EarNode* ear) {
+        const EarNode* a = ear->prev;
+        const EarNode* c = ear->next;
+        if (area(a, ear, c) >= 0.0) {
+            return false;  // 凹顶点
+        }
+        const double x0 = std::min({a->x, ear->x, c->x});
+        const double y0 = std::min({a->y, ear->y, c->y});
+        const double x1 = std::max({a->x, ear->x, c->x});
+        const double y1 = std::max({a->y, ear->y, c->y});
+        // 只有凹顶点可能落在耳朵里
+        for (const EarNode* p = c->next; p != a; p = p->next) {
+            if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+                pointInEar(a, ear, c, p) && area(p->prev, p, p->next) >= 0.0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isEarHashed(const EarNode* ear) const {
+        const EarNode* a = ear->prev;
+        const EarNode* c = ear->next;
+        if (area(a, ear, c) >= 0.0) {
+            return false;
+        }
+        const double x0 = std::min({a->x, ear->x, c->x});
+        const double y0 = std::min({a->y, ear->y, c->y});
+        const double x1 = std::max({a->x, ear->x, c->x});
+        const double y1 = std::max({a->y, ear->y, c->y});
+        const uint32_t minZ = zOrder(x0, y0);
+        const uint32_t maxZ = zOrder(x1, y1);
+
+        const auto blocks = [&](const EarNode* p) {
+            return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+                   pointInEar(a, ear, c, p) && area(p->prev, p, p->next) >= 0.0;
+        };
+        // 沿 Z 序链表从耳朵向两侧查找，只看 Z 值落在边界框范围内的顶点
+        const EarNode* p = ear->prevZ;
+        const EarNode* n = ear->nextZ;
+        while (p != nullptr && p->z >= minZ && n != nullptr && n->z <= maxZ) {
+            if (blocks(p) || blocks(n)) {
+                return false;
+            }
+            p = p->prevZ;
+            n = n->nextZ;
+        }
+        for (; p != nullptr && p->z >= minZ; p = p->prevZ) {
+            if (blocks(p)) {
+                return false;
+            }
+        }
+        for (; n != nullptr && n->z <= maxZ; n = n->nextZ) {
+            if (blocks(n)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 消除相邻边相交形成的局部自相交
+     */
+    EarNode* cureLocalIntersections(EarNode* start) {
+        EarNode* p = start;
+        do {
+            EarNode* a = p->prev;
+            EarNode* b = p->next->next;
+            if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) &&
+                locallyInside(b, a)) {
+                emit(a, p, b);
+                removeNode(p);
+                removeNode(p->next);
+                p = start = b;
+            }
+            p = p->next;
+        } while (p != start);
+        return filterPoints(p);
+    }
+
+    /**
+     * @brief 沿合法对角线把多边形一分为二，分别剖分
+     */
+    void splitEarcut(EarNode* start) {
+        EarNode* a = start;
+        do {
+            for (EarNode* b = a->next->next; b != a->prev; b = b->next) {
+                if (a->index != b->index && isValidDiagonal(a, b)) {
+                    EarNode* c = splitPolygon(a, b);
+                    a = filterPoints(a, a->next);
+                    c = filterPoints(c, c->next);
+                    earcutLinked(a, 0);
+                    earcutLinked(c, 0);
+                    return;
+                }
+            }
+            a = a->next;
+        } while (a != start);
+    }
+
+    /**
+     * @brief 用 a、b 的副本把环分成两个：a -> b 与 b' -> a'
+     * @return b 的副本
+     */
+    EarNode* splitPolygon(EarNode* a, EarNode* b) {
+        EarNode* a2 = createNode(a->index, a->x, a->y);
+        EarNode* b2 = createNode(b->index, b->x, b->y);
+        EarNode* an = a->next;
+        EarNode* bp = b->prev;
+
+        a->next = b;
+        b->prev = a;
+        a2->next = an;
+        an->prev = a2;
+        b2->next = a2;
+        a2->prev = b2;
+        bp->next = b2;
+        b2->prev = bp;
+        return b2;
+    }
+
+    EarNode* eliminateHoles(const std::vector<size_t>& ringStarts, size_t vertexCount,
+                            EarNode* outer) {
+        std::vector<EarNode*> holes;
+        for (size_t i = 1; i < ringStarts.size(); ++i) {
+            const size_t end = i + 1 < ringStarts.size() ? ringStarts[i + 1] : vertexCount;
+            EarNode* list = linkedList(ringStarts[i], end, false);
+            if (list != nullptr) {
+                holes.push_back(getLeftmost(list));
+            }
+        }
+        std::sort(holes.begin(), holes.end(), [](const EarNode* a, const EarNode* b) {
+            return a->x != b->x ? a->x < b->x : a->y < b->y;
+        });
+        for (EarNode* hole : holes) {
+            outer = eliminateHole(hole, outer);
+        }
+        return outer;
+    }
+
+    EarNode* eliminateHole(EarNode* hole, EarNode* outer) {
+        EarNode* bridge = findHoleBridge(hole, outer);
+        if (bridge == nullptr) {
+            return outer;
+        }
+        EarNode* bridgeReverse = splitPolygon(bridge, hole);
+        filterPoints(bridgeReverse, bridgeReverse->next);
+        return filterPoints(bridge, bridge->next);
+    }
+
+    /**
+     * @brief 从洞的最左顶点向左发射线，找一个可以连桥的外环顶点
+     */
+    static EarNode* findHoleBridge(const EarNode* hole, EarNode* outer) {
+        const double hx = hole->x;
+        const double hy = hole->y;
+        double qx = -std::numeric_limits<double>::infinity();
+        EarNode* m = nullptr;
+
+        // 射线与向下走的外环边的最近交点，取该边 x 较小的端点
+        EarNode* p = outer;
+        do {
+            if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+                const double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+                if (x <= hx && x > qx) {
+                    qx = x;
+                    m = p->x < p->next->x ? p : p->next;
+                    if (x == hx) {
+                        return m;  // 洞顶点落在外环边上
+                    }
+                }
+            }
+            p = p->next;
+        } while (p != outer);
+        if (m == nullptr) {
+            return nullptr;
+        }
+
+        // 如果三角形 (洞顶点, 交点, m) 内有外环顶点，取与射线夹角最小的那个
+        const EarNode* stop = m;
+        const double mx = m->x;
+        const double my = m->y;
+        double tanMin = std::numeric_limits<double>::infinity();
+        p = m;
+        do {
+            if (hx >= p->x && p->x >= mx && hx != p->x &&
+                pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x,
+                                p->y)) {
+                const double tan = std::abs(hy - p->y) / (hx - p->x);
+                if (locallyInside(p, hole) &&
+                    (tan < tanMin ||
+                     (tan == tanMin &&
+                      (p->x > m->x || (p->x == m->x && sectorContainsSector(m, p)))))) {
+                    m = p;
+                    tanMin = tan;
+                }
+            }
+            p = p->next;
+        } while (p != stop);
+        return m;
+    }
+
+    static EarNode* getLeftmost(EarNode* start) {
+        EarNode* p = start;
+        EarNode* leftmost = start;
+        do {
+            if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) {
+                leftmost = p;
+            }
+            p = p->next;
+        } while (p != start);
+        return leftmost;
+    }
+
+    /**
+     * @brief 坐标在 15 位网格上的 Z 序值（交错 x、y 的二进制位）
+     */
+    uint32_t zOrder(double px, double py) const {
+        uint32_t x = static_cast<uint32_t>((px - m_minX) * m_invSize);
+        uint32_t y = static_cast<uint32_t>((py - m_minY) * m_invSize);
+        x = (x | (x << 8)) & 0x00FF00FF;
+        x = (x | (x << 4)) & 0x0F0F0F0F;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+        y = (y | (y << 8)) & 0x00FF00FF;
+        y = (y | (y << 4)) & 0x0F0F0F0F;
+        y = (y | (y << 2)) & 0x33333333;
+        y = (y | (y << 1)) & 0x55555555;
+        return x | (y << 1);
+    }
+
+    void indexCurve(EarNode* start) {
+        EarNode* p = start;
+        do {
+            if (p->z == 0) {
+                p->z = zOrder(p->x, p->y);
+            }
+            p->prevZ = p->prev;
+            p->nextZ = p->next;
+            p = p->next;
+        } while (p != start);
+        p->prevZ->nextZ = nullptr;
+        p->prevZ = nullptr;
+        sortLinked(p);
+    }
+
+    /**
+     * @brief 按 Z 值对 Z 序链表做自底向上的归并排序
+     */
+    static EarNode* sortLinked(EarNode* list) {
+        size_t inSize = 1;
+        size_t merges;
+        do {
+            EarNode* p = list;
+            EarNode* tail = nullptr;
+            list = nullptr;
+            merges = 0;
+            while (p != nullptr) {
+                ++merges;
+                EarNode* q = p;
+                size_t pSize = 0;
+                for (size_t i = 0; i < inSize && q != nullptr; ++i) {
+                    ++pSize;
+                    q = q->nextZ;
+                }
+                size_t qSize = inSize;
+                while (pSize > 0 || (qSize > 0 && q != nullptr)) {
+                    EarNode* e;
+                    if (pSize != 0 && (qSize == 0 || q == nullptr || p->z <= q->z)) {
+                        e = p;
+                        p = p->nextZ;
+                        --pSize;
+                    } else {
+                        e = q;
+                        q = q->nextZ;
+                        --qSize;
+                    }
+                    if (tail != nullptr) {
+                        tail->nextZ = e;
+                    } else {
+                        list = e;
+                    }
+                    e->prevZ = tail;
+                    tail = e;
+                }
+                p = q;
+            }
+            tail->nextZ = nullptr;
+            inSize *= 2;
+        } while (merges > 1);
+        return list;
+    }
+
+  private:
+    std::deque<EarNode> m_nodes;                             ///< 节点存储（地址稳定）
+    const std::vector<double>* m_coords = nullptr;           ///< 顶点坐标
+    std::vector<std::array<uint32_t, 3>>* m_triangles = nullptr; ///< 输出三角形
+    uint32_t m_firstIndex = 0;                               ///< 第一个顶点的编号
+    double m_minX = 0.0;                                     ///< Z 序网格原点 X
+    double m_minY = 0.0;                                     ///< Z 序网格原点 Y
+    double m_invSize = 0.0;                                  ///< Z 序网格缩放（0 为不用 Z 序）
+};
+
+/**
+ * @brief 二倍有向面积：大于 0 表示 o -> a -> b 左转
+ */
+double cross(const Point2D& o, const Point2D& a, const Point2D& b) {
+    return (static_cast<double>(a.x()) - o.x()) * (static_cast<double>(b.y()) - o.y()) -
+           (static_cast<double>(a.y()) - o.y()) * (static_cast<double>(b.x()) - o.x());
+}
+
+bool samePoint(const Point2D& a, const Point2D& b) {
+    return a.x() == b.x() && a.y() == b.y();
+}
+
+/**
+ * @brief 从 from 经过线段 ab 到达 to 时的穿越点
+ *
+ * from 和 to 的连线穿过 ab 时取交点，否则取使 from -> 端点 -> to 较短的端点。
+ * 长边的中点可能离真实路径很远，用它估计代价会让搜索绕开宽阔的直通走廊。
+ */
+Point2D crossingPoint(const Point2D& a, const Point2D& b, const Point2D& from, const Point2D& to) {
+    const double ca = cross(from, to, a);
+    const double cb = cross(from, to, b);
+    if ((ca <= 0.0 && cb >= 0.0) || (ca >= 0.0 && cb <= 0.0)) {
+        const double t = ca == cb ? 0.5 : ca / (ca - cb);
+        return Point2D(static_cast<float>(a.x() + (b.x() - a.x()) * t),
+                       static_cast<float>(a.y() + (b.y() - a.y()) * t));
+    }
+    const double viaA = bg::distance(from, a) + bg::distance(a, to);
+    const double viaB = bg::distance(from, b) + bg::distance(b, to);
+    return viaA <= viaB ? a : b;
+}
+
+/**
+ * @brief 顶点坐标的哈希键
+ */
+uint64_t pointKey(const Point2D& point) {
+    return (static_cast<uint64_t>(std::bit_cast<uint32_t>(point.x())) << 32) |
+           std::bit_cast<uint32_t>(point.y());
+}
+
+/**
+ * @brief 查找严格位于边 ab 内部（不含端点）的一个顶点
+ * @return 顶点编号，没有时返回 -1
+ */
+int64_t findVertexOnEdge(const RTree& index, const std::vector<Point2D>& vertices, uint32_t a,
+                         uint32_t b) {
+    const Point2D& pa = vertices[a];
+    const Point2D& pb = vertices[b];
+    Box box(pa, pa);
+    bg::expand(box, pb);
+    const double dx = static_cast<double>(pb.x()) - pa.x();
+    const double dy = static_cast<double>(pb.y()) - pa.y();
+    const double length2 = dx * dx + dy * dy;
+    for (auto it = index.qbegin(bgi::intersects(box)); it != index.qend(); ++it) {
+        const Point2D& p = vertices[it->second];
+        if (it->second == a || it->second == b || samePoint(p, pa) || samePoint(p, pb)) {
+            continue;
+        }
+        // 到直线的距离相对边长可忽略，且投影落在两端点之间
+        const double offset = cross(pa, pb, p);
+        const double along = (static_cast<double>(p.x()) - pa.x()) * dx +
+                             (static_cast<double>(p.y()) - pa.y()) * dy;
+        if (offset * offset <= length2 * length2 * 1e-18 && along > 0.0 && along < length2) {
+            return static_cast<int64_t>(it->second);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief d 是否严格位于逆时针三角形 abc 的外接圆内（留有相对容差，共圆时不翻转）
+ */
+bool inCircumcircle(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+    const double adx = static_cast<double>(a.x()) - d.x();
+    const double ady = static_cast<double>(a.y()) - d.y();
+    const double bdx = static_cast<double>(b.x()) - d.x();
+    const double bdy = static_cast<double>(b.y()) - d.y();
+    const double cdx = static_cast<double>(c.x()) - d.x();
+    const double cdy = static_cast<double>(c.y()) - d.y();
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+    const double det = alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy) +
+                       clift * (adx * bdy - bdx * ady);
+    const double scale = alift * (std::abs(bdx * cdy) + std::abs(cdx * bdy)) +
+                         blift * (std::abs(cdx * ady) + std::abs(adx * cdy)) +
+                         clift * (std::abs(adx * bdy) + std::abs(bdx * ady));
+    return det > scale * 1e-12;
+}
+
+/**
+ * @brief 两两合并多边形（分治，避免一个不断变大的结果反复参与合并）
+ */
+MultiPolygon unionAll(std::vector<MultiPolygon> parts) {
+    while (parts.size() > 1) {
+        std::vector<MultiPolygon> merged((parts.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < parts.size(); i += 2) {
+            bg::union_(parts[i], parts[i + 1], merged[i / 2]);
+        }
+        if (parts.size() % 2 == 1) {
+            merged.back() = std::move(parts.back());
+        }
+        parts.swap(merged);
+    }
+    return parts.empty() ? MultiPolygon() : std::move(parts.front());
+}
+
+size_t findRoot(std::vector<size_t>& parents, size_t node) {
+    while (parents[node] != node) {
+        parents[node] = parents[parents[node]];
+        node = parents[node];
+    }
+    return node;
+}
+
+}  // namespace
+
+NavMesh::NavMesh() = default;
+
+bool NavMesh::build(const Box& bounds, const ObstacleLayer& obstacles,
+                    const NavMeshOptions& options) {
+    auto startTime = std::chrono::steady_clock::now();
+    clear();
+
+    MultiPolygon walkable;
+    try {
+        // 按单位半径外扩障碍物，外扩后的多边形另建一层索引
+        const ObstacleLayer* layer = &obstacles;
+        ObstacleLayer inflated;
+        if (options.agentRadius > 0.0f) {
+            std::vector<Polygon> buffered;
+            for (const Polygon& obstacle : obstacles.getObstacles()) {
+                for (Polygon& part : GeometryUtils::bufferPolygon(obstacle, options.agentRadius)) {
+                    buffered.push_back(std::move(part));
+                }
+            }
+            inflated.build(std::move(buffered));
+            layer = &inflated;
+        }
+
+        // 用 R 树找出边界框相交的障碍物簇，只在簇内合并
+        const size_t count = layer->size();
+        std::vector<size_t> parents(count);
+        std::iota(parents.begin(), parents.end(), size_t{0});
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t other : layer->queryBox(layer->getObstacleBounds(i))) {
+                parents[findRoot(parents, other)] = findRoot(parents, i);
+            }
+        }
+        std::unordered_map<size_t, std::vector<MultiPolygon>> clusters;
+        for (size_t i = 0; i < count; ++i) {
+            clusters[findRoot(parents, i)].push_back(MultiPolygon{layer->getObstacle(i)});
+        }
+        MultiPolygon blocked;
+        for (auto& [root, parts] : clusters) {
+            for (Polygon& polygon : unionAll(std::move(parts))) {
+                blocked.push_back(std::move(polygon));
+            }
+        }
+
+        Polygon boundary;
+        bg::convert(bounds, boundary);
+        bg::difference(boundary, blocked, walkable);
+    } catch (const std::exception& e) {
+        Logger::error("Error building navigation mesh: {}", e.what());
+        return false;
+    }
+
+    for (const Polygon& polygon : walkable) {
+        triangulate(polygon);
+    }
+    linkNeighbors();
+    m_lastStats.polygons = static_cast<int>(walkable.size());
+    m_lastStats.vertices = static_cast<int>(m_vertices.size());
+    m_lastStats.triangles = static_cast<int>(m_triangles.size());
+    m_lastStats.flips = options.delaunay ? makeDelaunay() : 0;
+
+    std::vector<RTreeValue> boxes;
+    boxes.reserve(m_triangles.size());
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        Box box(m_vertices[m_triangles[i].vertices[0]], m_vertices[m_triangles[i].vertices[0]]);
+        bg::expand(box, m_vertices[m_triangles[i].vertices[1]]);
+        bg::expand(box, m_vertices[m_triangles[i].vertices[2]]);
+        boxes.emplace_back(box, i);
+    }
+    m_index = RTree(boxes.begin(), boxes.end());
+
+    auto endTime = std::chrono::steady_clock::now();
+    m_lastStats.buildTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    Logger::info("Navigation mesh built: {} polygons, {} triangles, {} flips in {:.2f}ms",
+                 m_lastStats.polygons, m_lastStats.triangles, m_lastStats.flips,
+                 m_lastStats.buildTime);
+    return true;
+}
+
+void NavMesh::triangulate(const Polygon& polygon) {
+    // Boost.Geometry 的环是闭合的，去掉重复的终点
+    std::vector<double> coords;
+    std::vector<size_t> ringStarts;
+    std::vector<Point2D> points;
+    const auto appendRing = [&](const Polygon::ring_type& ring) {
+        ringStarts.push_back(coords.size() / 2);
+        for (size_t i = 0; i + 1 < ring.size(); ++i) {
+            coords.push_back(ring[i].x());
+            coords.push_back(ring[i].y());
+            points.push_back(ring[i]);
+        }
+    };
+    appendRing(polygon.outer());
+    for (const auto& ring : polygon.inners()) {
+        appendRing(ring);
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    EarClipper clipper;
+    clipper.triangulate(coords, ringStarts, 0, triangles);
+
+    // 坐标相同的顶点（环在障碍物相接处自相接触）合并成一个，共享边才能按编号配对
+    std::unordered_map<uint64_t, uint32_t> welded;
+    std::vector<uint32_t> remap(points.size());
+    std::vector<RTreeValue> boxes;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto [it, inserted] =
+            welded.emplace(pointKey(points[i]), static_cast<uint32_t>(m_vertices.size()));
+        if (inserted) {
+            boxes.emplace_back(Box(points[i], points[i]), m_vertices.size());
+            m_vertices.push_back(points[i]);
+        }
+        remap[i] = it->second;
+    }
+    const RTree vertexIndex(boxes.begin(), boxes.end());
+
+    // 共线的顶点会让耳切法产生面积为 0 的三角形，去掉它们后相邻三角形的边在这些顶点处
+    // 错开（T 形连接），因此把边上夹着顶点的三角形在这些顶点处拆开
+    std::vector<std::array<uint32_t, 3>> pending;
+    for (const auto& local : triangles) {
+        const std::array<uint32_t, 3> vertices = {remap[local[0]], remap[local[1]],
+                                                  remap[local[2]]};
+        if (cross(m_vertices[vertices[0]], m_vertices[vertices[1]], m_vertices[vertices[2]]) <=
+            0.0) {
+            continue;  // 退化的三角形（共线）不参与导航
+        }
+        pending.push_back(vertices);
+        while (!pending.empty()) {
+            const std::array<uint32_t, 3> triangle = pending.back();
+            pending.pop_back();
+            bool split = false;
+            for (int i = 0; i < 3 && !split; ++i) {
+                const uint32_t a = triangle[i];
+                const uint32_t b = triangle[(i + 1) % 3];
+                const uint32_t c = triangle[(i + 2) % 3];
+                const int64_t v = findVertexOnEdge(vertexIndex, m_vertices, a, b);
+                if (v >= 0) {
+                    pending.push_back({a, static_cast<uint32_t>(v), c});
+                    pending.push_back({static_cast<uint32_t>(v), b, c});
+                    split = true;
+                }
+            }
+            if (!split) {
+                m_triangles.push_back({triangle, {-1, -1, -1}});
+            }
+        }
+    }
+}
+
+void NavMesh::linkNeighbors() {
+    // 相邻三角形以相反方向经过共享边
+    std::unordered_map<uint64_t, uint32_t> edges;
+    edges.reserve(m_triangles.size() * 3);
+    const auto key = [](uint32_t from, uint32_t to) {
+        return (static_cast<uint64_t>(from) << 32) | to;
+    };
+    for (uint32_t t = 0; t < m_triangles.size(); ++t) {
+        const auto& v = m_triangles[t].vertices;
+        for (int i = 0; i < 3; ++i) {
+            edges.emplace(key(v[i], v[(i + 1) % 3]), t * 3 + i);
+        }
+    }
+    for (uint32_t t = 0; t < m_triangles.size(); ++t) {
+        const auto& v = m_triangles[t].vertices;
+        for (int i = 0; i < 3; ++i) {
+            const auto it = edges.find(key(v[(i + 1) % 3], v[i]));
+            if (it != edges.end()) {
+                m_triangles[t].neighbors[i] = static_cast<int32_t>(it->second / 3);
+            }
+        }
+    }
+}
+
+int NavMesh::makeDelaunay() {
+    std::vector<int32_t> stack(m_triangles.size());
+    std::iota(stack.begin(), stack.end(), 0);
+    std::vector<char> queued(m_triangles.size(), 1);
+
+    // 共圆点的容差保证终止，上限只防御浮点异常
+    const int maxFlips = static_cast<int>(m_triangles.size()) * 16;
+    int flips = 0;
+    while (!stack.empty() && flips < maxFlips) {
+        const int32_t t = stack.back();
+        stack.pop_back();
+        queued[t] = 0;
+        for (int edge = 0; edge < 3; ++edge) {
+            const int32_t u = m_triangles[t].neighbors[edge];
+            if (u >= 0 && flipIfIllegal(t, edge)) {
+                ++flips;
+                for (int32_t changed : {t, u}) {
+                    if (!queued[changed]) {
+                        queued[changed] = 1;
+                        stack.push_back(changed);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return flips;
+}
+
+bool NavMesh::flipIfIllegal(int32_t t, int edge) {
+    Triangle& first = m_triangles[t];
+    const int32_t u = first.neighbors[edge];
+    Triangle& second = m_triangles[u];
+    const uint32_t a = first.vertices[edge];
+    const uint32_t b = first.vertices[(edge + 1) % 3];
+    const uint32_t c = first.vertices[(edge + 2) % 3];
+    int j = 0;
+    while (j < 3 && !(second.vertices[j] == b && second.vertices[(j + 1) % 3] == a)) {
+        ++j;
+    }
+    if (j == 3) {
+        return false;
+    }
+    const uint32_t d = second.vertices[(j + 2) % 3];
+    const Point2D& pa = m_vertices[a];
+    const Point2D& pb = m_vertices[b];
+    const Point2D& pc = m_vertices[c];
+    const Point2D& pd = m_vertices[d];
+    // 翻转后的两个三角形都必须是非退化的逆时针三角形（四边形为凸）
+    if (d == c || !inCircumcircle(pa, pb, pc, pd) || cross(pc, pa, pd) <= 0.0 ||
+        cross(pd, pb, pc) <= 0.0) {
+        return false;
+    }
+
+    const int32_t ca = first.neighbors[(edge + 2) % 3];
+    const int32_t bc = first.neighbors[(edge + 1) % 3];
+    const int32_t ad = second.neighbors[(j + 1) % 3];
+    const int32_t db = second.neighbors[(j + 2) % 3];
+    first = {{c, a, d}, {ca, ad, u}};
+    second = {{d, b, c}, {db, bc, t}};
+    if (ad >= 0) {
+        setNeighbor(ad, a, d, t);
+    }
+    if (bc >= 0) {
+        setNeighbor(bc, b, c, u);
+    }
+    return true;
+}
+
+void NavMesh::setNeighbor(int32_t triangle, uint32_t a, uint32_t b, int32_t neighbor) {
+    Triangle& target = m_triangles[triangle];
+    for (int i = 0; i < 3; ++i) {
+        const uint32_t from = target.vertices[i];
+        const uint32_t to = target.vertices[(i + 1) % 3];
+        if ((from == a && to == b) || (from == b && to == a)) {
+            target.neighbors[i] = neighbor;
+            return;
+        }
+    }
+}
+
+void NavMesh::clear() {
+    m_vertices.clear();
+    m_triangles.clear();
+    m_index.clear();
+    m_lastStats = NavMeshStats();
+}
+
+bool NavMesh::isBuilt() const {
+    return !m_triangles.empty();
+}
+
+const std::vector<Point2D>& NavMesh::getVertices() const {
+    return m_vertices;
+}
+
+const std::vector<NavMesh::Triangle>& NavMesh::getTriangles() const {
+    return m_triangles;
+}
+
+NavMeshStats NavMesh::getLastBuildStats() const {
+    return m_lastStats;
+}
+
+int NavMesh::findTriangle(const Point2D& point) const {
+    for (auto it = m_index.qbegin(bgi::intersects(point)); it != m_index.qend(); ++it) {
+        const auto& v = m_triangles[it->second].vertices;
+        const Point2D& a = m_vertices[v[0]];
+        const Point2D& b = m_vertices[v[1]];
+        const Point2D& c = m_vertices[v[2]];
+        // 边界上的点（有向面积为 0）也算在三角形内
+        if (cross(a, b, point) >= 0.0 && cross(b, c, point) >= 0.0 &&
+            cross(c, a, point) >= 0.0) {
+            return static_cast<int>(it->second);
+        }
+    }
+    return -1;
+}
+
+std::vector<Point2D> NavMesh::findPath(const Point2D& start, const Point2D& goal) const {
+    std::vector<Point2D> path;
+    PathfindingStats stats;
+    findPath(start, goal, path, stats);
+    return path;
+}
+
+bool NavMesh::findPath(const Point2D& start, const Point2D& goal, std::vector<Point2D>& path,
+                       PathfindingStats& stats) const {
+    path.clear();
+    stats = PathfindingStats();
+    auto startTime = std::chrono::steady_clock::now();
+
+    const int startTriangle = findTriangle(start);
+    const int goalTriangle = findTriangle(goal);
+    if (startTriangle < 0 || goalTriangle < 0) {
+        Logger::error("Start or goal position is outside the navigation mesh");
+        return false;
+    }
+
+    std::vector<int32_t> corridor;
+    stats.nodesExplored = searchCorridor(startTriangle, goalTriangle, start, goal, corridor);
+    if (!corridor.empty()) {
+        stringPull(start, goal, corridor, path);
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    stats.pathFound = !path.empty();
+    stats.pathLength = static_cast<int>(path.size());
+    stats.executionTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    if (!stats.pathFound) {
+        Logger::warning("No path found after {} triangles", stats.nodesExplored);
+    }
+    return stats.pathFound;
+}
+
+int NavMesh::searchCorridor(int32_t startTriangle, int32_t goalTriangle, const Point2D& start,
+                            const Point2D& goal, std::vector<int32_t>& corridor) const {
+    // 三角形的位置取进入边上的穿越点（起点三角形取起点），代价为位置间的直线距离
+    const size_t count = m_triangles.size();
+    std::vector<double> gCost(count, std::numeric_limits<double>::infinity());
+    std::vector<int32_t> parents(count, -1);
+    std::vector<Point2D> positions(count);
+    std::vector<char> closed(count, 0);
+    using Entry = std::pair<double, int32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> openSet;
+
+    gCost[startTriangle] = 0.0;
+    positions[startTriangle] = start;
+    openSet.emplace(bg::distance(start, goal), startTriangle);
+
+    int expanded = 0;
+    while (!openSet.empty()) {
+        const int32_t current = openSet.top().second;
+        openSet.pop();
+        if (closed[current]) {
+            continue;
+        }
+        closed[current] = 1;
+        ++expanded;
+
+        if (current == goalTriangle) {
+            for (int32_t t = current; t >= 0; t = parents[t]) {
+                corridor.push_back(t);
+            }
+            std::reverse(corridor.begin(), corridor.end());
+            return expanded;
+        }
+
+        const Triangle& triangle = m_triangles[current];
+        for (int i = 0; i < 3; ++i) {
+            const int32_t neighbor = triangle.neighbors[i];
+            if (neighbor < 0 || closed[neighbor]) {
+                continue;
+            }
+            const Point2D& a = m_vertices[triangle.vertices[i]];
+            const Point2D& b = m_vertices[triangle.vertices[(i + 1) % 3]];
+            const Point2D entry = crossingPoint(a, b, positions[current], goal);
+            const double tentativeGCost = gCost[current] + bg::distance(positions[current], entry);
+            if (tentativeGCost >= gCost[neighbor]) {
+                continue;
+            }
+            gCost[neighbor] = tentativeGCost;
+            parents[neighbor] = current;
+            positions[neighbor] = entry;
+            openSet.emplace(tentativeGCost + bg::distance(entry, goal), neighbor);
+        }
+    }
+    return expanded;
+}
+
+void NavMesh::stringPull(const Point2D& start, const Point2D& goal,
+                         const std::vector<int32_t>& corridor, std::vector<Point2D>& path) const {
+    // 门户按前进方向区分左右：离开逆时针三角形的边 (a, b) 时，b 在左、a 在右
+    std::vector<std::pair<Point2D, Point2D>> portals;
+    portals.reserve(corridor.size() + 1);
+    portals.emplace_back(start, start);
+    for (size_t i = 0; i + 1 < corridor.size(); ++i) {
+        const Triangle& triangle = m_triangles[corridor[i]];
+        for (int j = 0; j < 3; ++j) {
+            if (triangle.neighbors[j] == corridor[i + 1]) {
+                portals.emplace_back(m_vertices[triangle.vertices[(j + 1) % 3]],
+                                     m_vertices[triangle.vertices[j]]);
+                break;
+            }
+        }
+    }
+    portals.emplace_back(goal, goal);
+
+    Point2D apex = start;
+    Point2D left = start;
+    Point2D right = start;
+    size_t leftIndex = 0;
+    size_t rightIndex = 0;
+    path.push_back(start);
+    for (size_t i = 1; i < portals.size(); ++i) {
+        const Point2D& portalLeft = portals[i].first;
+        const Point2D& portalRight = portals[i].second;
+
+        // 右边界向内收紧；越过左边界时左端点成为新的转折点
+        if (cross(apex, right, portalRight) >= 0.0) {
+            if (samePoint(apex, right) || cross(apex, left, portalRight) < 0.0) {
+                right = portalRight;
+                rightIndex = i;
+            } else {
+                apex = left;
+                if (!samePoint(path.back(), apex)) {
+                    path.push_back(apex);
+                }
+                right = apex;
+                rightIndex = leftIndex;
+                i = leftIndex;  // 从新转折点之后的门户重新收紧漏斗
+                continue;
+            }
+        }
+
+        // 左边界向内收紧；越过右边界时右端点成为新的转折点
+        if (cross(apex, left, portalLeft) <= 0.0) {
+            if (samePoint(apex, left) || cross(apex, right, portalLeft) > 0.0) {
+                left = portalLeft;
+                leftIndex = i;
+            } else {
+                apex = right;
+                if (!samePoint(path.back(), apex)) {
+                    path.push_back(apex);
+                }
+                left = apex;
+                leftIndex = rightIndex;
+                i = rightIndex;
+                continue;
+            }
+        }
+    }
+    if (!samePoint(path.back(), goal)) {
+        path.push_back(goal);
+    }
+}
+
+}  // namespace oneday::pathfinding
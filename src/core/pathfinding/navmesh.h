@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "geometry_utils.h"
+#include "obstacle_layer.h"
+#include "pathfinding_algorithm.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 导航网格构建选项
+ */
+struct NavMeshOptions {
+    float agentRadius = 0.0f; ///< 障碍物外扩距离（单位半径，0 为不外扩）
+    bool delaunay = true;     ///< 是否翻转内部边，使三角剖分满足约束 Delaunay 条件
+};
+
+/**
+ * @brief 导航网格构建统计信息
+ */
+struct NavMeshStats {
+    int polygons = 0;          ///< 可行走区域的多边形数（互不连通的区域）
+    int vertices = 0;          ///< 顶点数
+    int triangles = 0;         ///< 三角形数
+    int flips = 0;             ///< Delaunay 边翻转次数
+    double buildTime = 0.0;    ///< 构建时间（毫秒）
+};
+
+/**
+ * @brief 可行走空间的三角形导航网格
+ *
+ * 构建时从边界矩形中减去障碍物（按 R 树找出的重叠簇分别合并）得到可行走区域，
+ * 用耳切法（带洞多边形先通过桥接边连成单环）三角剖分，再对内部边做 Lawson 翻转，
+ * 得到以障碍物边界为约束边的约束 Delaunay 三角剖分。三角形的边界框装入 R 树用于定位。
+ *
+ * 查询时在三角形邻接图上做 A*（节点位置取进入边上朝向终点的穿越点），再用漏斗算法把三角形走廊
+ * 拉直成最短折线，转折点都在障碍物顶点上。
+ */
+class NavMesh {
+  public:
+    /**
+     * @brief 三角形
+     */
+    struct Triangle {
+        std::array<uint32_t, 3> vertices; ///< 逆时针排列的顶点编号
+        std::array<int32_t, 3> neighbors; ///< 边 (v[i], v[i + 1]) 对面的三角形（-1 为边界）
+    };
+
+    /**
+     * @brief 构造空的导航网格
+     */
+    NavMesh();
+
+    /**
+     * @brief 构建导航网格
+     * @param bounds 世界边界
+     * @param obstacles 障碍物
+     * @param options 构建选项
+     * @return 是否构建成功（几何运算失败时返回 false 并清空网格）
+     */
+    bool build(const Box& bounds, const ObstacleLayer& obstacles,
+               const NavMeshOptions& options = NavMeshOptions());
+
+    /**
+     * @brief 清空网格
+     */
+    void clear();
+
+    /**
+     * @brief 是否已构建（且至少有一个三角形）
+     */
+    bool isBuilt() const;
+
+    /**
+     * @brief 获取顶点
+     */
+    const std::vector<Point2D>& getVertices() const;
+
+    /**
+     * @brief 获取三角形
+     */
+    const std::vector<Triangle>& getTriangles() const;
+
+    /**
+     * @brief 获取上次构建的统计信息
+     */
+    NavMeshStats getLastBuildStats() const;
+
+    /**
+     * @brief 查找包含点的三角形
+     * @param point 点
+     * @return 三角形编号（边界上的点返回任一相邻三角形），不在可行走区域内返回 -1
+     */
+    int findTriangle(const Point2D& point) const;
+
+    /**
+     * @brief 查找从起点到终点的路径
+     * @param start 起点
+     * @param goal 终点
+     * @return 转折点列表（含起点和终点），如果没有找到路径则返回空列表
+     */
+    std::vector<Point2D> findPath(const Point2D& start, const Point2D& goal) const;
+
+    /**
+     * @brief 查找路径并写入调用方提供的缓冲区
+     * @param start 起点
+     * @param goal 终点
+     * @param path 输出转折点（未找到路径时清空）
+     * @param stats 输出统计信息（nodesExplored 为扩展的三角形数，pathLength 为转折点数）
+     * @return 是否找到路径
+     */
+    bool findPath(const Point2D& start, const Point2D& goal, std::vector<Point2D>& path,
+                  PathfindingStats& stats) const;
+
+  private:
+    /**
+     * @brief 三角剖分一个带洞多边形，追加顶点和三角形
+     */
+    void triangulate(const Polygon& polygon);
+
+    /**
+     * @brief 根据共享边建立三角形的邻接关系
+     */
+    void linkNeighbors();
+
+    /**
+     * @brief 翻转不满足 Delaunay 条件的内部边
+     * @return 翻转次数
+     */
+    int makeDelaunay();
+
+    /**
+     * @brief 如果内部边不满足 Delaunay 条件则翻转
+     * @param triangle 三角形编号
+     * @param edge 边序号
+     * @return 是否翻转
+     */
+    bool flipIfIllegal(int32_t triangle, int edge);
+
+    /**
+     * @brief 把三角形中 (a, b) 边的邻居改为 neighbor
+     */
+    void setNeighbor(int32_t triangle, uint32_t a, uint32_t b, int32_t neighbor);
+
+    /**
+     * @brief 在三角形邻接图上搜索走廊
+     * @return 扩展的三角形数
+     */
+    int searchCorridor(int32_t startTriangle, int32_t goalTriangle, const Point2D& start,
+                       const Point2D& goal, std::vector<int32_t>& corridor) const;
+
+    /**
+     * @brief 用漏斗算法把走廊拉直成折线
+     */
+    void stringPull(const Point2D& start, const Point2D& goal,
+                    const std::vector<int32_t>& corridor, std::vector<Point2D>& path) const;
+
+  private:
+    std::vector<Point2D> m_vertices;   ///< 顶点
+    std::vector<Triangle> m_triangles; ///< 三角形
+    RTree m_index;                     ///< 三角形边界框的 R 树
+    NavMeshStats m_lastStats;          ///< 上次构建的统计信息
+};
+
+}  // namespace oneday::pathfinding
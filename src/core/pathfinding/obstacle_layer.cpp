@@ -0,0 +1,163 @@
+#include "obstacle_layer.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "../common/logger.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+ObstacleLayer::ObstacleLayer() = default;
+
+ObstacleLayer::ObstacleLayer(std::vector<Polygon> obstacles) {
+    build(std::move(obstacles));
+}
+
+void ObstacleLayer::build(std::vector<Polygon> obstacles) {
+    m_obstacles = std::move(obstacles);
+    m_bounds.clear();
+    m_bounds.reserve(m_obstacles.size());
+
+    std::vector<RTreeValue> values;
+    values.reserve(m_obstacles.size());
+    for (size_t i = 0; i < m_obstacles.size(); ++i) {
+        bg::correct(m_obstacles[i]);
+        m_bounds.push_back(GeometryUtils::getBoundingBox(m_obstacles[i]));
+        values.emplace_back(m_bounds.back(), i);
+    }
+
+    // 迭代器构造函数使用打包算法，比逐个插入快且树更平衡
+    m_index = RTree(values.begin(), values.end());
+    ONEDAY_LOG_DEBUG("Obstacle layer built with {} obstacles", m_obstacles.size());
+}
+
+size_t ObstacleLayer::insert(Polygon obstacle) {
+    bg::correct(obstacle);
+    const size_t index = m_obstacles.size();
+    m_obstacles.push_back(std::move(obstacle));
+    m_bounds.push_back(GeometryUtils::getBoundingBox(m_obstacles.back()));
+    m_index.insert(RTreeValue(m_bounds.back(), index));
+    return index;
+}
+
+void ObstacleLayer::clear() {
+    m_obstacles.clear();
+    m_bounds.clear();
+    m_index.clear();
+}
+
+size_t ObstacleLayer::size() const {
+    return m_obstacles.size();
+}
+
+bool ObstacleLayer::empty() const {
+    return m_obstacles.empty();
+}
+
+const Polygon& ObstacleLayer::getObstacle(size_t index) const {
+    return m_obstacles[index];
+}
+
+const std::vector<Polygon>& ObstacleLayer::getObstacles() const {
+    return m_obstacles;
+}
+
+const Box& ObstacleLayer::getObstacleBounds(size_t index) const {
+    return m_bounds[index];
+}
+
+bool ObstacleLayer::containsPoint(const Point2D& point) const {
+    try {
+        for (auto it = m_index.qbegin(bgi::intersects(point)); it != m_index.qend(); ++it) {
+            if (bg::within(point, m_obstacles[it->second])) {
+                return true;
+            }
+        }
+        return false;
+    } catch (const std::exception& e) {
+        Logger::error("Error in containsPoint: {}", e.what());
+        return false;
+    }
+}
+
+bool ObstacleLayer::intersectsSegment(const Point2D& start, const Point2D& end) const {
+    if (bg::equals(start, end)) {
+        return containsPoint(start);
+    }
+    try {
+        LineString line;
+        bg::append(line, start);
+        bg::append(line, end);
+        const bg::model::segment<Point2D> segment(start, end);
+        for (auto it = m_index.qbegin(bgi::intersects(segment)); it != m_index.qend(); ++it) {
+            const Polygon& obstacle = m_obstacles[it->second];
+            if (bg::intersects(line, obstacle) && !bg::touches(line, obstacle)) {
+                return true;
+            }
+        }
+        return false;
+    } catch (const std::exception& e) {
+        Logger::error("Error in intersectsSegment: {}", e.what());
+        return true; // 安全起见，假设相交
+    }
+}
+
+std::vector<size_t> ObstacleLayer::queryBox(const Box& box) const {
+    std::vector<size_t> result;
+    try {
+        for (auto it = m_index.qbegin(bgi::intersects(box)); it != m_index.qend(); ++it) {
+            if (bg::intersects(box, m_obstacles[it->second])) {
+                result.push_back(it->second);
+            }
+        }
+    } catch (const std::exception& e) {
+        Logger::error("Error in queryBox: {}", e.what());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<Polygon> ObstacleLayer::extractObstacles(const Map& map) {
+    std::vector<Polygon> rectangles;
+    const auto emit = [&rectangles](int x0, int x1, int y0, int y1) {
+        rectangles.push_back(GeometryUtils::createRectangle(
+            static_cast<float>(x0), static_cast<float>(y0), static_cast<float>(x1 - x0),
+            static_cast<float>(y1 - y0)));
+    };
+
+    // 键为段的 [x0, x1)，值为矩形的起始行
+    std::map<std::pair<int, int>, int> open;
+    std::map<std::pair<int, int>, int> next;
+    for (int y = 0; y < map.getHeight(); ++y) {
+        next.clear();
+        int x = 0;
+        while (x < map.getWidth()) {
+            if (map.isWalkableUnchecked(x, y)) {
+                ++x;
+                continue;
+            }
+            const int runStart = x;
+            while (x < map.getWidth() && !map.isWalkableUnchecked(x, y)) {
+                ++x;
+            }
+            const std::pair<int, int> run(runStart, x);
+            const auto it = open.find(run);
+            next.emplace(run, it == open.end() ? y : it->second);
+        }
+        for (const auto& [run, top] : open) {
+            if (next.find(run) == next.end()) {
+                emit(run.first, run.second, top, y);
+            }
+        }
+        open.swap(next);
+    }
+    for (const auto& [run, top] : open) {
+        emit(run.first, run.second, top, map.getHeight());
+    }
+    return rectangles;
+}
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+
+#include "geometry_utils.h"
+#include "map.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 多边形障碍物的空间索引
+ *
+ * 把障碍物的边界框装入 R 树（build 用打包算法批量装载，insert 逐个插入），
+ * 点、线段和矩形查询先在 R 树上找出边界框相交的候选，再对候选做精确的多边形测试，
+ * 查询代价与障碍物总数成对数关系，而不是像 GeometryUtils 那样逐个多边形测试。
+ */
+class ObstacleLayer {
+  public:
+    /**
+     * @brief 构造空的障碍物层
+     */
+    ObstacleLayer();
+
+    /**
+     * @brief 批量装载障碍物
+     * @param obstacles 障碍物多边形
+     */
+    explicit ObstacleLayer(std::vector<Polygon> obstacles);
+
+    /**
+     * @brief 替换全部障碍物并重新批量装载 R 树
+     * @param obstacles 障碍物多边形（会被修正为 Boost.Geometry 要求的环方向）
+     */
+    void build(std::vector<Polygon> obstacles);
+
+    /**
+     * @brief 插入一个障碍物
+     * @param obstacle 障碍物多边形
+     * @return 障碍物编号
+     */
+    size_t insert(Polygon obstacle);
+
+    /**
+     * @brief 清空所有障碍物
+     */
+    void clear();
+
+    /**
+     * @brief 获取障碍物数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 是否没有障碍物
+     */
+    bool empty() const;
+
+    /**
+     * @brief 获取障碍物
+     * @param index 障碍物编号
+     */
+    const Polygon& getObstacle(size_t index) const;
+
+    /**
+     * @brief 获取所有障碍物（下标即编号）
+     */
+    const std::vector<Polygon>& getObstacles() const;
+
+    /**
+     * @brief 获取障碍物的边界框
+     * @param index 障碍物编号
+     */
+    const Box& getObstacleBounds(size_t index) const;
+
+    /**
+     * @brief 检查点是否在某个障碍物内部（边界上不算）
+     * @param point 待检查的点
+     * @return true 如果点在障碍物内部
+     */
+    bool containsPoint(const Point2D& point) const;
+
+    /**
+     * @brief 检查线段是否穿过障碍物内部
+     * @param start 线段起点
+     * @param end 线段终点
+     * @return true 如果线段穿过某个障碍物内部（只沿边界擦过或碰到顶点不算）
+     *
+     * 与 GeometryUtils::lineIntersectsPolygon 不同，贴着障碍物边界的线段不算相交，
+     * 因此导航网格在障碍物顶点处转弯的路径可以直接用它验证。
+     */
+    bool intersectsSegment(const Point2D& start, const Point2D& end) const;
+
+    /**
+     * @brief 查询与矩形相交的障碍物
+     * @param box 查询矩形
+     * @return 与矩形相交（含接触）的障碍物编号，按编号升序
+     */
+    std::vector<size_t> queryBox(const Box& box) const;
+
+    /**
+     * @brief 把网格地图的障碍物单元格合并成矩形多边形
+     * @param map 地图
+     * @return 矩形列表，单元格 (x, y) 覆盖 [x, x + 1] x [y, y + 1]
+     *
+     * 每行的连续障碍物合并成一段，上下相邻且端点相同的段再合并成一个矩形。
+     */
+    static std::vector<Polygon> extractObstacles(const Map& map);
+
+  private:
+    std::vector<Polygon> m_obstacles; ///< 障碍物多边形
+    std::vector<Box> m_bounds;        ///< 障碍物的边界框
+    RTree m_index;                    ///< 边界框的 R 树
+};
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,39 @@
+#include "pathfinding_algorithm.h"
+
+#include "../common/logger.h"
+
+namespace oneday::pathfinding {
+
+std::vector<Point> PathfindingAlgorithm::smoothPath(const std::vector<Point>& path,
+                                                    const Map& map) {
+    if (path.size() <= 2) {
+        return path;
+    }
+
+    std::vector<Point> smoothedPath;
+    smoothedPath.push_back(path[0]);  // 添加起点
+
+    size_t current = 0;
+
+    while (current < path.size() - 1) {
+        size_t farthest = current + 1;
+
+        // 找到从当前点能直接到达的最远点
+        for (size_t i = current + 2; i < path.size(); ++i) {
+            if (map.hasLineOfSight(path[current], path[i])) {
+                farthest = i;
+            } else {
+                break;
+            }
+        }
+
+        smoothedPath.push_back(path[farthest]);
+        current = farthest;
+    }
+
+    ONEDAY_LOG_DEBUG("Path smoothed from {} to {} points", path.size(), smoothedPath.size());
+
+    return smoothedPath;
+}
+
+}  // namespace oneday::pathfinding
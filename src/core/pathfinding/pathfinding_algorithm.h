@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+
+#include "map.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 路径查找统计信息
+ */
+struct PathfindingStats {
+    int nodesExplored = 0;       ///< 探索的节点数
+    int pathLength = 0;          ///< 路径长度
+    double executionTime = 0.0;  ///< 执行时间（毫秒）
+    bool pathFound = false;      ///< 是否找到路径
+};
+
+/**
+ * @brief 路径查找算法接口
+ */
+class PathfindingAlgorithm {
+public:
+    virtual ~PathfindingAlgorithm() = default;
+
+    /**
+     * @brief 查找路径
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @return 路径点列表
+     */
+    virtual std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) = 0;
+
+    /**
+     * @brief 平滑路径
+     * @param path 原始路径
+     * @param map 地图
+     * @return 平滑后的路径
+     *
+     * 默认实现从每个保留点出发，跳到沿路径能直接看到（Map::hasLineOfSight）的最远点。
+     */
+    virtual std::vector<Point> smoothPath(const std::vector<Point>& path, const Map& map);
+
+    /**
+     * @brief 设置启发式权重
+     * @param weight 权重
+     */
+    virtual void setHeuristicWeight(double weight) = 0;
+
+    /**
+     * @brief 获取启发式权重
+     * @return 权重
+     */
+    virtual double getHeuristicWeight() const = 0;
+
+    /**
+     * @brief 获取上次路径查找统计信息
+     * @return 统计信息
+     */
+    virtual PathfindingStats getLastPathfindingStats() const = 0;
+};
+
+} // namespace oneday::pathfinding
@@ -1,11 +1,27 @@
 #include "pathplanner.h"
 #include "../common/logger.h"
+#include "../common/thread_pool.h"
 
 using oneday::core::Logger;
+using oneday::common::ThreadPool;
 #include "astar.h"
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
 namespace oneday::pathfinding {
 
+namespace {
+
+double elapsedMilliseconds(std::chrono::high_resolution_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() -
+                                                     since)
+        .count();
+}
+
+} // namespace
+
 PathPlanner::PathPlanner() 
     : m_algorithm(std::make_unique<AStar>())
 {
@@ -22,28 +38,45 @@ std::vector<Point> PathPlanner::findPath(const Point& start, const Point& goal,
         return std::vector<Point>();
     }
     
+    m_lastQueryOnNavMesh = false;
     auto startTime = std::chrono::high_resolution_clock::now();
     
-    std::vector<Point> path = m_algorithm->findPath(start, goal, map);
+    std::vector<Point> path = m_queryMode == QueryMode::FlowField
+                                  ? findPathOnFlowField(start, goal, map)
+                                  : m_algorithm->findPath(start, goal, map);
     
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
     
-    m_lastExecutionTime = duration.count() / 1000.0; // 转换为毫?    
+    m_lastExecutionTime = duration.count() / 1000.0; // 转换为毫秒
+    
     if (!path.empty()) {
-        Logger::info("Path found with " + std::to_string(path.size()) + " points in " + 
-                    std::to_string(m_lastExecutionTime) + " ms");
+        ONEDAY_LOG_DEBUG("Path found with {} points in {} ms", path.size(), m_lastExecutionTime);
         
         if (m_enableSmoothing) {
             path = smoothPath(path, map);
         }
     } else {
-        Logger::warning("No path found in " + std::to_string(m_lastExecutionTime) + " ms");
+        Logger::warning("No path found in {} ms", m_lastExecutionTime);
     }
     
     return path;
 }
 
+std::vector<Point2D> PathPlanner::findPath(const Point2D& start, const Point2D& goal,
+                                           const NavMesh& navMesh) {
+    m_lastQueryOnNavMesh = true;
+    std::vector<Point2D> path;
+    navMesh.findPath(start, goal, path, m_lastNavMeshStats);
+    m_lastExecutionTime = m_lastNavMeshStats.executionTime;
+    
+    if (!path.empty()) {
+        ONEDAY_LOG_DEBUG("Path found on navigation mesh with {} points in {} ms", path.size(),
+                         m_lastExecutionTime);
+    }
+    return path;
+}
+
 std::vector<Point> PathPlanner::findPathWithWaypoints(const std::vector<Point>& waypoints, const Map& map) {
     if (waypoints.size() < 2) {
         Logger::error("At least 2 waypoints required");
@@ -56,22 +89,174 @@ std::vector<Point> PathPlanner::findPathWithWaypoints(const std::vector<Point>&
         std::vector<Point> segment = findPath(waypoints[i], waypoints[i + 1], map);
         
         if (segment.empty()) {
-            Logger::error("Failed to find path between waypoints " + std::to_string(i) + 
-                         " and " + std::to_string(i + 1));
+            Logger::error("Failed to find path between waypoints {} and {}", i, i + 1);
             return std::vector<Point>();
         }
         
-        // 避免重复添加连接?        if (i > 0 && !fullPath.empty()) {
+        // 避免重复添加连接点
+        if (i > 0 && !fullPath.empty()) {
             segment.erase(segment.begin());
         }
         
         fullPath.insert(fullPath.end(), segment.begin(), segment.end());
     }
     
-    Logger::info("Multi-waypoint path found with " + std::to_string(fullPath.size()) + " total points");
+    Logger::info("Multi-waypoint path found with {} total points", fullPath.size());
     return fullPath;
 }
 
+BatchResult PathPlanner::findPaths(const std::vector<PathQuery>& queries, const Map& map,
+                                   const BatchOptions& options) {
+    const auto batchStart = std::chrono::high_resolution_clock::now();
+    BatchResult result;
+    result.paths.resize(queries.size());
+    result.stats.resize(queries.size());
+    if (queries.empty()) {
+        return result;
+    }
+
+    // 统计每个终点的查询数，查询多的终点共享该终点的流场
+    auto toIndex = [&map](const Point& point) {
+        return static_cast<uint32_t>(point.y * map.getWidth() + point.x);
+    };
+    std::unordered_map<uint32_t, size_t> fieldIndices;
+    std::vector<Point> sharedGoals;
+    if (options.sharedGoalThreshold > 0) {
+        std::unordered_map<uint32_t, size_t> goalCounts;
+        for (const PathQuery& query : queries) {
+            if (map.isWalkable(query.goal) &&
+                ++goalCounts[toIndex(query.goal)] == options.sharedGoalThreshold) {
+                fieldIndices.emplace(toIndex(query.goal), sharedGoals.size());
+                sharedGoals.push_back(query.goal);
+            }
+        }
+    }
+
+    // 流场取自缓存，上一批次之后地图的变化只需增量修复；批次中用到的流场都保留到批次结束
+    ThreadPool& pool = ThreadPool::instance();
+    std::vector<FlowField*> fields;
+    for (const Point& goal : sharedGoals) {
+        fields.push_back(&acquireFlowField(goal));
+        fields.back()->setParallel(options.parallel);
+    }
+    const auto fieldStart = std::chrono::high_resolution_clock::now();
+    auto syncField = [&](size_t index) { fields[index]->synchronize(map, sharedGoals[index]); };
+    if (options.parallel) {
+        pool.parallelFor(fields.size(), syncField);
+    } else {
+        for (size_t i = 0; i < fields.size(); ++i) {
+            syncField(i);
+        }
+    }
+    result.fieldTime = elapsedMilliseconds(fieldStart);
+
+    // 每个并行任务独占一个算法实例，从共享计数器领取查询，耗时不均时也能均衡
+    const size_t slotCount =
+        options.parallel ? std::min<size_t>(queries.size(), pool.getThreadCount() + 1) : 1;
+    while (m_batchAlgorithms.size() < slotCount) {
+        m_batchAlgorithms.push_back(m_batchFactory ? m_batchFactory() : std::make_unique<AStar>());
+        if (m_heuristicWeight) {
+            m_batchAlgorithms.back()->setHeuristicWeight(*m_heuristicWeight);
+        }
+    }
+
+    std::atomic<size_t> nextQuery{0};
+    std::atomic<int> sharedQueries{0};
+    auto runSlot = [&](size_t slot) {
+        PathfindingAlgorithm& algorithm = *m_batchAlgorithms[slot];
+        for (size_t i = nextQuery.fetch_add(1); i < queries.size(); i = nextQuery.fetch_add(1)) {
+            const PathQuery& query = queries[i];
+            std::vector<Point>& path = result.paths[i];
+            PathfindingStats& stats = result.stats[i];
+
+            auto field = map.isValidPosition(query.goal) ? fieldIndices.find(toIndex(query.goal))
+                                                         : fieldIndices.end();
+            if (field != fieldIndices.end() && map.isWalkable(query.start)) {
+                const auto queryStart = std::chrono::high_resolution_clock::now();
+                fields[field->second]->extractPath(query.start, path);
+                stats.executionTime = elapsedMilliseconds(queryStart);
+                stats.pathFound = !path.empty();
+                stats.pathLength = static_cast<int>(path.size());
+                sharedQueries.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                path = algorithm.findPath(query.start, query.goal, map);
+                stats = algorithm.getLastPathfindingStats();
+            }
+
+            if (!path.empty() && m_enableSmoothing) {
+                path = algorithm.smoothPath(path, map);
+            }
+        }
+    };
+    if (slotCount > 1) {
+        pool.parallelFor(slotCount, runSlot);
+    } else {
+        runSlot(0);
+    }
+
+    for (FlowField* field : fields) {
+        field->setParallel(true);
+    }
+    trimFlowFieldCache();
+
+    result.sharedFields = static_cast<int>(fields.size());
+    result.sharedQueries = sharedQueries.load();
+    for (const PathfindingStats& stats : result.stats) {
+        result.pathsFound += stats.pathFound ? 1 : 0;
+        result.totalSearchTime += stats.executionTime;
+    }
+    result.wallTime = elapsedMilliseconds(batchStart);
+    m_lastExecutionTime = result.wallTime;
+
+    Logger::info("Batch of {} queries: {} paths found, {} shared fields, {} ms wall time",
+                 queries.size(), result.pathsFound, result.sharedFields, result.wallTime);
+    return result;
+}
+
+std::vector<Point> PathPlanner::findPathOnFlowField(const Point& start, const Point& goal,
+                                                    const Map& map) {
+    m_lastFlowFieldStats = PathfindingStats();
+    if (!map.isValidPosition(start) || !map.isValidPosition(goal)) {
+        Logger::error("Invalid start or goal position");
+        return std::vector<Point>();
+    }
+
+    const auto startTime = std::chrono::high_resolution_clock::now();
+    FlowField& field = acquireFlowField(goal);
+    field.synchronize(map, goal);
+
+    std::vector<Point> path;
+    field.extractPath(start, path);
+    m_lastFlowFieldStats.nodesExplored = field.getLastStats().cellsUpdated;
+    m_lastFlowFieldStats.pathLength = static_cast<int>(path.size());
+    m_lastFlowFieldStats.pathFound = !path.empty();
+    m_lastFlowFieldStats.executionTime = elapsedMilliseconds(startTime);
+    trimFlowFieldCache();
+    return path;
+}
+
+FlowField& PathPlanner::acquireFlowField(const Point& goal) {
+    m_flowFieldUses++;
+    for (CachedFlowField& cached : m_flowFields) {
+        if (cached.field->isBuilt() && cached.field->getGoal() == goal) {
+            cached.lastUse = m_flowFieldUses;
+            return *cached.field;
+        }
+    }
+    m_flowFields.push_back(CachedFlowField{std::make_unique<FlowField>(), m_flowFieldUses});
+    return *m_flowFields.back().field;
+}
+
+void PathPlanner::trimFlowFieldCache() {
+    while (m_flowFields.size() > m_flowFieldCacheSize) {
+        auto oldest = std::min_element(m_flowFields.begin(), m_flowFields.end(),
+                                       [](const CachedFlowField& a, const CachedFlowField& b) {
+                                           return a.lastUse < b.lastUse;
+                                       });
+        m_flowFields.erase(oldest);
+    }
+}
+
 std::vector<Point> PathPlanner::smoothPath(const std::vector<Point>& path, const Map& map) {
     if (!m_algorithm) {
         return path;
@@ -85,18 +270,18 @@ bool PathPlanner::isPathValid(const std::vector<Point>& path, const Map& map) co
         return false;
     }
     
-    // 检查所有点是否可行?    for (const Point& point : path) {
+    // 检查所有点是否可行走
+    for (const Point& point : path) {
         if (!map.isWalkable(point)) {
-            Logger::warning("Path contains non-walkable point at (" + 
-                           std::to_string(point.x) + "," + std::to_string(point.y) + ")");
+            Logger::warning("Path contains non-walkable point at ({},{})", point.x, point.y);
             return false;
         }
     }
     
-    // 检查相邻点之间的连接是否有?    for (size_t i = 0; i < path.size() - 1; ++i) {
+    // 检查相邻点之间的连接是否有效
+    for (size_t i = 0; i < path.size() - 1; ++i) {
         if (!isConnectionValid(path[i], path[i + 1], map)) {
-            Logger::warning("Invalid connection between points " + std::to_string(i) + 
-                           " and " + std::to_string(i + 1));
+            Logger::warning("Invalid connection between points {} and {}", i, i + 1);
             return false;
         }
     }
@@ -105,11 +290,13 @@ bool PathPlanner::isPathValid(const std::vector<Point>& path, const Map& map) co
 }
 
 bool PathPlanner::isConnectionValid(const Point& from, const Point& to, const Map& map) const {
-    // 检查两点之间的距离是否合理（最多对角线移动?    int dx = std::abs(to.x - from.x);
+    // 检查两点之间的距离是否合理（最多对角线移动）
+    int dx = std::abs(to.x - from.x);
     int dy = std::abs(to.y - from.y);
     
     if (dx > 1 || dy > 1) {
-        // 距离太远，需要检查中间路?        return hasLineOfSight(from, to, map);
+        // 距离太远，需要检查中间路径
+        return hasLineOfSight(from, to, map);
     }
     
     // 对于对角线移动，检查是否被阻挡
@@ -124,41 +311,7 @@ bool PathPlanner::isConnectionValid(const Point& from, const Point& to, const Ma
 }
 
 bool PathPlanner::hasLineOfSight(const Point& from, const Point& to, const Map& map) const {
-    // 使用Bresenham直线算法检查视?    int dx = std::abs(to.x - from.x);
-    int dy = std::abs(to.y - from.y);
-    int x = from.x;
-    int y = from.y;
-    
-    int x_inc = (to.x > from.x) ? 1 : -1;
-    int y_inc = (to.y > from.y) ? 1 : -1;
-    
-    int error = dx - dy;
-    
-    while (true) {
-        Point current = {x, y};
-        
-        if (!map.isValidPosition(current) || !map.isWalkable(current)) {
-            return false;
-        }
-        
-        if (x == to.x && y == to.y) {
-            break;
-        }
-        
-        int error2 = 2 * error;
-        
-        if (error2 > -dy) {
-            error -= dy;
-            x += x_inc;
-        }
-        
-        if (error2 < dx) {
-            error += dx;
-            y += y_inc;
-        }
-    }
-    
-    return true;
+    return map.hasLineOfSight(from, to);
 }
 
 double PathPlanner::calculatePathLength(const std::vector<Point>& path) const {
@@ -203,8 +356,7 @@ std::vector<Point> PathPlanner::optimizePath(const std::vector<Point>& path, con
         current = farthest;
     }
     
-    Logger::info("Path optimized from " + std::to_string(path.size()) + 
-                " to " + std::to_string(optimized.size()) + " points");
+    Logger::info("Path optimized from {} to {} points", path.size(), optimized.size());
     
     return optimized;
 }
@@ -214,10 +366,43 @@ void PathPlanner::setAlgorithm(std::unique_ptr<PathfindingAlgorithm> algorithm)
     Logger::info("Pathfinding algorithm changed");
 }
 
+void PathPlanner::setBatchAlgorithmFactory(
+    std::function<std::unique_ptr<PathfindingAlgorithm>()> factory) {
+    m_batchFactory = std::move(factory);
+    m_batchAlgorithms.clear();
+    Logger::info("Batch pathfinding algorithm changed");
+}
+
+void PathPlanner::setQueryMode(QueryMode mode) {
+    m_queryMode = mode;
+    Logger::info("Path query mode set to {}", mode == QueryMode::FlowField ? "flow field"
+                                                                           : "search");
+}
+
+PathPlanner::QueryMode PathPlanner::getQueryMode() const {
+    return m_queryMode;
+}
+
+void PathPlanner::setFlowFieldCacheSize(size_t size) {
+    m_flowFieldCacheSize = std::max<size_t>(size, 1);
+    trimFlowFieldCache();
+}
+
+const FlowField& PathPlanner::getFlowField(const Point& goal, const Map& map) {
+    FlowField& field = acquireFlowField(goal);
+    field.synchronize(map, goal);
+    trimFlowFieldCache();
+    return field;
+}
+
 void PathPlanner::setHeuristicWeight(double weight) {
+    m_heuristicWeight = weight;
+    for (auto& algorithm : m_batchAlgorithms) {
+        algorithm->setHeuristicWeight(weight);
+    }
     if (m_algorithm) {
         m_algorithm->setHeuristicWeight(weight);
-        Logger::info("Heuristic weight set to " + std::to_string(weight));
+        Logger::info("Heuristic weight set to {}", weight);
     }
 }
 
@@ -230,7 +415,7 @@ double PathPlanner::getHeuristicWeight() const {
 
 void PathPlanner::enableSmoothing(bool enable) {
     m_enableSmoothing = enable;
-    Logger::info("Path smoothing " + std::string(enable ? "enabled" : "disabled"));
+    Logger::info("Path smoothing {}", enable ? "enabled" : "disabled");
 }
 
 bool PathPlanner::isSmoothingEnabled() const {
@@ -242,6 +427,12 @@ double PathPlanner::getLastExecutionTime() const {
 }
 
 PathfindingStats PathPlanner::getLastStats() const {
+    if (m_lastQueryOnNavMesh) {
+        return m_lastNavMeshStats;
+    }
+    if (m_queryMode == QueryMode::FlowField) {
+        return m_lastFlowFieldStats;
+    }
     if (m_algorithm) {
         return m_algorithm->getLastPathfindingStats();
     }
@@ -260,7 +451,8 @@ std::vector<Point> PathPlanner::findNearestWalkablePoints(const Point& point, co
     for (int radius = 1; radius <= maxRadius; ++radius) {
         for (int dx = -radius; dx <= radius; ++dx) {
             for (int dy = -radius; dy <= radius; ++dy) {
-                // 只检查当前半径圈上的?                if (std::abs(dx) != radius && std::abs(dy) != radius) {
+                // 只检查当前半径圈上的点
+                if (std::abs(dx) != radius && std::abs(dy) != radius) {
                     continue;
                 }
                 
@@ -277,9 +469,7 @@ std::vector<Point> PathPlanner::findNearestWalkablePoints(const Point& point, co
         }
     }
     
-    Logger::info("Found " + std::to_string(walkablePoints.size()) + 
-                " walkable points near (" + std::to_string(point.x) + "," + 
-                std::to_string(point.y) + ")");
+    Logger::info("Found {} walkable points near ({},{})", walkablePoints.size(), point.x, point.y);
     
     return walkablePoints;
 }
@@ -288,9 +478,11 @@ Point PathPlanner::findNearestWalkablePoint(const Point& point, const Map& map,
     std::vector<Point> candidates = findNearestWalkablePoints(point, map, maxRadius);
     
     if (candidates.empty()) {
-        return {-1, -1}; // 未找?    }
+        return {-1, -1}; // 未找到
+    }
     
-    // 返回距离最近的?    Point nearest = candidates[0];
+    // 返回距离最近的点
+    Point nearest = candidates[0];
     double minDistance = std::sqrt(std::pow(nearest.x - point.x, 2) + std::pow(nearest.y - point.y, 2));
     
     for (size_t i = 1; i < candidates.size(); ++i) {
@@ -1,54 +1,45 @@
 #pragma once
 
+#include "flow_field.h"
 #include "map.h"
-#include "astar.h"
+#include "navmesh.h"
+#include "pathfinding_algorithm.h"
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <chrono>
 
 namespace oneday::pathfinding {
 
 /**
- * @brief 路径查找算法接口
+ * @brief 批量查询中的一条查询
  */
-class PathfindingAlgorithm {
-public:
-    virtual ~PathfindingAlgorithm() = default;
-    
-    /**
-     * @brief 查找路径
-     * @param start 起点
-     * @param goal 终点
-     * @param map 地图
-     * @return 路径点列表
-     */
-    virtual std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) = 0;
-    
-    /**
-     * @brief 平滑路径
-     * @param path 原始路径
-     * @param map 地图
-     * @return 平滑后的路径
-     */
-    virtual std::vector<Point> smoothPath(const std::vector<Point>& path, const Map& map) = 0;
-    
-    /**
-     * @brief 设置启发式权重
-     * @param weight 权重
-     */
-    virtual void setHeuristicWeight(double weight) = 0;
-    
-    /**
-     * @brief 获取启发式权重
-     * @return 权重
-     */
-    virtual double getHeuristicWeight() const = 0;
-    
-    /**
-     * @brief 获取上次路径查找统计信息
-     * @return 统计信息
-     */
-    virtual PathfindingStats getLastPathfindingStats() const = 0;
+struct PathQuery {
+    Point start;  ///< 起点
+    Point goal;   ///< 终点
+};
+
+/**
+ * @brief 批量查询选项
+ */
+struct BatchOptions {
+    bool parallel = true;            ///< 是否在进程级线程池上并行执行
+    size_t sharedGoalThreshold = 16; ///< 同一终点的查询数达到该值时共享终点流场（0 为不共享）
+};
+
+/**
+ * @brief 批量查询结果
+ */
+struct BatchResult {
+    std::vector<std::vector<Point>> paths; ///< 与查询一一对应的路径（未找到时为空）
+    std::vector<PathfindingStats> stats;   ///< 与查询一一对应的统计信息
+    int pathsFound = 0;                    ///< 找到路径的查询数
+    int sharedFields = 0;                  ///< 使用的共享流场数
+    int sharedQueries = 0;                 ///< 通过共享流场回答的查询数
+    double fieldTime = 0.0;                ///< 构建或同步共享流场的墙钟时间（毫秒）
+    double totalSearchTime = 0.0;          ///< 各查询执行时间之和（毫秒）
+    double wallTime = 0.0;                 ///< 整个批次的墙钟时间（毫秒）
 };
 
 /**
@@ -58,6 +49,14 @@ public:
  */
 class PathPlanner {
 public:
+    /**
+     * @brief 单条查询的执行方式
+     */
+    enum class QueryMode {
+        Search,   ///< 使用当前算法逐条搜索
+        FlowField ///< 沿缓存的终点流场走（同一终点的后续查询为 O(路径长度)）
+    };
+    
     /**
      * @brief 构造函数
      */
@@ -77,6 +76,19 @@ public:
      */
     std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map);
     
+    /**
+     * @brief 在导航网格上查找路径
+     * @param start 起点
+     * @param goal 终点
+     * @param navMesh 导航网格
+     * @return 转折点列表（含起点和终点），如果没有找到路径则返回空列表
+     *
+     * 搜索三角形而不是网格单元格，路径已由漏斗算法拉直，不再平滑。
+     * 之后的 getLastStats 返回这次查询的统计信息，直到下一次网格查询。
+     */
+    std::vector<Point2D> findPath(const Point2D& start, const Point2D& goal,
+                                  const NavMesh& navMesh);
+    
     /**
      * @brief 通过多个路径点查找路径
      * @param waypoints 路径点列表（至少2个点）
@@ -85,6 +97,21 @@ public:
      */
     std::vector<Point> findPathWithWaypoints(const std::vector<Point>& waypoints, const Map& map);
     
+    /**
+     * @brief 批量查找路径
+     * @param queries 查询列表
+     * @param map 地图（批次执行期间不能修改）
+     * @param options 批量查询选项
+     * @return 每条查询的路径和统计信息，以及整个批次的耗时
+     *
+     * 查询分发到进程级线程池，每个并行任务使用自己的算法实例（及其搜索工作区），
+     * 实例在批次之间复用。终点相同的查询足够多时改用该终点的流场（与 FlowField
+     * 查询模式共用缓存，地图变化后增量修复），统计信息中的 nodesExplored 为 0。
+     * 启用路径平滑时每条路径都会平滑。
+     */
+    BatchResult findPaths(const std::vector<PathQuery>& queries, const Map& map,
+                          const BatchOptions& options = BatchOptions());
+    
     /**
      * @brief 平滑路径
      * @param path 原始路径
@@ -141,7 +168,41 @@ public:
     void setAlgorithm(std::unique_ptr<PathfindingAlgorithm> algorithm);
     
     /**
-     * @brief 设置启发式函数权重
+     * @brief 设置批量查询使用的算法工厂
+     * @param factory 每次调用返回一个新的算法实例（默认创建 AStar）
+     *
+     * 调用过 setHeuristicWeight() 时，新建的实例也使用该权重，否则保持工厂的默认值。
+     */
+    void setBatchAlgorithmFactory(std::function<std::unique_ptr<PathfindingAlgorithm>()> factory);
+    
+    /**
+     * @brief 设置单条查询的执行方式（默认 Search）
+     * @param mode 执行方式
+     */
+    void setQueryMode(QueryMode mode);
+    
+    /**
+     * @brief 获取单条查询的执行方式
+     * @return 执行方式
+     */
+    QueryMode getQueryMode() const;
+    
+    /**
+     * @brief 设置最多缓存的终点流场数（按最近使用淘汰，默认 8）
+     * @param size 缓存大小（至少为 1）
+     */
+    void setFlowFieldCacheSize(size_t size);
+    
+    /**
+     * @brief 获取与地图同步的终点流场，供调用方让多个单位逐步查表移动
+     * @param goal 终点
+     * @param map 地图
+     * @return 流场（在下一次查询或修改缓存大小之前有效）
+     */
+    const FlowField& getFlowField(const Point& goal, const Map& map);
+    
+    /**
+     * @brief 设置启发式函数权重（同时作用于单条查询和批量查询的算法实例）
      * @param weight 权重值
      */
     void setHeuristicWeight(double weight);
@@ -194,11 +255,53 @@ private:
      * @return 是否有视线
      */
     bool hasLineOfSight(const Point& from, const Point& to, const Map& map) const;
+    
+    /**
+     * @brief 取出终点的缓存流场（不存在时创建），不与地图同步
+     * @param goal 终点
+     * @return 流场
+     */
+    FlowField& acquireFlowField(const Point& goal);
+    
+    /**
+     * @brief 淘汰最久未用的流场，直到不超过缓存大小
+     */
+    void trimFlowFieldCache();
+    
+    /**
+     * @brief 沿终点流场查找路径，记录统计信息
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @return 路径点列表
+     */
+    std::vector<Point> findPathOnFlowField(const Point& start, const Point& goal, const Map& map);
+
+    /**
+     * @brief 缓存的终点流场
+     */
+    struct CachedFlowField {
+        std::unique_ptr<FlowField> field; ///< 流场
+        uint64_t lastUse = 0;             ///< 最近一次使用的序号
+    };
 
 private:
     std::unique_ptr<PathfindingAlgorithm> m_algorithm; ///< 路径查找算法
     bool m_enableSmoothing = true;                     ///< 是否启用路径平滑
     double m_lastExecutionTime = 0.0;                  ///< 上次执行时间
+    
+    std::function<std::unique_ptr<PathfindingAlgorithm>()> m_batchFactory; ///< 批量查询的算法工厂
+    std::vector<std::unique_ptr<PathfindingAlgorithm>> m_batchAlgorithms;  ///< 各批量任务的算法实例
+    std::optional<double> m_heuristicWeight;  ///< 显式设置的启发式权重（批量实例同样使用）
+    
+    QueryMode m_queryMode = QueryMode::Search;    ///< 单条查询的执行方式
+    PathfindingStats m_lastFlowFieldStats;        ///< 上次流场查询的统计信息
+    std::vector<CachedFlowField> m_flowFields;    ///< 按终点缓存的流场
+    size_t m_flowFieldCacheSize = 8;              ///< 最多缓存的流场数
+    uint64_t m_flowFieldUses = 0;                 ///< 流场使用计数（用于淘汰）
+    
+    bool m_lastQueryOnNavMesh = false;            ///< 上次查询是否在导航网格上
+    PathfindingStats m_lastNavMeshStats;          ///< 上次导航网格查询的统计信息
 };
 
 } // namespace oneday::pathfinding
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "indexed_heap.h"
+#include "map.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief 可复用的网格搜索工作区
+ *
+ * 按 y * width + x 索引的平坦数组保存每个单元格的 gCost、父节点和搜索状态，
+ * 配合 IndexedHeap 作为开放列表。每次搜索只递增世代计数器，
+ * 状态戳不等于当前世代的单元格视为未访问，因此数组无需在搜索之间清空。
+ * 数组只增不减，在同一张（或更小的）地图上反复搜索不会再分配内存。
+ */
+class SearchWorkspace {
+  public:
+    static constexpr int32_t kNoParent = -1;  ///< 起点的父节点
+
+    /**
+     * @brief 为新一次搜索做准备
+     * @param width 地图宽度
+     * @param height 地图高度
+     */
+    void prepare(int width, int height) {
+        m_width = width;
+        const size_t cellCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+        if (m_cells.size() < cellCount) {
+            m_cells.resize(cellCount);
+        }
+        m_openList.reserve(cellCount);
+        m_openList.clear();
+
+        // 每次搜索占用两个世代值：m_generation 表示已访问，m_generation + 1 表示已关闭
+        m_generation += 2;
+        if (m_generation < 2) {
+            // 计数器回绕，清除所有旧状态戳
+            for (Cell& cell : m_cells) {
+                cell.stamp = 0;
+            }
+            m_generation = 2;
+        }
+    }
+
+    int getWidth() const {
+        return m_width;
+    }
+
+    uint32_t toIndex(const Point& point) const {
+        return static_cast<uint32_t>(point.y * m_width + point.x);
+    }
+
+    Point toPoint(uint32_t index) const {
+        return Point{static_cast<int>(index % static_cast<uint32_t>(m_width)),
+                     static_cast<int>(index / static_cast<uint32_t>(m_width))};
+    }
+
+    /**
+     * @brief 单元格在本次搜索中是否已被访问（在开放或关闭列表中）
+     */
+    bool isVisited(uint32_t index) const {
+        return m_cells[index].stamp >= m_generation;
+    }
+
+    /**
+     * @brief 单元格是否已关闭（已扩展）
+     */
+    bool isClosed(uint32_t index) const {
+        return m_cells[index].stamp == m_generation + 1;
+    }
+
+    /**
+     * @brief 记录单元格的代价和父节点并标记为已访问
+     */
+    void visit(uint32_t index, double gCost, int32_t parent) {
+        Cell& cell = m_cells[index];
+        cell.gCost = gCost;
+        cell.parent = parent;
+        cell.stamp = m_generation;
+    }
+
+    /**
+     * @brief 标记单元格为已关闭
+     */
+    void close(uint32_t index) {
+        m_cells[index].stamp = m_generation + 1;
+    }
+
+    double getGCost(uint32_t index) const {
+        return m_cells[index].gCost;
+    }
+
+    int32_t getParent(uint32_t index) const {
+        return m_cells[index].parent;
+    }
+
+    /**
+     * @brief 开放列表
+     */
+    IndexedHeap& getOpenList() {
+        return m_openList;
+    }
+
+    /**
+     * @brief 沿父节点回溯到起点，输出从起点到终点的路径
+     * @param goal 终点下标
+     * @param path 输出路径（复用调用方的缓冲区）
+     */
+    void reconstructPath(uint32_t goal, std::vector<Point>& path) const {
+        path.clear();
+        for (int32_t index = static_cast<int32_t>(goal); index != kNoParent;
+             index = m_cells[index].parent) {
+            path.push_back(toPoint(static_cast<uint32_t>(index)));
+        }
+        std::reverse(path.begin(), path.end());
+    }
+
+  private:
+    /**
+     * @brief 单元格搜索状态（16 字节，一次缓存访问即可读取）
+     */
+    struct Cell {
+        double gCost = 0.0;          ///< 从起点出发的实际代价
+        int32_t parent = kNoParent;  ///< 父节点下标
+        uint32_t stamp = 0;          ///< 世代状态戳
+    };
+
+    std::vector<Cell> m_cells;  ///< 单元格状态
+    IndexedHeap m_openList;     ///< 开放列表
+    uint32_t m_generation = 0;  ///< 当前搜索的世代
+    int m_width = 0;            ///< 当前地图宽度
+};
+
+}  // namespace oneday::pathfinding
@@ -0,0 +1,235 @@
+#include "theta_star.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "../common/logger.h"
+#include "grid_directions.h"
+
+using oneday::core::Logger;
+
+namespace oneday::pathfinding {
+
+using grid::Direction;
+using grid::kDirections;
+
+namespace {
+
+constexpr double kCostEpsilon = 1e-9;  ///< 代价相等时优先接到父节点上（共线时不留多余转折点）
+
+double euclidean(const Point& from, const Point& to) {
+    return std::hypot(static_cast<double>(to.x - from.x), static_cast<double>(to.y - from.y));
+}
+
+}  // namespace
+
+ThetaStar::ThetaStar(Variant variant) : m_variant(variant) {
+    Logger::info("Theta* pathfinder initialized ({})", variant == Variant::Lazy ? "lazy" : "basic");
+}
+
+ThetaStar::~ThetaStar() {
+    Logger::info("Theta* pathfinder destroyed");
+}
+
+std::vector<Point> ThetaStar::findPath(const Point& start, const Point& goal, const Map& map) {
+    std::vector<Point> path;
+    findPath(start, goal, map, path);
+    return path;
+}
+
+bool ThetaStar::findPath(const Point& start,
+                         const Point& goal,
+                         const Map& map,
+                         std::vector<Point>& path) {
+    ONEDAY_LOG_DEBUG("Starting Theta* pathfinding from ({},{}) to ({},{})",
+                     start.x, start.y, goal.x, goal.y);
+    path.clear();
+    m_lastStats = PathfindingStats();
+    m_lineOfSightChecks = 0;
+
+    // 检查起点和终点是否有效
+    if (!map.isValidPosition(start) || !map.isValidPosition(goal)) {
+        Logger::error("Invalid start or goal position");
+        return false;
+    }
+
+    if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+        Logger::error("Start or goal position is not walkable");
+        return false;
+    }
+
+    // 如果起点就是终点
+    if (start == goal) {
+        path.push_back(start);
+        m_lastStats.pathFound = true;
+        m_lastStats.pathLength = 1;
+        return true;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    const int iterations = search(start, goal, map, path);
+    auto endTime = std::chrono::steady_clock::now();
+
+    m_lastStats.nodesExplored = iterations;
+    m_lastStats.pathFound = !path.empty();
+    m_lastStats.pathLength = static_cast<int>(path.size());
+    m_lastStats.executionTime =
+        std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    if (!m_lastStats.pathFound) {
+        Logger::warning("No path found after {} iterations", iterations);
+        return false;
+    }
+    ONEDAY_LOG_DEBUG("Path found after {} iterations, {} line-of-sight checks", iterations,
+                     m_lineOfSightChecks);
+    return true;
+}
+
+int ThetaStar::search(const Point& start,
+                      const Point& goal,
+                      const Map& map,
+                      std::vector<Point>& path) {
+    m_workspace.prepare(map.getWidth(), map.getHeight());
+    IndexedHeap& openSet = m_workspace.getOpenList();
+
+    const uint32_t startIndex = m_workspace.toIndex(start);
+    const uint32_t goalIndex = m_workspace.toIndex(goal);
+    const double startHCost = calculateHeuristic(start, goal);
+    m_workspace.visit(startIndex, 0.0, SearchWorkspace::kNoParent);
+    openSet.push(startIndex, startHCost, startHCost);
+
+    int iterations = 0;
+    while (!openSet.empty()) {
+        const uint32_t current = openSet.pop().node;
+        if (m_variant == Variant::Lazy && current != startIndex) {
+            repairParent(current, map);
+        }
+        m_workspace.close(current);
+        iterations++;
+
+        if (current == goalIndex) {
+            m_workspace.reconstructPath(goalIndex, path);
+            return iterations;
+        }
+
+        const Point position = m_workspace.toPoint(current);
+        // 起点没有父节点，把它当作自己的父节点
+        const int32_t parentIndex = m_workspace.getParent(current);
+        const uint32_t parent = parentIndex == SearchWorkspace::kNoParent
+                                    ? current
+                                    : static_cast<uint32_t>(parentIndex);
+        const Point parentPosition = m_workspace.toPoint(parent);
+        const double parentGCost = m_workspace.getGCost(parent);
+
+        for (const Direction& dir : kDirections) {
+            if (!grid::canMove(map, position.x, position.y, dir)) {
+                continue;
+            }
+            const Point next{position.x + dir.dx, position.y + dir.dy};
+            const uint32_t neighbor = m_workspace.toIndex(next);
+            if (m_workspace.isClosed(neighbor)) {
+                continue;
+            }
+
+            // 路径 2：从父节点直接连过去（Lazy 变体留到出队时再验证视线）
+            uint32_t via = current;
+            double tentativeGCost = m_workspace.getGCost(current) + dir.cost;
+            if (parent != current) {
+                const double direct = parentGCost + euclidean(parentPosition, next);
+                if (direct <= tentativeGCost + kCostEpsilon &&
+                    (m_variant == Variant::Lazy || hasLineOfSight(parentPosition, next, map))) {
+                    via = parent;
+                    tentativeGCost = direct;
+                }
+            }
+
+            // 已访问但未关闭的节点一定在开放列表中，代价更低时就地降低
+            const bool inOpenSet = m_workspace.isVisited(neighbor);
+            if (inOpenSet && tentativeGCost >= m_workspace.getGCost(neighbor)) {
+                continue;
+            }
+
+            const double hCost = calculateHeuristic(next, goal);
+            m_workspace.visit(neighbor, tentativeGCost, static_cast<int32_t>(via));
+            if (inOpenSet) {
+                openSet.decreaseKey(neighbor, tentativeGCost + hCost, hCost);
+            } else {
+                openSet.push(neighbor, tentativeGCost + hCost, hCost);
+            }
+        }
+    }
+
+    return iterations;
+}
+
+void ThetaStar::repairParent(uint32_t node, const Map& map) {
+    const Point position = m_workspace.toPoint(node);
+    const uint32_t parent = static_cast<uint32_t>(m_workspace.getParent(node));
+    if (hasLineOfSight(m_workspace.toPoint(parent), position, map)) {
+        return;
+    }
+
+    // 把节点压入开放列表的邻居已关闭，因此至少有一个候选
+    double best = std::numeric_limits<double>::infinity();
+    int32_t bestParent = static_cast<int32_t>(parent);
+    for (const Direction& dir : kDirections) {
+        if (!grid::canMove(map, position.x, position.y, dir)) {
+            continue;
+        }
+        const uint32_t neighbor = m_workspace.toIndex({position.x + dir.dx, position.y + dir.dy});
+        if (m_workspace.isClosed(neighbor) && m_workspace.getGCost(neighbor) + dir.cost < best) {
+            best = m_workspace.getGCost(neighbor) + dir.cost;
+            bestParent = static_cast<int32_t>(neighbor);
+        }
+    }
+    m_workspace.visit(node, best, bestParent);
+}
+
+bool ThetaStar::hasLineOfSight(const Point& from, const Point& to, const Map& map) {
+    // 相邻单元格按 8 方向移动规则判断，与 PathPlanner::isPathValid 一致（对角线不能穿过拐角）
+    const int dx = to.x - from.x;
+    const int dy = to.y - from.y;
+    if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
+        return grid::canMove(from.x, from.y, dx, dy,
+                             [&map](int x, int y) { return map.isWalkableUnchecked(x, y); });
+    }
+    m_lineOfSightChecks++;
+    return map.hasLineOfSight(from, to);
+}
+
+double ThetaStar::calculateHeuristic(const Point& from, const Point& to) const {
+    return m_heuristicWeight * euclidean(from, to);
+}
+
+void ThetaStar::setVariant(Variant variant) {
+    m_variant = variant;
+}
+
+ThetaStar::Variant ThetaStar::getVariant() const {
+    return m_variant;
+}
+
+void ThetaStar::setHeuristicWeight(double weight) {
+    m_heuristicWeight = std::max(1.0, weight);
+    Logger::info("Heuristic weight set to {}", m_heuristicWeight);
+}
+
+double ThetaStar::getHeuristicWeight() const {
+    return m_heuristicWeight;
+}
+
+std::vector<Point> ThetaStar::smoothPath(const std::vector<Point>& path, const Map& /*map*/) {
+    return path;
+}
+
+PathfindingStats ThetaStar::getLastPathfindingStats() const {
+    return m_lastStats;
+}
+
+int ThetaStar::getLastLineOfSightChecks() const {
+    return m_lineOfSightChecks;
+}
+
+}  // namespace oneday::pathfinding
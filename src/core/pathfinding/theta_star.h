@@ -0,0 +1,132 @@
+#pragma once
+
+#include <vector>
+
+#include "map.h"
+#include "pathfinding_algorithm.h"
+#include "search_workspace.h"
+
+namespace oneday::pathfinding {
+
+/**
+ * @brief Theta* 任意角度路径查找算法
+ *
+ * 在 8 方向网格上搜索，但节点的父节点可以是任何有视线的已扩展节点：扩展节点 s 的邻居 s'
+ * 时，如果 s 的父节点能直接看到 s'，就把 s' 接到 s 的父节点上，代价取两点间的欧几里得距离。
+ * 返回的路径只包含转折点，相邻转折点之间有视线（Map::hasLineOfSight），不需要再平滑。
+ *
+ * Lazy 变体（默认）先假定视线存在，节点出队时才检查一次，不成立时改接到代价最小的
+ * 已关闭邻居上，每个扩展节点最多检查一次视线；Basic 变体为每个邻居检查视线。
+ */
+class ThetaStar : public PathfindingAlgorithm {
+  public:
+    /**
+     * @brief 算法变体
+     */
+    enum class Variant {
+        Basic,  ///< 为每个邻居检查视线
+        Lazy    ///< 节点出队时才检查视线（默认）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param variant 算法变体
+     */
+    explicit ThetaStar(Variant variant = Variant::Lazy);
+
+    /**
+     * @brief 析构函数
+     */
+    ~ThetaStar();
+
+    /**
+     * @brief 查找从起点到终点的任意角度路径
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @return 转折点列表（含起点和终点），如果没有找到路径则返回空列表
+     */
+    std::vector<Point> findPath(const Point& start, const Point& goal, const Map& map) override;
+
+    /**
+     * @brief 查找路径并写入调用方提供的缓冲区
+     * @param start 起点
+     * @param goal 终点
+     * @param map 地图
+     * @param path 输出转折点（复用其容量，未找到路径时清空）
+     * @return 是否找到路径
+     */
+    bool findPath(const Point& start, const Point& goal, const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief 设置算法变体
+     */
+    void setVariant(Variant variant);
+
+    /**
+     * @brief 获取算法变体
+     */
+    Variant getVariant() const;
+
+    /**
+     * @brief 设置启发式函数权重
+     * @param weight 权重值（>= 1.0）
+     */
+    void setHeuristicWeight(double weight) override;
+
+    /**
+     * @brief 获取启发式函数权重
+     * @return 权重值
+     */
+    double getHeuristicWeight() const override;
+
+    /**
+     * @brief 平滑路径
+     * @param path 原始路径
+     * @param map 地图
+     * @return 原样返回：Theta* 的路径在搜索中已经拉直
+     */
+    std::vector<Point> smoothPath(const std::vector<Point>& path, const Map& map) override;
+
+    /**
+     * @brief 获取上次路径查找的统计信息
+     * @return 统计信息（pathLength 为转折点数）
+     */
+    PathfindingStats getLastPathfindingStats() const override;
+
+    /**
+     * @brief 获取上次路径查找中（非相邻单元格间的）视线检查次数
+     */
+    int getLastLineOfSightChecks() const;
+
+  private:
+    /**
+     * @brief 在平坦工作区上搜索
+     * @return 扩展的节点数
+     */
+    int search(const Point& start, const Point& goal, const Map& map, std::vector<Point>& path);
+
+    /**
+     * @brief Lazy 变体：节点出队时视线不成立，改接到代价最小的已关闭邻居上
+     */
+    void repairParent(uint32_t node, const Map& map);
+
+    /**
+     * @brief 检查视线并计数（相邻单元格按移动规则判断，不计数）
+     */
+    bool hasLineOfSight(const Point& from, const Point& to, const Map& map);
+
+    /**
+     * @brief 计算启发式距离（加权欧几里得距离）
+     */
+    double calculateHeuristic(const Point& from, const Point& to) const;
+
+  private:
+    Variant m_variant;                ///< 算法变体
+    double m_heuristicWeight = 1.0;   ///< 启发式函数权重
+    PathfindingStats m_lastStats;     ///< 上次查找的统计信息
+    int m_lineOfSightChecks = 0;      ///< 上次查找的视线检查次数
+    SearchWorkspace m_workspace;      ///< 跨查询复用的搜索工作区
+};
+
+}  // namespace oneday::pathfinding
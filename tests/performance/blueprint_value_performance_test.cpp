@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <variant>
+#include <vector>
+#include "core/blueprint/data_types.h"
+
+using namespace oneday::core::blueprint;
+using namespace std::chrono;
+
+namespace {
+
+/**
+ * @brief 旧的 BlueprintValue 布局：std::variant 加冗余的类型字段，每次赋值重新计算类型
+ */
+class LegacyValue {
+public:
+    using Variant = std::variant<std::monostate, bool, int, float, std::string, Vector2, Vector3,
+                                 Color, ObjectReference, std::vector<LegacyValue>, ExecutionToken>;
+
+    LegacyValue() = default;
+
+    template<typename T>
+    LegacyValue(const T& value) : m_value(value) {
+        updateType();
+    }
+
+    template<typename T>
+    T get() const {
+        try {
+            return std::get<T>(m_value);
+        } catch (const std::bad_variant_access&) {
+            return T{};
+        }
+    }
+
+private:
+    Variant m_value;
+    DataType m_type = DataType::None;
+
+    void updateType() {
+        static constexpr DataType kTypes[] = {
+            DataType::None,    DataType::Boolean, DataType::Integer, DataType::Float,
+            DataType::String,  DataType::Vector2, DataType::Vector3, DataType::Color,
+            DataType::Object,  DataType::Array,   DataType::Execution};
+        m_type = kTypes[m_value.index()];
+    }
+};
+
+constexpr int kValueCount = 1024;
+constexpr int kRounds = 2000;
+
+/**
+ * @brief 测量拷贝、移动和读取吞吐量（每秒百万次操作）
+ */
+template<typename Value, typename Make>
+void measure(const char* label, Make make) {
+    std::vector<Value> source;
+    source.reserve(kValueCount);
+    for (int i = 0; i < kValueCount; ++i) {
+        source.push_back(make(i));
+    }
+    std::vector<Value> target(kValueCount);
+
+    auto start = high_resolution_clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (int i = 0; i < kValueCount; ++i) {
+            target[i] = source[i];
+        }
+    }
+    const double copyMs = duration<double, std::milli>(high_resolution_clock::now() - start).count();
+
+    start = high_resolution_clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (int i = 0; i < kValueCount; ++i) {
+            Value moved(std::move(target[i]));
+            target[i] = std::move(moved);
+        }
+    }
+    const double moveMs = duration<double, std::milli>(high_resolution_clock::now() - start).count();
+
+    float sum = 0.0f;
+    start = high_resolution_clock::now();
+    for (int r = 0; r < kRounds; ++r) {
+        for (int i = 0; i < kValueCount; ++i) {
+            sum += target[i].template get<Vector3>().x;
+        }
+    }
+    const double getMs = duration<double, std::milli>(high_resolution_clock::now() - start).count();
+
+    const double ops = static_cast<double>(kValueCount) * kRounds / 1000.0;
+    std::cout << label << " (sizeof " << sizeof(Value) << "): copy " << ops / copyMs
+              << " M/s, move " << ops / moveMs << " M/s, get " << ops / getMs
+              << " M/s (checksum " << sum << ")" << std::endl;
+}
+
+}  // namespace
+
+TEST(BlueprintValuePerformanceTest, InlinePayloadRoundTrip) {
+    EXPECT_LT(sizeof(BlueprintValue), sizeof(LegacyValue));
+
+    BlueprintValue vector(Vector3(1.0f, 2.0f, 3.0f));
+    BlueprintValue copy = vector;
+    EXPECT_TRUE(copy.is<Vector3>());
+    EXPECT_FLOAT_EQ(copy.get<Vector3>().z, 3.0f);
+
+    BlueprintValue text(std::string("hello"));
+    BlueprintValue shared = text;
+    EXPECT_EQ(shared.getIf<std::string>(), text.getIf<std::string>());
+    shared.set(7);
+    EXPECT_EQ(shared.get<int>(), 7);
+    EXPECT_EQ(text.get<std::string>(), "hello");
+
+    BlueprintValue moved(std::move(text));
+    EXPECT_TRUE(text.isEmpty());
+    EXPECT_EQ(moved.toString(), "hello");
+    EXPECT_EQ(moved.get<float>(), 0.0f);
+}
+
+TEST(BlueprintValuePerformanceTest, CopyMoveGetThroughput) {
+    measure<LegacyValue>("legacy variant", [](int i) {
+        return LegacyValue(Vector3(static_cast<float>(i), 0.0f, 0.0f));
+    });
+    measure<BlueprintValue>("inline payload", [](int i) {
+        return BlueprintValue(Vector3(static_cast<float>(i), 0.0f, 0.0f));
+    });
+    SUCCEED();
+}
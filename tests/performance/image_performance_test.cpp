@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include "core/image/tiled_filter.h"
+
+using namespace oneday::image;
+using namespace std::chrono;
+
+namespace {
+
+constexpr int kRepeats = 5;
+
+/**
+ * @brief 生成合成截图：平滑渐变背景上叠加随机色块和噪声
+ */
+cv::Mat makeCapture(const cv::Size& size, uint64_t seed) {
+    cv::Mat capture(size, CV_8UC3);
+    for (int y = 0; y < size.height; ++y) {
+        cv::Vec3b* row = capture.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < size.width; ++x) {
+            row[x] = cv::Vec3b(static_cast<uchar>(x * 255 / size.width),
+                               static_cast<uchar>(y * 255 / size.height),
+                               static_cast<uchar>((x + y) & 0xFF));
+        }
+    }
+
+    cv::RNG rng(seed);
+    for (int i = 0; i < 200; ++i) {
+        const cv::Point topLeft(rng.uniform(0, size.width), rng.uniform(0, size.height));
+        const cv::Size extent(rng.uniform(20, 200), rng.uniform(20, 200));
+        cv::rectangle(capture, cv::Rect(topLeft, extent),
+                      cv::Scalar(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256)),
+                      cv::FILLED);
+    }
+
+    cv::Mat noise(size, CV_8UC3);
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(24));
+    cv::add(capture, noise, capture);
+    return capture;
+}
+
+/**
+ * @brief 重复执行并返回平均耗时（毫秒）
+ */
+double measure(const std::function<void()>& run) {
+    run();  // 预热：分配输出和各线程的块缓冲区
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < kRepeats; ++i) {
+        run();
+    }
+    return duration<double, std::milli>(high_resolution_clock::now() - start).count() / kRepeats;
+}
+
+}  // namespace
+
+TEST(ImagePerformanceTest, TiledVersusWholeFrameFilters) {
+    const std::pair<std::string, cv::Size> resolutions[] = {{"1080p", cv::Size(1920, 1080)},
+                                                            {"1440p", cv::Size(2560, 1440)},
+                                                            {"4K", cv::Size(3840, 2160)}};
+    const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(7, 7));
+
+    for (const auto& [name, size] : resolutions) {
+        const cv::Mat capture = makeCapture(size, 11);
+        cv::Mat gray;
+        cv::cvtColor(capture, gray, cv::COLOR_BGR2GRAY);
+
+        cv::Mat whole;
+        cv::Mat tiled;
+        const auto report = [&](const char* filter, double wholeMs, double tiledMs) {
+            std::cout << filter << " " << name << ": whole frame " << wholeMs << " ms, tiled "
+                      << tiledMs << " ms (" << wholeMs / tiledMs << "x)" << std::endl;
+            // 分块结果必须与整帧结果逐像素一致
+            EXPECT_EQ(cv::norm(whole, tiled, cv::NORM_INF), 0.0) << filter << " " << name;
+        };
+
+        report("bilateralFilter",
+               measure([&]() { cv::bilateralFilter(capture, whole, 9, 50, 50); }),
+               measure([&]() { TiledFilter::bilateralFilter(capture, tiled, 9, 50, 50); }));
+
+        report("medianBlur",
+               measure([&]() { cv::medianBlur(capture, whole, 5); }),
+               measure([&]() { TiledFilter::medianBlur(capture, tiled, 5); }));
+
+        report("adaptiveThreshold",
+               measure([&]() {
+                   cv::adaptiveThreshold(gray, whole, 255, cv::ADAPTIVE_THRESH_GAUSSIAN_C,
+                                         cv::THRESH_BINARY, 31, 5);
+               }),
+               measure([&]() {
+                   TiledFilter::adaptiveThreshold(gray, tiled, 255, cv::ADAPTIVE_THRESH_GAUSSIAN_C,
+                                                  cv::THRESH_BINARY, 31, 5);
+               }));
+
+        report("morphologyEx",
+               measure([&]() {
+                   cv::morphologyEx(capture, whole, cv::MORPH_OPEN, kernel, cv::Point(-1, -1), 2);
+               }),
+               measure([&]() {
+                   TiledFilter::morphologyEx(capture, tiled, cv::MORPH_OPEN, kernel, 2);
+               }));
+    }
+}
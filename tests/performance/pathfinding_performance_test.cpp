@@ -0,0 +1,598 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "core/common/thread_pool.h"
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/dstar_lite.h"
+#include "core/pathfinding/flow_field.h"
+#include "core/pathfinding/hpa_star.h"
+#include "core/pathfinding/jps.h"
+#include "core/pathfinding/pathplanner.h"
+#include "core/pathfinding/theta_star.h"
+
+using namespace oneday::pathfinding;
+using namespace std::chrono;
+
+namespace {
+
+constexpr int kMapSize = 1024;
+constexpr int kQueryCount = 20;
+
+/**
+ * @brief 生成带随机矩形障碍的大地图
+ */
+Map makeObstacleMap(unsigned int seed) {
+    Map map(kMapSize, kMapSize);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+    std::uniform_int_distribution<int> extent(2, 24);
+    for (int i = 0; i < 3000; ++i) {
+        const Point topLeft{coord(rng), coord(rng)};
+        map.setRectangle(topLeft, {topLeft.x + extent(rng), topLeft.y + extent(rng)},
+                         CellType::Obstacle);
+    }
+    return map;
+}
+
+/**
+ * @brief 生成开阔地图：大片空地上散布少量小障碍
+ */
+Map makeOpenMap(unsigned int seed) {
+    Map map(kMapSize, kMapSize);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+    std::uniform_int_distribution<int> extent(1, 6);
+    for (int i = 0; i < 400; ++i) {
+        const Point topLeft{coord(rng), coord(rng)};
+        map.setRectangle(topLeft, {topLeft.x + extent(rng), topLeft.y + extent(rng)},
+                         CellType::Obstacle);
+    }
+    return map;
+}
+
+/**
+ * @brief 生成迷宫地图：深度优先生成的单格宽通道
+ */
+Map makeMazeMap(unsigned int seed) {
+    Map map(kMapSize, kMapSize);
+    map.clear(CellType::Obstacle);
+
+    // 迷宫单元位于奇数坐标，单元之间的墙在打通时置为可行走
+    const int cells = (kMapSize - 1) / 2;
+    std::vector<bool> visited(static_cast<size_t>(cells) * cells, false);
+    std::vector<Point> stack{{0, 0}};
+    visited[0] = true;
+    map.setCellType({1, 1}, CellType::Walkable);
+
+    std::mt19937 rng(seed);
+    const Point steps[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    while (!stack.empty()) {
+        const Point current = stack.back();
+        Point candidates[4];
+        int count = 0;
+        for (const Point& step : steps) {
+            const Point next{current.x + step.x, current.y + step.y};
+            if (next.x >= 0 && next.x < cells && next.y >= 0 && next.y < cells &&
+                !visited[static_cast<size_t>(next.y) * cells + next.x]) {
+                candidates[count++] = next;
+            }
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        const Point next = candidates[std::uniform_int_distribution<int>(0, count - 1)(rng)];
+        visited[static_cast<size_t>(next.y) * cells + next.x] = true;
+        map.setCellType({current.x + next.x + 1, current.y + next.y + 1}, CellType::Walkable);
+        map.setCellType({next.x * 2 + 1, next.y * 2 + 1}, CellType::Walkable);
+        stack.push_back(next);
+    }
+    return map;
+}
+
+/**
+ * @brief 生成洞穴地图：随机填充后做几轮元胞自动机平滑
+ */
+Map makeCaveMap(unsigned int seed) {
+    const size_t cellCount = static_cast<size_t>(kMapSize) * kMapSize;
+    std::vector<uint8_t> solid(cellCount);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (uint8_t& cell : solid) {
+        cell = percent(rng) < 45 ? 1 : 0;
+    }
+
+    std::vector<uint8_t> next(cellCount);
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        for (int y = 0; y < kMapSize; ++y) {
+            for (int x = 0; x < kMapSize; ++x) {
+                // 地图外视为岩石；周围岩石不少于 5 格则成为岩石
+                int walls = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int nx = x + dx;
+                        const int ny = y + dy;
+                        const bool outside = nx < 0 || nx >= kMapSize || ny < 0 || ny >= kMapSize;
+                        walls += outside || solid[static_cast<size_t>(ny) * kMapSize + nx];
+                    }
+                }
+                next[static_cast<size_t>(y) * kMapSize + x] = walls >= 5 ? 1 : 0;
+            }
+        }
+        solid.swap(next);
+    }
+
+    Map map(kMapSize, kMapSize);
+    for (int y = 0; y < kMapSize; ++y) {
+        for (int x = 0; x < kMapSize; ++x) {
+            if (solid[static_cast<size_t>(y) * kMapSize + x]) {
+                map.setCellType({x, y}, CellType::Obstacle);
+            }
+        }
+    }
+    return map;
+}
+
+/**
+ * @brief 生成两端都可行走的查询
+ */
+std::vector<std::pair<Point, Point>> makeQueries(const Map& map, unsigned int seed) {
+    std::vector<std::pair<Point, Point>> queries;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+    while (static_cast<int>(queries.size()) < kQueryCount) {
+        Point start{coord(rng), coord(rng)};
+        Point goal{coord(rng), coord(rng)};
+        if (map.isWalkable(start) && map.isWalkable(goal)) {
+            queries.emplace_back(start, goal);
+        }
+    }
+    return queries;
+}
+
+/**
+ * @brief 运行全部查询，返回平均每次查询耗时（毫秒）
+ */
+template <typename Algorithm>
+double measure(Algorithm& algorithm,
+               const Map& map,
+               const std::vector<std::pair<Point, Point>>& queries,
+               size_t& totalLength,
+               long long* totalExplored = nullptr) {
+    std::vector<Point> path;
+    totalLength = 0;
+    long long explored = 0;
+    auto start = high_resolution_clock::now();
+    for (const auto& query : queries) {
+        algorithm.findPath(query.first, query.second, map, path);
+        totalLength += path.size();
+        explored += algorithm.getLastPathfindingStats().nodesExplored;
+    }
+    const double elapsed =
+        duration<double, std::milli>(high_resolution_clock::now() - start).count();
+    if (totalExplored) {
+        *totalExplored = explored;
+    }
+    return elapsed / queries.size();
+}
+
+}  // namespace
+
+TEST(PathfindingPerformanceTest, WorkspaceVersusHashMapAStar) {
+    const Map map = makeObstacleMap(7);
+    const auto queries = makeQueries(map, 11);
+
+    AStar hashMap;
+    hashMap.setSearchMode(AStar::SearchMode::HashMap);
+    AStar workspace;
+
+    size_t hashMapLength = 0;
+    size_t workspaceLength = 0;
+    const double hashMapMs = measure(hashMap, map, queries, hashMapLength);
+    const double workspaceMs = measure(workspace, map, queries, workspaceLength);
+
+    std::cout << "A* on " << kMapSize << "x" << kMapSize << ": hash map " << hashMapMs
+              << " ms/query, flat workspace " << workspaceMs << " ms/query ("
+              << hashMapMs / workspaceMs << "x)" << std::endl;
+    EXPECT_GT(workspaceLength, 0u);
+}
+
+TEST(PathfindingPerformanceTest, JumpPointSearchVersusAStar) {
+    const std::pair<std::string, Map> maps[] = {{"open", makeOpenMap(3)},
+                                                {"maze", makeMazeMap(5)},
+                                                {"cave", makeCaveMap(9)}};
+
+    for (const auto& [name, map] : maps) {
+        const auto queries = makeQueries(map, 13);
+
+        AStar astar;
+        JumpPointSearch jps(JumpPointSearch::JumpMode::Scan);
+        JumpPointSearch jpsPlus(JumpPointSearch::JumpMode::Precomputed);
+
+        auto precomputeStart = high_resolution_clock::now();
+        jpsPlus.precompute(map);
+        const double precomputeMs =
+            duration<double, std::milli>(high_resolution_clock::now() - precomputeStart).count();
+
+        size_t astarLength = 0;
+        size_t jpsLength = 0;
+        size_t jpsPlusLength = 0;
+        long long astarExplored = 0;
+        long long jpsExplored = 0;
+        long long jpsPlusExplored = 0;
+        const double astarMs = measure(astar, map, queries, astarLength, &astarExplored);
+        const double jpsMs = measure(jps, map, queries, jpsLength, &jpsExplored);
+        const double jpsPlusMs = measure(jpsPlus, map, queries, jpsPlusLength, &jpsPlusExplored);
+
+        std::cout << name << " " << kMapSize << "x" << kMapSize << ": A* " << astarMs
+                  << " ms/query (" << astarExplored / kQueryCount << " nodes), JPS " << jpsMs
+                  << " ms/query (" << jpsExplored / kQueryCount << " nodes, "
+                  << astarMs / jpsMs << "x), JPS+ " << jpsPlusMs << " ms/query ("
+                  << jpsPlusExplored / kQueryCount << " nodes, " << astarMs / jpsPlusMs
+                  << "x, table built in " << precomputeMs << " ms)" << std::endl;
+
+        // 最优路径的直线步数和对角线步数唯一确定，逐格路径的总长度必须一致
+        EXPECT_EQ(jpsLength, astarLength) << name;
+        EXPECT_EQ(jpsPlusLength, astarLength) << name;
+    }
+}
+
+TEST(PathfindingPerformanceTest, HierarchicalVersusFlatAStar) {
+    Map map = makeObstacleMap(7);
+    const auto queries = makeQueries(map, 17);
+
+    HPAStar hpa(16);
+    auto buildStart = high_resolution_clock::now();
+    const int builtClusters = hpa.precompute(map);
+    const double buildMs =
+        duration<double, std::milli>(high_resolution_clock::now() - buildStart).count();
+
+    AStar astar;
+    size_t astarLength = 0;
+    size_t hpaLength = 0;
+    long long astarExplored = 0;
+    long long hpaExplored = 0;
+    const double astarMs = measure(astar, map, queries, astarLength, &astarExplored);
+    const double hpaMs = measure(hpa, map, queries, hpaLength, &hpaExplored);
+
+    // 局部修改后只重算受影响的簇
+    auto updateStart = high_resolution_clock::now();
+    map.setRectangle({500, 500}, {520, 510}, CellType::Obstacle);
+    map.setCircle({200, 800}, 6, CellType::Walkable);
+    const int updatedClusters = hpa.precompute(map);
+    const double updateMs =
+        duration<double, std::milli>(high_resolution_clock::now() - updateStart).count();
+
+    std::cout << "HPA* on " << kMapSize << "x" << kMapSize << ": A* " << astarMs
+              << " ms/query (" << astarExplored / kQueryCount << " nodes), HPA* " << hpaMs
+              << " ms/query (" << hpaExplored / kQueryCount << " nodes, " << astarMs / hpaMs
+              << "x); abstraction built in " << buildMs << " ms (" << builtClusters
+              << " clusters), updated in " << updateMs << " ms (" << updatedClusters
+              << " clusters)" << std::endl;
+    EXPECT_GT(hpaLength, 0u);
+    EXPECT_LT(updatedClusters, builtClusters);
+}
+
+TEST(PathfindingPerformanceTest, MapRowQueriesVersusPerCellLoops) {
+    const Map map = makeCaveMap(21);
+    const int width = map.getWidth();
+    const int height = map.getHeight();
+    constexpr int kRepeats = 10;
+
+    // 逐格调用 getCellType 的基准
+    auto loopStart = high_resolution_clock::now();
+    int loopCount = 0;
+    std::vector<Point> loopPoints;
+    for (int repeat = 0; repeat < kRepeats; ++repeat) {
+        loopPoints.clear();
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (map.getCellType({x, y}) == CellType::Obstacle) {
+                    loopPoints.push_back({x, y});
+                }
+            }
+        }
+        loopCount = static_cast<int>(loopPoints.size());
+    }
+    const double loopMs =
+        duration<double, std::milli>(high_resolution_clock::now() - loopStart).count() / kRepeats;
+
+    auto countStart = high_resolution_clock::now();
+    int count = 0;
+    for (int repeat = 0; repeat < kRepeats; ++repeat) {
+        count = map.countCellsOfType(CellType::Obstacle);
+    }
+    const double countMs =
+        duration<double, std::milli>(high_resolution_clock::now() - countStart).count() / kRepeats;
+
+    auto findStart = high_resolution_clock::now();
+    std::vector<Point> points;
+    for (int repeat = 0; repeat < kRepeats; ++repeat) {
+        points = map.findCellsOfType(CellType::Obstacle);
+    }
+    const double findMs =
+        duration<double, std::milli>(high_resolution_clock::now() - findStart).count() / kRepeats;
+
+    // 整张地图的洞穴连通区域填充
+    Map filled = map;
+    auto fillStart = high_resolution_clock::now();
+    filled.floodFill(filled.findFirstCellOfType(CellType::Walkable), CellType::Start);
+    const double fillMs =
+        duration<double, std::milli>(high_resolution_clock::now() - fillStart).count();
+
+    const size_t cellBytes = static_cast<size_t>(width) * height * sizeof(CellType);
+    const size_t bitBytes = (static_cast<size_t>(width) + 2 + 63) / 64 * (height + 2) * 8;
+    std::cout << "Map queries on " << width << "x" << height << ": per-cell loop " << loopMs
+              << " ms, countCellsOfType " << countMs << " ms (" << loopMs / countMs
+              << "x), findCellsOfType " << findMs << " ms (" << loopMs / findMs
+              << "x), floodFill " << fillMs << " ms (" << filled.countCellsOfType(CellType::Start)
+              << " cells); storage " << cellBytes / 1024 << " KB types + " << bitBytes / 1024
+              << " KB walkable bits" << std::endl;
+    EXPECT_EQ(count, loopCount);
+    EXPECT_EQ(points.size(), loopPoints.size());
+}
+
+TEST(PathfindingPerformanceTest, IncrementalReplanningVersusAStar) {
+    Map map = makeObstacleMap(7);
+    const auto queries = makeQueries(map, 19);
+    const Point goal = queries[0].second;
+    Point current = queries[0].first;
+
+    AStar astar;
+    DStarLite dstar;
+    std::vector<Point> path;
+    std::vector<Point> expected;
+    ASSERT_TRUE(dstar.findPath(current, goal, map, path));
+    const int initialExpanded = dstar.getLastPathfindingStats().nodesExplored;
+
+    // 每走 5 步在前方路径上放一个障碍，然后两种算法都从当前位置重新规划
+    double astarMs = 0.0;
+    double dstarMs = 0.0;
+    long long astarExpanded = 0;
+    long long dstarExpanded = 0;
+    int replans = 0;
+    while (replans < 100 && path.size() > 30) {
+        current = path[5];
+        map.setCellType(path[20], CellType::Obstacle);
+
+        auto astarStart = high_resolution_clock::now();
+        const bool found = astar.findPath(current, goal, map, expected);
+        astarMs += duration<double, std::milli>(high_resolution_clock::now() - astarStart).count();
+        astarExpanded += astar.getLastPathfindingStats().nodesExplored;
+
+        auto dstarStart = high_resolution_clock::now();
+        ASSERT_EQ(dstar.findPath(current, goal, map, path), found);
+        dstarMs += duration<double, std::milli>(high_resolution_clock::now() - dstarStart).count();
+        dstarExpanded += dstar.getLastPathfindingStats().nodesExplored;
+        EXPECT_TRUE(dstar.getLastReplanStats().incremental);
+        EXPECT_EQ(path.size(), expected.size());
+        replans++;
+    }
+
+    std::cout << "Replanning on " << kMapSize << "x" << kMapSize << " (" << replans
+              << " obstacle updates): A* " << astarMs / replans << " ms/replan ("
+              << astarExpanded / replans << " nodes), D* Lite " << dstarMs / replans
+              << " ms/replan (" << dstarExpanded / replans << " nodes re-expanded, "
+              << astarMs / dstarMs << "x; initial search " << initialExpanded << " nodes)"
+              << std::endl;
+    EXPECT_GT(replans, 0);
+}
+
+TEST(PathfindingPerformanceTest, BatchQueriesVersusSequentialPlanner) {
+    const Map map = makeObstacleMap(7);
+
+    // 64 个单位：一半前往同一个集结点，另一半各自的终点
+    std::vector<PathQuery> queries;
+    const auto rallyQueries = makeQueries(map, 23);
+    for (int group = 0; group < 4; ++group) {
+        for (const auto& query : makeQueries(map, 29 + group)) {
+            queries.push_back({query.first, queries.size() % 2 == 0 ? rallyQueries[0].second
+                                                                    : query.second});
+        }
+    }
+    queries.resize(64);
+
+    PathPlanner planner;
+    planner.enableSmoothing(false);
+    auto sequentialStart = high_resolution_clock::now();
+    size_t sequentialLength = 0;
+    for (const PathQuery& query : queries) {
+        sequentialLength += planner.findPath(query.start, query.goal, map).size();
+    }
+    const double sequentialMs =
+        duration<double, std::milli>(high_resolution_clock::now() - sequentialStart).count();
+
+    BatchOptions unshared;
+    unshared.sharedGoalThreshold = 0;
+    const BatchResult parallel = planner.findPaths(queries, map, unshared);
+    const BatchResult shared = planner.findPaths(queries, map);
+
+    size_t sharedLength = 0;
+    for (const auto& path : shared.paths) {
+        sharedLength += path.size();
+    }
+    std::cout << "Batch of " << queries.size() << " queries on " << kMapSize << "x" << kMapSize
+              << " (" << oneday::common::ThreadPool::instance().getThreadCount()
+              << " pool threads): sequential " << sequentialMs << " ms, batch "
+              << parallel.wallTime << " ms (" << sequentialMs / parallel.wallTime
+              << "x), batch with " << shared.sharedFields << " shared goal field(s) "
+              << shared.wallTime << " ms (" << sequentialMs / shared.wallTime << "x; field "
+              << shared.fieldTime << " ms, " << shared.sharedQueries << " queries from field)"
+              << std::endl;
+    EXPECT_EQ(parallel.pathsFound, shared.pathsFound);
+    EXPECT_EQ(sharedLength, sequentialLength);
+}
+
+TEST(PathfindingPerformanceTest, FlowFieldVersusAStar) {
+    Map map = makeObstacleMap(11);
+    const auto queries = makeQueries(map, 37);
+    const Point goal = queries[0].second;
+
+    // 一次串行构建与一次并行构建
+    FlowField serial;
+    serial.setParallel(false);
+    serial.build(map, goal);
+    FlowField field;
+    field.build(map, goal);
+    const double serialBuildMs = serial.getLastStats().executionTime;
+    const double buildMs = field.getLastStats().executionTime;
+
+    // 所有单位去同一个终点：A* 每个单位搜索一次，流场每步查表
+    AStar astar;
+    std::vector<Point> path;
+    double astarMs = 0.0;
+    double stepMs = 0.0;
+    long long steps = 0;
+    for (const auto& query : queries) {
+        auto astarStart = high_resolution_clock::now();
+        const bool found = astar.findPath(query.first, goal, map, path);
+        astarMs += duration<double, std::milli>(high_resolution_clock::now() - astarStart).count();
+        ASSERT_EQ(found, field.isReachable(query.first));
+
+        auto stepStart = high_resolution_clock::now();
+        for (Point current = query.first; found && current != goal; steps++) {
+            current = field.getNextStep(current);
+        }
+        stepMs += duration<double, std::milli>(high_resolution_clock::now() - stepStart).count();
+    }
+
+    // 地图变化后增量修复与重新构建
+    std::mt19937 rng(41);
+    std::uniform_int_distribution<int> coord(0, kMapSize - 10);
+    double repairMs = 0.0;
+    long long repaired = 0;
+    const int updates = 20;
+    for (int i = 0; i < updates; ++i) {
+        const Point topLeft{coord(rng), coord(rng)};
+        map.setRectangle(topLeft, {topLeft.x + 3, topLeft.y + 3}, CellType::Obstacle);
+        repaired += field.synchronize(map, goal);
+        EXPECT_TRUE(field.getLastStats().incremental);
+        repairMs += field.getLastStats().executionTime;
+    }
+    serial.build(map, goal);
+    EXPECT_EQ(field.getDistance(queries[1].first), serial.getDistance(queries[1].first));
+
+    std::cout << "Flow field on " << kMapSize << "x" << kMapSize << ": build " << serialBuildMs
+              << " ms serial, " << buildMs << " ms parallel ("
+              << oneday::common::ThreadPool::instance().getThreadCount() << " pool threads); "
+              << queries.size() << " agents to one goal: A* " << astarMs << " ms, flow field "
+              << steps << " steps in " << stepMs << " ms; repair after a 4x4 obstacle "
+              << repairMs / updates << " ms (" << repaired / updates << " cells) versus rebuild "
+              << serial.getLastStats().executionTime << " ms" << std::endl;
+    EXPECT_LT(repairMs / updates, serial.getLastStats().executionTime);
+}
+
+TEST(PathfindingPerformanceTest, AnyAngleSearchVersusSmoothedAStar) {
+    const Map map = makeOpenMap(13);
+    const auto queries = makeQueries(map, 43);
+
+    // 视线检查：按段整字检查与逐格 Bresenham，分别用随机方向和接近水平/垂直的线段
+    std::mt19937 rng(47);
+    std::uniform_int_distribution<int> coord(0, kMapSize - 1);
+    std::uniform_int_distribution<int> offset(-40, 40);
+    std::vector<std::pair<Point, Point>> randomSegments;
+    std::vector<std::pair<Point, Point>> shallowSegments;
+    while (shallowSegments.size() < 20000) {
+        const Point from{coord(rng), coord(rng)};
+        randomSegments.push_back({from, {coord(rng), coord(rng)}});
+        const Point to = shallowSegments.size() % 2 == 0 ? Point{coord(rng), from.y + offset(rng)}
+                                                         : Point{from.x + offset(rng), coord(rng)};
+        if (map.isValidPosition(to)) {
+            shallowSegments.push_back({from, to});
+        }
+    }
+    auto perCell = [&map](const Point& from, const Point& to) {
+        const int dx = std::abs(to.x - from.x);
+        const int dy = std::abs(to.y - from.y);
+        int x = from.x;
+        int y = from.y;
+        int error = dx - dy;
+        while (map.isWalkableUnchecked(x, y)) {
+            if (x == to.x && y == to.y) {
+                return true;
+            }
+            const int error2 = 2 * error;
+            if (error2 > -dy) {
+                error -= dy;
+                x += (to.x > from.x) ? 1 : -1;
+            }
+            if (error2 < dx) {
+                error += dx;
+                y += (to.y > from.y) ? 1 : -1;
+            }
+        }
+        return false;
+    };
+    std::cout << "Line of sight on " << kMapSize << "x" << kMapSize;
+    for (const auto* segments : {&randomSegments, &shallowSegments}) {
+        int visibleWords = 0;
+        int visibleCells = 0;
+        auto wordStart = high_resolution_clock::now();
+        for (const auto& segment : *segments) {
+            visibleWords += map.hasLineOfSight(segment.first, segment.second) ? 1 : 0;
+        }
+        const double wordMs =
+            duration<double, std::milli>(high_resolution_clock::now() - wordStart).count();
+        auto cellStart = high_resolution_clock::now();
+        for (const auto& segment : *segments) {
+            visibleCells += perCell(segment.first, segment.second) ? 1 : 0;
+        }
+        const double cellMs =
+            duration<double, std::milli>(high_resolution_clock::now() - cellStart).count();
+        EXPECT_EQ(visibleWords, visibleCells);
+        std::cout << (segments == &randomSegments ? ": " : "; ") << segments->size()
+                  << (segments == &randomSegments ? " random" : " near-axis")
+                  << " segments, word runs " << wordMs << " ms, per cell " << cellMs << " ms ("
+                  << cellMs / wordMs << "x)";
+    }
+    std::cout << std::endl;
+
+    // A* 加平滑后处理，与搜索中直接拉直的 Theta*
+    AStar astar;
+    std::vector<Point> path;
+    double astarMs = 0.0;
+    double smoothMs = 0.0;
+    double astarLength = 0.0;
+    for (const auto& query : queries) {
+        auto searchStart = high_resolution_clock::now();
+        astar.findPath(query.first, query.second, map, path);
+        auto smoothStart = high_resolution_clock::now();
+        const std::vector<Point> smoothed = astar.smoothPath(path, map);
+        auto smoothEnd = high_resolution_clock::now();
+        astarMs += duration<double, std::milli>(smoothStart - searchStart).count();
+        smoothMs += duration<double, std::milli>(smoothEnd - smoothStart).count();
+        for (size_t i = 1; i < smoothed.size(); ++i) {
+            astarLength += std::hypot(smoothed[i].x - smoothed[i - 1].x,
+                                      smoothed[i].y - smoothed[i - 1].y);
+        }
+    }
+
+    std::cout << "Any-angle paths: A* " << astarMs / queries.size() << " ms + smoothing "
+              << smoothMs / queries.size() << " ms/query (length " << astarLength << ")";
+    for (ThetaStar::Variant variant : {ThetaStar::Variant::Basic, ThetaStar::Variant::Lazy}) {
+        ThetaStar theta(variant);
+        double length = 0.0;
+        long long checks = 0;
+        auto thetaStart = high_resolution_clock::now();
+        for (const auto& query : queries) {
+            ASSERT_TRUE(theta.findPath(query.first, query.second, map, path));
+            checks += theta.getLastLineOfSightChecks();
+            for (size_t i = 1; i < path.size(); ++i) {
+                length += std::hypot(path[i].x - path[i - 1].x, path[i].y - path[i - 1].y);
+            }
+        }
+        const double thetaMs =
+            duration<double, std::milli>(high_resolution_clock::now() - thetaStart).count();
+        std::cout << ", " << (variant == ThetaStar::Variant::Lazy ? "Lazy Theta* " : "Theta* ")
+                  << thetaMs / queries.size() << " ms/query (length " << length << ", "
+                  << checks / static_cast<long long>(queries.size()) << " LOS checks/query)";
+        EXPECT_LE(length, astarLength + 1e-6);
+    }
+    std::cout << std::endl;
+}
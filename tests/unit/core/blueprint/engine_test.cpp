@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
+#include "core/blueprint/async_scheduler.h"
 #include "core/blueprint/engine.h"
+#include "core/blueprint/execution_context.h"
+#include "core/blueprint/execution_plan.h"
 #include "core/blueprint/graph.h"
+#include "core/blueprint/nodes/control_flow_nodes.h"
+#include "core/blueprint/nodes/math_nodes.h"
+#include "core/blueprint/nodes/variable_nodes.h"
+#include <thread>
 
 using namespace oneday::core::blueprint;
 
@@ -35,4 +42,346 @@ TEST_F(EngineTest, ExecuteEmptyGraph) {
 TEST_F(EngineTest, PauseAndResume) {
     EXPECT_NO_THROW(engine->pauseExecution());
     EXPECT_NO_THROW(engine->resumeExecution());
-}
\ No newline at end of file
+}
+
+TEST_F(EngineTest, ExecuteDataflowGraph) {
+    BlueprintGraph graph;
+    auto first = std::make_unique<AddNode>("add1");
+    auto second = std::make_unique<AddNode>("add2");
+    first->setInputValue("a", BlueprintValue(1.0f));
+    first->setInputValue("b", BlueprintValue(2.0f));
+    second->setInputValue("b", BlueprintValue(10.0f));
+    BaseNode* output = second.get();
+    graph.addNode(std::move(first));
+    graph.addNode(std::move(second));
+    ASSERT_TRUE(graph.addConnection(NodeConnection("add1", "result", "add2", "a")));
+
+    auto result = engine->executeGraph(graph);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.nodesExecuted, 2);
+    EXPECT_FLOAT_EQ(output->getOutputValue("result").get<float>(), 13.0f);
+}
+
+TEST_F(EngineTest, ExecuteLoopWithVariable) {
+    BlueprintGraph graph;
+    auto loop = std::make_unique<LoopNode>("loop");
+    loop->setInputValue("count", BlueprintValue(3));
+    auto increment = std::make_unique<IncrementVariableNode>("inc");
+    increment->setVariableName("counter");
+    increment->setInputValue("increment", BlueprintValue(1.0f));
+    graph.addNode(std::make_unique<StartNode>("start"));
+    graph.addNode(std::move(loop));
+    graph.addNode(std::move(increment));
+    ASSERT_TRUE(graph.addConnection(NodeConnection("start", "exec_out", "loop", "exec_in")));
+    ASSERT_TRUE(graph.addConnection(NodeConnection("loop", "loop_body", "inc", "exec_in")));
+
+    ExecutionContext context;
+    context.setVariable("counter", BlueprintValue(0.0f));
+    auto result = engine->executeGraph(graph, context);
+    EXPECT_TRUE(result.success);
+    EXPECT_FLOAT_EQ(context.getVariable("counter").get<float>(), 3.0f);
+
+    // 再次执行时循环计数重新开始
+    result = engine->executeGraph(graph, context);
+    EXPECT_TRUE(result.success);
+    EXPECT_FLOAT_EQ(context.getVariable("counter").get<float>(), 6.0f);
+}
+
+TEST_F(EngineTest, CompiledPlanIsCachedUntilGraphChanges) {
+    BlueprintGraph graph;
+    graph.addNode(std::make_unique<StartNode>("start"));
+
+    auto plan = engine->compileGraph(graph);
+    ASSERT_NE(plan, nullptr);
+    EXPECT_EQ(engine->compileGraph(graph), plan);
+
+    graph.addNode(std::make_unique<EndNode>("end"));
+    EXPECT_NE(engine->compileGraph(graph), plan);
+}
+
+TEST_F(EngineTest, CompilesLongReversedPureChain) {
+    // 每个节点的结果接到前一个节点的 a 输入，从第一个节点出发的依赖链深达 100k
+    constexpr int chainLength = 100000;
+    BlueprintGraph graph;
+    for (int i = 0; i < chainLength; ++i) {
+        auto add = std::make_unique<AddNode>("add" + std::to_string(i));
+        add->setInputValue("a", BlueprintValue(0.0f));
+        add->setInputValue("b", BlueprintValue(1.0f));
+        graph.addNode(std::move(add));
+    }
+    for (int i = 1; i < chainLength; ++i) {
+        ASSERT_TRUE(graph.addConnection(NodeConnection(
+            "add" + std::to_string(i), "result", "add" + std::to_string(i - 1), "a")));
+    }
+
+    auto plan = engine->compileGraph(graph);
+    ASSERT_NE(plan, nullptr);
+    ASSERT_EQ(plan->dataflowOrder.size(), static_cast<size_t>(chainLength));
+    EXPECT_EQ(plan->dataflowOrder.front(), static_cast<uint32_t>(chainLength - 1));
+    EXPECT_EQ(plan->dataflowOrder.back(), 0u);
+}
+
+TEST_F(EngineTest, DataCycleReportsCompileError) {
+    BlueprintGraph graph;
+    graph.addNode(std::make_unique<AddNode>("add1"));
+    graph.addNode(std::make_unique<AddNode>("add2"));
+    ASSERT_TRUE(graph.addConnection(NodeConnection("add1", "result", "add2", "a")));
+    ASSERT_TRUE(graph.addConnection(NodeConnection("add2", "result", "add1", "a")));
+
+    ExecutionContext context;
+    auto result = engine->executeGraph(graph, context);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.message, "Graph compilation failed");
+    EXPECT_EQ(result.errorDetails, "Data connections form a cycle");
+    EXPECT_EQ(context.getError(), result.errorDetails);
+
+    ExecutionContext runContext;
+    ExecutionRun run;
+    EXPECT_FALSE(engine->startRun(graph, runContext, run));
+    EXPECT_TRUE(run.finished);
+    EXPECT_EQ(run.result.errorDetails, "Data connections form a cycle");
+    EXPECT_EQ(runContext.getError(), run.result.errorDetails);
+}
+
+TEST_F(EngineTest, ConnectionConvertsPortTypes) {
+    BlueprintGraph graph;
+    auto modulo = std::make_unique<ModuloNode>("mod");
+    modulo->setInputValue("a", BlueprintValue(7));
+    modulo->setInputValue("b", BlueprintValue(4));
+    auto add = std::make_unique<AddNode>("add");
+    add->setInputValue("b", BlueprintValue(0.5f));
+    BaseNode* output = add.get();
+    graph.addNode(std::move(modulo));
+    graph.addNode(std::move(add));
+    ASSERT_TRUE(graph.addConnection(NodeConnection("mod", "result", "add", "a")));
+
+    auto plan = engine->compileGraph(graph);
+    ASSERT_NE(plan, nullptr);
+    ASSERT_EQ(plan->inputBindings.size(), 1u);
+    EXPECT_EQ(plan->inputBindings[0].convert,
+              TypeConversionManager::instance().getConverter(DataType::Integer, DataType::Float));
+
+    auto result = engine->executeGraph(graph);
+    EXPECT_TRUE(result.success);
+    EXPECT_FLOAT_EQ(output->getOutputValue("result").get<float>(), 3.5f);
+}
+
+TEST_F(EngineTest, ParallelWavefrontMatchesSerial) {
+    BlueprintGraph graph;
+    std::vector<BaseNode*> outputs;
+    for (int i = 0; i < 64; ++i) {
+        auto add = std::make_unique<AddNode>("add" + std::to_string(i));
+        add->setInputValue("a", BlueprintValue(static_cast<float>(i)));
+        add->setInputValue("b", BlueprintValue(1.0f));
+        auto multiply = std::make_unique<MultiplyNode>("mul" + std::to_string(i));
+        multiply->setInputValue("b", BlueprintValue(2.0f));
+        outputs.push_back(multiply.get());
+        graph.addNode(std::move(add));
+        graph.addNode(std::move(multiply));
+        ASSERT_TRUE(graph.addConnection(NodeConnection(
+            "add" + std::to_string(i), "result", "mul" + std::to_string(i), "a")));
+    }
+
+    engine->setParallelExecution(true, 8);
+    auto result = engine->executeGraph(graph);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.nodesExecuted, 128);
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_FLOAT_EQ(outputs[i]->getOutputValue("result").get<float>(), (i + 1) * 2.0f);
+    }
+
+    engine->setParallelExecution(false);
+    result = engine->executeGraph(graph);
+    EXPECT_TRUE(result.success);
+    EXPECT_FLOAT_EQ(outputs[63]->getOutputValue("result").get<float>(), 128.0f);
+}
+
+namespace {
+
+/**
+ * @brief 没有声明可并行的纯数据节点，记录执行所在的线程
+ */
+class ThreadRecordingNode : public BaseNode {
+public:
+    explicit ThreadRecordingNode(const std::string& id) : BaseNode(id, NodeType::Custom) {
+        initializePorts();
+    }
+
+    std::unique_ptr<BaseNode> clone() const override {
+        return std::make_unique<ThreadRecordingNode>(getId());
+    }
+
+    std::thread::id thread;
+
+protected:
+    NodeExecutionResult executeInternal(ExecutionContext&) override {
+        thread = std::this_thread::get_id();
+        setOutputValue(0, BlueprintValue(1.0f));
+        NodeExecutionResult result;
+        result.success = true;
+        return result;
+    }
+
+    void initializePorts() override {
+        addOutputPort("value", "Value", DataType::Float);
+    }
+};
+
+}  // namespace
+
+TEST_F(EngineTest, ParallelWavefrontOnlyDispatchesParallelSafeNodes) {
+    BlueprintGraph graph;
+    std::vector<ThreadRecordingNode*> recorders;
+    for (int i = 0; i < 32; ++i) {
+        auto recorder = std::make_unique<ThreadRecordingNode>("rec" + std::to_string(i));
+        recorders.push_back(recorder.get());
+        graph.addNode(std::move(recorder));
+        auto add = std::make_unique<AddNode>("add" + std::to_string(i));
+        add->setInputValue("a", BlueprintValue(static_cast<float>(i)));
+        add->setInputValue("b", BlueprintValue(1.0f));
+        graph.addNode(std::move(add));
+    }
+
+    // 同一波前内可并行的加法节点排在前面
+    auto plan = engine->compileGraph(graph);
+    ASSERT_NE(plan, nullptr);
+    ASSERT_EQ(plan->wavefronts.size(), 1u);
+    ASSERT_EQ(plan->parallelCounts.size(), 1u);
+    EXPECT_EQ(plan->parallelCounts[0], 32u);
+    for (uint32_t k = 0; k < 64; ++k) {
+        EXPECT_EQ(plan->nodes[plan->dataflowOrder[k]].isParallelSafe, k < 32);
+    }
+
+    engine->setParallelExecution(true, 8);
+    auto result = engine->executeGraph(graph);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.nodesExecuted, 64);
+    for (ThreadRecordingNode* recorder : recorders) {
+        EXPECT_EQ(recorder->thread, std::this_thread::get_id());
+    }
+}
+
+namespace {
+
+/**
+ * @brief 构建 开始 -> 延迟 -> 变量自增 的图表
+ */
+std::unique_ptr<BlueprintGraph> makeDelayedIncrementGraph(float delaySeconds) {
+    auto graph = std::make_unique<BlueprintGraph>();
+    auto delay = std::make_unique<DelayNode>("delay");
+    delay->setInputValue("delay", BlueprintValue(delaySeconds));
+    auto increment = std::make_unique<IncrementVariableNode>("inc");
+    increment->setVariableName("counter");
+    increment->setInputValue("increment", BlueprintValue(1.0f));
+    graph->addNode(std::make_unique<StartNode>("start"));
+    graph->addNode(std::move(delay));
+    graph->addNode(std::move(increment));
+    graph->addConnection(NodeConnection("start", "exec_out", "delay", "exec_in"));
+    graph->addConnection(NodeConnection("delay", "exec_out", "inc", "exec_in"));
+    return graph;
+}
+
+}  // namespace
+
+TEST_F(EngineTest, DelaySuspendsUntilResumed) {
+    auto graph = makeDelayedIncrementGraph(10.0f);
+    ExecutionContext context;
+    context.setVariable("counter", BlueprintValue(0.0f));
+
+    AsyncScheduler scheduler(*engine);
+    int completed = 0;
+    scheduler.start(*graph, &context, [&](AsyncScheduler::TaskId, const ExecutionResult& result) {
+        EXPECT_TRUE(result.success);
+        ++completed;
+    });
+    EXPECT_EQ(scheduler.getActiveCount(), 1u);
+    EXPECT_TRUE(context.isWaiting());
+    EXPECT_FLOAT_EQ(context.getVariable("counter").get<float>(), 0.0f);
+
+    auto now = AsyncScheduler::Clock::now();
+    EXPECT_EQ(scheduler.update(now), 0u);
+    EXPECT_EQ(scheduler.update(now + std::chrono::seconds(11)), 1u);
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(scheduler.getActiveCount(), 0u);
+    EXPECT_FLOAT_EQ(context.getVariable("counter").get<float>(), 1.0f);
+}
+
+TEST_F(EngineTest, SchedulerMultiplexesDelayedGraphs) {
+    constexpr int kGraphCount = 200;
+    std::vector<std::unique_ptr<BlueprintGraph>> graphs;
+    std::vector<ExecutionContext> contexts(kGraphCount);
+    AsyncScheduler scheduler(*engine);
+    int completed = 0;
+    for (int i = 0; i < kGraphCount; ++i) {
+        graphs.push_back(makeDelayedIncrementGraph(0.05f));
+        contexts[i].setVariable("counter", BlueprintValue(0.0f));
+        scheduler.start(*graphs.back(), &contexts[i],
+                        [&](AsyncScheduler::TaskId, const ExecutionResult& result) {
+                            completed += result.success ? 1 : 0;
+                        });
+    }
+
+    // 串行阻塞等待需要 10 秒，单线程协作调度只需等待一次延迟
+    auto begin = std::chrono::steady_clock::now();
+    scheduler.runUntilIdle();
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    EXPECT_EQ(completed, kGraphCount);
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+    for (const auto& context : contexts) {
+        EXPECT_FLOAT_EQ(context.getVariable("counter").get<float>(), 1.0f);
+    }
+}
+
+TEST_F(EngineTest, SchedulerRejectsSecondRunOfSuspendedGraph) {
+    auto graph = makeDelayedIncrementGraph(10.0f);
+    ExecutionContext context;
+    context.setVariable("counter", BlueprintValue(0.0f));
+    AsyncScheduler scheduler(*engine);
+
+    int succeeded = 0;
+    const auto first = scheduler.start(*graph, &context,
+                                       [&](AsyncScheduler::TaskId, const ExecutionResult& result) {
+                                           succeeded += result.success ? 1 : 0;
+                                       });
+    ASSERT_NE(first, AsyncScheduler::kInvalidTaskId);
+    EXPECT_TRUE(scheduler.isGraphActive(*graph));
+
+    // 第二次开始被拒绝，不会重置挂起中执行的节点状态
+    std::string message;
+    auto onRejected = [&](AsyncScheduler::TaskId id, const ExecutionResult& result) {
+        EXPECT_EQ(id, AsyncScheduler::kInvalidTaskId);
+        EXPECT_FALSE(result.success);
+        message = result.message;
+    };
+    const auto second = scheduler.start(*graph, nullptr, onRejected);
+    EXPECT_EQ(second, AsyncScheduler::kInvalidTaskId);
+    EXPECT_EQ(message, "Graph already has an active execution");
+    EXPECT_EQ(scheduler.getActiveCount(), 1u);
+
+    const auto later = AsyncScheduler::Clock::now() + std::chrono::seconds(11);
+    EXPECT_EQ(scheduler.update(later), 1u);
+    EXPECT_EQ(succeeded, 1);
+    EXPECT_FLOAT_EQ(context.getVariable("counter").get<float>(), 1.0f);
+    EXPECT_FALSE(scheduler.isGraphActive(*graph));
+
+    // 执行结束或取消后图表可以再次开始
+    const auto third = scheduler.start(*graph, &context);
+    ASSERT_NE(third, AsyncScheduler::kInvalidTaskId);
+    EXPECT_TRUE(scheduler.cancel(third));
+    EXPECT_FALSE(scheduler.isGraphActive(*graph));
+    EXPECT_NE(scheduler.start(*graph, &context), AsyncScheduler::kInvalidTaskId);
+}
+
+TEST_F(EngineTest, CancelSuspendedRun) {
+    auto graph = makeDelayedIncrementGraph(10.0f);
+    AsyncScheduler scheduler(*engine);
+    std::string message;
+    auto id = scheduler.start(*graph, nullptr,
+                              [&](AsyncScheduler::TaskId, const ExecutionResult& result) {
+                                  message = result.message;
+                              });
+    EXPECT_TRUE(scheduler.cancel(id));
+    EXPECT_EQ(message, "Execution cancelled");
+    EXPECT_FALSE(scheduler.getNextWakeTime().has_value());
+    EXPECT_FALSE(scheduler.cancel(id));
+}
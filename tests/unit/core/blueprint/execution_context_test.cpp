@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "core/blueprint/execution_context.h"
+
+using namespace oneday::core::blueprint;
+
+TEST(ExecutionContextTest, ScopesShadowAndRestore) {
+    ExecutionContext context;
+    const VariableId counter = VariableNameTable::instance().intern("counter");
+    EXPECT_EQ(VariableNameTable::instance().find("counter"), counter);
+
+    context.setVariable("counter", BlueprintValue(1));
+    context.pushScope();
+    EXPECT_EQ(context.getVariable(counter).get<int>(), 1);
+
+    context.setVariable(counter, BlueprintValue(2));
+    context.setVariable("local", BlueprintValue(true));
+    EXPECT_EQ(context.getVariable("counter").get<int>(), 2);
+    EXPECT_EQ(context.getScopeDepth(), 2);
+
+    context.popScope();
+    EXPECT_EQ(context.getVariable(counter).get<int>(), 1);
+    EXPECT_FALSE(context.hasVariable("local"));
+    EXPECT_EQ(context.getScopeDepth(), 1);
+}
+
+TEST(ExecutionContextTest, DeleteRestoresOuterBinding) {
+    ExecutionContext context;
+    context.setVariable("value", BlueprintValue(1.0f));
+    context.pushScope();
+    context.setVariable("value", BlueprintValue(2.0f));
+    context.setVariable("other", BlueprintValue(3.0f));
+
+    EXPECT_TRUE(context.deleteVariable("value"));
+    EXPECT_FLOAT_EQ(context.getVariable("value").get<float>(), 1.0f);
+    EXPECT_EQ(context.getAllVariableNames().size(), 2u);
+
+    context.popScope();
+    EXPECT_TRUE(context.deleteVariable("value"));
+    EXPECT_FALSE(context.hasVariable("value"));
+    EXPECT_FALSE(context.deleteVariable("missing"));
+}
@@ -1,6 +1,8 @@
 #include "core/blueprint/graph.h"
+#include "core/blueprint/nodes/math_nodes.h"
 
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 using namespace oneday::core::blueprint;
 
@@ -45,4 +47,63 @@ TEST_F(GraphTest, ImportFromJson) {
     EXPECT_TRUE(graph->importFromJson(testJson));
     EXPECT_EQ(graph->getName(), "Test Graph");
     EXPECT_EQ(graph->getId(), "test_graph_123");
-}
\ No newline at end of file
+}
+
+TEST_F(GraphTest, ExportWritesNodesAndConnections) {
+    graph->setName("Exported");
+    graph->addNode(std::make_unique<AddNode>("a"));
+    graph->addNode(std::make_unique<AddNode>("b"));
+    graph->findNode("a")->setInputValue("b", BlueprintValue(2.5f));
+    NodeConnection ab("a", "result", "b", "a");
+    ab.id = "ab";
+    ASSERT_TRUE(graph->addConnection(ab));
+
+    const nlohmann::json json = nlohmann::json::parse(graph->exportToJson());
+    ASSERT_EQ(json["nodes"].size(), 2u);
+    EXPECT_EQ(json["nodes"][0]["id"], "a");
+    EXPECT_EQ(json["nodes"][0]["inputs"]["b"], "2.500");
+    EXPECT_EQ(json["nodes"][1]["id"], "b");
+    ASSERT_EQ(json["connections"].size(), 1u);
+    EXPECT_EQ(json["connections"][0]["id"], "ab");
+    EXPECT_EQ(json["connections"][0]["sourceNode"], "a");
+    EXPECT_EQ(json["connections"][0]["targetPort"], "a");
+
+    // 节点无法重建：导入报错，目标图表保持不变
+    BlueprintGraph imported("existing");
+    EXPECT_FALSE(imported.importFromJson(json.dump()));
+    EXPECT_EQ(imported.getId(), "existing");
+}
+
+TEST_F(GraphTest, ConnectionIndexesFollowEdits) {
+    graph->addNode(std::make_unique<AddNode>("a"));
+    graph->addNode(std::make_unique<AddNode>("b"));
+    graph->addNode(std::make_unique<AddNode>("c"));
+
+    NodeConnection ab("a", "result", "b", "a");
+    ab.id = "ab";
+    NodeConnection bc("b", "result", "c", "a");
+    bc.id = "bc";
+    NodeConnection ac("a", "result", "c", "b");
+    ac.id = "ac";
+    ASSERT_TRUE(graph->addConnection(ab));
+    ASSERT_TRUE(graph->addConnection(bc));
+    ASSERT_TRUE(graph->addConnection(ac));
+
+    EXPECT_EQ(graph->getOutputConnectionsView("a").size(), 2u);
+    EXPECT_EQ(graph->getInputConnectionsView("c").size(), 2u);
+    EXPECT_EQ(graph->getTopologicalOrder().size(), 3u);
+
+    // 删除中间的连接后，被交换位置的连接仍能通过索引找到
+    ASSERT_TRUE(graph->removeConnection("ab"));
+    ASSERT_NE(graph->findConnection("ac"), nullptr);
+    EXPECT_EQ(graph->findConnection("ac")->targetPortId, "b");
+    EXPECT_EQ(graph->getOutputConnectionsView("a").size(), 1u);
+    EXPECT_EQ(graph->getOutputConnectionsView("a")[0].id, "ac");
+
+    ASSERT_TRUE(graph->removeNode("b"));
+    EXPECT_EQ(graph->findNode("b"), nullptr);
+    EXPECT_NE(graph->findNode("c"), nullptr);
+    EXPECT_EQ(graph->getConnectionCount(), 1u);
+    EXPECT_EQ(graph->getInputConnections("c").size(), 1u);
+    EXPECT_FALSE(graph->hasCyclicDependency());
+}
@@ -22,6 +22,16 @@ TEST_F(LoggerTest, LogMessages) {
     EXPECT_NO_THROW(Logger::critical("Test critical message"));
 }
 
+TEST_F(LoggerTest, LogFormattedMessages) {
+    EXPECT_NO_THROW(Logger::trace("Test trace {}", 1));
+    EXPECT_NO_THROW(Logger::debug("Test debug {}", 2));
+    EXPECT_NO_THROW(Logger::info("Test info {}", 3));
+    EXPECT_NO_THROW(Logger::warn("Test warn {}", 4));
+    EXPECT_NO_THROW(Logger::warning("Test warning {}", 5));
+    EXPECT_NO_THROW(Logger::error("Test error {}", 6));
+    EXPECT_NO_THROW(Logger::critical("Test critical {} {}", 7, "x"));
+}
+
 TEST_F(LoggerTest, SetLevel) {
     EXPECT_NO_THROW(Logger::setLevel(Logger::Level::Info));
     EXPECT_NO_THROW(Logger::setLevel(Logger::Level::Debug));
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "core/common/parallel_utils.h"
+#include "core/common/thread_pool.h"
+#include <atomic>
 #include <vector>
 #include <numeric>
 #include <chrono>
@@ -195,3 +197,71 @@ TEST_F(ParallelUtilsTest, PerformanceTest) {
     std::cout << "并行处理 " << large_size << " 个元素耗时: " 
               << duration.count() << " ms" << std::endl;
 }
+
+// 测试常驻线程池的并行for
+TEST_F(ParallelUtilsTest, ThreadPoolParallelForTest) {
+    ThreadPool pool(4);
+    std::vector<int> data(10000, 0);
+
+    pool.parallelFor(data.size(), [&data](size_t i) { data[i] = static_cast<int>(i); }, 64);
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(data[i], static_cast<int>(i));
+    }
+
+    // 任务异常在调用线程重新抛出
+    EXPECT_THROW(pool.parallelFor(100,
+                                  [](size_t i) {
+                                      if (i == 42) {
+                                          throw std::runtime_error("task failed");
+                                      }
+                                  }),
+                 std::runtime_error);
+
+    // 工作线程内部嵌套调用不会死锁
+    std::atomic<int> total{0};
+    pool.parallelFor(8, [&pool, &total](size_t) {
+        pool.parallelFor(8, [&total](size_t) { total.fetch_add(1); });
+    });
+    EXPECT_EQ(total.load(), 64);
+}
+
+// 测试任务组：嵌套提交、等待时帮忙执行、异常传播
+TEST_F(ParallelUtilsTest, ThreadPoolTaskGroupTest) {
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+
+    ThreadPool::TaskGroup group(pool);
+    for (int i = 0; i < 16; ++i) {
+        group.run([&pool, &total]() {
+            // 任务内部再开任务组，外层工作线程等待时会执行队列中的任务
+            ThreadPool::TaskGroup inner(pool);
+            for (int j = 0; j < 16; ++j) {
+                inner.run([&total]() { total.fetch_add(1); });
+            }
+            inner.wait();
+        });
+    }
+    group.wait();
+    EXPECT_EQ(total.load(), 256);
+
+    group.run([]() { throw std::runtime_error("task failed"); });
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_NO_THROW(group.wait());
+}
+
+// 测试并行归约只计入一次初始值，且嵌套在 parallel_for 中也能正常完成
+TEST_F(ParallelUtilsTest, ParallelReduceNestedTest) {
+    std::vector<int> data(10000);
+    std::iota(data.begin(), data.end(), 1);
+    const long long expected = std::accumulate(data.begin(), data.end(), 100LL);
+
+    std::vector<long long> sums(8, 0);
+    ParallelUtils::parallel_for(0, sums.size(), [&data, &sums](size_t i) {
+        sums[i] = ParallelUtils::parallel_reduce(data, 100LL, [](long long a, long long b) {
+            return a + b;
+        });
+    });
+    for (long long sum : sums) {
+        EXPECT_EQ(sum, expected);
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "core/image/cascade_registry.h"
+#include "core/image/processor.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace oneday::image;
+
+namespace {
+
+/**
+ * @brief 测试用的级联分类器文件（通过 ONEDAY_TEST_CASCADE 环境变量指定，例如 OpenCV 自带的
+ * haarcascade_frontalface_default.xml）
+ */
+std::string testCascadePath() {
+    const char* path = std::getenv("ONEDAY_TEST_CASCADE");
+    return path ? std::string(path) : std::string();
+}
+
+}  // namespace
+
+// 测试不存在或无效的分类器文件被拒绝，未注册的分类器返回空结果
+TEST(CascadeRegistryTest, RejectsMissingAndInvalidFiles) {
+    CascadeRegistry registry;
+    EXPECT_FALSE(registry.load("missing", "nonexistent_cascade.xml"));
+    EXPECT_FALSE(registry.has("missing"));
+
+    const std::filesystem::path invalidPath =
+        std::filesystem::temp_directory_path() / "cascade_registry_invalid.xml";
+    {
+        std::ofstream file(invalidPath);
+        file << "<?xml version=\"1.0\"?>\n<opencv_storage>\n</opencv_storage>\n";
+    }
+    EXPECT_FALSE(registry.load("invalid", invalidPath.string()));
+    EXPECT_FALSE(registry.has("invalid"));
+    std::filesystem::remove(invalidPath);
+
+    const cv::Mat frame(120, 160, CV_8UC3, cv::Scalar(40, 80, 120));
+    EXPECT_TRUE(registry.detect("missing", frame).empty());
+    const auto results = registry.detectBatch(frame, {{"missing", {}}, {"invalid", {}}});
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].empty());
+    EXPECT_TRUE(results[1].empty());
+}
+
+// 测试预处理只做一次灰度转换和均衡化
+TEST(CascadeRegistryTest, PreprocessConvertsAndEqualizes) {
+    cv::Mat frame(90, 120, CV_8UC3);
+    cv::RNG rng(7);
+    rng.fill(frame, cv::RNG::UNIFORM, cv::Scalar::all(60), cv::Scalar::all(120));
+
+    cv::Mat gray;
+    ASSERT_TRUE(CascadeRegistry::preprocess(frame, gray));
+    cv::Mat expected;
+    cv::cvtColor(frame, expected, cv::COLOR_BGR2GRAY);
+    cv::equalizeHist(expected, expected);
+    EXPECT_EQ(gray.type(), CV_8UC1);
+    EXPECT_EQ(cv::norm(gray, expected, cv::NORM_INF), 0.0);
+
+    ASSERT_TRUE(CascadeRegistry::preprocess(frame, gray, false));
+    cv::cvtColor(frame, expected, cv::COLOR_BGR2GRAY);
+    EXPECT_EQ(cv::norm(gray, expected, cv::NORM_INF), 0.0);
+
+    EXPECT_FALSE(CascadeRegistry::preprocess(cv::Mat(), gray));
+}
+
+// 测试真实分类器：批量检测、缩小检测与逐个检测结果一致，多线程并发检测安全
+TEST(CascadeRegistryTest, BatchDetectionMatchesSingleDetection) {
+    const std::string cascadePath = testCascadePath();
+    if (cascadePath.empty()) {
+        GTEST_SKIP() << "ONEDAY_TEST_CASCADE is not set";
+    }
+
+    CascadeRegistry registry;
+    ASSERT_TRUE(registry.load("cascade", cascadePath));
+    ASSERT_TRUE(registry.has("cascade"));
+
+    cv::Mat frame(360, 640, CV_8UC3);
+    cv::RNG rng(3);
+    rng.fill(frame, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    CascadeDetectOptions half;
+    half.downscale = 0.5;
+    CascadeDetectOptions region;
+    region.roi = cv::Rect(100, 50, 300, 200);
+    const std::vector<CascadeRequest> requests = {
+        {"cascade", {}}, {"cascade", half}, {"cascade", region}, {"cascade", half}};
+
+    cv::Mat gray;
+    ASSERT_TRUE(CascadeRegistry::preprocess(frame, gray));
+    const auto batch = registry.detectBatch(frame, requests);
+    ASSERT_EQ(batch.size(), requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        EXPECT_EQ(batch[i], registry.detect("cascade", gray, requests[i].options));
+    }
+    EXPECT_EQ(batch[1], batch[3]);
+    for (const cv::Rect& object : batch[2]) {
+        EXPECT_EQ(object & region.roi, object);
+    }
+
+    // 多个线程同时使用同一分类器（各自的副本）
+    std::vector<std::vector<std::vector<cv::Rect>>> concurrent(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < concurrent.size(); ++t) {
+        threads.emplace_back([&, t]() { concurrent[t] = registry.detectBatch(frame, requests); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& results : concurrent) {
+        EXPECT_EQ(results, batch);
+    }
+
+    // ImageProcessor::detectObjects 复用注册表中按路径注册的分类器
+    ImageProcessor processor;
+    cv::Mat unequalized;
+    ASSERT_TRUE(CascadeRegistry::preprocess(frame, unequalized, false));
+    EXPECT_EQ(processor.detectObjects(frame, cascadePath),
+              CascadeRegistry::instance().detect(cascadePath, unequalized));
+    EXPECT_TRUE(CascadeRegistry::instance().has(cascadePath));
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "core/image/color_detector.h"
+
+#include <opencv2/imgproc.hpp>
+
+using namespace oneday::image;
+
+namespace {
+
+/**
+ * @brief 红色需要两个色相区间（靠近 0 和靠近 180）
+ */
+const std::vector<ColorRange> kRedRanges = {
+    {cv::Scalar(0, 100, 100), cv::Scalar(10, 255, 255)},
+    {cv::Scalar(170, 100, 100), cv::Scalar(179, 255, 255)}};
+const std::vector<ColorRange> kGreenRanges = {{cv::Scalar(50, 100, 100), cv::Scalar(70, 255, 255)}};
+
+void expectBlob(const ColorBlob& blob, int color, const cv::Rect& rect) {
+    EXPECT_EQ(blob.color, color);
+    EXPECT_EQ(blob.area, rect.area());
+    EXPECT_EQ(blob.boundingBox, rect);
+    EXPECT_NEAR(blob.centroid.x, rect.x + (rect.width - 1) / 2.0, 1e-6);
+    EXPECT_NEAR(blob.centroid.y, rect.y + (rect.height - 1) / 2.0, 1e-6);
+}
+
+ColorBlob makeBlob(int color, cv::Point2d centroid) {
+    ColorBlob blob;
+    blob.color = color;
+    blob.centroid = centroid;
+    blob.area = 100;
+    blob.boundingBox = cv::Rect(cvRound(centroid.x) - 5, cvRound(centroid.y) - 5, 10, 10);
+    return blob;
+}
+
+}  // namespace
+
+// 测试多个颜色（包括由两个色相区间组成的红色）在一次检测中返回各自的色块
+TEST(ColorDetectorTest, DetectsMultipleColorsInOneSweep) {
+    cv::Mat frame(120, 200, CV_8UC3, cv::Scalar(30, 30, 30));
+    const cv::Rect redLarge(10, 10, 40, 20);
+    const cv::Rect redSmall(150, 80, 12, 10);
+    const cv::Rect green(70, 40, 25, 25);
+    cv::rectangle(frame, redLarge, cv::Scalar(0, 0, 255), cv::FILLED);
+    cv::rectangle(frame, redSmall, cv::Scalar(40, 0, 255), cv::FILLED);  // 色相约 175
+    cv::rectangle(frame, green, cv::Scalar(0, 255, 0), cv::FILLED);
+    // 小于最小面积，不返回
+    cv::rectangle(frame, cv::Rect(5, 100, 2, 2), cv::Scalar(0, 255, 0), cv::FILLED);
+
+    ColorDetector detector;
+    const int red = detector.addColor("red", kRedRanges);
+    const int greenIndex = detector.addColor("green", kGreenRanges);
+    ASSERT_EQ(red, 0);
+    ASSERT_EQ(greenIndex, 1);
+    EXPECT_EQ(detector.findColor("green"), greenIndex);
+    EXPECT_EQ(detector.findColor("blue"), -1);
+
+    const auto blobs = detector.detect(frame);
+    ASSERT_EQ(blobs.size(), 3u);
+    expectBlob(blobs[0], red, redLarge);
+    expectBlob(blobs[1], red, redSmall);
+    expectBlob(blobs[2], greenIndex, green);
+
+    // 掩码与 cvtColor + inRange 的结果一致
+    cv::Mat hsv;
+    cv::cvtColor(frame, hsv, cv::COLOR_BGR2HSV);
+    cv::Mat expected;
+    cv::inRange(hsv, kGreenRanges[0].lower, kGreenRanges[0].upper, expected);
+    EXPECT_EQ(cv::norm(detector.getMask(greenIndex), expected, cv::NORM_INF), 0.0);
+    EXPECT_TRUE(detector.getMask(5).empty());
+
+    // 单个跨越 0 的色相区间与两个区间等价
+    ColorDetector wrapped;
+    wrapped.addColor("red", {{cv::Scalar(170, 100, 100), cv::Scalar(10, 255, 255)}});
+    const auto wrappedBlobs = wrapped.detect(frame);
+    ASSERT_EQ(wrappedBlobs.size(), 2u);
+    expectBlob(wrappedBlobs[0], 0, redLarge);
+    expectBlob(wrappedBlobs[1], 0, redSmall);
+}
+
+// 测试检测区域、BGR 模式和 BGRA 输入
+TEST(ColorDetectorTest, RegionAndColorSpaces) {
+    cv::Mat frame(100, 160, CV_8UC3, cv::Scalar(0, 0, 0));
+    const cv::Rect inside(60, 30, 20, 10);
+    cv::rectangle(frame, inside, cv::Scalar(200, 50, 20), cv::FILLED);
+    cv::rectangle(frame, cv::Rect(5, 5, 20, 10), cv::Scalar(200, 50, 20), cv::FILLED);
+
+    ColorDetectOptions options;
+    options.useHsv = false;
+    options.roi = cv::Rect(40, 20, 80, 60);
+    ColorDetector detector(options);
+    const int blue =
+        detector.addColor("blue", {{cv::Scalar(150, 0, 0), cv::Scalar(255, 100, 100)}});
+    ASSERT_GE(blue, 0);
+
+    const auto blobs = detector.detect(frame);
+    ASSERT_EQ(blobs.size(), 1u);
+    expectBlob(blobs[0], blue, inside);
+    EXPECT_EQ(detector.getMask(blue).size(), options.roi.size());
+
+    cv::Mat bgra;
+    cv::cvtColor(frame, bgra, cv::COLOR_BGR2BGRA);
+    const auto bgraBlobs = detector.detect(bgra);
+    ASSERT_EQ(bgraBlobs.size(), 1u);
+    expectBlob(bgraBlobs[0], blue, inside);
+
+    // 切换到 HSV 后同一范围按 HSV 解释
+    options.useHsv = true;
+    options.roi = cv::Rect();
+    detector.setOptions(options);
+    detector.clear();
+    detector.addColor("blue", {{cv::Scalar(100, 150, 150), cv::Scalar(130, 255, 255)}});
+    EXPECT_EQ(detector.detect(bgra).size(), 2u);
+}
+
+// 测试无效输入和范围数量上限
+TEST(ColorDetectorTest, RejectsInvalidInput) {
+    ColorDetector detector;
+    const cv::Mat frame(40, 40, CV_8UC3, cv::Scalar(0, 0, 255));
+    EXPECT_TRUE(detector.detect(frame).empty());  // 没有颜色
+
+    EXPECT_EQ(detector.addColor("empty", {}), -1);
+    ASSERT_EQ(detector.addColor("red", kRedRanges), 0);
+    EXPECT_EQ(detector.addColor("red", kRedRanges), -1);
+
+    EXPECT_TRUE(detector.detect(cv::Mat()).empty());
+    EXPECT_TRUE(detector.detect(cv::Mat(40, 40, CV_8UC1, cv::Scalar(0))).empty());
+
+    ColorDetectOptions options;
+    options.roi = cv::Rect(100, 100, 10, 10);
+    detector.setOptions(options);
+    EXPECT_FALSE(detector.computeMasks(frame));
+
+    const std::vector<ColorRange> many(ColorDetector::kMaxRanges - 1, kGreenRanges[0]);
+    EXPECT_EQ(detector.addColor("many", many), -1);
+    EXPECT_EQ(detector.getColorCount(), 1u);
+}
+
+// 测试跟踪编号在帧间保持，丢失超过上限后删除，新色块获得新编号
+TEST(BlobTrackerTest, FollowsBlobsAcrossFrames) {
+    BlobTrackerOptions options;
+    options.maxDistance = 15.0;
+    options.maxMissedFrames = 2;
+    BlobTracker tracker(options);
+
+    auto tracks = tracker.update({makeBlob(0, {20, 20}), makeBlob(1, {100, 50})});
+    ASSERT_EQ(tracks.size(), 2u);
+    const int first = tracks[0].id;
+    const int second = tracks[1].id;
+    EXPECT_NE(first, second);
+
+    // 两个色块匀速移动，第二个色块在第 3 帧后消失
+    for (int frame = 1; frame <= 3; ++frame) {
+        tracks = tracker.update(
+            {makeBlob(0, {20.0 + 10 * frame, 20}), makeBlob(1, {100, 50.0 + 8 * frame})});
+        ASSERT_EQ(tracks.size(), 2u);
+        EXPECT_EQ(tracker.find(first)->blob.centroid, cv::Point2d(20.0 + 10 * frame, 20));
+        EXPECT_EQ(tracker.find(second)->missedFrames, 0);
+    }
+    EXPECT_GT(tracker.find(first)->velocity.x, 5.0);
+    EXPECT_EQ(tracker.find(first)->age, 4);
+
+    // 预测区域跟随速度前移
+    const cv::Rect region = tracker.predictRegion(first, 4);
+    EXPECT_GT(region.x, tracker.find(first)->blob.boundingBox.x - 4);
+    EXPECT_EQ(region.width, 18);
+    EXPECT_TRUE(tracker.predictRegion(999, 4).empty());
+
+    // 颜色不同的色块不会匹配到已有跟踪
+    for (int frame = 4; frame <= 6; ++frame) {
+        tracks = tracker.update(
+            {makeBlob(0, {20.0 + 10 * frame, 20}), makeBlob(0, {100, 50.0 + 8 * frame})});
+    }
+    ASSERT_NE(tracker.find(first), nullptr);
+    EXPECT_EQ(tracker.find(second), nullptr);
+    EXPECT_EQ(tracks.size(), 2u);
+    for (const TrackedBlob& track : tracks) {
+        EXPECT_TRUE(track.id == first || (track.id != second && track.blob.color == 0));
+    }
+
+    tracker.reset();
+    EXPECT_TRUE(tracker.getTracks().empty());
+}
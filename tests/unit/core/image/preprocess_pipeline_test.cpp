@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "core/image/preprocess_pipeline.h"
+#include "core/image/processor.h"
+
+using namespace oneday::image;
+
+namespace {
+
+cv::Mat makeFrame(cv::Size size, uint64_t seed) {
+    cv::Mat frame(size, CV_8UC3);
+    cv::RNG rng(seed);
+    rng.fill(frame, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+    return frame;
+}
+
+}  // namespace
+
+// 测试相邻的逐像素阶段合并为一遍，结果与逐个调用 ImageProcessor 一致
+TEST(PreprocessPipelineTest, FusesElementwiseStages) {
+    const cv::Mat frame = makeFrame(cv::Size(321, 197), 1);
+    ImageProcessor processor;
+
+    PreprocessPipeline gray;
+    gray.adjustContrast(1.3, 12).convertColor(cv::COLOR_BGR2GRAY);
+    EXPECT_EQ(gray.getStageCount(), 2u);
+    EXPECT_EQ(gray.getPassCount(), 1u);
+    const cv::Mat expectedGray =
+        processor.convertColorSpace(processor.enhanceContrast(frame, 1.3, 12), cv::COLOR_BGR2GRAY);
+    const cv::Mat& actualGray = gray.run(frame);
+    ASSERT_EQ(actualGray.type(), CV_8UC1);
+    // 允许浮点乘加的舍入差异造成的 1 级误差
+    EXPECT_LE(cv::norm(actualGray, expectedGray, cv::NORM_INF), 1.0);
+
+    PreprocessPipeline normalized;
+    normalized.convertColor(cv::COLOR_BGR2RGB)
+        .adjustContrast(0.8, -5)
+        .normalize(1.0 / 255.0, cv::Scalar(0.485, 0.456, 0.406), cv::Scalar(0.229, 0.224, 0.225));
+    EXPECT_EQ(normalized.getPassCount(), 1u);
+    cv::Mat expected = processor.enhanceContrast(
+        processor.convertColorSpace(frame, cv::COLOR_BGR2RGB), 0.8, -5);
+    expected.convertTo(expected, CV_32FC3, 1.0 / 255.0);
+    cv::subtract(expected, cv::Scalar(0.485, 0.456, 0.406), expected);
+    cv::divide(expected, cv::Scalar(0.229, 0.224, 0.225), expected);
+    const cv::Mat& actual = normalized.run(frame);
+    ASSERT_EQ(actual.type(), CV_32FC3);
+    EXPECT_LE(cv::norm(actual, expected, cv::NORM_INF), 0.02);
+}
+
+// 测试非逐像素阶段按声明顺序执行，结果与 ImageProcessor 的调用链一致
+TEST(PreprocessPipelineTest, MatchesProcessorChain) {
+    const cv::Mat frame = makeFrame(cv::Size(640, 360), 2);
+    ImageProcessor processor;
+
+    PreprocessPipeline pipeline;
+    pipeline.resize(cv::Size(320, 180))
+        .gaussianBlur(cv::Size(5, 5), 1.2)
+        .equalizeHistogram()
+        .convertColor(cv::COLOR_BGR2GRAY);
+    EXPECT_EQ(pipeline.getPassCount(), 4u);
+
+    cv::Mat expected = processor.resize(frame, cv::Size(320, 180));
+    expected = processor.applyGaussianBlur(expected, cv::Size(5, 5), 1.2);
+    expected = processor.applyHistogramEqualization(expected);
+    expected = processor.convertColorSpace(expected, cv::COLOR_BGR2GRAY);
+
+    const cv::Mat& actual = pipeline.run(frame);
+    ASSERT_EQ(actual.size(), expected.size());
+    ASSERT_EQ(actual.type(), expected.type());
+    EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0.0);
+}
+
+// 测试缓冲区在帧间复用，输入不匹配时返回空图像
+TEST(PreprocessPipelineTest, ReusesBuffersAcrossFrames) {
+    PreprocessPipeline pipeline;
+    pipeline.resize(cv::Size(160, 90)).adjustContrast(1.5).convertColor(cv::COLOR_BGR2GRAY);
+    ASSERT_TRUE(pipeline.prepare(cv::Size(640, 360), CV_8UC3));
+
+    const uchar* data = pipeline.run(makeFrame(cv::Size(640, 360), 3)).data;
+    for (uint64_t seed = 4; seed < 8; ++seed) {
+        const cv::Mat& output = pipeline.run(makeFrame(cv::Size(640, 360), seed));
+        EXPECT_EQ(output.data, data);
+        EXPECT_EQ(output.size(), cv::Size(160, 90));
+    }
+
+    // 灰度输入不能再做 BGR2GRAY
+    const cv::Mat gray(360, 640, CV_8UC1, cv::Scalar(10));
+    EXPECT_TRUE(pipeline.run(gray).empty());
+    EXPECT_TRUE(pipeline.run(cv::Mat()).empty());
+
+    // 没有阶段时输出输入的副本
+    PreprocessPipeline empty;
+    const cv::Mat frame = makeFrame(cv::Size(32, 16), 9);
+    EXPECT_EQ(cv::norm(empty.run(frame), frame, cv::NORM_INF), 0.0);
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "core/blueprint/execution_context.h"
+#include "core/blueprint/nodes/image_nodes.h"
+#include "core/image/template_matcher.h"
+
+using namespace oneday::image;
+
+namespace {
+
+/**
+ * @brief 生成带纹理的随机灰度图（模糊后的噪声，降采样后仍有可区分的结构）
+ */
+cv::Mat makeTexture(cv::Size size, uint64_t seed) {
+    cv::Mat noise(size, CV_8UC1);
+    cv::RNG rng(seed);
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar(0), cv::Scalar(256));
+    cv::Mat texture;
+    cv::GaussianBlur(noise, texture, cv::Size(5, 5), 1.5);
+    return texture;
+}
+
+cv::Mat makeFrame(uint64_t seed) {
+    cv::Mat gray = makeTexture(cv::Size(640, 360), seed);
+    cv::Mat frame;
+    cv::cvtColor(gray, frame, cv::COLOR_GRAY2BGR);
+    return frame;
+}
+
+void paste(cv::Mat& frame, const cv::Mat& patch, cv::Point at) {
+    cv::Mat colored;
+    cv::cvtColor(patch, colored, cv::COLOR_GRAY2BGR);
+    colored.copyTo(frame(cv::Rect(at, patch.size())));
+}
+
+}  // namespace
+
+// 测试不同尺寸的模板都能在金字塔上由粗到细定位到原位置，不存在的模板不会误报
+TEST(TemplateMatcherTest, FindsTemplatesCoarseToFine) {
+    const cv::Mat large = makeTexture(cv::Size(64, 48), 11);
+    const cv::Mat medium = makeTexture(cv::Size(28, 28), 12);
+    const cv::Mat small = makeTexture(cv::Size(12, 10), 13);
+    const cv::Mat absent = makeTexture(cv::Size(40, 40), 14);
+
+    cv::Mat frame = makeFrame(1);
+    paste(frame, large, {401, 37});
+    paste(frame, medium, {90, 250});
+    paste(frame, small, {333, 181});
+
+    TemplateMatcher matcher;
+    ASSERT_TRUE(matcher.addTemplate("large", large));
+    ASSERT_TRUE(matcher.addTemplate("medium", medium));
+    ASSERT_TRUE(matcher.addTemplate("small", small));
+    ASSERT_TRUE(matcher.addTemplate("absent", absent));
+    EXPECT_FALSE(matcher.addTemplate("empty", cv::Mat()));
+    EXPECT_EQ(matcher.getTemplateCount(), 4u);
+
+    const std::vector<TemplateMatch> matches = matcher.matchAll(frame);
+    ASSERT_EQ(matches.size(), 4u);
+    EXPECT_EQ(matches[0].name, "large");
+    EXPECT_TRUE(matches[0].found);
+    EXPECT_EQ(matches[0].location, cv::Rect(401, 37, 64, 48));
+    EXPECT_TRUE(matches[1].found);
+    EXPECT_EQ(matches[1].location, cv::Rect(90, 250, 28, 28));
+    EXPECT_TRUE(matches[2].found);
+    EXPECT_EQ(matches[2].location, cv::Rect(333, 181, 12, 10));
+    EXPECT_FALSE(matches[3].found);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_GT(matches[i].score, 0.99);
+        EXPECT_FALSE(matches[i].fromRoi);
+    }
+
+    EXPECT_TRUE(matcher.removeTemplate("absent"));
+    EXPECT_FALSE(matcher.hasTemplate("absent"));
+    EXPECT_TRUE(matcher.match("medium").found);
+}
+
+// 测试最近找到的模板在上次位置附近的 ROI 内匹配，目标移出 ROI 后回退到全帧搜索
+TEST(TemplateMatcherTest, SearchesLastKnownRegionFirst) {
+    const cv::Mat marker = makeTexture(cv::Size(32, 24), 21);
+    TemplateMatchOptions options;
+    options.roiMargin = 16;
+    options.roiLifetimeFrames = 2;
+    TemplateMatcher matcher(options);
+    ASSERT_TRUE(matcher.addTemplate("marker", marker));
+
+    cv::Mat frame = makeFrame(2);
+    paste(frame, marker, {200, 100});
+    TemplateMatch match = matcher.matchAll(frame)[0];
+    ASSERT_TRUE(match.found);
+    EXPECT_FALSE(match.fromRoi);
+
+    // 小幅移动：在 ROI 内找到
+    frame = makeFrame(3);
+    paste(frame, marker, {210, 94});
+    match = matcher.matchAll(frame)[0];
+    ASSERT_TRUE(match.found);
+    EXPECT_TRUE(match.fromRoi);
+    EXPECT_EQ(match.location, cv::Rect(210, 94, 32, 24));
+
+    // 大幅移动：ROI 内找不到，全帧搜索仍能找到
+    frame = makeFrame(4);
+    paste(frame, marker, {500, 300});
+    match = matcher.matchAll(frame)[0];
+    ASSERT_TRUE(match.found);
+    EXPECT_FALSE(match.fromRoi);
+    EXPECT_EQ(match.location, cv::Rect(500, 300, 32, 24));
+
+    // 目标消失超过保留帧数后不再使用 ROI
+    for (uint64_t seed = 5; seed < 9; ++seed) {
+        EXPECT_FALSE(matcher.matchAll(makeFrame(seed))[0].found);
+    }
+    frame = makeFrame(9);
+    paste(frame, marker, {505, 302});
+    match = matcher.matchAll(frame)[0];
+    ASSERT_TRUE(match.found);
+    EXPECT_FALSE(match.fromRoi);
+}
+
+// 测试共享频谱的粗层搜索与直接 matchTemplate 的结果一致
+TEST(TemplateMatcherTest, SpectrumSearchMatchesDirectSearch) {
+    cv::Mat frame = makeFrame(31);
+    std::vector<cv::Mat> templates;
+    for (int i = 0; i < 6; ++i) {
+        templates.push_back(makeTexture(cv::Size(24 + i * 6, 20 + i * 4), 40 + i));
+        paste(frame, templates.back(), {30 + i * 95, 40 + i * 45});
+    }
+
+    TemplateMatchOptions direct;
+    direct.useFFT = false;
+    TemplateMatcher spectrumMatcher;
+    TemplateMatcher directMatcher(direct);
+    for (size_t i = 0; i < templates.size(); ++i) {
+        ASSERT_TRUE(spectrumMatcher.addTemplate("t" + std::to_string(i), templates[i]));
+        ASSERT_TRUE(directMatcher.addTemplate("t" + std::to_string(i), templates[i]));
+    }
+
+    const std::vector<TemplateMatch> fromSpectrum = spectrumMatcher.matchAll(frame);
+    const std::vector<TemplateMatch> fromDirect = directMatcher.matchAll(frame);
+    ASSERT_EQ(fromSpectrum.size(), fromDirect.size());
+    for (size_t i = 0; i < fromSpectrum.size(); ++i) {
+        EXPECT_TRUE(fromSpectrum[i].found);
+        EXPECT_EQ(fromSpectrum[i].location, fromDirect[i].location);
+        EXPECT_NEAR(fromSpectrum[i].score, fromDirect[i].score, 1e-3);
+    }
+}
+
+// 测试模板匹配节点只接受 cv::Mat 帧，其他类型的对象报节点错误
+TEST(TemplateMatcherTest, NodeRejectsFramesThatAreNotMats) {
+    using namespace oneday::core::blueprint;
+    cv::Mat frame = makeFrame(7);
+    const cv::Mat patch = makeTexture(cv::Size(40, 30), 8);
+    paste(frame, patch, {200, 100});
+    auto matcher = std::make_shared<TemplateMatcher>();
+    ASSERT_TRUE(matcher->addTemplate("patch", patch));
+
+    TemplateMatchNode node("match");
+    node.setMatcher(matcher);
+    node.setTemplateName("patch");
+    node.setInputValue("exec_in", BlueprintValue(ExecutionToken(true)));
+    ExecutionContext context;
+
+    node.setInputValue("frame", BlueprintValue(ObjectReference(std::make_shared<std::string>("frame"))));
+    NodeExecutionResult result = node.execute(context);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.errorMessage, "Frame input is not a cv::Mat");
+
+    // 没有类型信息的引用同样被拒绝
+    node.setInputValue("frame", BlueprintValue(ObjectReference(std::shared_ptr<void>(
+                                    std::make_shared<cv::Mat>(frame)))));
+    result = node.execute(context);
+    EXPECT_FALSE(result.success);
+
+    node.setInputValue("frame", BlueprintValue(ObjectReference(std::make_shared<cv::Mat>(frame))));
+    result = node.execute(context);
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(node.getOutputValue("found").get<bool>());
+}
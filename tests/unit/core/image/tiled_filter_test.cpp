@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "core/image/tiled_filter.h"
+
+using namespace oneday::image;
+
+namespace {
+
+cv::Mat makeImage(cv::Size size, int type, uint64_t seed) {
+    cv::Mat image(size, type);
+    cv::RNG rng(seed);
+    rng.fill(image, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(256));
+    return image;
+}
+
+/**
+ * @brief 强制分块的小块参数（测试图像低于默认的整帧处理阈值）
+ */
+TileOptions smallTiles() {
+    TileOptions options;
+    options.tileSize = cv::Size(48, 40);
+    options.minTilePixels = 0;
+    return options;
+}
+
+}  // namespace
+
+// 测试分块覆盖整幅图像且互不重叠，块不小于两倍 halo
+TEST(TiledFilterTest, TilesCoverImage) {
+    const cv::Size size(203, 117);
+    const auto tiles = TiledFilter::makeTiles(size, cv::Size(2, 2), smallTiles());
+    ASSERT_GT(tiles.size(), 1u);
+
+    const cv::Rect bounds(0, 0, size.width, size.height);
+    int area = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        EXPECT_EQ(tiles[i] & bounds, tiles[i]);
+        for (size_t j = i + 1; j < tiles.size(); ++j) {
+            EXPECT_TRUE((tiles[i] & tiles[j]).empty());
+        }
+        area += tiles[i].area();
+    }
+    EXPECT_EQ(area, bounds.area());
+
+    for (const cv::Rect& tile : TiledFilter::makeTiles(size, cv::Size(30, 30), smallTiles())) {
+        EXPECT_TRUE(tile.width >= 60 || tile.x + tile.width == size.width);
+        EXPECT_TRUE(tile.height >= 60 || tile.y + tile.height == size.height);
+    }
+}
+
+// 测试各滤波的分块结果与整帧结果逐像素一致（包括图像边缘处的块）
+TEST(TiledFilterTest, MatchesWholeFrame) {
+    const cv::Mat color = makeImage(cv::Size(211, 157), CV_8UC3, 1);
+    const cv::Mat gray = makeImage(cv::Size(211, 157), CV_8UC1, 2);
+    const TileOptions options = smallTiles();
+    cv::Mat expected;
+    cv::Mat actual;
+
+    cv::bilateralFilter(color, expected, 9, 40, 40);
+    ASSERT_TRUE(TiledFilter::bilateralFilter(color, actual, 9, 40, 40, options));
+    EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0.0);
+
+    for (int ksize : {3, 5, 7}) {
+        cv::medianBlur(gray, expected, ksize);
+        ASSERT_TRUE(TiledFilter::medianBlur(gray, actual, ksize, options));
+        EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0.0) << ksize;
+    }
+
+    cv::adaptiveThreshold(gray, expected, 255, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY, 15,
+                          3);
+    ASSERT_TRUE(TiledFilter::adaptiveThreshold(gray, actual, 255, cv::ADAPTIVE_THRESH_MEAN_C,
+                                               cv::THRESH_BINARY, 15, 3, options));
+    EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0.0);
+
+    const cv::Mat kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(5, 5));
+    for (int op : {cv::MORPH_ERODE, cv::MORPH_OPEN, cv::MORPH_CLOSE, cv::MORPH_GRADIENT,
+                   cv::MORPH_TOPHAT}) {
+        cv::morphologyEx(color, expected, op, kernel, cv::Point(-1, -1), 2);
+        ASSERT_TRUE(TiledFilter::morphologyEx(color, actual, op, kernel, 2, options));
+        EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0.0) << op;
+    }
+}
+
+// 测试原地处理、输出缓冲区复用和参数校验
+TEST(TiledFilterTest, InPlaceAndInvalidInput) {
+    const TileOptions options = smallTiles();
+    cv::Mat image = makeImage(cv::Size(160, 120), CV_8UC1, 3);
+    cv::Mat expected;
+    cv::medianBlur(image, expected, 5);
+    ASSERT_TRUE(TiledFilter::medianBlur(image, image, 5, options));
+    EXPECT_EQ(cv::norm(image, expected, cv::NORM_INF), 0.0);
+
+    cv::Mat output(160, 120, CV_8UC1);
+    const uchar* data = output.data;
+    const cv::Mat source = makeImage(cv::Size(120, 160), CV_8UC1, 4);
+    ASSERT_TRUE(TiledFilter::medianBlur(source, output, 3, options));
+    EXPECT_EQ(output.data, data);
+
+    cv::Mat dst;
+    EXPECT_FALSE(TiledFilter::medianBlur(cv::Mat(), dst, 3, options));
+    EXPECT_FALSE(TiledFilter::medianBlur(source, dst, 4, options));
+    EXPECT_FALSE(TiledFilter::adaptiveThreshold(makeImage(cv::Size(32, 32), CV_8UC3, 5), dst, 255,
+                                                cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY,
+                                                11, 2, options));
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/indexed_heap.h"
+#include "test_helpers.h"
+#include <cmath>
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+class AStarTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 中间一堵竖墙，只在底部留出缺口
+        map = Map(20, 20);
+        map.setLine({10, 0}, {10, 17}, CellType::Obstacle);
+    }
+
+    Map map;
+    AStar astar;
+};
+
+// 测试索引堆的出队顺序和 decrease-key
+TEST(IndexedHeapTest, DecreaseKeyReordersEntries) {
+    IndexedHeap heap;
+    heap.reserve(8);
+    heap.push(1, 5.0, 1.0);
+    heap.push(2, 3.0, 1.0);
+    heap.push(3, 3.0, 0.5);
+    heap.push(4, 9.0, 1.0);
+
+    EXPECT_TRUE(heap.contains(4));
+    heap.decreaseKey(4, 1.0, 1.0);
+    EXPECT_EQ(heap.pop().node, 4u);
+    EXPECT_EQ(heap.pop().node, 3u);  // F 值相同时 H 值较小的优先
+    EXPECT_EQ(heap.pop().node, 2u);
+    EXPECT_FALSE(heap.contains(2));
+    EXPECT_EQ(heap.pop().node, 1u);
+    EXPECT_TRUE(heap.empty());
+}
+
+// 测试绕墙寻路
+TEST_F(AStarTest, FindsPathAroundWall) {
+    std::vector<Point> path = astar.findPath({2, 2}, {17, 2}, map);
+
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), (Point{2, 2}));
+    EXPECT_EQ(path.back(), (Point{17, 2}));
+    for (size_t i = 1; i < path.size(); ++i) {
+        EXPECT_TRUE(map.isWalkable(path[i]));
+        EXPECT_LE(std::abs(path[i].x - path[i - 1].x), 1);
+        EXPECT_LE(std::abs(path[i].y - path[i - 1].y), 1);
+    }
+
+    PathfindingStats stats = astar.getLastPathfindingStats();
+    EXPECT_TRUE(stats.pathFound);
+    EXPECT_EQ(stats.pathLength, static_cast<int>(path.size()));
+    EXPECT_GT(stats.nodesExplored, 0);
+}
+
+// 测试封闭区域无路径
+TEST_F(AStarTest, ReturnsEmptyPathWhenBlocked) {
+    map.setLine({10, 18}, {10, 19}, CellType::Obstacle);
+
+    std::vector<Point> path;
+    EXPECT_FALSE(astar.findPath({2, 2}, {17, 2}, map, path));
+    EXPECT_TRUE(path.empty());
+    EXPECT_FALSE(astar.getLastPathfindingStats().pathFound);
+}
+
+// 测试工作区模式与旧的哈希表模式得到相同代价的路径，且工作区可跨地图复用
+TEST_F(AStarTest, WorkspaceMatchesHashMapSearch) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> coord(0, 39);
+    Map randomMap(40, 40);
+    for (int i = 0; i < 400; ++i) {
+        randomMap.setCellType({coord(rng), coord(rng)}, CellType::Obstacle);
+    }
+
+    AStar reference;
+    reference.setSearchMode(AStar::SearchMode::HashMap);
+    std::vector<Point> path;
+    for (int query = 0; query < 200; ++query) {
+        const Map& target = query % 3 == 0 ? map : randomMap;
+        const int limit = target.getWidth() - 1;
+        Point start{coord(rng) % limit, coord(rng) % limit};
+        Point goal{coord(rng) % limit, coord(rng) % limit};
+        if (!target.isWalkable(start) || !target.isWalkable(goal)) {
+            continue;
+        }
+
+        const bool found = astar.findPath(start, goal, target, path);
+        std::vector<Point> expected = reference.findPath(start, goal, target);
+        ASSERT_EQ(found, !expected.empty());
+        EXPECT_NEAR(pathCost(path), pathCost(expected), 1e-9);
+    }
+}
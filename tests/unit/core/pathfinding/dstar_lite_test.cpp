@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/dstar_lite.h"
+#include "core/pathfinding/pathplanner.h"
+#include "test_helpers.h"
+#include <memory>
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+// 测试边走边改地图时，每次增量修复的结果与 A* 重新搜索的代价相同
+TEST(DStarLiteTest, IncrementalRepairMatchesAStar) {
+    std::mt19937 rng(23);
+    AStar astar;
+    DStarLite dstar;
+
+    for (int round = 0; round < 4; ++round) {
+        Map map(48, 40);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+        std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+        for (int y = 0; y < map.getHeight(); ++y) {
+            for (int x = 0; x < map.getWidth(); ++x) {
+                if (percent(rng) < 25) {
+                    map.setCellType({x, y}, CellType::Obstacle);
+                }
+            }
+        }
+        Point current{1, 1};
+        const Point goal{map.getWidth() - 2, map.getHeight() - 2};
+        map.setCellType(current, CellType::Walkable);
+        map.setCellType(goal, CellType::Walkable);
+
+        std::vector<Point> path;
+        std::vector<Point> expected;
+        for (int step = 0; step < 40 && current != goal; ++step) {
+            const bool found = astar.findPath(current, goal, map, expected);
+            ASSERT_EQ(dstar.findPath(current, goal, map, path), found);
+            EXPECT_EQ(dstar.getLastReplanStats().incremental, step > 0);
+            if (!found) {
+                break;
+            }
+            EXPECT_NEAR(pathCost(path), pathCost(expected), 1e-9);
+            EXPECT_EQ(path.front(), current);
+            EXPECT_EQ(path.back(), goal);
+            for (size_t i = 1; i < path.size(); ++i) {
+                EXPECT_TRUE(map.isWalkable(path[i]));
+            }
+
+            // 沿路径走几步，再随机打开或堵上一些单元格（包括路径上的）
+            current = path[std::min<size_t>(3, path.size() - 1)];
+            for (int change = 0; change < 6; ++change) {
+                Point cell = change < 2 ? path[std::min<size_t>(6 + change, path.size() - 1)]
+                                        : Point{xs(rng), ys(rng)};
+                if (cell != current && cell != goal) {
+                    map.setCellType(cell, map.isWalkable(cell) ? CellType::Obstacle
+                                                               : CellType::Walkable);
+                }
+            }
+        }
+    }
+}
+
+// 测试显式通知变化后 replan() 只重新扩展受影响的部分
+TEST(DStarLiteTest, ReplanExpandsOnlyAffectedNodes) {
+    Map map(100, 100);
+    map.setRectangle({20, 10}, {22, 89}, CellType::Obstacle);
+    DStarLite dstar;
+
+    std::vector<Point> path;
+    ASSERT_TRUE(dstar.findPath({5, 50}, {95, 50}, map, path));
+    const int initialExpansions = dstar.getLastPathfindingStats().nodesExplored;
+    EXPECT_FALSE(dstar.getLastReplanStats().incremental);
+
+    // 在路径远端堵住一格
+    map.setCellType({80, 50}, CellType::Obstacle);
+    map.setCellType({80, 49}, CellType::Obstacle);
+    dstar.notifyCellsChanged({{80, 49}, {80, 50}});
+    ASSERT_TRUE(dstar.replan(path[2], path));
+    const ReplanStats stats = dstar.getLastReplanStats();
+    EXPECT_TRUE(stats.incremental);
+    EXPECT_EQ(stats.updatedNodes, 12);  // 变化单元格外扩一格
+    EXPECT_LT(dstar.getLastPathfindingStats().nodesExplored, initialExpansions / 4);
+    EXPECT_TRUE(map.isWalkable(path[path.size() / 2]));
+
+    AStar astar;
+    EXPECT_NEAR(pathCost(path), pathCost(astar.findPath(path.front(), {95, 50}, map)), 1e-9);
+
+    // 终点改变时重新完整搜索
+    ASSERT_TRUE(dstar.findPath(path.front(), {95, 10}, map, path));
+    EXPECT_FALSE(dstar.getLastReplanStats().incremental);
+}
+
+// 测试通过 PathPlanner 使用时按地图变化记录自动增量修复
+TEST(DStarLiteTest, FollowsMapChangesThroughPathPlanner) {
+    Map map(40, 40);
+    map.setRectangle({10, 0}, {11, 30}, CellType::Obstacle);
+
+    PathPlanner planner;
+    planner.enableSmoothing(false);
+    planner.setAlgorithm(std::make_unique<DStarLite>());
+
+    std::vector<Point> path = planner.findPath({2, 2}, {30, 2}, map);
+    ASSERT_FALSE(path.empty());
+
+    map.setRectangle({10, 31}, {11, 39}, CellType::Obstacle);
+    EXPECT_TRUE(planner.findPath(path[1], {30, 2}, map).empty());
+
+    map.setCellType({10, 35}, CellType::Walkable);
+    map.setCellType({11, 35}, CellType::Walkable);
+    path = planner.findPath(path[1], {30, 2}, map);
+    ASSERT_FALSE(path.empty());
+    EXPECT_TRUE(planner.isPathValid(path, map));
+}
+
+// 测试没有通知的修改也会被 replan() 和之后的 findPath() 看到
+TEST(DStarLiteTest, ReplanReadsUnnotifiedMapChanges) {
+    Map map(30, 30);
+    DStarLite dstar;
+
+    std::vector<Point> path;
+    ASSERT_TRUE(dstar.findPath({2, 15}, {27, 15}, map, path));
+
+    // 在直线路径上竖一堵墙，不调用 notifyCellsChanged()
+    map.setRectangle({15, 5}, {15, 25}, CellType::Obstacle);
+    ASSERT_TRUE(dstar.replan(path[1], path));
+    EXPECT_TRUE(dstar.getLastReplanStats().incremental);
+    for (const Point& cell : path) {
+        EXPECT_TRUE(map.isWalkable(cell));
+    }
+    AStar astar;
+    EXPECT_NEAR(pathCost(path), pathCost(astar.findPath(path.front(), {27, 15}, map)), 1e-9);
+
+    // 之后的增量 findPath() 仍然避开这堵墙
+    map.setCellType({20, 15}, CellType::Obstacle);
+    ASSERT_TRUE(dstar.findPath(path[1], {27, 15}, map, path));
+    for (const Point& cell : path) {
+        EXPECT_TRUE(map.isWalkable(cell));
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/flow_field.h"
+#include "core/pathfinding/pathplanner.h"
+#include "test_helpers.h"
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+// 测试距离场等于 A* 的最优代价，沿流场逐步查表走出的路径代价等于距离
+TEST(FlowFieldTest, DistancesMatchAStar) {
+    Map map = makeRandomMap(64, 48, 25, 5);
+    const Point goal{40, 30};
+    map.setCellType(goal, CellType::Walkable);
+
+    FlowField field;
+    field.build(map, goal);
+    EXPECT_FALSE(field.getLastStats().incremental);
+    EXPECT_EQ(field.getNextStep(goal), goal);
+    EXPECT_EQ(field.getNextStep({-1, 3}), Point(-1, -1));
+
+    AStar astar;
+    std::vector<Point> path;
+    for (int y = 0; y < map.getHeight(); y += 3) {
+        for (int x = 0; x < map.getWidth(); x += 3) {
+            const Point start{x, y};
+            const std::vector<Point> expected = astar.findPath(start, goal, map);
+            ASSERT_EQ(field.isReachable(start), !expected.empty()) << x << "," << y;
+            ASSERT_EQ(field.extractPath(start, path), !expected.empty());
+            if (!expected.empty()) {
+                EXPECT_NEAR(field.getDistance(start), pathCost(expected), 1e-9);
+                EXPECT_NEAR(pathCost(path), pathCost(expected), 1e-9);
+                EXPECT_EQ(path.back(), goal);
+            }
+        }
+    }
+
+    // 并行传播（波前足够大）与串行传播得到相同的距离
+    const Map open = makeRandomMap(400, 300, 10, 9);
+    FlowField parallel;
+    FlowField serial;
+    serial.setParallel(false);
+    parallel.build(open, {200, 150});
+    serial.build(open, {200, 150});
+    for (int y = 0; y < open.getHeight(); ++y) {
+        for (int x = 0; x < open.getWidth(); ++x) {
+            ASSERT_EQ(parallel.getDistance({x, y}), serial.getDistance({x, y}));
+        }
+    }
+}
+
+// 测试地图变化后增量修复的结果与重新构建相同
+TEST(FlowFieldTest, IncrementalRepairMatchesRebuild) {
+    Map map = makeRandomMap(60, 50, 20, 17);
+    const Point goal{30, 25};
+    map.setCellType(goal, CellType::Walkable);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+    std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+
+    FlowField field;
+    EXPECT_GT(field.synchronize(map, goal), 0);
+    EXPECT_EQ(field.synchronize(map, goal), 0);
+
+    for (int round = 0; round < 30; ++round) {
+        // 翻转几个单元格，偶尔堵上一片或堵住终点
+        for (int change = 0; change < 4; ++change) {
+            const Point cell{xs(rng), ys(rng)};
+            map.setCellType(cell, map.isWalkable(cell) ? CellType::Obstacle : CellType::Walkable);
+        }
+        if (round % 7 == 3) {
+            map.setRectangle({xs(rng) / 2, ys(rng) / 2}, {xs(rng) / 2 + 4, ys(rng) / 2 + 3},
+                             CellType::Obstacle);
+        }
+        if (round % 10 == 5) {
+            map.setCellType(goal, map.isWalkable(goal) ? CellType::Obstacle : CellType::Walkable);
+        }
+
+        field.synchronize(map, goal);
+        EXPECT_TRUE(field.getLastStats().incremental);
+        FlowField rebuilt;
+        rebuilt.build(map, goal);
+
+        std::vector<Point> path;
+        for (int y = 0; y < map.getHeight(); ++y) {
+            for (int x = 0; x < map.getWidth(); ++x) {
+                const Point cell{x, y};
+                ASSERT_EQ(field.isReachable(cell), rebuilt.isReachable(cell)) << round;
+                if (!rebuilt.isReachable(cell)) {
+                    continue;
+                }
+                ASSERT_NEAR(field.getDistance(cell), rebuilt.getDistance(cell), 1e-9) << round;
+                ASSERT_TRUE(field.extractPath(cell, path));
+                EXPECT_NEAR(pathCost(path), rebuilt.getDistance(cell), 1e-9);
+            }
+        }
+    }
+}
+
+// 测试 PathPlanner 的流场查询模式：同一终点的后续查询不再传播，地图变化后增量修复
+TEST(FlowFieldTest, PathPlannerFlowFieldMode) {
+    Map map = makeRandomMap(50, 50, 20, 12);
+    const Point goal{45, 45};
+    map.setCellType(goal, CellType::Walkable);
+    map.setCellType({2, 2}, CellType::Walkable);
+    map.setCellType({2, 40}, CellType::Walkable);
+
+    PathPlanner planner;
+    planner.enableSmoothing(false);
+    planner.setQueryMode(PathPlanner::QueryMode::FlowField);
+    EXPECT_EQ(planner.getQueryMode(), PathPlanner::QueryMode::FlowField);
+
+    AStar astar;
+    std::vector<Point> path = planner.findPath({2, 2}, goal, map);
+    EXPECT_NEAR(pathCost(path), pathCost(astar.findPath({2, 2}, goal, map)), 1e-9);
+    EXPECT_GT(planner.getLastStats().nodesExplored, 0);
+
+    path = planner.findPath({2, 40}, goal, map);
+    EXPECT_NEAR(pathCost(path), pathCost(astar.findPath({2, 40}, goal, map)), 1e-9);
+    EXPECT_EQ(planner.getLastStats().nodesExplored, 0);
+    EXPECT_TRUE(planner.getLastStats().pathFound || path.empty());
+
+    map.setCellType(path[path.size() / 2], CellType::Obstacle);
+    path = planner.findPath({2, 40}, goal, map);
+    EXPECT_NEAR(pathCost(path), pathCost(astar.findPath({2, 40}, goal, map)), 1e-9);
+    EXPECT_TRUE(planner.getFlowField(goal, map).getLastStats().incremental);
+
+    // 缓存只保留最近使用的流场
+    planner.setFlowFieldCacheSize(1);
+    planner.findPath({2, 2}, {2, 40}, map);
+    EXPECT_FALSE(planner.getFlowField(goal, map).getLastStats().incremental);
+}
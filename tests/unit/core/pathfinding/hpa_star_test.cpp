@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/hpa_star.h"
+#include "test_helpers.h"
+#include <cmath>
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+namespace {
+
+/**
+ * @brief 增量更新后的抽象必须与从头构建的抽象完全一致
+ */
+void expectSameAbstraction(const ClusterAbstraction& actual, const ClusterAbstraction& expected) {
+    ASSERT_EQ(actual.getClusterCount(), expected.getClusterCount());
+    for (int cluster = 0; cluster < expected.getClusterCount(); ++cluster) {
+        const std::vector<Point>& entrances = expected.getEntrances(cluster);
+        ASSERT_EQ(actual.getEntrances(cluster), entrances) << "cluster " << cluster;
+        for (size_t i = 0; i < entrances.size(); ++i) {
+            EXPECT_EQ(actual.getEntranceSlot(entrances[i]), static_cast<int>(i));
+            for (size_t j = 0; j < entrances.size(); ++j) {
+                EXPECT_EQ(actual.getDistance(cluster, static_cast<int>(i), static_cast<int>(j)),
+                          expected.getDistance(cluster, static_cast<int>(i), static_cast<int>(j)));
+            }
+        }
+    }
+}
+
+}  // namespace
+
+// 测试地图变化记录
+TEST(MapChangeLogTest, ReportsRegionsSinceRevision) {
+    Map map(32, 32);
+    const uint64_t initial = map.getRevision();
+
+    map.setRectangle({4, 4}, {6, 5}, CellType::Obstacle);
+    const uint64_t afterRectangle = map.getRevision();
+    map.setCellType({20, 21}, CellType::Obstacle);
+    map.setCellType({20, 21}, CellType::Obstacle);  // 没有变化，不产生记录
+
+    std::vector<MapRegion> regions;
+    ASSERT_TRUE(map.getChangedRegions(initial, regions));
+    ASSERT_EQ(regions.size(), 2u);
+    EXPECT_EQ(regions[0].topLeft, (Point{4, 4}));
+    EXPECT_EQ(regions[0].bottomRight, (Point{6, 5}));
+
+    ASSERT_TRUE(map.getChangedRegions(afterRectangle, regions));
+    ASSERT_EQ(regions.size(), 1u);
+    EXPECT_EQ(regions[0].topLeft, (Point{20, 21}));
+
+    Map other(32, 32);
+    EXPECT_FALSE(map.getChangedRegions(other.getRevision(), regions));
+    map.resize(40, 40);
+    EXPECT_FALSE(map.getChangedRegions(afterRectangle, regions));
+}
+
+// 测试 HPA* 在 A* 能找到路径时也能找到，且路径合法、总体接近最优
+TEST(HPAStarTest, FindsNearOptimalPaths) {
+    const Map map = makeRandomMap(96, 80, 25, 3);
+    AStar astar;
+    HPAStar hpa(16);
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+    std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+    std::vector<Point> expected;
+    std::vector<Point> path;
+    double hpaTotal = 0.0;
+    double optimalTotal = 0.0;
+    for (int query = 0; query < 200; ++query) {
+        Point start{xs(rng), ys(rng)};
+        Point goal{xs(rng), ys(rng)};
+        if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+            continue;
+        }
+
+        const bool found = astar.findPath(start, goal, map, expected);
+        ASSERT_EQ(hpa.findPath(start, goal, map, path), found);
+        if (!found) {
+            continue;
+        }
+        EXPECT_EQ(path.front(), start);
+        EXPECT_EQ(path.back(), goal);
+        for (size_t i = 1; i < path.size(); ++i) {
+            EXPECT_TRUE(map.isWalkable(path[i]));
+            EXPECT_LE(std::abs(path[i].x - path[i - 1].x), 1);
+            EXPECT_LE(std::abs(path[i].y - path[i - 1].y), 1);
+        }
+        EXPECT_GE(pathCost(path), pathCost(expected) - 1e-9);
+        EXPECT_EQ(hpa.getLastPathfindingStats().pathLength, static_cast<int>(path.size()));
+        hpaTotal += pathCost(path);
+        optimalTotal += pathCost(expected);
+    }
+    EXPECT_LE(hpaTotal, optimalTotal * 1.1);
+}
+
+// 测试地图修改后只重算受影响的簇，且结果与从头构建一致
+TEST(HPAStarTest, UpdatesOnlyAffectedClusters) {
+    Map map = makeRandomMap(96, 80, 20, 5);
+    HPAStar hpa(16);
+    EXPECT_EQ(hpa.precompute(map), 30);  // 6 x 5 个簇完全构建
+    EXPECT_EQ(hpa.precompute(map), 0);
+
+    map.setRectangle({40, 20}, {44, 24}, CellType::Obstacle);
+    const int afterRectangle = hpa.precompute(map);
+    EXPECT_GT(afterRectangle, 0);
+    EXPECT_LE(afterRectangle, 5);  // 所在的簇加上入口变化的四个相邻簇
+
+    map.setCircle({70, 60}, 3, CellType::Walkable);
+    map.setCellType({15, 15}, CellType::Obstacle);
+    map.setCellType({16, 16}, CellType::Walkable);
+    EXPECT_LT(hpa.precompute(map), hpa.getAbstraction().getClusterCount());
+
+    ClusterAbstraction rebuilt(16);
+    rebuilt.synchronize(map);
+    expectSameAbstraction(hpa.getAbstraction(), rebuilt);
+
+    // 修改后的地图上仍能找到与 A* 连通性一致的路径
+    AStar astar;
+    std::vector<Point> path;
+    const Point start{1, 1};
+    const Point goal{94, 78};
+    map.setCellType(start, CellType::Walkable);
+    map.setCellType(goal, CellType::Walkable);
+    EXPECT_EQ(hpa.findPath(start, goal, map, path), !astar.findPath(start, goal, map).empty());
+}
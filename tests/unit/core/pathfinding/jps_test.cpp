@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/jps.h"
+#include "core/pathfinding/pathplanner.h"
+#include "test_helpers.h"
+#include <cmath>
+#include <memory>
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+// 测试 JPS 与 JPS+ 在随机地图上得到与 A* 相同代价的逐格路径
+TEST(JumpPointSearchTest, MatchesAStarCostOnRandomMaps) {
+    std::mt19937 rng(7);
+    AStar astar;
+    JumpPointSearch jps(JumpPointSearch::JumpMode::Scan);
+    JumpPointSearch jpsPlus(JumpPointSearch::JumpMode::Precomputed);
+
+    std::vector<Point> expected;
+    std::vector<Point> path;
+    for (int density = 10; density <= 40; density += 15) {
+        Map map(48, 32);
+        std::uniform_int_distribution<int> percent(0, 99);
+        for (int y = 0; y < map.getHeight(); ++y) {
+            for (int x = 0; x < map.getWidth(); ++x) {
+                if (percent(rng) < density) {
+                    map.setCellType({x, y}, CellType::Obstacle);
+                }
+            }
+        }
+
+        std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+        std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+        for (int query = 0; query < 150; ++query) {
+            Point start{xs(rng), ys(rng)};
+            Point goal{xs(rng), ys(rng)};
+            if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+                continue;
+            }
+
+            const bool found = astar.findPath(start, goal, map, expected);
+            for (JumpPointSearch* search : {&jps, &jpsPlus}) {
+                ASSERT_EQ(search->findPath(start, goal, map, path), found);
+                if (!found) {
+                    continue;
+                }
+                EXPECT_NEAR(pathCost(path), pathCost(expected), 1e-9);
+                EXPECT_EQ(path.front(), start);
+                EXPECT_EQ(path.back(), goal);
+                for (size_t i = 1; i < path.size(); ++i) {
+                    EXPECT_TRUE(map.isWalkable(path[i]));
+                    EXPECT_LE(std::abs(path[i].x - path[i - 1].x), 1);
+                    EXPECT_LE(std::abs(path[i].y - path[i - 1].y), 1);
+                }
+            }
+        }
+    }
+}
+
+// 测试地图修改后 JPS+ 距离表自动重建
+TEST(JumpPointSearchTest, PrecomputedTableFollowsMapChanges) {
+    Map map(20, 20);
+    map.setLine({10, 0}, {10, 17}, CellType::Obstacle);
+    JumpPointSearch jps(JumpPointSearch::JumpMode::Precomputed);
+
+    std::vector<Point> path;
+    ASSERT_TRUE(jps.findPath({2, 2}, {17, 2}, map, path));
+    EXPECT_GT(jps.getLastPathfindingStats().nodesExplored, 0);
+    EXPECT_EQ(jps.getLastPathfindingStats().pathLength, static_cast<int>(path.size()));
+
+    map.setLine({10, 18}, {10, 19}, CellType::Obstacle);
+    EXPECT_FALSE(jps.findPath({2, 2}, {17, 2}, map, path));
+    EXPECT_TRUE(path.empty());
+
+    map.setCellType({10, 5}, CellType::Walkable);
+    EXPECT_TRUE(jps.findPath({2, 2}, {17, 2}, map, path));
+}
+
+// 测试通过 PathPlanner 选择 JPS
+TEST(JumpPointSearchTest, SelectableThroughPathPlanner) {
+    Map map(30, 30);
+    map.setRectangle({5, 5}, {24, 6}, CellType::Obstacle);
+    map.setRectangle({12, 10}, {13, 29}, CellType::Obstacle);
+
+    PathPlanner planner;
+    planner.enableSmoothing(false);
+    planner.setAlgorithm(std::make_unique<JumpPointSearch>());
+
+    std::vector<Point> path = planner.findPath({1, 1}, {28, 28}, map);
+    ASSERT_FALSE(path.empty());
+    EXPECT_TRUE(planner.isPathValid(path, map));
+    EXPECT_TRUE(planner.getLastStats().pathFound);
+}
@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/hpa_star.h"
+#include "core/pathfinding/map_file.h"
+#include "test_helpers.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+// 测试二进制文件的内存映射视图、加载结果与原地图一致，并能与文本格式互相转换
+TEST(MapFileTest, RoundTripsThroughBinaryAndText) {
+    // 宽度不是 4 和 64 的倍数，覆盖打包字节和位平面的边界
+    const Map original = makeRandomMap(131, 67, 25, 5, 2);
+    const std::string binaryPath = tempPath("map_file_test.odmap");
+    const std::string textPath = tempPath("map_file_test.txt");
+    const std::string convertedPath = tempPath("map_file_test_converted.odmap");
+    ASSERT_TRUE(MapFile::save(binaryPath, original));
+    EXPECT_TRUE(MapFile::isBinaryFile(binaryPath));
+
+    MapFile file;
+    ASSERT_TRUE(file.open(binaryPath));
+    EXPECT_FALSE(file.hasAbstraction());
+    ASSERT_EQ(file.getWidth(), original.getWidth());
+    ASSERT_EQ(file.getHeight(), original.getHeight());
+    for (int y = -1; y <= original.getHeight(); ++y) {
+        for (int x = -1; x <= original.getWidth(); ++x) {
+            EXPECT_EQ(file.getCellType({x, y}), original.getCellType({x, y}));
+            EXPECT_EQ(file.isWalkableUnchecked(x, y), original.isWalkableUnchecked(x, y));
+        }
+    }
+
+    Map loaded(3, 3);
+    ASSERT_TRUE(loaded.loadFromFile(binaryPath));
+    EXPECT_EQ(loaded.getCells(), original.getCells());
+    EXPECT_EQ(loaded.countCellsOfType(CellType::Walkable),
+              original.countCellsOfType(CellType::Walkable));
+    EXPECT_TRUE(loaded.hasLineOfSight({0, 0}, {130, 66}) ==
+                original.hasLineOfSight({0, 0}, {130, 66}));
+
+    // 二进制 -> 文本 -> 二进制
+    ASSERT_TRUE(MapFile::convert(binaryPath, textPath));
+    EXPECT_FALSE(MapFile::isBinaryFile(textPath));
+    ASSERT_TRUE(MapFile::convert(textPath, convertedPath));
+    Map converted(3, 3);
+    ASSERT_TRUE(converted.loadFromFile(convertedPath));
+    EXPECT_EQ(converted.getCells(), original.getCells());
+
+    file.close();
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(convertedPath);
+}
+
+// 测试随地图保存的簇抽象导入后与重新构建的结果一致，且不需要重新计算
+TEST(MapFileTest, RestoresPrecomputedAbstraction) {
+    const Map original = makeRandomMap(96, 80, 25, 9, 2);
+    HPAStar saved(16);
+    saved.precompute(original);
+    const std::string path = tempPath("map_file_abstraction.odmap");
+    ASSERT_TRUE(MapFile::save(path, original, &saved.getAbstraction()));
+
+    MapFile file;
+    ASSERT_TRUE(file.open(path));
+    ASSERT_TRUE(file.hasAbstraction());
+    Map map(1, 1);
+    ASSERT_TRUE(file.loadInto(map));
+
+    HPAStar restored(8);
+    ASSERT_TRUE(file.loadAbstraction(restored.getAbstraction(), map));
+    EXPECT_EQ(restored.getClusterSize(), 16);
+    EXPECT_EQ(restored.precompute(map), 0);
+
+    const ClusterAbstraction& expected = saved.getAbstraction();
+    const ClusterAbstraction& actual = restored.getAbstraction();
+    ASSERT_EQ(actual.getClusterCount(), expected.getClusterCount());
+    for (int cluster = 0; cluster < expected.getClusterCount(); ++cluster) {
+        const std::vector<Point>& entrances = expected.getEntrances(cluster);
+        ASSERT_EQ(actual.getEntrances(cluster), entrances);
+        for (size_t i = 0; i < entrances.size(); ++i) {
+            EXPECT_EQ(actual.getEntranceSlot(entrances[i]), static_cast<int>(i));
+            for (size_t j = 0; j < entrances.size(); ++j) {
+                EXPECT_EQ(actual.getDistance(cluster, static_cast<int>(i), static_cast<int>(j)),
+                          expected.getDistance(cluster, static_cast<int>(i), static_cast<int>(j)));
+            }
+        }
+    }
+
+    // 导入后地图的修改仍然按变化区域增量更新
+    map.setRectangle({20, 20}, {22, 22}, CellType::Obstacle);
+    EXPECT_LT(restored.precompute(map), actual.getClusterCount());
+
+    // 尺寸相同但可行走单元格与文件不同的地图不能导入抽象
+    HPAStar stale(16);
+    EXPECT_FALSE(file.loadAbstraction(stale.getAbstraction(), map));
+    EXPECT_FALSE(file.loadAbstraction(stale.getAbstraction(), Map(96, 80)));
+    EXPECT_EQ(stale.getAbstraction().getClusterCount(), 0);
+
+    file.close();
+    std::filesystem::remove(path);
+}
+
+// 测试簇抽象中入口、过渡单元格或簇边长与地图不符的数据被拒绝
+TEST(MapFileTest, RejectsInconsistentAbstraction) {
+    const Map map(32, 32);
+    ClusterAbstraction source(16);
+    source.synchronize(map);
+    std::vector<uint8_t> bytes;
+    source.serialize(bytes);
+
+    // 布局：5 个 int32，然后簇 0 的三个计数和入口、东边、南边坐标
+    constexpr size_t kCountsOffset = 5 * sizeof(int32_t);
+    constexpr size_t kPointsOffset = kCountsOffset + 3 * sizeof(uint32_t);
+    uint32_t counts[3];
+    std::memcpy(counts, bytes.data() + kCountsOffset, sizeof(counts));
+    ASSERT_GE(counts[0], 2u);
+    ASSERT_GE(counts[1], 1u);
+    const size_t eastOffset = kPointsOffset + counts[0] * sizeof(Point);
+
+    const auto withPoint = [&](size_t offset, const Point& point) {
+        std::vector<uint8_t> copy = bytes;
+        std::memcpy(copy.data() + offset, &point, sizeof(point));
+        return copy;
+    };
+    const auto accepts = [](const std::vector<uint8_t>& data, const Map& target) {
+        ClusterAbstraction abstraction(16);
+        return abstraction.deserialize(data.data(), data.size(), target);
+    };
+    ASSERT_TRUE(accepts(bytes, map));
+
+    // 簇 0 的入口落在簇 3 内
+    EXPECT_FALSE(accepts(withPoint(kPointsOffset, Point{20, 20}), map));
+
+    // 重复的入口
+    Point firstEntrance;
+    std::memcpy(&firstEntrance, bytes.data() + kPointsOffset, sizeof(firstEntrance));
+    EXPECT_FALSE(accepts(withPoint(kPointsOffset + sizeof(Point), firstEntrance), map));
+
+    // 过渡单元格不在东边上，或者已不可行走
+    EXPECT_FALSE(accepts(withPoint(eastOffset, Point{3, 3}), map));
+    Point transition;
+    std::memcpy(&transition, bytes.data() + eastOffset, sizeof(transition));
+    Map blocked(32, 32);
+    blocked.setCellType(transition, CellType::Obstacle);
+    EXPECT_FALSE(accepts(bytes, blocked));
+
+    // 簇边长超过地图尺寸（否则计算簇数时会溢出）
+    std::vector<uint8_t> oversized = bytes;
+    const int32_t clusterSize = std::numeric_limits<int32_t>::max();
+    std::memcpy(oversized.data(), &clusterSize, sizeof(clusterSize));
+    EXPECT_FALSE(accepts(oversized, map));
+}
+
+// 测试损坏或截断的文件被拒绝
+TEST(MapFileTest, RejectsCorruptFiles) {
+    const Map original = makeRandomMap(40, 30, 25, 3, 2);
+    const std::string path = tempPath("map_file_corrupt.odmap");
+    ASSERT_TRUE(MapFile::save(path, original));
+
+    const auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 8);
+    MapFile file;
+    EXPECT_FALSE(file.open(path));
+
+    {
+        std::ofstream text(path, std::ios::trunc);
+        text << "..#\n.#.\n";
+    }
+    EXPECT_FALSE(file.open(path));
+    EXPECT_FALSE(file.isOpen());
+
+    std::filesystem::remove(path);
+}
+
+// 测试可行走位平面的填充位被置位或与单元格不一致的文件被拒绝
+TEST(MapFileTest, RejectsInconsistentWalkability) {
+    const std::string path = tempPath("map_file_walkability.odmap");
+    // 宽 70 加两格填充后每行 2 个 64 位字，共 20 + 2 行
+    constexpr size_t kRowWords = 2;
+
+    // 保存地图后把 bits 按位或到可行走段的指定字上
+    const auto saveCorrupted = [&](const Map& map, const std::vector<size_t>& words, uint64_t bits) {
+        ASSERT_TRUE(MapFile::save(path, map));
+        std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+        MapFileHeader header{};
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        for (size_t word : words) {
+            const auto offset =
+                static_cast<std::streamoff>(header.walkableOffset + word * sizeof(uint64_t));
+            uint64_t value = 0;
+            stream.seekg(offset);
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+            value |= bits;
+            stream.seekp(offset);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    };
+
+    MapFile file;
+    const Map obstacles = makeRandomMap(70, 20, 25, 4, 2);
+    saveCorrupted(obstacles, {}, 0);
+    ASSERT_TRUE(file.open(path));
+    file.close();
+
+    // 整个字置位：填充位和障碍格都变为可行走
+    saveCorrupted(obstacles, {kRowWords}, ~0ull);
+    EXPECT_FALSE(file.open(path));
+
+    // 全部可行走的地图只额外置位每行 x = -1 的填充位
+    const Map walkable(70, 20);
+    std::vector<size_t> rowStarts;
+    for (size_t y = 1; y <= 20; ++y) {
+        rowStarts.push_back(y * kRowWords);
+    }
+    saveCorrupted(walkable, rowStarts, 1u);
+    EXPECT_FALSE(file.open(path));
+    Map loaded(3, 3);
+    EXPECT_FALSE(loaded.loadFromFile(path));
+
+    // 底部填充行
+    saveCorrupted(walkable, {21 * kRowWords}, 1u);
+    EXPECT_FALSE(file.open(path));
+
+    std::filesystem::remove(path);
+}
+
+// 测试各种宽度（行首落在打包字节的不同位置、行跨多个 64 位字）下的校验：
+// 一致的文件能打开，任一不可行走单元格的位被置位时被拒绝
+TEST(MapFileTest, ValidatesWalkabilityAtEveryRowAlignment) {
+    const std::string path = tempPath("map_file_alignment.odmap");
+    MapFile file;
+    for (int width : {1, 2, 3, 5, 31, 33, 62, 63, 64, 65, 127, 130}) {
+        const Map map = makeRandomMap(width, 7, 40, static_cast<unsigned int>(width), 2);
+        ASSERT_TRUE(MapFile::save(path, map));
+        ASSERT_TRUE(file.open(path)) << "width " << width;
+        file.close();
+
+        const size_t rowWords = (static_cast<size_t>(width) + 2 + 63) / 64;
+        for (int y = 0; y < map.getHeight(); ++y) {
+            // 每行检查第一个和最后一个不可行走的单元格
+            std::vector<int> blocked;
+            for (int x = 0; x < width; ++x) {
+                if (!map.isWalkable({x, y})) {
+                    blocked.push_back(x);
+                }
+            }
+            if (blocked.empty()) {
+                continue;
+            }
+            for (int x : {blocked.front(), blocked.back()}) {
+                ASSERT_TRUE(MapFile::save(path, map));
+                {
+                    std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+                    MapFileHeader header{};
+                    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+                    const size_t bit = static_cast<size_t>(x) + 1;
+                    const size_t word = (static_cast<size_t>(y) + 1) * rowWords + bit / 64;
+                    const auto offset = static_cast<std::streamoff>(header.walkableOffset +
+                                                                    word * sizeof(uint64_t));
+                    uint64_t value = 0;
+                    stream.seekg(offset);
+                    stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+                    value |= 1ull << (bit % 64);
+                    stream.seekp(offset);
+                    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+                }
+                EXPECT_FALSE(file.open(path)) << "width " << width << " cell " << x << "," << y;
+            }
+        }
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/map.h"
+#include "test_helpers.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+namespace {
+
+/**
+ * @brief 逐格比较的视线参考实现
+ */
+bool referenceLineOfSight(const Map& map, const Point& from, const Point& to) {
+    int dx = std::abs(to.x - from.x);
+    int dy = std::abs(to.y - from.y);
+    int x = from.x;
+    int y = from.y;
+    int error = dx - dy;
+    while (true) {
+        if (map.getCellType({x, y}) != CellType::Walkable) {
+            return false;
+        }
+        if (x == to.x && y == to.y) {
+            return true;
+        }
+        int error2 = 2 * error;
+        if (error2 > -dy) {
+            error -= dy;
+            x += (to.x > from.x) ? 1 : -1;
+        }
+        if (error2 < dx) {
+            error += dx;
+            y += (to.y > from.y) ? 1 : -1;
+        }
+    }
+}
+
+/**
+ * @brief 逐格递归的 4 连通填充参考实现
+ */
+void referenceFloodFill(std::vector<CellType>& cells, int width, int height, Point start,
+                        CellType newType) {
+    const CellType target = cells[start.y * width + start.x];
+    if (target == newType) {
+        return;
+    }
+    std::vector<Point> stack{start};
+    while (!stack.empty()) {
+        const Point p = stack.back();
+        stack.pop_back();
+        if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height ||
+            cells[p.y * width + p.x] != target) {
+            continue;
+        }
+        cells[p.y * width + p.x] = newType;
+        stack.push_back({p.x + 1, p.y});
+        stack.push_back({p.x - 1, p.y});
+        stack.push_back({p.x, p.y + 1});
+        stack.push_back({p.x, p.y - 1});
+    }
+}
+
+}  // namespace
+
+// 测试按行批量查询与逐格查询结果一致（宽度不是 16 的倍数，覆盖行尾）
+TEST(MapTest, RowQueriesMatchPerCellScan) {
+    const Map map = makeRandomMap(83, 37, 30, 11, 2);
+
+    for (CellType type : {CellType::Walkable, CellType::Obstacle, CellType::Goal,
+                          CellType::Start}) {
+        std::vector<Point> expected;
+        for (int y = 0; y < map.getHeight(); ++y) {
+            for (int x = 0; x < map.getWidth(); ++x) {
+                if (map.getCellType({x, y}) == type) {
+                    expected.push_back({x, y});
+                }
+            }
+        }
+        EXPECT_EQ(map.countCellsOfType(type), static_cast<int>(expected.size()));
+        EXPECT_EQ(map.findCellsOfType(type), expected);
+        const Point first = expected.empty() ? Point{-1, -1} : expected[0];
+        EXPECT_EQ(map.findFirstCellOfType(type), first);
+    }
+}
+
+// 测试位平面随修改同步，填充格总是不可行走
+TEST(MapTest, WalkableBitsFollowEdits) {
+    Map map = makeRandomMap(70, 20, 30, 5, 2);
+    map.setRectangle({60, 2}, {69, 8}, CellType::Walkable);
+    map.setCircle({10, 10}, 4, CellType::Obstacle);
+    map.setCellType({0, 0}, CellType::Walkable);
+    map.resize(71, 22);
+
+    for (int y = -1; y <= map.getHeight(); ++y) {
+        for (int x = -1; x <= map.getWidth(); ++x) {
+            EXPECT_EQ(map.isWalkableUnchecked(x, y), map.isWalkable({x, y})) << x << "," << y;
+            if (map.isValidPosition({x, y})) {
+                EXPECT_EQ(map.isWalkable({x, y}), map.getCellType({x, y}) == CellType::Walkable);
+            }
+        }
+    }
+
+    // 边角上的邻居不越界
+    std::vector<Point> neighbors = map.getWalkableNeighbors({0, 0}, true);
+    for (const Point& neighbor : neighbors) {
+        EXPECT_TRUE(map.isWalkable(neighbor));
+    }
+    EXPECT_TRUE(map.getWalkableNeighbors({-5, 3}).empty());
+}
+
+// 测试扫描线填充与逐格填充结果一致，并且只记录一个变化区域
+TEST(MapTest, FloodFillMatchesReference) {
+    for (unsigned int seed = 1; seed <= 5; ++seed) {
+        Map map = makeRandomMap(90, 40, 30, seed, 2);
+        std::vector<CellType> expected = map.getCells();
+        const Point start = map.findFirstCellOfType(CellType::Walkable);
+        ASSERT_NE(start, (Point{-1, -1}));
+        referenceFloodFill(expected, map.getWidth(), map.getHeight(), start, CellType::Start);
+
+        const uint64_t before = map.getRevision();
+        map.floodFill(start, CellType::Start);
+        EXPECT_EQ(map.getCells(), expected);
+
+        std::vector<MapRegion> regions;
+        ASSERT_TRUE(map.getChangedRegions(before, regions));
+        EXPECT_EQ(regions.size(), 1u);
+        for (int y = 0; y < map.getHeight(); ++y) {
+            for (int x = 0; x < map.getWidth(); ++x) {
+                EXPECT_EQ(map.isWalkableUnchecked(x, y),
+                          map.getCellType({x, y}) == CellType::Walkable);
+            }
+        }
+    }
+}
+
+// 测试视线检查与逐格参考实现一致
+TEST(MapTest, LineOfSightMatchesReference) {
+    const Map map = makeRandomMap(64, 48, 30, 3, 2);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+    std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+    for (int i = 0; i < 2000; ++i) {
+        const Point from{xs(rng), ys(rng)};
+        const Point to{xs(rng), ys(rng)};
+        EXPECT_EQ(map.hasLineOfSight(from, to), referenceLineOfSight(map, from, to));
+    }
+    EXPECT_FALSE(map.hasLineOfSight({0, 0}, {-1, 0}));
+
+    // 稀疏障碍上的长直线（跨越多个 64 位字），以及构建后修改过的单元格
+    Map sparse(150, 140);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int round = 0; round < 3; ++round) {
+        for (int y = 0; y < sparse.getHeight(); ++y) {
+            for (int x = 0; x < sparse.getWidth(); ++x) {
+                if (percent(rng) < 1) {
+                    sparse.setCellType({x, y}, round == 1 ? CellType::Walkable : CellType::Goal);
+                }
+            }
+        }
+        sparse.setRectangle({60 + round * 5, 20}, {62 + round * 5, 110}, CellType::Obstacle);
+        int visible = 0;
+        for (int i = 0; i < 3000; ++i) {
+            const Point from{xs(rng) * 2, ys(rng) * 2};
+            const Point to{xs(rng) * 2 + 1, ys(rng) * 2 + 1};
+            const bool expected = referenceLineOfSight(sparse, from, to);
+            ASSERT_EQ(sparse.hasLineOfSight(from, to), expected) << from.x << "," << from.y
+                                                                 << " -> " << to.x << "," << to.y;
+            visible += expected ? 1 : 0;
+        }
+        EXPECT_GT(visible, 100);
+    }
+}
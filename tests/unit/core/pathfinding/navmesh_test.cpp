@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/navmesh.h"
+#include "core/pathfinding/pathplanner.h"
+#include "test_helpers.h"
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+namespace {
+
+double pathLength(const std::vector<Point2D>& path) {
+    double length = 0.0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += bg::distance(path[i - 1], path[i]);
+    }
+    return length;
+}
+
+}  // namespace
+
+// 测试三角形覆盖全部可行走区域、邻接关系对称，且内部边满足 Delaunay 条件
+TEST(NavMeshTest, TriangulationCoversWalkableSpace) {
+    std::vector<Polygon> obstacles = {
+        GeometryUtils::createRectangle(10.0f, 10.0f, 20.0f, 5.0f),
+        GeometryUtils::createRectangle(25.0f, 12.0f, 5.0f, 30.0f),  // 与上一个重叠
+        GeometryUtils::createCircle(Point2D(60.0f, 60.0f), 8.0f, 20),
+        GeometryUtils::createRectangle(90.0f, 40.0f, 20.0f, 10.0f),  // 超出边界
+        GeometryUtils::createRectangle(50.0f, 5.0f, 4.0f, 4.0f)};
+    const ObstacleLayer layer(obstacles);
+    const Box bounds(Point2D(0.0f, 0.0f), Point2D(100.0f, 80.0f));
+
+    NavMesh mesh;
+    ASSERT_TRUE(mesh.build(bounds, layer));
+    ASSERT_TRUE(mesh.isBuilt());
+    EXPECT_GT(mesh.getLastBuildStats().flips, 0);
+
+    MultiPolygon blocked;
+    for (const Polygon& obstacle : obstacles) {
+        MultiPolygon merged;
+        bg::union_(blocked, obstacle, merged);
+        blocked.swap(merged);
+    }
+    MultiPolygon clipped;
+    bg::intersection(bounds, blocked, clipped);
+
+    const auto& vertices = mesh.getVertices();
+    const auto& triangles = mesh.getTriangles();
+    double area = 0.0;
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const auto& v = triangles[t].vertices;
+        Polygon triangle;
+        for (int i : {0, 1, 2, 0}) {
+            bg::append(triangle.outer(), vertices[v[i]]);
+        }
+        bg::correct(triangle);
+        area += bg::area(triangle);
+
+        for (int i = 0; i < 3; ++i) {
+            const int32_t neighbor = triangles[t].neighbors[i];
+            if (neighbor < 0) {
+                continue;
+            }
+            // 对面的三角形以相反方向经过同一条边，对顶点不在本三角形的外接圆内
+            const auto& other = triangles[neighbor];
+            int j = 0;
+            while (j < 3 && other.neighbors[j] != static_cast<int32_t>(t)) {
+                ++j;
+            }
+            ASSERT_LT(j, 3);
+            EXPECT_EQ(other.vertices[j], v[(i + 1) % 3]);
+            EXPECT_EQ(other.vertices[(j + 1) % 3], v[i]);
+            const Point2D& a = vertices[v[0]];
+            const Point2D& b = vertices[v[1]];
+            const Point2D& c = vertices[v[2]];
+            const Point2D& d = vertices[other.vertices[(j + 2) % 3]];
+            const double r2 = [&] {
+                const double ax = a.x() - c.x(), ay = a.y() - c.y();
+                const double bx = b.x() - c.x(), by = b.y() - c.y();
+                const double denominator = 2.0 * (ax * by - ay * bx);
+                const double ux = (by * (ax * ax + ay * ay) - ay * (bx * bx + by * by)) /
+                                  denominator;
+                const double uy = (ax * (bx * bx + by * by) - bx * (ax * ax + ay * ay)) /
+                                  denominator;
+                const double dx = d.x() - c.x() - ux, dy = d.y() - c.y() - uy;
+                return (dx * dx + dy * dy) / (ux * ux + uy * uy);
+            }();
+            EXPECT_GE(r2, 1.0 - 1e-4);
+        }
+    }
+    EXPECT_NEAR(area, 100.0 * 80.0 - bg::area(clipped), 1e-2);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> xs(0.0f, 100.0f);
+    std::uniform_real_distribution<float> ys(0.0f, 80.0f);
+    for (int i = 0; i < 500; ++i) {
+        const Point2D point(xs(rng), ys(rng));
+        EXPECT_EQ(mesh.findTriangle(point) >= 0, !layer.containsPoint(point));
+    }
+    EXPECT_EQ(mesh.findTriangle(Point2D(-1.0f, 5.0f)), -1);
+}
+
+// 测试网格地图转换的导航网格：连通性与 A* 一致，路径不穿过障碍物且接近网格路径长度
+// （走廊搜索按进入边上的点估计代价，只保证走廊内最短，允许比网格路径略长）
+TEST(NavMeshTest, PathsMatchGridReachability) {
+    Map map(80, 60);
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+    std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+    std::uniform_int_distribution<int> sizes(1, 6);
+    for (int i = 0; i < 120; ++i) {
+        const Point corner{xs(rng), ys(rng)};
+        map.setRectangle(corner, {corner.x + sizes(rng), corner.y + sizes(rng)},
+                         CellType::Obstacle);
+    }
+    // 一堵封闭的墙把右下角隔开
+    map.setRectangle({60, 40}, {79, 40}, CellType::Obstacle);
+    map.setRectangle({60, 40}, {60, 59}, CellType::Obstacle);
+
+    const ObstacleLayer layer(ObstacleLayer::extractObstacles(map));
+    NavMesh mesh;
+    ASSERT_TRUE(mesh.build(Box(Point2D(0.0f, 0.0f), Point2D(80.0f, 60.0f)), layer));
+    EXPECT_LT(mesh.getLastBuildStats().triangles, map.getWidth() * map.getHeight() / 4);
+
+    AStar astar;
+    PathPlanner planner;
+    int found = 0;
+    for (int i = 0; i < 200; ++i) {
+        const Point start{xs(rng), ys(rng)};
+        const Point goal{xs(rng), ys(rng)};
+        if (!map.isWalkable(start) || !map.isWalkable(goal)) {
+            continue;
+        }
+        const Point2D from(start.x + 0.5f, start.y + 0.5f);
+        const Point2D to(goal.x + 0.5f, goal.y + 0.5f);
+        const std::vector<Point> grid = astar.findPath(start, goal, map);
+        const std::vector<Point2D> path = planner.findPath(from, to, mesh);
+        ASSERT_EQ(path.empty(), grid.empty()) << start.x << "," << start.y;
+        if (path.empty()) {
+            continue;
+        }
+        ++found;
+        EXPECT_TRUE(bg::equals(path.front(), from));
+        EXPECT_TRUE(bg::equals(path.back(), to));
+        for (size_t j = 1; j < path.size(); ++j) {
+            EXPECT_FALSE(layer.intersectsSegment(path[j - 1], path[j]));
+        }
+        EXPECT_LE(pathLength(path), pathCost(grid) * 1.05 + 1e-3);
+        EXPECT_EQ(planner.getLastStats().pathLength, static_cast<int>(path.size()));
+    }
+    EXPECT_GT(found, 50);
+}
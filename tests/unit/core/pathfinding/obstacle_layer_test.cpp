@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/obstacle_layer.h"
+#include <random>
+
+using namespace oneday::pathfinding;
+
+// 测试 R 树查询与逐个多边形测试的结果一致
+TEST(ObstacleLayerTest, QueriesMatchBruteForce) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(0.0f, 200.0f);
+    std::uniform_real_distribution<float> extent(1.0f, 12.0f);
+
+    std::vector<Polygon> obstacles;
+    for (int i = 0; i < 150; ++i) {
+        if (i % 3 == 0) {
+            obstacles.push_back(GeometryUtils::createCircle(Point2D(coord(rng), coord(rng)),
+                                                            extent(rng) / 2.0f, 12));
+        } else {
+            obstacles.push_back(
+                GeometryUtils::createRectangle(coord(rng), coord(rng), extent(rng), extent(rng)));
+        }
+    }
+    ObstacleLayer layer(std::vector<Polygon>(obstacles.begin(), obstacles.end() - 10));
+    for (auto it = obstacles.end() - 10; it != obstacles.end(); ++it) {
+        layer.insert(*it);
+    }
+    ASSERT_EQ(layer.size(), obstacles.size());
+
+    for (int i = 0; i < 300; ++i) {
+        const Point2D point(coord(rng), coord(rng));
+        bool inside = false;
+        for (const Polygon& obstacle : obstacles) {
+            inside = inside || GeometryUtils::pointInPolygon(point, obstacle);
+        }
+        EXPECT_EQ(layer.containsPoint(point), inside);
+
+        const Point2D end(coord(rng), coord(rng));
+        bool crosses = false;
+        for (const Polygon& obstacle : obstacles) {
+            crosses = crosses || GeometryUtils::lineIntersectsPolygon(point, end, obstacle);
+        }
+        EXPECT_EQ(layer.intersectsSegment(point, end), crosses);
+
+        const Box box(point, Point2D(point.x() + extent(rng), point.y() + extent(rng)));
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < obstacles.size(); ++j) {
+            if (bg::intersects(box, obstacles[j])) {
+                expected.push_back(j);
+            }
+        }
+        EXPECT_EQ(layer.queryBox(box), expected);
+    }
+
+    // 贴着边界或只碰到顶点的线段不算穿过障碍物
+    ObstacleLayer square({GeometryUtils::createRectangle(10.0f, 10.0f, 5.0f, 5.0f)});
+    EXPECT_FALSE(square.intersectsSegment(Point2D(0.0f, 10.0f), Point2D(30.0f, 10.0f)));
+    EXPECT_FALSE(square.intersectsSegment(Point2D(5.0f, 5.0f), Point2D(10.0f, 10.0f)));
+    EXPECT_FALSE(square.intersectsSegment(Point2D(5.0f, 15.0f), Point2D(15.0f, 5.0f)));
+    EXPECT_TRUE(square.intersectsSegment(Point2D(5.0f, 5.0f), Point2D(20.0f, 20.0f)));
+    EXPECT_TRUE(square.intersectsSegment(Point2D(12.0f, 12.0f), Point2D(13.0f, 12.0f)));
+}
+
+// 测试从网格地图提取的矩形恰好覆盖障碍物单元格
+TEST(ObstacleLayerTest, ExtractObstaclesFromMap) {
+    Map map(40, 30);
+    map.setRectangle({5, 5}, {14, 9}, CellType::Obstacle);
+    map.setRectangle({20, 0}, {22, 29}, CellType::Obstacle);
+    map.setCellType({0, 0}, CellType::Obstacle);
+    map.setCellType({39, 29}, CellType::Obstacle);
+    map.setCellType({10, 20}, CellType::Obstacle);
+    map.setCellType({11, 20}, CellType::Obstacle);
+    map.setCellType({11, 21}, CellType::Obstacle);
+
+    const std::vector<Polygon> rectangles = ObstacleLayer::extractObstacles(map);
+    EXPECT_EQ(rectangles.size(), 6u);
+    float area = 0.0f;
+    for (const Polygon& rectangle : rectangles) {
+        area += GeometryUtils::polygonArea(rectangle);
+    }
+    EXPECT_FLOAT_EQ(area, 50.0f + 90.0f + 2.0f + 3.0f);
+
+    const ObstacleLayer layer(rectangles);
+    for (int y = 0; y < map.getHeight(); ++y) {
+        for (int x = 0; x < map.getWidth(); ++x) {
+            const Point2D center(x + 0.5f, y + 0.5f);
+            EXPECT_EQ(layer.containsPoint(center), !map.isWalkable({x, y})) << x << "," << y;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/jps.h"
+#include "core/pathfinding/pathplanner.h"
+#include "test_helpers.h"
+#include <atomic>
+#include <memory>
+#include <random>
+
+using namespace oneday::pathfinding;
+using namespace oneday::pathfinding::test;
+
+// 测试批量查询（并行、共享终点距离场）与逐条 A* 查询的结果一致
+TEST(PathPlannerBatchTest, MatchesSequentialQueries) {
+    const Map map = makeRandomMap(80, 60, 25, 31);
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+    std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+
+    // 一半查询去同一个终点，另一半终点随机
+    const Point rally = map.findFirstCellOfType(CellType::Walkable);
+    std::vector<PathQuery> queries;
+    for (int i = 0; i < 120; ++i) {
+        queries.push_back({{xs(rng), ys(rng)}, i % 2 == 0 ? rally : Point{xs(rng), ys(rng)}});
+    }
+
+    PathPlanner planner;
+    planner.enableSmoothing(false);
+    BatchOptions options;
+    options.sharedGoalThreshold = 10;
+    const BatchResult result = planner.findPaths(queries, map, options);
+    ASSERT_EQ(result.paths.size(), queries.size());
+    ASSERT_EQ(result.stats.size(), queries.size());
+    EXPECT_EQ(result.sharedFields, 1);
+    EXPECT_GT(result.sharedQueries, 0);
+    EXPECT_GE(result.wallTime, 0.0);
+
+    AStar astar;
+    int found = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const std::vector<Point> expected = astar.findPath(queries[i].start, queries[i].goal, map);
+        const std::vector<Point>& path = result.paths[i];
+        ASSERT_EQ(path.empty(), expected.empty()) << "query " << i;
+        EXPECT_EQ(result.stats[i].pathFound, !path.empty());
+        if (!path.empty()) {
+            found++;
+            EXPECT_NEAR(pathCost(path), pathCost(expected), 1e-9);
+            EXPECT_EQ(path.front(), queries[i].start);
+            EXPECT_EQ(path.back(), queries[i].goal);
+            EXPECT_TRUE(planner.isPathValid(path, map));
+        }
+    }
+    EXPECT_EQ(result.pathsFound, found);
+
+    // 串行执行、不共享距离场时结果相同
+    options.parallel = false;
+    options.sharedGoalThreshold = 0;
+    const BatchResult serial = planner.findPaths(queries, map, options);
+    EXPECT_EQ(serial.sharedFields, 0);
+    EXPECT_EQ(serial.pathsFound, found);
+}
+
+// 测试批量查询使用工厂创建的算法实例
+TEST(PathPlannerBatchTest, UsesBatchAlgorithmFactory) {
+    Map map = makeRandomMap(40, 40, 15, 8);
+    map.setCellType({0, 0}, CellType::Walkable);
+    map.setCellType({39, 39}, CellType::Walkable);
+    std::atomic<int> created{0};
+
+    PathPlanner planner;
+    planner.setBatchAlgorithmFactory([&created]() {
+        created++;
+        return std::make_unique<JumpPointSearch>();
+    });
+
+    std::vector<PathQuery> queries(32, PathQuery{{0, 0}, {39, 39}});
+    planner.findPaths(queries, map);
+    const int afterFirstBatch = created.load();
+    EXPECT_GT(afterFirstBatch, 0);
+
+    // 实例在批次之间复用
+    const BatchResult result = planner.findPaths(queries, map);
+    EXPECT_EQ(created.load(), afterFirstBatch);
+    EXPECT_EQ(result.sharedFields, 1);  // 32 条查询同一终点
+}
+
+// 测试启发式权重同步到批量查询的算法实例（已创建的和之后新建的）
+TEST(PathPlannerBatchTest, ForwardsHeuristicWeightToBatchAlgorithms) {
+    Map map = makeRandomMap(40, 40, 15, 8);
+    map.setCellType({0, 0}, CellType::Walkable);
+    map.setCellType({39, 39}, CellType::Walkable);
+    std::vector<PathfindingAlgorithm*> created;
+
+    PathPlanner planner;
+    planner.setBatchAlgorithmFactory([&created]() {
+        auto algorithm = std::make_unique<AStar>();
+        created.push_back(algorithm.get());
+        return algorithm;
+    });
+
+    const std::vector<PathQuery> queries = {{{0, 0}, {39, 39}}, {{39, 39}, {0, 0}}};
+    BatchOptions options;
+    options.parallel = false;
+    planner.findPaths(queries, map, options);
+    ASSERT_EQ(created.size(), 1u);
+    EXPECT_DOUBLE_EQ(created[0]->getHeuristicWeight(), 1.0);
+
+    planner.setHeuristicWeight(2.5);
+    EXPECT_DOUBLE_EQ(planner.getHeuristicWeight(), 2.5);
+    EXPECT_DOUBLE_EQ(created[0]->getHeuristicWeight(), 2.5);
+
+    // 更换工厂后新建的实例也使用该权重
+    created.clear();
+    planner.setBatchAlgorithmFactory([&created]() {
+        auto algorithm = std::make_unique<AStar>();
+        created.push_back(algorithm.get());
+        return algorithm;
+    });
+    planner.findPaths(queries, map, options);
+    ASSERT_EQ(created.size(), 1u);
+    EXPECT_DOUBLE_EQ(created[0]->getHeuristicWeight(), 2.5);
+}
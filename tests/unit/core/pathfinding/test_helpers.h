@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "core/pathfinding/map.h"
+
+namespace oneday::pathfinding::test {
+
+/**
+ * @brief 8 方向网格路径的代价（直线一步 1，对角线一步 sqrt(2)）
+ */
+inline double pathCost(const std::vector<Point>& path) {
+    double cost = 0.0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        const bool diagonal = path[i].x != path[i - 1].x && path[i].y != path[i - 1].y;
+        cost += diagonal ? std::sqrt(2.0) : 1.0;
+    }
+    return cost;
+}
+
+/**
+ * @brief 生成随机障碍物地图
+ * @param density 障碍物所占百分比
+ * @param seed 随机种子
+ * @param markers 另外交替标记为起点、终点的百分比（用来覆盖其他不可行走的单元格类型）
+ */
+inline Map makeRandomMap(int width, int height, int density, unsigned int seed, int markers = 0) {
+    Map map(width, height);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const int roll = percent(rng);
+            if (roll < density) {
+                map.setCellType({x, y}, CellType::Obstacle);
+            } else if (roll < density + markers) {
+                const bool start = (roll - density) % 2 == 0;
+                map.setCellType({x, y}, start ? CellType::Start : CellType::Goal);
+            }
+        }
+    }
+    return map;
+}
+
+}  // namespace oneday::pathfinding::test
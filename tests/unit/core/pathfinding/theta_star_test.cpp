@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "core/pathfinding/astar.h"
+#include "core/pathfinding/pathplanner.h"
+#include "core/pathfinding/theta_star.h"
+#include <cmath>
+#include <memory>
+#include <random>
+
+using namespace oneday::pathfinding;
+
+namespace {
+
+double pathLength(const std::vector<Point>& path) {
+    double length = 0.0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += std::hypot(path[i].x - path[i - 1].x, path[i].y - path[i - 1].y);
+    }
+    return length;
+}
+
+}  // namespace
+
+// 测试两种变体在随机地图上的路径都有效，且不比 8 方向最短路径长
+TEST(ThetaStarTest, AnyAnglePathsAreValidAndShort) {
+    Map map(60, 45);
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int y = 0; y < map.getHeight(); ++y) {
+        for (int x = 0; x < map.getWidth(); ++x) {
+            if (percent(rng) < 22) {
+                map.setCellType({x, y}, CellType::Obstacle);
+            }
+        }
+    }
+    std::uniform_int_distribution<int> xs(0, map.getWidth() - 1);
+    std::uniform_int_distribution<int> ys(0, map.getHeight() - 1);
+
+    AStar astar;
+    ThetaStar lazy;
+    ThetaStar basic(ThetaStar::Variant::Basic);
+    PathPlanner planner;
+    int found = 0;
+    for (int i = 0; i < 150; ++i) {
+        const Point start{xs(rng), ys(rng)};
+        const Point goal{xs(rng), ys(rng)};
+        const std::vector<Point> grid = astar.findPath(start, goal, map);
+        for (ThetaStar* theta : {&lazy, &basic}) {
+            const std::vector<Point> path = theta->findPath(start, goal, map);
+            ASSERT_EQ(path.empty(), grid.empty());
+            if (path.empty()) {
+                continue;
+            }
+            EXPECT_EQ(path.front(), start);
+            EXPECT_EQ(path.back(), goal);
+            EXPECT_TRUE(planner.isPathValid(path, map));
+            EXPECT_LE(pathLength(path), pathLength(grid) + 1e-9);
+            EXPECT_LE(path.size(), grid.size());
+        }
+        found += grid.empty() ? 0 : 1;
+    }
+    EXPECT_GT(found, 50);
+}
+
+// 测试绕过墙角的长路径直接由少量转折点组成，Lazy 变体的视线检查更少
+TEST(ThetaStarTest, LongPathsComeBackSmooth) {
+    Map map(200, 200);
+    map.setRectangle({100, 0}, {104, 150}, CellType::Obstacle);
+
+    ThetaStar lazy;
+    std::vector<Point> path;
+    ASSERT_TRUE(lazy.findPath({10, 10}, {190, 20}, map, path));
+    EXPECT_LE(path.size(), 4u);
+    EXPECT_EQ(lazy.getLastPathfindingStats().pathLength, static_cast<int>(path.size()));
+
+    // 空地上的直线只有起点和终点
+    ASSERT_TRUE(lazy.findPath({5, 180}, {195, 160}, map, path));
+    EXPECT_EQ(path, (std::vector<Point>{{5, 180}, {195, 160}}));
+
+    ThetaStar basic(ThetaStar::Variant::Basic);
+    std::vector<Point> basicPath;
+    ASSERT_TRUE(basic.findPath({10, 10}, {190, 20}, map, basicPath));
+    ASSERT_TRUE(lazy.findPath({10, 10}, {190, 20}, map, path));
+    EXPECT_NEAR(pathLength(path), pathLength(basicPath), 0.5);
+    EXPECT_LT(lazy.getLastLineOfSightChecks(), basic.getLastLineOfSightChecks());
+
+    // PathPlanner 的平滑不再改变路径
+    PathPlanner planner;
+    planner.setAlgorithm(std::make_unique<ThetaStar>());
+    EXPECT_EQ(planner.findPath({10, 10}, {190, 20}, map), path);
+}